@@ -0,0 +1,73 @@
+package com.nitrofs
+
+import org.json.JSONArray
+import org.json.JSONObject
+import java.io.File
+
+/**
+ * What the partial download in `<destinationPath>.part` was fetched from, saved next to it as
+ * `<destinationPath>.part.json`. A later download of the same URL resumes from [bytes] with
+ * `Range`/`If-Range`, so the server only sends the rest if the file hasn't changed in between.
+ * Segmented downloads also record how far each of their [segments] got.
+ */
+data class DownloadCheckpoint(
+    val url: String,
+    val etag: String?,
+    val lastModified: String?,
+    val bytes: Long,
+    val totalBytes: Long?,
+    val segments: List<Segment>? = null
+) {
+    /**
+     * The range `[start, end)` of a segmented download, of which the first [received] bytes are in the part file.
+     */
+    data class Segment(val start: Long, val end: Long, val received: Long)
+
+    /**
+     * The `If-Range` value: the ETag if it is a strong one (weak ETags aren't allowed there), else Last-Modified.
+     */
+    val validator: String?
+        get() = etag?.takeUnless { it.startsWith("W/") } ?: lastModified
+
+    fun write(file: File) {
+        val json = JSONObject()
+            .put("url", url)
+            .put("etag", etag ?: JSONObject.NULL)
+            .put("lastModified", lastModified ?: JSONObject.NULL)
+            .put("bytes", bytes)
+            .put("totalBytes", totalBytes ?: JSONObject.NULL)
+        segments?.let { segments ->
+            json.put("segments", JSONArray(segments.map { JSONArray(listOf(it.start, it.end, it.received)) }))
+        }
+        file.writeText(json.toString())
+    }
+
+    companion object {
+        const val PART_SUFFIX = ".part"
+        const val CHECKPOINT_SUFFIX = ".json"
+
+        /**
+         * The checkpoint in [file], or null if there is none or it can't be parsed.
+         */
+        fun read(file: File): DownloadCheckpoint? {
+            return try {
+                val json = JSONObject(file.readText())
+                DownloadCheckpoint(
+                    url = json.getString("url"),
+                    etag = json.optString("etag").takeUnless { json.isNull("etag") },
+                    lastModified = json.optString("lastModified").takeUnless { json.isNull("lastModified") },
+                    bytes = json.getLong("bytes"),
+                    totalBytes = if (json.isNull("totalBytes")) null else json.getLong("totalBytes"),
+                    segments = json.optJSONArray("segments")?.let { segments ->
+                        (0 until segments.length()).map { i ->
+                            val segment = segments.getJSONArray(i)
+                            Segment(segment.getLong(0), segment.getLong(1), segment.getLong(2))
+                        }
+                    }
+                )
+            } catch (e: Exception) {
+                null
+            }
+        }
+    }
+}
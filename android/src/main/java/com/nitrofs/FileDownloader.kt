@@ -3,21 +3,29 @@ package com.nitrofs
 import android.util.Log
 import com.margelo.nitro.nitrofs.NitroDownloadOptions
 import com.margelo.nitro.nitrofs.NitroFile
-import io.ktor.client.HttpClient
-import io.ktor.client.call.body
-import io.ktor.client.engine.okhttp.OkHttp
-import io.ktor.client.plugins.onDownload
+import io.ktor.client.request.HttpRequestBuilder
 import io.ktor.client.request.header
 import io.ktor.client.request.prepareGet
-import io.ktor.http.HttpMethod
+import io.ktor.client.statement.HttpResponse
+import io.ktor.client.statement.bodyAsChannel
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.http.contentLength
 import io.ktor.http.isSuccess
-import io.ktor.util.cio.writeChannel
 import io.ktor.utils.io.ByteReadChannel
-import io.ktor.utils.io.copyAndClose
+import io.ktor.utils.io.readAvailable
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.withContext
 import java.io.File
+import java.io.FileOutputStream
+import java.io.RandomAccessFile
 
+/**
+ * Downloads into `<destinationPath>.part` and renames it into place once complete. The progress is
+ * checkpointed (see [DownloadCheckpoint]), so a failed or cancelled download of the same URL picks
+ * up where it left off instead of starting from byte zero. With `segments` > 1, large files are
+ * fetched by a [SegmentedDownloader].
+ */
 class FileDownloader {
     suspend fun downloadFile(
         downloadOptions: NitroDownloadOptions,
@@ -26,40 +34,189 @@ class FileDownloader {
         var contentType = ""
         val outputFile = File(downloadOptions.destinationPath)
         outputFile.parentFile?.mkdirs()
+        val partFile = File(outputFile.path + DownloadCheckpoint.PART_SUFFIX)
+        val checkpointFile = File(partFile.path + DownloadCheckpoint.CHECKPOINT_SUFFIX)
 
-        val client = HttpClient(OkHttp)
-        
+        val headers = downloadOptions.headers ?: emptyMap()
+        // A caller asking for a range of their own gets exactly that, without resuming.
+        val resumable = headers.keys.none { it.equals(HttpHeaders.Range, ignoreCase = true) }
 
-        client.use { it
-            it.prepareGet(downloadOptions.url) {
-                method = HttpMethod.Get
-                downloadOptions.headers?.forEach { (name, value) ->
-                    header(name, value)
-                }
-                onDownload { totalBytesSent, contentLength ->
-                    if (totalBytesSent > 0 && contentLength != null){
-                        onProgress?.let {
-                            withContext(Dispatchers.Main) {
-                                onProgress.invoke(totalBytesSent.toDouble(), contentLength.toDouble())
-                            }
-                        }
-                    }
+        val segments = downloadOptions.segments?.toInt() ?: 1
+        // Segments need a connection each, so they go over HTTP/1.1.
+        val client = if (segments > 1) TransferClient.http1 else TransferClient.http
+
+        if (segments > 1 && resumable) {
+            val minSegmentSize = downloadOptions.minSegmentSize?.toLong() ?: DEFAULT_MIN_SEGMENT_SIZE
+            SegmentedDownloader(client, downloadOptions.url, headers, partFile, checkpointFile)
+                .download(segments, minSegmentSize, onProgress)
+                ?.let { segmentedContentType -> contentType = segmentedContentType }
+        }
+        // Also where segmented downloads end up if the server can't serve ranges or the file is too small to split.
+        var checkpoint = if (resumable && contentType.isEmpty()) loadCheckpoint(downloadOptions.url, partFile, checkpointFile) else null
+        while (contentType.isEmpty()) {
+            val resumeFrom = checkpoint?.bytes ?: 0L
+            val restart = client.prepareGet(downloadOptions.url) {
+                downloadHeaders(headers)
+                checkpoint?.let { resumeCheckpoint ->
+                    header(HttpHeaders.Range, "bytes=$resumeFrom-")
+                    header(HttpHeaders.IfRange, resumeCheckpoint.validator)
                 }
             }.execute { response ->
                 Log.d("TAG", "${response.status.isSuccess()} ${response.status.value} ${downloadOptions.url}")
+                val contentRange = ContentRange.parse(response.headers[HttpHeaders.ContentRange])
+                if (response.status == HttpStatusCode.RequestedRangeNotSatisfiable && resumeFrom > 0) {
+                    // Nothing left after the part file: it is complete, unless the file changed size.
+                    if (contentRange?.total == resumeFrom) {
+                        contentType = response.headers["Content-Type"] ?: "application/octet-stream"
+                        return@execute false
+                    }
+                    return@execute true
+                }
                 if (!response.status.isSuccess()) {
                     throw RuntimeException("HTTP ${response.status.value}: Failed to download file")
                 }
                 contentType = response.headers["Content-Type"] ?: "application/octet-stream"
-                val channel: ByteReadChannel = response.body()
-                channel.copyAndClose(outputFile.writeChannel())
+
+                // 206 continues the part file; 200 means the server ignored the range or the file changed.
+                val append = resumeFrom > 0 && response.status == HttpStatusCode.PartialContent
+                if (append && contentRange?.start != resumeFrom) {
+                    throw RuntimeException("HTTP 206: Unexpected Content-Range ${response.headers[HttpHeaders.ContentRange]}")
+                }
+                val offset = if (append) resumeFrom else 0L
+                val totalBytes = contentRange?.total ?: response.contentLength()?.plus(offset)
+                val current = DownloadCheckpoint(
+                    url = downloadOptions.url,
+                    etag = response.headers[HttpHeaders.ETag],
+                    lastModified = response.headers[HttpHeaders.LastModified],
+                    bytes = offset,
+                    totalBytes = totalBytes
+                )
+                writeBody(response, partFile, checkpointFile.takeIf { resumable }, current, append, onProgress)
+                false
+            }
+            if (restart) {
+                partFile.delete()
+                checkpointFile.delete()
+                checkpoint = null
             }
         }
-        
+
+        if (!partFile.renameTo(outputFile)) {
+            outputFile.delete()
+            if (!partFile.renameTo(outputFile)) {
+                throw RuntimeException("Failed to move the download to ${outputFile.path}")
+            }
+        }
+        checkpointFile.delete()
+
         return NitroFile(
             name = outputFile.name,
             path = outputFile.absolutePath,
             mimeType = contentType
         )
     }
+
+    /**
+     * The checkpoint to resume from, with the part file trimmed to the bytes it vouches for.
+     * Anything that can't be resumed safely is deleted, so the download starts over.
+     */
+    private fun loadCheckpoint(url: String, partFile: File, checkpointFile: File): DownloadCheckpoint? {
+        val checkpoint = DownloadCheckpoint.read(checkpointFile)
+        val bytes = minOf(checkpoint?.bytes ?: 0L, partFile.length())
+        if (checkpoint == null || checkpoint.url != url || checkpoint.validator == null || bytes <= 0) {
+            partFile.delete()
+            checkpointFile.delete()
+            return null
+        }
+        RandomAccessFile(partFile, "rw").use { it.setLength(bytes) }
+        return checkpoint.copy(bytes = bytes)
+    }
+
+    /**
+     * Streams the body into the part file. The checkpoint is saved every [CHECKPOINT_INTERVAL] bytes and
+     * once more however the transfer ends, so a retry resumes from the last byte that made it to disk.
+     */
+    private suspend fun writeBody(
+        response: HttpResponse,
+        partFile: File,
+        checkpointFile: File?,
+        checkpoint: DownloadCheckpoint,
+        append: Boolean,
+        onProgress: ((Double, Double) -> Unit)?
+    ) {
+        val channel: ByteReadChannel = response.bodyAsChannel()
+        val buffer = ByteArray(BUFFER_SIZE)
+        var written = checkpoint.bytes
+        var saved = written
+        var lastReport = 0L
+        checkpointFile?.let { checkpoint.write(it) }
+        FileOutputStream(partFile, append).use { output ->
+            try {
+                while (true) {
+                    val read = channel.readAvailable(buffer, 0, buffer.size)
+                    if (read < 0) {
+                        break
+                    }
+                    output.write(buffer, 0, read)
+                    written += read
+                    if (checkpointFile != null && written - saved >= CHECKPOINT_INTERVAL) {
+                        checkpoint.copy(bytes = written).write(checkpointFile)
+                        saved = written
+                    }
+                    val now = System.nanoTime()
+                    if (onProgress != null && checkpoint.totalBytes != null && now - lastReport >= PROGRESS_INTERVAL_NANOS) {
+                        lastReport = now
+                        val totalBytes = checkpoint.totalBytes
+                        withContext(Dispatchers.Main) {
+                            onProgress.invoke(written.toDouble(), totalBytes.toDouble())
+                        }
+                    }
+                }
+            } finally {
+                checkpointFile?.let { checkpoint.copy(bytes = written).write(it) }
+            }
+        }
+        if (checkpoint.totalBytes != null && written != checkpoint.totalBytes) {
+            throw RuntimeException("Download ended after $written of ${checkpoint.totalBytes} bytes")
+        }
+        if (onProgress != null) {
+            val totalBytes = checkpoint.totalBytes ?: written
+            withContext(Dispatchers.Main) {
+                onProgress.invoke(written.toDouble(), totalBytes.toDouble())
+            }
+        }
+    }
+
+    /**
+     * A parsed `Content-Range: bytes <start>-<end>/<total>`. A 416 carries only the total.
+     */
+    internal data class ContentRange(val start: Long?, val total: Long?) {
+        companion object {
+            fun parse(value: String?): ContentRange? {
+                val match = value?.let { Regex("""bytes\s+(?:(\d+)-\d+|\*)/(\d+|\*)""").find(it) } ?: return null
+                return ContentRange(match.groupValues[1].toLongOrNull(), match.groupValues[2].toLongOrNull())
+            }
+        }
+    }
+
+    companion object {
+        private const val DEFAULT_MIN_SEGMENT_SIZE = 4L * 1024 * 1024
+        private const val BUFFER_SIZE = 64 * 1024
+        private const val CHECKPOINT_INTERVAL = 4L * 1024 * 1024
+        private const val PROGRESS_INTERVAL_NANOS = 100_000_000L
+    }
+}
+
+/**
+ * Sends the caller's [headers] with a download request, plus `Accept-Encoding: identity` unless they set one:
+ * Range offsets count bytes of the encoded body, so they only line up with the part file if nothing is
+ * transparently decompressed in between.
+ */
+internal fun HttpRequestBuilder.downloadHeaders(headers: Map<String, String>) {
+    headers.forEach { (name, value) ->
+        header(name, value)
+    }
+    if (headers.keys.none { it.equals(HttpHeaders.AcceptEncoding, ignoreCase = true) }) {
+        header(HttpHeaders.AcceptEncoding, "identity")
+    }
 }
@@ -3,19 +3,25 @@ package com.nitrofs
 import android.util.Log
 import com.margelo.nitro.NitroModules
 import com.margelo.nitro.core.Promise
-import com.margelo.nitro.nitrofs.HybridNitroFSSpec
+import com.margelo.nitro.nitrofs.HybridNitroFSPlatformSpec
 import com.margelo.nitro.nitrofs.NitroDownloadOptions
 import com.margelo.nitro.nitrofs.NitroFile
 import com.margelo.nitro.nitrofs.NitroFileEncoding
 import com.margelo.nitro.nitrofs.NitroFileStat
 import com.margelo.nitro.nitrofs.NitroUploadOptions
 import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.CoroutineStart
 import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.launch
+import java.util.concurrent.ConcurrentHashMap
 
-class HybridNitroFS: HybridNitroFSSpec() {
+class HybridNitroFSPlatform: HybridNitroFSPlatformSpec() {
     val context = NitroModules.applicationContext ?: error("React Native context not found")
     val nitroFsImpl = NitroFSImpl(context)
     val ioScope = CoroutineScope(Dispatchers.IO)
+    // Running transfer attempts by the id the C++ queue gave them, so `cancelTransfer` can stop them.
+    private val transfers = ConcurrentHashMap<Double, Job>()
 
     override val BUNDLE_DIR: String
         get() = ""
@@ -178,10 +184,11 @@ class HybridNitroFS: HybridNitroFSSpec() {
     }
 
     override fun uploadFile(
+        transferId: Double,
         uploadOptions: NitroUploadOptions,
         onProgress: ((Double, Double) -> Unit)?
     ): Promise<Unit> {
-        return Promise.async(ioScope) {
+        return transfer(transferId) {
             try {
                 nitroFsImpl.uploadFile(uploadOptions, onProgress)
             } catch (e: Exception) {
@@ -192,10 +199,11 @@ class HybridNitroFS: HybridNitroFSSpec() {
     }
 
     override fun downloadFile(
+        transferId: Double,
         downloadOptions: NitroDownloadOptions,
         onProgress: ((Double, Double) -> Unit)?
     ): Promise<NitroFile> {
-        return Promise.async(ioScope) {
+        return transfer(transferId) {
             try {
                 nitroFsImpl.downloadFile(downloadOptions, onProgress)
             } catch (e: Exception) {
@@ -205,6 +213,30 @@ class HybridNitroFS: HybridNitroFSSpec() {
         }
     }
 
+    override fun setMaxConnectionsPerHost(maxConnections: Double) {
+        TransferClient.maxConnectionsPerHost = maxConnections.toInt()
+    }
+
+    override fun cancelTransfer(transferId: Double) {
+        transfers[transferId]?.cancel()
+    }
+
+    /**
+     * Like `Promise.async(ioScope)`, but keeps the job under `transferId` until it ends. It is dropped before the
+     * promise settles, as the queue may start the next attempt under the same id from there.
+     */
+    private fun <T> transfer(transferId: Double, run: suspend () -> T): Promise<T> {
+        val promise = Promise<T>()
+        val job = ioScope.launch(start = CoroutineStart.LAZY) {
+            val result = runCatching { run() }
+            transfers.remove(transferId)
+            result.fold({ promise.resolve(it) }, { promise.reject(it) })
+        }
+        transfers[transferId] = job
+        job.start()
+        return promise
+    }
+
     companion object {
         const val TAG = "NitroFS"
     }
@@ -1,17 +1,22 @@
 package com.nitrofs
 
-import io.ktor.client.HttpClient
+import com.margelo.nitro.nitrofs.NitroUploadBodyType
 import com.margelo.nitro.nitrofs.NitroUploadMethod
 import com.margelo.nitro.nitrofs.NitroUploadOptions
-import io.ktor.client.engine.okhttp.OkHttp
 import io.ktor.client.plugins.onUpload
+import io.ktor.client.request.HttpRequestBuilder
 import io.ktor.client.request.header
 import io.ktor.client.request.forms.formData
 import io.ktor.client.request.forms.submitFormWithBinaryData
+import io.ktor.client.request.request
+import io.ktor.client.request.setBody
+import io.ktor.client.statement.HttpResponse
 import io.ktor.http.ContentType
 import io.ktor.http.Headers
 import io.ktor.http.HttpHeaders
 import io.ktor.http.HttpMethod
+import io.ktor.http.content.LocalFileContent
+import io.ktor.http.isSuccess
 import io.ktor.utils.io.streams.asInput
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.withContext
@@ -23,36 +28,77 @@ class NitroFileUploader {
         onProgress: ((Double, Double) -> Unit)?
     ) {
         val file = File(uploadOptions.filePath)
+        if (uploadOptions.bodyType == NitroUploadBodyType.RAW) {
+            uploadRaw(file, uploadOptions, onProgress)
+            return
+        }
         val totalBytes = file.length()
-        val client = HttpClient(OkHttp)
-
-        client.use { it
-            it.submitFormWithBinaryData(
-                url = uploadOptions.url,
-                formData = formData {
-                    appendInput(
-                        key = uploadOptions.field ?: "file",
-                        headers = Headers.build {
-                            append(HttpHeaders.ContentDisposition, "filename=\"${file.name}\"")
-                            append(HttpHeaders.ContentType, ContentType.Application.OctetStream.toString())
-                        },
-                        size = totalBytes,
-                    ) {
-                        file.inputStream().asInput()
-                    }
+        val response = TransferClient.http.submitFormWithBinaryData(
+            url = uploadOptions.url,
+            formData = formData {
+                appendInput(
+                    key = uploadOptions.field ?: "file",
+                    headers = Headers.build {
+                        append(HttpHeaders.ContentDisposition, "filename=\"${file.name}\"")
+                        append(HttpHeaders.ContentType, ContentType.Application.OctetStream.toString())
+                    },
+                    size = totalBytes,
+                ) {
+                    file.inputStream().asInput()
                 }
-            ){
-                method = getMethod(uploadOptions.method)
-                uploadOptions.headers?.forEach { (name, value) ->
+            }
+        ){
+            method = getMethod(uploadOptions.method)
+            uploadOptions.headers?.forEach { (name, value) ->
+                header(name, value)
+            }
+            reportProgress(onProgress)
+        }
+        checkStatus(response)
+    }
+
+    /**
+     * Sends the file as the whole request body, streamed from disk with its exact length.
+     */
+    private suspend fun uploadRaw(
+        file: File,
+        uploadOptions: NitroUploadOptions,
+        onProgress: ((Double, Double) -> Unit)?
+    ) {
+        // Ktor rejects a Content-Type header next to a body, so it goes into the body instead.
+        val contentType = uploadOptions.headers
+            ?.entries
+            ?.firstOrNull { it.key.equals(HttpHeaders.ContentType, ignoreCase = true) }
+            ?.let { ContentType.parse(it.value) }
+            ?: ContentType.Application.OctetStream
+        val response = TransferClient.http.request(uploadOptions.url) {
+            method = getMethod(uploadOptions.method)
+            uploadOptions.headers?.forEach { (name, value) ->
+                if (!name.equals(HttpHeaders.ContentType, ignoreCase = true)) {
                     header(name, value)
                 }
-                onUpload { totalBytesSent, totalBytes ->
-                    if (totalBytesSent > 0 && totalBytes != null) {
-                        onProgress?.let {
-                            withContext(Dispatchers.Main) {
-                                it.invoke(totalBytesSent.toDouble(), totalBytes.toDouble())
-                            }
-                        }
+            }
+            setBody(LocalFileContent(file, contentType))
+            reportProgress(onProgress)
+        }
+        checkStatus(response)
+    }
+
+    /**
+     * Fails the upload for anything but a 2xx, like iOS does.
+     */
+    private fun checkStatus(response: HttpResponse) {
+        if (!response.status.isSuccess()) {
+            throw RuntimeException("HTTP ${response.status.value}: Failed to upload file")
+        }
+    }
+
+    private fun HttpRequestBuilder.reportProgress(onProgress: ((Double, Double) -> Unit)?) {
+        onUpload { totalBytesSent, totalBytes ->
+            if (totalBytesSent > 0 && totalBytes != null) {
+                onProgress?.let {
+                    withContext(Dispatchers.Main) {
+                        it.invoke(totalBytesSent.toDouble(), totalBytes.toDouble())
                     }
                 }
             }
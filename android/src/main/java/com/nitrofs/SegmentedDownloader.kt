@@ -0,0 +1,276 @@
+package com.nitrofs
+
+import android.system.ErrnoException
+import android.system.Os
+import io.ktor.client.HttpClient
+import io.ktor.client.request.header
+import io.ktor.client.request.prepareGet
+import io.ktor.client.statement.bodyAsChannel
+import io.ktor.http.HttpHeaders
+import io.ktor.http.HttpStatusCode
+import io.ktor.utils.io.readAvailable
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
+import java.io.EOFException
+import java.io.File
+import java.io.IOException
+import java.io.RandomAccessFile
+import java.nio.ByteBuffer
+import java.nio.channels.FileChannel
+import java.util.concurrent.atomic.AtomicLong
+
+/**
+ * Fetches one file as several byte ranges at once, each over its own connection, and writes every range straight
+ * to its offset in a preallocated part file. A segment that fails is retried on its own, from where it stopped.
+ *
+ * The per-segment progress is checkpointed like a single-stream download, so an interrupted segmented download
+ * resumes too, and either kind can pick up what the other left behind.
+ */
+internal class SegmentedDownloader(
+    private val client: HttpClient,
+    private val url: String,
+    private val headers: Map<String, String>,
+    private val partFile: File,
+    private val checkpointFile: File
+) {
+    /**
+     * What the probe learned about the file, as an empty checkpoint.
+     */
+    private class Probe(val totalBytes: Long, val checkpoint: DownloadCheckpoint, val contentType: String)
+
+    private class Segment(val start: Long, val end: Long, received: Long) {
+        val received = AtomicLong(received)
+        val position: Long
+            get() = start + received.get()
+        val isDone: Boolean
+            get() = position >= end
+    }
+
+    /**
+     * Thrown when the server answers a segment with another version of the file than the probe saw.
+     */
+    private class FileChangedException : Exception()
+
+    /**
+     * Downloads the file into the part file and returns its Content-Type, or null without touching anything if
+     * the server doesn't serve ranges or the file is smaller than two [minSegmentSize]s.
+     */
+    suspend fun download(segmentCount: Int, minSegmentSize: Long, onProgress: ((Double, Double) -> Unit)?): String? {
+        // One more try if the file changes on the server mid-download; the second one starts from scratch.
+        repeat(2) {
+            val probe = probe() ?: return null
+            if (probe.totalBytes < 2 * minSegmentSize) {
+                return null
+            }
+            val segments = plan(probe, segmentCount, minSegmentSize)
+            try {
+                fetch(probe, segments, onProgress)
+                return probe.contentType
+            } catch (e: FileChangedException) {
+                partFile.delete()
+                checkpointFile.delete()
+            }
+        }
+        throw RuntimeException("Failed to download file: $url keeps changing on the server")
+    }
+
+    /**
+     * A one-byte range request: it tells the size, the validators and whether ranges are supported at all.
+     */
+    private suspend fun probe(): Probe? {
+        return client.prepareGet(url) {
+            downloadHeaders(headers)
+            header(HttpHeaders.Range, "bytes=0-0")
+        }.execute { response ->
+            if (response.status != HttpStatusCode.PartialContent) {
+                return@execute null
+            }
+            val totalBytes = FileDownloader.ContentRange.parse(response.headers[HttpHeaders.ContentRange])?.total
+                ?: return@execute null
+            val checkpoint = DownloadCheckpoint(
+                url = url,
+                etag = response.headers[HttpHeaders.ETag],
+                lastModified = response.headers[HttpHeaders.LastModified],
+                bytes = 0,
+                totalBytes = totalBytes
+            )
+            Probe(totalBytes, checkpoint, response.headers["Content-Type"] ?: "application/octet-stream")
+        }
+    }
+
+    /**
+     * The segments still to fetch: those of the checkpoint if it belongs to the same version of the file,
+     * otherwise a fresh split of the whole file (or of what a single-stream download didn't get to).
+     */
+    private fun plan(probe: Probe, segmentCount: Int, minSegmentSize: Long): List<Segment> {
+        val checkpoint = DownloadCheckpoint.read(checkpointFile)
+        val validator = probe.checkpoint.validator
+        if (checkpoint != null && checkpoint.url == url && validator != null && checkpoint.validator == validator &&
+            checkpoint.totalBytes == probe.totalBytes && partFile.exists()) {
+            checkpoint.segments?.let { segments ->
+                return segments.map { Segment(it.start, it.end, it.received) }
+            }
+            val done = minOf(checkpoint.bytes, partFile.length())
+            return listOf(Segment(0, done, done)) + split(done, probe.totalBytes, segmentCount, minSegmentSize)
+        }
+        partFile.delete()
+        checkpointFile.delete()
+        return split(0, probe.totalBytes, segmentCount, minSegmentSize)
+    }
+
+    private fun split(start: Long, end: Long, segmentCount: Int, minSegmentSize: Long): List<Segment> {
+        val length = end - start
+        if (length <= 0) {
+            return emptyList()
+        }
+        val count = (length / minSegmentSize).coerceIn(1, segmentCount.toLong())
+        val size = (length + count - 1) / count
+        return (0 until count).map { i ->
+            Segment(start + i * size, minOf(start + (i + 1) * size, end), 0)
+        }
+    }
+
+    private suspend fun fetch(probe: Probe, segments: List<Segment>, onProgress: ((Double, Double) -> Unit)?) {
+        RandomAccessFile(partFile, "rw").use { file ->
+            preallocate(file, probe.totalBytes)
+            val channel = file.channel
+            var saved = received(segments)
+            try {
+                coroutineScope {
+                    val reporter = launch {
+                        while (true) {
+                            delay(PROGRESS_INTERVAL_MS)
+                            val received = received(segments)
+                            if (received - saved >= CHECKPOINT_INTERVAL) {
+                                saveCheckpoint(probe, segments)
+                                saved = received
+                            }
+                            onProgress?.let {
+                                withContext(Dispatchers.Main) {
+                                    onProgress.invoke(received.toDouble(), probe.totalBytes.toDouble())
+                                }
+                            }
+                        }
+                    }
+                    segments.filterNot { it.isDone }
+                        .map { segment -> async(Dispatchers.IO) { fetchSegment(probe, segment, channel) } }
+                        .awaitAll()
+                    reporter.cancel()
+                }
+            } finally {
+                saveCheckpoint(probe, segments)
+            }
+            file.setLength(probe.totalBytes)
+        }
+        onProgress?.let {
+            withContext(Dispatchers.Main) {
+                onProgress.invoke(probe.totalBytes.toDouble(), probe.totalBytes.toDouble())
+            }
+        }
+    }
+
+    /**
+     * Fetches what is left of [segment], retrying dropped connections and server errors from where they stopped.
+     * Only consecutive failures that make no progress count towards [MAX_SEGMENT_RETRIES].
+     */
+    private suspend fun fetchSegment(probe: Probe, segment: Segment, channel: FileChannel) {
+        var failures = 0
+        while (!segment.isDone) {
+            val position = segment.position
+            try {
+                fetchRange(probe, segment, channel)
+            } catch (e: IOException) {
+                failures = if (segment.position > position) 1 else failures + 1
+                if (failures > MAX_SEGMENT_RETRIES) {
+                    throw e
+                }
+                delay(RETRY_DELAY_MS * failures)
+            }
+        }
+    }
+
+    private suspend fun fetchRange(probe: Probe, segment: Segment, channel: FileChannel) {
+        val validator = probe.checkpoint.validator
+        client.prepareGet(url) {
+            downloadHeaders(headers)
+            header(HttpHeaders.Range, "bytes=${segment.position}-${segment.end - 1}")
+            validator?.let { header(HttpHeaders.IfRange, it) }
+        }.execute { response ->
+            if (response.status.value >= 500) {
+                throw IOException("HTTP ${response.status.value}")
+            }
+            if (response.status == HttpStatusCode.OK) {
+                // If-Range didn't match, so the server sent the new version of the whole file.
+                throw FileChangedException()
+            }
+            if (response.status != HttpStatusCode.PartialContent) {
+                throw RuntimeException("HTTP ${response.status.value}: Failed to download file")
+            }
+            val contentRange = FileDownloader.ContentRange.parse(response.headers[HttpHeaders.ContentRange])
+            if (contentRange?.start != segment.position || contentRange.total != probe.totalBytes) {
+                throw FileChangedException()
+            }
+
+            val body = response.bodyAsChannel()
+            val buffer = ByteArray(BUFFER_SIZE)
+            while (!segment.isDone) {
+                val read = body.readAvailable(buffer, 0, minOf(buffer.size.toLong(), segment.end - segment.position).toInt())
+                if (read < 0) {
+                    throw EOFException("Connection closed ${segment.end - segment.position} bytes before the end of the range")
+                }
+                val data = ByteBuffer.wrap(buffer, 0, read)
+                var position = segment.position
+                while (data.hasRemaining()) {
+                    position += channel.write(data, position)
+                }
+                segment.received.addAndGet(read.toLong())
+            }
+        }
+    }
+
+    private fun received(segments: List<Segment>): Long = segments.sumOf { it.received.get() }
+
+    private fun saveCheckpoint(probe: Probe, segments: List<Segment>) {
+        // `bytes` is the contiguous prefix, which is what a single-stream download can resume from.
+        var prefix = 0L
+        for (segment in segments.sortedBy { it.start }) {
+            if (segment.start != prefix) {
+                break
+            }
+            prefix = segment.position
+            if (!segment.isDone) {
+                break
+            }
+        }
+        val snapshot = segments.map { DownloadCheckpoint.Segment(it.start, it.end, it.received.get()) }
+        probe.checkpoint.copy(bytes = prefix, segments = snapshot).write(checkpointFile)
+    }
+
+    /**
+     * Reserves the whole file up front, so the segments don't fragment it and a full disk fails before the
+     * download rather than in the middle of it. Filesystems without fallocate get a sparse file.
+     */
+    private fun preallocate(file: RandomAccessFile, size: Long) {
+        if (file.length() >= size) {
+            return
+        }
+        try {
+            Os.posix_fallocate(file.fd, 0, size)
+        } catch (e: ErrnoException) {
+            file.setLength(size)
+        }
+    }
+
+    companion object {
+        private const val BUFFER_SIZE = 64 * 1024
+        private const val CHECKPOINT_INTERVAL = 4L * 1024 * 1024
+        private const val PROGRESS_INTERVAL_MS = 100L
+        private const val MAX_SEGMENT_RETRIES = 3
+        private const val RETRY_DELAY_MS = 500L
+    }
+}
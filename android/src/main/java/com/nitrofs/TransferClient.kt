@@ -0,0 +1,57 @@
+package com.nitrofs
+
+import io.ktor.client.HttpClient
+import io.ktor.client.engine.okhttp.OkHttp
+import okhttp3.ConnectionPool
+import okhttp3.Dispatcher
+import okhttp3.OkHttpClient
+import okhttp3.Protocol
+import java.util.concurrent.TimeUnit
+
+/**
+ * The HTTP clients every upload and download goes through. They live as long as the module and share one
+ * connection pool and one dispatcher, so keep-alive connections, TLS sessions and HTTP/2 streams are reused
+ * from one transfer to the next instead of being set up again for each. They are never closed: closing a
+ * Ktor OkHttp client evicts its pool and shuts its dispatcher down.
+ */
+internal object TransferClient {
+    const val DEFAULT_MAX_CONNECTIONS_PER_HOST = 6
+    private const val MAX_IDLE_CONNECTIONS = 16
+    private const val KEEP_ALIVE_MINUTES = 5L
+
+    private val connectionPool = ConnectionPool(MAX_IDLE_CONNECTIONS, KEEP_ALIVE_MINUTES, TimeUnit.MINUTES)
+    private val dispatcher = Dispatcher().apply { maxRequestsPerHost = DEFAULT_MAX_CONNECTIONS_PER_HOST }
+
+    /**
+     * Negotiates HTTP/2 where the server supports it, so concurrent transfers to one host share a connection.
+     */
+    val http: HttpClient by lazy { create {} }
+
+    /**
+     * HTTP/1.1 only, for segmented downloads: HTTP/2 would multiplex the segments onto a single TCP connection,
+     * which is exactly the bottleneck they are meant to get around.
+     */
+    val http1: HttpClient by lazy { create { protocols(listOf(Protocol.HTTP_1_1)) } }
+
+    /**
+     * The most requests running at once to one host, across all transfers. Further requests wait their turn.
+     */
+    var maxConnectionsPerHost: Int
+        get() = dispatcher.maxRequestsPerHost
+        set(value) {
+            dispatcher.maxRequestsPerHost = value
+        }
+
+    private fun create(configure: OkHttpClient.Builder.() -> Unit): HttpClient {
+        return HttpClient(OkHttp) {
+            engine {
+                // Applied after the engine's own defaults, which include a fresh dispatcher per client.
+                config {
+                    connectionPool(connectionPool)
+                    dispatcher(dispatcher)
+                    configure()
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+//
+//  ByteCount.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * Converts a JS number used as a byte offset or length, rejecting negative and fractional values.
+   */
+  inline uint64_t toByteCount(double value, const char* name) {
+    if (!(value >= 0) || value >= 18446744073709551616.0 || value != static_cast<double>(static_cast<uint64_t>(value))) {
+      throw std::invalid_argument(std::string(name) + " must be a non-negative integer, got " + std::to_string(value));
+    }
+    return static_cast<uint64_t>(value);
+  }
+
+} // namespace margelo::nitro::nitrofs
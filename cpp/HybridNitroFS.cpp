@@ -0,0 +1,936 @@
+//
+//  HybridNitroFS.cpp
+//  NitroFS
+//
+
+#include "HybridNitroFS.hpp"
+#include "ByteCount.hpp"
+#include "HybridNitroFileHandle.hpp"
+#include "HybridNitroFileWriter.hpp"
+#include "HybridNitroMappedFile.hpp"
+#include "HybridNitroReadStream.hpp"
+#include "HybridNitroTransfer.hpp"
+
+#include "core/Base64.hpp"
+#include "core/Compression.hpp"
+#include "core/CopyTree.hpp"
+#include "core/FileHandle.hpp"
+#include "core/FileSystem.hpp"
+#include "core/FileWriter.hpp"
+#include "core/Hash.hpp"
+#include "core/Lines.hpp"
+#include "core/MappedFile.hpp"
+#include "core/MimeTypes.hpp"
+#include "core/Path.hpp"
+#include "core/ReadStream.hpp"
+#include "core/Remove.hpp"
+#include "core/Text.hpp"
+#include "core/TransferQueue.hpp"
+#include "core/Walk.hpp"
+#include "core/Zip.hpp"
+
+#include <NitroModules/HybridObjectRegistry.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <set>
+#include <system_error>
+#include <thread>
+
+namespace margelo::nitro::nitrofs {
+
+  namespace {
+    /** More connections than this to one server stop paying off and start looking like abuse. */
+    constexpr uint64_t kMaxDownloadSegments = 16;
+    /** The range `maxConnectionsPerHost` is clamped to; past the top, a host is better served by HTTP/2. */
+    constexpr uint64_t kMaxConnectionsPerHost = 64;
+    constexpr uint64_t kMaxConcurrentTransfers = 64;
+
+    /** Shared by every `NitroFS` instance, so the limits hold for the whole app. */
+    const std::shared_ptr<core::TransferQueue>& transferQueue() {
+      static const auto queue = std::make_shared<core::TransferQueue>();
+      return queue;
+    }
+
+    template <typename T>
+    std::shared_ptr<Promise<T>> rejectContentUri(const char* method, const std::string& path) {
+      auto error = std::runtime_error(std::string(method) + "(...) does not support content:// URIs: " + path);
+      return Promise<T>::rejected(std::make_exception_ptr(error));
+    }
+
+    core::OpenMode toOpenMode(NitroOpenMode mode) {
+      switch (mode) {
+        case NitroOpenMode::READ:
+          return core::OpenMode::Read;
+        case NitroOpenMode::WRITE:
+          return core::OpenMode::Write;
+        case NitroOpenMode::CREATE:
+          return core::OpenMode::Create;
+        case NitroOpenMode::OVERWRITE:
+          return core::OpenMode::Overwrite;
+      }
+      throw std::invalid_argument("Invalid NitroOpenMode");
+    }
+
+    core::ConflictPolicy toConflictPolicy(NitroConflictPolicy conflict) {
+      switch (conflict) {
+        case NitroConflictPolicy::OVERWRITE:
+          return core::ConflictPolicy::Overwrite;
+        case NitroConflictPolicy::SKIP:
+          return core::ConflictPolicy::Skip;
+        case NitroConflictPolicy::FAIL:
+          return core::ConflictPolicy::Fail;
+      }
+      throw std::invalid_argument("Invalid NitroConflictPolicy");
+    }
+
+    core::SyncMode toSyncMode(NitroFsyncMode fsync) {
+      switch (fsync) {
+        case NitroFsyncMode::NONE:
+          return core::SyncMode::None;
+        case NitroFsyncMode::DATA:
+          return core::SyncMode::Data;
+        case NitroFsyncMode::FULL:
+          return core::SyncMode::Full;
+      }
+      throw std::invalid_argument("Invalid NitroFsyncMode");
+    }
+
+    core::HashAlgorithm toHashAlgorithm(NitroHashAlgorithm algorithm) {
+      switch (algorithm) {
+        case NitroHashAlgorithm::SHA256:
+          return core::HashAlgorithm::Sha256;
+        case NitroHashAlgorithm::CRC32C:
+          return core::HashAlgorithm::Crc32c;
+        case NitroHashAlgorithm::XXH3:
+          return core::HashAlgorithm::Xxh3;
+        case NitroHashAlgorithm::BLAKE3:
+          return core::HashAlgorithm::Blake3;
+      }
+      throw std::invalid_argument("Invalid NitroHashAlgorithm");
+    }
+
+    core::CompressionFormat toCompressionFormat(NitroCompressionFormat format) {
+      switch (format) {
+        case NitroCompressionFormat::GZIP:
+          return core::CompressionFormat::Gzip;
+        case NitroCompressionFormat::DEFLATE:
+          return core::CompressionFormat::Deflate;
+        case NitroCompressionFormat::ZSTD:
+          return core::CompressionFormat::Zstd;
+      }
+      throw std::invalid_argument("Invalid NitroCompressionFormat");
+    }
+
+    core::CompressionOptions toCompressionOptions(NitroCompressionFormat format, const std::optional<double>& level) {
+      core::CompressionOptions result;
+      result.format = toCompressionFormat(format);
+      if (level.has_value()) {
+        // zstd has negative "fast" levels, so this can't be a toByteCount. The range is checked by the compressor.
+        if (!std::isfinite(*level) || std::trunc(*level) != *level || std::fabs(*level) > INT32_MAX) {
+          throw std::invalid_argument("compressionLevel must be an integer, got " + std::to_string(*level));
+        }
+        result.level = static_cast<int>(*level);
+      }
+      return result;
+    }
+
+    core::WriteOptions toWriteOptions(const std::optional<NitroWriteOptions>& options) {
+      NitroWriteOptions writeOptions = options.value_or(NitroWriteOptions());
+      core::WriteOptions result;
+      result.atomic = writeOptions.atomic.value_or(false);
+      result.preallocate = writeOptions.preallocate.value_or(false);
+      // Atomic writes exist for crash safety, which needs the data on disk before the rename.
+      NitroFsyncMode fsync = writeOptions.fsync.value_or(result.atomic ? NitroFsyncMode::DATA : NitroFsyncMode::NONE);
+      result.sync = toSyncMode(fsync);
+      if (writeOptions.compress.has_value()) {
+        result.compression = toCompressionOptions(*writeOptions.compress, writeOptions.compressionLevel);
+      }
+      return result;
+    }
+
+    NitroFileType toNitroFileType(core::FileType type) {
+      switch (type) {
+        case core::FileType::File:
+          return NitroFileType::FILE;
+        case core::FileType::Directory:
+          return NitroFileType::DIRECTORY;
+        case core::FileType::Symlink:
+          return NitroFileType::SYMLINK;
+        case core::FileType::Unknown:
+        case core::FileType::Other:
+          break;
+      }
+      return NitroFileType::OTHER;
+    }
+
+    NitroDirEntry toNitroDirEntry(core::DirEntry&& entry, bool withMimeType) {
+      std::optional<std::string> mimeType;
+      if (withMimeType) {
+        mimeType = std::string(core::mimeTypeForFileName(entry.name));
+      }
+      std::optional<double> size;
+      std::optional<double> mtime;
+      if (entry.stat.has_value()) {
+        size = static_cast<double>(entry.stat->size);
+        mtime = entry.stat->mtime;
+      }
+      NitroFileType type = toNitroFileType(entry.type);
+      return NitroDirEntry(std::move(entry.name), std::move(mimeType), std::move(entry.path), type, size, mtime);
+    }
+
+    std::string toLowerCase(std::string value) {
+      std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+      return value;
+    }
+
+    /**
+     * Turns `NitroWalkOptions.filter` into the core's `exclude`/`filter` callbacks.
+     */
+    void applyWalkFilter(const NitroWalkFilter& filter, core::WalkOptions& walkOptions) {
+      if (!filter.includeHidden.value_or(true)) {
+        walkOptions.exclude = [](const core::DirEntry& entry) {
+          return entry.name[0] == '.';
+        };
+      }
+      std::optional<std::set<NitroFileType>> types;
+      if (filter.types.has_value()) {
+        types.emplace(filter.types->begin(), filter.types->end());
+      }
+      std::optional<std::set<std::string>> extensions;
+      if (filter.extensions.has_value()) {
+        extensions.emplace();
+        for (const auto& extension : *filter.extensions) {
+          // Accept both "jpg" and ".jpg".
+          extensions->insert(toLowerCase(extension.size() > 0 && extension[0] == '.' ? extension.substr(1) : extension));
+        }
+      }
+      if (!types.has_value() && !extensions.has_value()) {
+        return;
+      }
+      walkOptions.filter = [types = std::move(types), extensions = std::move(extensions)](const core::DirEntry& entry) {
+        if (types.has_value() && types->count(toNitroFileType(entry.type)) == 0) {
+          return false;
+        }
+        return !extensions.has_value() || extensions->count(toLowerCase(core::extname(entry.name))) > 0;
+      };
+    }
+
+    std::vector<NitroDiskUsageEntry> toNitroDiskUsageEntries(std::vector<core::DiskUsageEntry>&& entries) {
+      std::vector<NitroDiskUsageEntry> result;
+      result.reserve(entries.size());
+      for (auto& entry : entries) {
+        result.emplace_back(std::move(entry.path), static_cast<double>(entry.size));
+      }
+      return result;
+    }
+
+    NitroFileStat toNitroFileStat(const core::FileStat& stat) {
+      return NitroFileStat(static_cast<double>(stat.size), stat.ctime, stat.mtime, stat.isFile, stat.isDirectory);
+    }
+  } // namespace
+
+  HybridNitroFS::HybridNitroFS(): HybridObject(TAG) {
+    auto platform = HybridObjectRegistry::createHybridObject("NitroFSPlatform");
+    _platform = std::dynamic_pointer_cast<HybridNitroFSPlatformSpec>(platform);
+    if (_platform == nullptr) [[unlikely]] {
+      throw std::runtime_error("NitroFSPlatform is not a HybridNitroFSPlatformSpec!");
+    }
+    sweepTrashOnce();
+  }
+
+  void HybridNitroFS::sweepTrashOnce() {
+    // Background `rm`s interrupted by the app being killed leave `.nitrofs-trash-*` directories behind.
+    // Those in the app's own directories are cleared once per process; others go with the next `rm` next to them.
+    static std::once_flag once;
+    std::call_once(once, [this]() {
+      std::vector<std::string> directories = {core::toLocalPath(_platform->getDOCUMENT_DIR()), core::toLocalPath(_platform->getCACHE_DIR())};
+      std::thread([directories = std::move(directories)]() {
+        for (const auto& directory : directories) {
+          try {
+            core::sweepTrash(directory);
+          } catch (...) {
+            // Tried again on the next launch.
+          }
+        }
+      }).detach();
+    });
+  }
+
+  // Properties
+  std::string HybridNitroFS::getBUNDLE_DIR() {
+    return _platform->getBUNDLE_DIR();
+  }
+
+  std::string HybridNitroFS::getDOCUMENT_DIR() {
+    return _platform->getDOCUMENT_DIR();
+  }
+
+  std::string HybridNitroFS::getCACHE_DIR() {
+    return _platform->getCACHE_DIR();
+  }
+
+  std::string HybridNitroFS::getDOWNLOAD_DIR() {
+    return _platform->getDOWNLOAD_DIR();
+  }
+
+  std::string HybridNitroFS::getDCIM_DIR() {
+    return _platform->getDCIM_DIR();
+  }
+
+  std::string HybridNitroFS::getPICTURES_DIR() {
+    return _platform->getPICTURES_DIR();
+  }
+
+  std::string HybridNitroFS::getMOVIES_DIR() {
+    return _platform->getMOVIES_DIR();
+  }
+
+  std::string HybridNitroFS::getMUSIC_DIR() {
+    return _platform->getMUSIC_DIR();
+  }
+
+  // Methods
+  std::shared_ptr<Promise<bool>> HybridNitroFS::exists(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->exists(path);
+    }
+    return Promise<bool>::async([path = core::toLocalPath(path)]() {
+      return core::exists(path);
+    });
+  }
+
+  std::shared_ptr<Promise<std::vector<bool>>> HybridNitroFS::existsMany(const std::vector<std::string>& paths) {
+    std::vector<std::string> localPaths;
+    localPaths.reserve(paths.size());
+    for (const auto& path : paths) {
+      if (core::isContentUri(path)) {
+        return rejectContentUri<std::vector<bool>>("existsMany", path);
+      }
+      localPaths.push_back(core::toLocalPath(path));
+    }
+    return Promise<std::vector<bool>>::async([localPaths = std::move(localPaths)]() {
+      return core::existsMany(localPaths);
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding, const std::optional<NitroWriteOptions>& options) {
+    if (core::isContentUri(path)) {
+      if (options.has_value() && options->compress.has_value()) {
+        return rejectContentUri<void>("writeFile", path);
+      }
+      return _platform->writeFile(path, data, encoding);
+    }
+    return Promise<void>::async([path = core::toLocalPath(path), data, encoding, writeOptions = toWriteOptions(options)]() {
+      switch (encoding) {
+        case NitroFileEncoding::BASE64:
+          core::writeFileBase64(path, data, writeOptions);
+          break;
+        case NitroFileEncoding::ASCII:
+          core::writeFile(path, core::utf8ToAscii(data), writeOptions);
+          break;
+        case NitroFileEncoding::UTF8:
+          core::writeFile(path, data, writeOptions);
+          break;
+      }
+    });
+  }
+
+  std::shared_ptr<Promise<std::string>> HybridNitroFS::readFile(const std::string& path, NitroFileEncoding encoding, const std::optional<NitroReadOptions>& options) {
+    std::optional<NitroCompressionFormat> decompress = options.has_value() ? options->decompress : std::nullopt;
+    if (core::isContentUri(path)) {
+      if (decompress.has_value()) {
+        return rejectContentUri<std::string>("readFile", path);
+      }
+      return _platform->readFile(path, encoding);
+    }
+    return Promise<std::string>::async([path = core::toLocalPath(path), encoding, decompress]() {
+      auto read = [&]() {
+        return decompress.has_value() ? core::readFile(path, toCompressionFormat(*decompress)) : core::readFile(path);
+      };
+      switch (encoding) {
+        case NitroFileEncoding::BASE64:
+          return decompress.has_value() ? core::readFileBase64(path, toCompressionFormat(*decompress)) : core::readFileBase64(path);
+        case NitroFileEncoding::ASCII: {
+          std::string content = read();
+          core::sanitizeAscii(content);
+          return content;
+        }
+        case NitroFileEncoding::UTF8:
+          break;
+      }
+      // Invalid sequences are replaced up front, so the JS string does not depend on how the engine handles them.
+      std::string content = read();
+      core::sanitizeUtf8(content);
+      return content;
+    });
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNitroFS::readFileBuffer(const std::string& path, const std::optional<NitroReadOptions>& options) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<std::shared_ptr<ArrayBuffer>>("readFileBuffer", path);
+    }
+    std::optional<NitroCompressionFormat> decompress = options.has_value() ? options->decompress : std::nullopt;
+    return Promise<std::shared_ptr<ArrayBuffer>>::async([path = core::toLocalPath(path), decompress]() {
+      // The file is read (or decompressed) straight into the memory that backs the JS ArrayBuffer.
+      core::ByteBuffer bytes = decompress.has_value() ? core::readFileBytes(path, toCompressionFormat(*decompress)) : core::readFileBytes(path);
+      size_t size = bytes.size();
+      uint8_t* data = bytes.release();
+      return ArrayBuffer::wrap(data, size, [data]() { std::free(data); });
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::writeFileBuffer(const std::string& path, const std::shared_ptr<ArrayBuffer>& data, const std::optional<NitroWriteOptions>& options) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<void>("writeFileBuffer", path);
+    }
+    // A JS-owned ArrayBuffer may only be touched on the JS thread, so those are copied once here.
+    // Native buffers (e.g. from readFileBuffer) are written as-is.
+    std::shared_ptr<ArrayBuffer> buffer = data->isOwner() ? data : ArrayBuffer::copy(data->data(), data->size());
+    return Promise<void>::async([path = core::toLocalPath(path), buffer, writeOptions = toWriteOptions(options)]() {
+      core::writeFile(path, std::string_view(reinterpret_cast<const char*>(buffer->data()), buffer->size()), writeOptions);
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::appendFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<void>("appendFile", path);
+    }
+    return Promise<void>::async([path = core::toLocalPath(path), data, encoding]() {
+      switch (encoding) {
+        case NitroFileEncoding::BASE64:
+          core::appendFile(path, core::base64::decode(data));
+          break;
+        case NitroFileEncoding::ASCII:
+          core::appendFile(path, core::utf8ToAscii(data));
+          break;
+        case NitroFileEncoding::UTF8:
+          core::appendFile(path, data);
+          break;
+      }
+    });
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<HybridNitroMappedFileSpec>>> HybridNitroFS::mapFile(const std::string& path, const std::optional<NitroMapOptions>& options) {
+    using Result = std::shared_ptr<HybridNitroMappedFileSpec>;
+    if (core::isContentUri(path)) {
+      return rejectContentUri<Result>("mapFile", path);
+    }
+    NitroMapOptions mapOptions = options.value_or(NitroMapOptions());
+    return Promise<Result>::async([path = core::toLocalPath(path), mapOptions]() -> Result {
+      uint64_t offset = toByteCount(mapOptions.offset.value_or(0), "offset");
+      std::optional<uint64_t> length;
+      if (mapOptions.length.has_value()) {
+        length = toByteCount(*mapOptions.length, "length");
+      }
+      auto file = core::MappedFile::open(path, offset, length, mapOptions.readOnly.value_or(true));
+      return std::make_shared<HybridNitroMappedFile>(std::move(file));
+    });
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileHandleSpec>>> HybridNitroFS::open(const std::string& path, NitroOpenMode mode) {
+    using Result = std::shared_ptr<HybridNitroFileHandleSpec>;
+    if (core::isContentUri(path)) {
+      return rejectContentUri<Result>("open", path);
+    }
+    return Promise<Result>::async([path = core::toLocalPath(path), mode]() -> Result {
+      return std::make_shared<HybridNitroFileHandle>(core::FileHandle::open(path, toOpenMode(mode)));
+    });
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileWriterSpec>>> HybridNitroFS::createFileWriter(const std::string& path, const std::optional<NitroFileWriterOptions>& options) {
+    using Result = std::shared_ptr<HybridNitroFileWriterSpec>;
+    if (core::isContentUri(path)) {
+      return rejectContentUri<Result>("createFileWriter", path);
+    }
+    NitroFileWriterOptions writerOptions = options.value_or(NitroFileWriterOptions());
+    return Promise<Result>::async([path = core::toLocalPath(path), writerOptions]() -> Result {
+      core::FileWriterOptions coreOptions;
+      if (writerOptions.bufferSize.has_value()) {
+        coreOptions.bufferSize = static_cast<size_t>(toByteCount(*writerOptions.bufferSize, "bufferSize"));
+      }
+      if (writerOptions.flushInterval.has_value()) {
+        coreOptions.flushInterval = std::chrono::milliseconds(toByteCount(*writerOptions.flushInterval, "flushInterval"));
+      }
+      if (writerOptions.highWaterMark.has_value()) {
+        coreOptions.highWaterMark = static_cast<size_t>(toByteCount(*writerOptions.highWaterMark, "highWaterMark"));
+      }
+      coreOptions.sync = toSyncMode(writerOptions.fsync.value_or(NitroFsyncMode::DATA));
+      if (writerOptions.compress.has_value()) {
+        coreOptions.compression = toCompressionOptions(*writerOptions.compress, writerOptions.compressionLevel);
+      }
+      return std::make_shared<HybridNitroFileWriter>(core::FileWriter::open(path, coreOptions));
+    });
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<HybridNitroReadStreamSpec>>> HybridNitroFS::createReadStream(const std::string& path, const std::optional<NitroReadStreamOptions>& options) {
+    using Result = std::shared_ptr<HybridNitroReadStreamSpec>;
+    if (core::isContentUri(path)) {
+      return rejectContentUri<Result>("createReadStream", path);
+    }
+    NitroReadStreamOptions streamOptions = options.value_or(NitroReadStreamOptions());
+    return Promise<Result>::async([path = core::toLocalPath(path), streamOptions]() -> Result {
+      core::ReadStreamOptions coreOptions;
+      if (streamOptions.chunkSize.has_value()) {
+        coreOptions.chunkSize = static_cast<size_t>(toByteCount(*streamOptions.chunkSize, "chunkSize"));
+      }
+      coreOptions.start = toByteCount(streamOptions.start.value_or(0), "start");
+      if (streamOptions.end.has_value()) {
+        // `end` is inclusive, like in Node's fs.createReadStream.
+        coreOptions.end = toByteCount(*streamOptions.end, "end") + 1;
+      }
+      if (streamOptions.highWaterMark.has_value()) {
+        coreOptions.highWaterMark = static_cast<size_t>(toByteCount(*streamOptions.highWaterMark, "highWaterMark"));
+      }
+      NitroFileEncoding encoding = streamOptions.encoding.value_or(NitroFileEncoding::UTF8);
+      return std::make_shared<HybridNitroReadStream>(core::ReadStream::open(path, coreOptions), encoding);
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::readLines(const std::string& path, const std::function<void(const NitroLineBatch& /* batch */)>& onLines, const std::optional<NitroReadLinesOptions>& options) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<double>("readLines", path);
+    }
+    NitroReadLinesOptions linesOptions = options.value_or(NitroReadLinesOptions());
+    return Promise<double>::async([path = core::toLocalPath(path), onLines, linesOptions]() {
+      core::ReadLinesOptions coreOptions;
+      double startLine = linesOptions.startLine.value_or(0);
+      // Negative lines count from the end, so only the magnitude is a "count".
+      auto fromStart = static_cast<int64_t>(toByteCount(std::fabs(startLine), "startLine"));
+      coreOptions.startLine = startLine < 0 ? -fromStart : fromStart;
+      if (linesOptions.maxLines.has_value() && !std::isinf(*linesOptions.maxLines)) {
+        coreOptions.maxLines = toByteCount(*linesOptions.maxLines, "maxLines");
+      }
+      if (linesOptions.batchSize.has_value()) {
+        coreOptions.batchSize = std::max<size_t>(1, static_cast<size_t>(toByteCount(*linesOptions.batchSize, "batchSize")));
+      }
+      coreOptions.offsetsOnly = linesOptions.offsetsOnly.value_or(false);
+
+      uint64_t count = core::readLines(path, coreOptions, [&](core::LineBatch&& batch) {
+        NitroLineBatch lines(static_cast<double>(batch.firstLine), std::move(batch.lines), std::vector<double>(batch.offsets.begin(), batch.offsets.end()));
+        for (auto& line : lines.lines) {
+          core::sanitizeUtf8(line);
+        }
+        onLines(lines);
+      });
+      return static_cast<double>(count);
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::indexLines(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<double>("indexLines", path);
+    }
+    return Promise<double>::async([path = core::toLocalPath(path)]() {
+      return static_cast<double>(core::indexLines(path));
+    });
+  }
+
+  std::shared_ptr<Promise<std::string>> HybridNitroFS::hashFile(const std::string& path, NitroHashAlgorithm algorithm, const std::optional<NitroHashOptions>& options) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<std::string>("hashFile", path);
+    }
+    NitroHashOptions hashOptions = options.value_or(NitroHashOptions());
+    return Promise<std::string>::async([path = core::toLocalPath(path), algorithm, hashOptions]() {
+      uint64_t offset = toByteCount(hashOptions.offset.value_or(0), "offset");
+      std::optional<uint64_t> length;
+      if (hashOptions.length.has_value()) {
+        length = toByteCount(*hashOptions.length, "length");
+      }
+      return core::hashFile(path, toHashAlgorithm(algorithm), offset, length);
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::compressFile(const std::string& srcPath, const std::string& destPath, NitroCompressionFormat format, const std::optional<NitroCompressOptions>& options) {
+    if (core::isContentUri(srcPath) || core::isContentUri(destPath)) {
+      return rejectContentUri<double>("compressFile", core::isContentUri(srcPath) ? srcPath : destPath);
+    }
+    NitroCompressOptions compressOptions = options.value_or(NitroCompressOptions());
+    return Promise<double>::async([srcPath = core::toLocalPath(srcPath), destPath = core::toLocalPath(destPath), format, compressOptions]() {
+      core::CompressionOptions compression = toCompressionOptions(format, compressOptions.level);
+      if (compressOptions.threads.has_value()) {
+        compression.threads = static_cast<size_t>(toByteCount(*compressOptions.threads, "threads"));
+      }
+      return static_cast<double>(core::compressFile(srcPath, destPath, compression));
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::decompressFile(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCompressionFormat>& format) {
+    if (core::isContentUri(srcPath) || core::isContentUri(destPath)) {
+      return rejectContentUri<double>("decompressFile", core::isContentUri(srcPath) ? srcPath : destPath);
+    }
+    return Promise<double>::async([srcPath = core::toLocalPath(srcPath), destPath = core::toLocalPath(destPath), format]() {
+      std::optional<core::CompressionFormat> coreFormat;
+      if (format.has_value()) {
+        coreFormat = toCompressionFormat(*format);
+      }
+      return static_cast<double>(core::decompressFile(srcPath, destPath, coreFormat));
+    });
+  }
+
+  bool HybridNitroFS::isCompressionAvailable(NitroCompressionFormat format) {
+    return core::isCompressionAvailable(toCompressionFormat(format));
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::copyFile(const std::string& srcPath, const std::string& destPath) {
+    if (core::isContentUri(srcPath) || core::isContentUri(destPath)) {
+      return _platform->copyFile(srcPath, destPath);
+    }
+    return Promise<void>::async([srcPath = core::toLocalPath(srcPath), destPath = core::toLocalPath(destPath)]() {
+      core::copyFile(srcPath, destPath);
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::copy(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCopyOptions>& options, const std::optional<std::function<void(double /* copiedBytes */, double /* totalBytes */, double /* copiedFiles */, double /* totalFiles */)>>& onProgress) {
+    if (core::isContentUri(srcPath) || core::isContentUri(destPath)) {
+      return _platform->copy(srcPath, destPath);
+    }
+    NitroCopyOptions copyOptions = options.value_or(NitroCopyOptions());
+    return Promise<void>::async([srcPath = core::toLocalPath(srcPath), destPath = core::toLocalPath(destPath), copyOptions, onProgress]() {
+      core::CopyTreeOptions treeOptions;
+      treeOptions.conflict = toConflictPolicy(copyOptions.conflict.value_or(NitroConflictPolicy::OVERWRITE));
+      if (copyOptions.parallelism.has_value()) {
+        treeOptions.maxThreads = std::max<size_t>(1, static_cast<size_t>(toByteCount(*copyOptions.parallelism, "parallelism")));
+      }
+      if (onProgress.has_value()) {
+        treeOptions.onProgress = [onProgress = *onProgress](const core::CopyProgress& progress) {
+          onProgress(static_cast<double>(progress.copiedBytes), static_cast<double>(progress.totalBytes),
+                     static_cast<double>(progress.copiedFiles), static_cast<double>(progress.totalFiles));
+        };
+      }
+      core::copyTree(srcPath, destPath, treeOptions);
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::unzip(const std::string& archivePath, const std::string& destDir, const std::optional<NitroUnzipOptions>& options, const std::optional<std::function<void(double /* extractedBytes */, double /* totalBytes */, double /* extractedEntries */, double /* totalEntries */)>>& onProgress) {
+    if (core::isContentUri(archivePath) || core::isContentUri(destDir)) {
+      return rejectContentUri<double>("unzip", core::isContentUri(archivePath) ? archivePath : destDir);
+    }
+    NitroUnzipOptions unzipOptions = options.value_or(NitroUnzipOptions());
+    return Promise<double>::async([archivePath = core::toLocalPath(archivePath), destDir = core::toLocalPath(destDir), unzipOptions, onProgress]() {
+      core::UnzipOptions coreOptions;
+      if (unzipOptions.parallelism.has_value()) {
+        coreOptions.maxThreads = std::max<size_t>(1, static_cast<size_t>(toByteCount(*unzipOptions.parallelism, "parallelism")));
+      }
+      if (onProgress.has_value()) {
+        coreOptions.onProgress = [onProgress = *onProgress](const core::ZipProgress& progress) {
+          onProgress(static_cast<double>(progress.processedBytes), static_cast<double>(progress.totalBytes),
+                     static_cast<double>(progress.processedEntries), static_cast<double>(progress.totalEntries));
+        };
+      }
+      return static_cast<double>(core::unzip(archivePath, destDir, coreOptions));
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::zip(const std::string& srcPath, const std::string& archivePath, const std::optional<NitroZipOptions>& options, const std::optional<std::function<void(double /* zippedBytes */, double /* totalBytes */, double /* zippedEntries */, double /* totalEntries */)>>& onProgress) {
+    if (core::isContentUri(srcPath) || core::isContentUri(archivePath)) {
+      return rejectContentUri<double>("zip", core::isContentUri(srcPath) ? srcPath : archivePath);
+    }
+    NitroZipOptions zipOptions = options.value_or(NitroZipOptions());
+    return Promise<double>::async([srcPath = core::toLocalPath(srcPath), archivePath = core::toLocalPath(archivePath), zipOptions, onProgress]() {
+      core::ZipOptions coreOptions;
+      if (zipOptions.level.has_value()) {
+        // Out-of-range levels are rejected by core::zip.
+        coreOptions.level = static_cast<int>(std::min<uint64_t>(toByteCount(*zipOptions.level, "level"), INT32_MAX));
+      }
+      if (zipOptions.parallelism.has_value()) {
+        coreOptions.maxThreads = std::max<size_t>(1, static_cast<size_t>(toByteCount(*zipOptions.parallelism, "parallelism")));
+      }
+      if (onProgress.has_value()) {
+        coreOptions.onProgress = [onProgress = *onProgress](const core::ZipProgress& progress) {
+          onProgress(static_cast<double>(progress.processedBytes), static_cast<double>(progress.totalBytes),
+                     static_cast<double>(progress.processedEntries), static_cast<double>(progress.totalEntries));
+        };
+      }
+      return static_cast<double>(core::zip(srcPath, archivePath, coreOptions));
+    });
+  }
+
+  std::shared_ptr<Promise<bool>> HybridNitroFS::unlink(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->unlink(path);
+    }
+    return Promise<bool>::async([path = core::toLocalPath(path)]() {
+      return core::removeAll(path);
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::rm(const std::string& path, const std::optional<NitroRemoveOptions>& options, const std::optional<std::function<void(double /* removedEntries */)>>& onProgress) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<double>("rm", path);
+    }
+    NitroRemoveOptions removeOptions = options.value_or(NitroRemoveOptions());
+    return Promise<double>::async([path = core::toLocalPath(path), removeOptions, onProgress]() {
+      core::RemoveOptions coreOptions;
+      coreOptions.recursive = removeOptions.recursive.value_or(false);
+      if (removeOptions.background.value_or(false) && coreOptions.recursive) {
+        core::removeInBackground(path);
+        return 0.0;
+      }
+      if (removeOptions.parallelism.has_value()) {
+        coreOptions.maxThreads = std::max<size_t>(1, static_cast<size_t>(toByteCount(*removeOptions.parallelism, "parallelism")));
+      }
+      if (onProgress.has_value()) {
+        coreOptions.onProgress = [onProgress = *onProgress](uint64_t removedEntries) {
+          onProgress(static_cast<double>(removedEntries));
+        };
+      }
+      return static_cast<double>(core::removeTree(path, coreOptions));
+    });
+  }
+
+  std::shared_ptr<Promise<bool>> HybridNitroFS::mkdir(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->mkdir(path);
+    }
+    return Promise<bool>::async([path = core::toLocalPath(path)]() {
+      core::mkdirs(path);
+      return true;
+    });
+  }
+
+  std::shared_ptr<Promise<NitroFileStat>> HybridNitroFS::stat(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->stat(path);
+    }
+    return Promise<NitroFileStat>::async([path = core::toLocalPath(path)]() {
+      return toNitroFileStat(core::stat(path));
+    });
+  }
+
+  std::shared_ptr<Promise<std::vector<NitroStatResult>>> HybridNitroFS::statMany(const std::vector<std::string>& paths) {
+    return Promise<std::vector<NitroStatResult>>::async([paths]() {
+      // content:// URIs are reported as per-path errors; everything else is stat'ed in one batch.
+      std::vector<std::string> localPaths;
+      localPaths.reserve(paths.size());
+      for (const auto& path : paths) {
+        localPaths.push_back(core::isContentUri(path) ? std::string() : core::toLocalPath(path));
+      }
+      auto stats = core::statMany(localPaths);
+
+      std::vector<NitroStatResult> results;
+      results.reserve(stats.size());
+      for (size_t i = 0; i < stats.size(); i++) {
+        if (core::isContentUri(paths[i])) {
+          results.emplace_back(std::nullopt, "statMany(...) does not support content:// URIs: " + paths[i]);
+        } else if (stats[i].error != 0) {
+          std::system_error error(stats[i].error, std::generic_category(), "stat(" + localPaths[i] + ")");
+          results.emplace_back(std::nullopt, error.what());
+        } else {
+          results.emplace_back(toNitroFileStat(stats[i].stat), std::nullopt);
+        }
+      }
+      return results;
+    });
+  }
+
+  std::shared_ptr<Promise<std::vector<NitroDirEntry>>> HybridNitroFS::readdir(const std::string& path, const std::optional<NitroReaddirOptions>& options) {
+    NitroReaddirOptions readdirOptions = options.value_or(NitroReaddirOptions());
+    bool withStats = readdirOptions.stats.value_or(false);
+    bool withMimeTypes = readdirOptions.mimeTypes.value_or(true);
+    if (core::isContentUri(path)) {
+      // The platform only knows names, MIME types and paths.
+      auto promise = Promise<std::vector<NitroDirEntry>>::create();
+      auto files = _platform->readdir(path);
+      files->addOnResolvedListener([promise, withMimeTypes](const std::vector<NitroFile>& files) {
+        std::vector<NitroDirEntry> entries;
+        entries.reserve(files.size());
+        for (const auto& file : files) {
+          std::optional<std::string> mimeType = withMimeTypes ? std::make_optional(file.mimeType) : std::nullopt;
+          entries.emplace_back(file.name, std::move(mimeType), file.path, std::nullopt, std::nullopt, std::nullopt);
+        }
+        promise->resolve(std::move(entries));
+      });
+      files->addOnRejectedListener([promise](const std::exception_ptr& error) {
+        promise->reject(error);
+      });
+      return promise;
+    }
+    return Promise<std::vector<NitroDirEntry>>::async([path = core::toLocalPath(path), withStats, withMimeTypes]() {
+      auto entries = core::readdir(path, withStats ? core::DirDetail::Stats : core::DirDetail::Types);
+      std::vector<NitroDirEntry> result;
+      result.reserve(entries.size());
+      for (auto& entry : entries) {
+        result.push_back(toNitroDirEntry(std::move(entry), withMimeTypes));
+      }
+      return result;
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFS::walk(const std::string& root, const std::function<void(const std::vector<NitroDirEntry>& /* entries */)>& onEntries, const std::optional<NitroWalkOptions>& options) {
+    if (core::isContentUri(root)) {
+      return rejectContentUri<double>("walk", root);
+    }
+    NitroWalkOptions walkOptions = options.value_or(NitroWalkOptions());
+    return Promise<double>::async([root = core::toLocalPath(root), onEntries, walkOptions]() {
+      core::WalkOptions coreOptions;
+      if (walkOptions.maxDepth.has_value() && !std::isinf(*walkOptions.maxDepth)) {
+        coreOptions.maxDepth = static_cast<size_t>(toByteCount(*walkOptions.maxDepth, "maxDepth"));
+      }
+      if (walkOptions.batchSize.has_value()) {
+        coreOptions.batchSize = std::max<size_t>(1, static_cast<size_t>(toByteCount(*walkOptions.batchSize, "batchSize")));
+      }
+      coreOptions.followSymlinks = walkOptions.followSymlinks.value_or(false);
+      coreOptions.detail = walkOptions.stats.value_or(false) ? core::DirDetail::Stats : core::DirDetail::Types;
+      if (walkOptions.filter.has_value()) {
+        applyWalkFilter(*walkOptions.filter, coreOptions);
+      }
+
+      bool withMimeTypes = walkOptions.mimeTypes.value_or(true);
+      uint64_t count = core::walk(root, coreOptions, [&](std::vector<core::DirEntry>&& batch) {
+        std::vector<NitroDirEntry> entries;
+        entries.reserve(batch.size());
+        for (auto& entry : batch) {
+          entries.push_back(toNitroDirEntry(std::move(entry), withMimeTypes));
+        }
+        // Calling a JS callback from here only schedules it on the JS thread; the walk doesn't wait for it.
+        onEntries(entries);
+      });
+      return static_cast<double>(count);
+    });
+  }
+
+  std::shared_ptr<Promise<NitroDiskUsage>> HybridNitroFS::du(const std::string& path, const std::optional<NitroDiskUsageOptions>& options) {
+    if (core::isContentUri(path)) {
+      return rejectContentUri<NitroDiskUsage>("du", path);
+    }
+    NitroDiskUsageOptions duOptions = options.value_or(NitroDiskUsageOptions());
+    return Promise<NitroDiskUsage>::async([path = core::toLocalPath(path), duOptions]() {
+      size_t parallelism = core::hardwareConcurrency();
+      if (duOptions.parallelism.has_value()) {
+        parallelism = std::max<size_t>(1, static_cast<size_t>(toByteCount(*duOptions.parallelism, "parallelism")));
+      }
+      size_t topK = static_cast<size_t>(toByteCount(duOptions.topK.value_or(0), "topK"));
+      core::DiskUsage usage = core::diskUsage(path, parallelism, topK);
+      return NitroDiskUsage(static_cast<double>(usage.size),
+                            static_cast<double>(usage.allocatedSize),
+                            static_cast<double>(usage.fileCount),
+                            static_cast<double>(usage.directoryCount),
+                            toNitroDiskUsageEntries(std::move(usage.largestFiles)),
+                            toNitroDiskUsageEntries(std::move(usage.largestDirectories)));
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::rename(const std::string& oldPath, const std::string& newPath) {
+    if (core::isContentUri(oldPath) || core::isContentUri(newPath)) {
+      return _platform->rename(oldPath, newPath);
+    }
+    return Promise<void>::async([oldPath = core::toLocalPath(oldPath), newPath = core::toLocalPath(newPath)]() {
+      core::rename(oldPath, newPath);
+    });
+  }
+
+  std::string HybridNitroFS::dirname(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->dirname(path);
+    }
+    return core::dirname(core::toLocalPath(path));
+  }
+
+  std::string HybridNitroFS::basename(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->basename(path);
+    }
+    return core::basename(core::toLocalPath(path));
+  }
+
+  std::string HybridNitroFS::extname(const std::string& path) {
+    if (core::isContentUri(path)) {
+      return _platform->extname(path);
+    }
+    return core::extname(core::toLocalPath(path));
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFS::uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) {
+    std::shared_ptr<Promise<NitroFile>> uploaded;
+    try {
+      uploaded = enqueueUpload(uploadOptions, std::nullopt, onProgress)->result();
+    } catch (...) {
+      return Promise<void>::rejected(std::current_exception());
+    }
+    auto promise = Promise<void>::create();
+    uploaded->addOnResolvedListener([promise](const NitroFile& /* file */) {
+      promise->resolve();
+    });
+    uploaded->addOnRejectedListener([promise](const std::exception_ptr& error) {
+      promise->reject(error);
+    });
+    return promise;
+  }
+
+  std::shared_ptr<Promise<NitroFile>> HybridNitroFS::downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) {
+    try {
+      return enqueueDownload(downloadOptions, std::nullopt, onProgress)->result();
+    } catch (...) {
+      return Promise<NitroFile>::rejected(std::current_exception());
+    }
+  }
+
+  std::shared_ptr<HybridNitroTransferSpec> HybridNitroFS::enqueueDownload(const NitroDownloadOptions& downloadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) {
+    // Checked here, so both platforms get the same errors and limits.
+    NitroDownloadOptions options = downloadOptions;
+    if (options.segments.has_value()) {
+      uint64_t segments = std::clamp<uint64_t>(toByteCount(*options.segments, "segments"), 1, kMaxDownloadSegments);
+      options.segments = static_cast<double>(segments);
+    }
+    if (options.minSegmentSize.has_value()) {
+      options.minSegmentSize = static_cast<double>(std::max<uint64_t>(toByteCount(*options.minSegmentSize, "minSegmentSize"), 1));
+    }
+    auto platform = _platform;
+    return std::make_shared<HybridNitroTransfer>(
+        transferQueue(), options.url, priority.value_or(NitroTransferPriority::USERVISIBLE),
+        [platform, options, onProgress](double transferId) {
+          return platform->downloadFile(transferId, options, onProgress);
+        },
+        [platform](double transferId) {
+          platform->cancelTransfer(transferId);
+        },
+        [partPath = core::toLocalPath(options.destinationPath) + ".part"]() {
+          // A paused download keeps its part file and checkpoint to resume from; a cancelled one doesn't need them.
+          core::removeAll(partPath);
+          core::removeAll(partPath + ".json");
+        });
+  }
+
+  std::shared_ptr<HybridNitroTransferSpec> HybridNitroFS::enqueueUpload(const NitroUploadOptions& uploadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) {
+    std::string name = core::basename(core::toLocalPath(uploadOptions.filePath));
+    NitroFile file(name, std::string(core::mimeTypeForFileName(name)), uploadOptions.filePath);
+    auto platform = _platform;
+    return std::make_shared<HybridNitroTransfer>(
+        transferQueue(), uploadOptions.url, priority.value_or(NitroTransferPriority::USERVISIBLE),
+        [platform, uploadOptions, onProgress, file](double transferId) {
+          auto uploaded = Promise<NitroFile>::create();
+          auto upload = platform->uploadFile(transferId, uploadOptions, onProgress);
+          upload->addOnResolvedListener([uploaded, file]() {
+            uploaded->resolve(file);
+          });
+          upload->addOnRejectedListener([uploaded](const std::exception_ptr& error) {
+            uploaded->reject(error);
+          });
+          return uploaded;
+        },
+        [platform](double transferId) {
+          platform->cancelTransfer(transferId);
+        },
+        nullptr);
+  }
+
+  void HybridNitroFS::configureTransfers(const NitroTransferOptions& options) {
+    core::TransferLimits limits = transferQueue()->limits();
+    if (options.maxConnectionsPerHost.has_value()) {
+      uint64_t maxConnections = std::clamp<uint64_t>(toByteCount(*options.maxConnectionsPerHost, "maxConnectionsPerHost"), 1, kMaxConnectionsPerHost);
+      _platform->setMaxConnectionsPerHost(static_cast<double>(maxConnections));
+      // Every transfer takes at least one connection, so more than this per host would only queue up in the client.
+      limits.maxPerHost = static_cast<size_t>(maxConnections);
+    }
+    if (options.maxConcurrentTransfers.has_value()) {
+      uint64_t maxTransfers = std::clamp<uint64_t>(toByteCount(*options.maxConcurrentTransfers, "maxConcurrentTransfers"), 1, kMaxConcurrentTransfers);
+      limits.maxConcurrent = static_cast<size_t>(maxTransfers);
+    }
+    transferQueue()->setLimits(limits);
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,89 @@
+//
+//  HybridNitroFS.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroFSSpec.hpp"
+#include "HybridNitroFSPlatformSpec.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The C++ implementation of `NitroFS`.
+   *
+   * Local paths (and `file://` URIs) are served directly with POSIX calls from `core/`,
+   * so `exists`, `stat`, `mkdir`, `rename` & co. never cross into Kotlin or Swift.
+   * Everything POSIX can't do — well-known directories, `content://` URIs and
+   * networking — is forwarded to the Swift/Kotlin `NitroFSPlatform` object.
+   */
+  class HybridNitroFS: public HybridNitroFSSpec {
+  public:
+    HybridNitroFS();
+
+  public:
+    // Properties
+    std::string getBUNDLE_DIR() override;
+    std::string getDOCUMENT_DIR() override;
+    std::string getCACHE_DIR() override;
+    std::string getDOWNLOAD_DIR() override;
+    std::string getDCIM_DIR() override;
+    std::string getPICTURES_DIR() override;
+    std::string getMOVIES_DIR() override;
+    std::string getMUSIC_DIR() override;
+
+  public:
+    // Methods
+    std::shared_ptr<Promise<bool>> exists(const std::string& path) override;
+    std::shared_ptr<Promise<std::vector<bool>>> existsMany(const std::vector<std::string>& paths) override;
+    std::shared_ptr<Promise<void>> writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding, const std::optional<NitroWriteOptions>& options) override;
+    std::shared_ptr<Promise<std::string>> readFile(const std::string& path, NitroFileEncoding encoding, const std::optional<NitroReadOptions>& options) override;
+    std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> readFileBuffer(const std::string& path, const std::optional<NitroReadOptions>& options) override;
+    std::shared_ptr<Promise<void>> writeFileBuffer(const std::string& path, const std::shared_ptr<ArrayBuffer>& data, const std::optional<NitroWriteOptions>& options) override;
+    std::shared_ptr<Promise<void>> appendFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) override;
+    std::shared_ptr<Promise<std::shared_ptr<HybridNitroMappedFileSpec>>> mapFile(const std::string& path, const std::optional<NitroMapOptions>& options) override;
+    std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileHandleSpec>>> open(const std::string& path, NitroOpenMode mode) override;
+    std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileWriterSpec>>> createFileWriter(const std::string& path, const std::optional<NitroFileWriterOptions>& options) override;
+    std::shared_ptr<Promise<std::shared_ptr<HybridNitroReadStreamSpec>>> createReadStream(const std::string& path, const std::optional<NitroReadStreamOptions>& options) override;
+    std::shared_ptr<Promise<double>> readLines(const std::string& path, const std::function<void(const NitroLineBatch& /* batch */)>& onLines, const std::optional<NitroReadLinesOptions>& options) override;
+    std::shared_ptr<Promise<double>> indexLines(const std::string& path) override;
+    std::shared_ptr<Promise<std::string>> hashFile(const std::string& path, NitroHashAlgorithm algorithm, const std::optional<NitroHashOptions>& options) override;
+    std::shared_ptr<Promise<double>> compressFile(const std::string& srcPath, const std::string& destPath, NitroCompressionFormat format, const std::optional<NitroCompressOptions>& options) override;
+    std::shared_ptr<Promise<double>> decompressFile(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCompressionFormat>& format) override;
+    bool isCompressionAvailable(NitroCompressionFormat format) override;
+    std::shared_ptr<Promise<void>> copyFile(const std::string& srcPath, const std::string& destPath) override;
+    std::shared_ptr<Promise<void>> copy(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCopyOptions>& options, const std::optional<std::function<void(double /* copiedBytes */, double /* totalBytes */, double /* copiedFiles */, double /* totalFiles */)>>& onProgress) override;
+    std::shared_ptr<Promise<double>> unzip(const std::string& archivePath, const std::string& destDir, const std::optional<NitroUnzipOptions>& options, const std::optional<std::function<void(double /* extractedBytes */, double /* totalBytes */, double /* extractedEntries */, double /* totalEntries */)>>& onProgress) override;
+    std::shared_ptr<Promise<double>> zip(const std::string& srcPath, const std::string& archivePath, const std::optional<NitroZipOptions>& options, const std::optional<std::function<void(double /* zippedBytes */, double /* totalBytes */, double /* zippedEntries */, double /* totalEntries */)>>& onProgress) override;
+    std::shared_ptr<Promise<bool>> unlink(const std::string& path) override;
+    std::shared_ptr<Promise<double>> rm(const std::string& path, const std::optional<NitroRemoveOptions>& options, const std::optional<std::function<void(double /* removedEntries */)>>& onProgress) override;
+    std::shared_ptr<Promise<bool>> mkdir(const std::string& path) override;
+    std::shared_ptr<Promise<NitroFileStat>> stat(const std::string& path) override;
+    std::shared_ptr<Promise<std::vector<NitroStatResult>>> statMany(const std::vector<std::string>& paths) override;
+    std::shared_ptr<Promise<std::vector<NitroDirEntry>>> readdir(const std::string& path, const std::optional<NitroReaddirOptions>& options) override;
+    std::shared_ptr<Promise<double>> walk(const std::string& root, const std::function<void(const std::vector<NitroDirEntry>& /* entries */)>& onEntries, const std::optional<NitroWalkOptions>& options) override;
+    std::shared_ptr<Promise<NitroDiskUsage>> du(const std::string& path, const std::optional<NitroDiskUsageOptions>& options) override;
+    std::shared_ptr<Promise<void>> rename(const std::string& oldPath, const std::string& newPath) override;
+    std::string dirname(const std::string& path) override;
+    std::string basename(const std::string& path) override;
+    std::string extname(const std::string& path) override;
+    std::shared_ptr<Promise<void>> uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    std::shared_ptr<Promise<NitroFile>> downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    std::shared_ptr<HybridNitroTransferSpec> enqueueDownload(const NitroDownloadOptions& downloadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    std::shared_ptr<HybridNitroTransferSpec> enqueueUpload(const NitroUploadOptions& uploadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    void configureTransfers(const NitroTransferOptions& options) override;
+
+  private:
+    void sweepTrashOnce();
+
+  private:
+    // Created on the JS thread in the constructor. Only ever called from it, except by queued transfers,
+    // which start on whichever thread the transfer before them finished.
+    std::shared_ptr<HybridNitroFSPlatformSpec> _platform;
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,64 @@
+//
+//  HybridNitroFileHandle.cpp
+//  NitroFS
+//
+
+#include "HybridNitroFileHandle.hpp"
+#include "ByteCount.hpp"
+
+#include "core/ByteBuffer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace margelo::nitro::nitrofs {
+
+  HybridNitroFileHandle::HybridNitroFileHandle(std::shared_ptr<core::FileHandle> file): HybridObject(TAG), _file(std::move(file)) {}
+
+  std::string HybridNitroFileHandle::getPath() {
+    return _file->path();
+  }
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNitroFileHandle::read(double offset, double length) {
+    return Promise<std::shared_ptr<ArrayBuffer>>::async([file = _file, offset, length]() {
+      uint64_t size = toByteCount(length, "length");
+      core::ByteBuffer bytes = file->read(toByteCount(offset, "offset"), static_cast<size_t>(std::min<uint64_t>(size, SIZE_MAX)));
+      size_t bytesRead = bytes.size();
+      uint8_t* data = bytes.release();
+      return ArrayBuffer::wrap(data, bytesRead, [data]() { std::free(data); });
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileHandle::write(double offset, const std::shared_ptr<ArrayBuffer>& data) {
+    // A JS-owned ArrayBuffer may only be touched on the JS thread, so those are copied once here.
+    std::shared_ptr<ArrayBuffer> buffer = data->isOwner() ? data : ArrayBuffer::copy(data->data(), data->size());
+    return Promise<void>::async([file = _file, offset, buffer]() {
+      file->write(toByteCount(offset, "offset"), buffer->data(), buffer->size());
+    });
+  }
+
+  std::shared_ptr<Promise<double>> HybridNitroFileHandle::size() {
+    return Promise<double>::async([file = _file]() {
+      return static_cast<double>(file->size());
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileHandle::truncate(double length) {
+    return Promise<void>::async([file = _file, length]() {
+      file->truncate(toByteCount(length, "length"));
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileHandle::sync() {
+    return Promise<void>::async([file = _file]() {
+      file->sync();
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileHandle::close() {
+    return Promise<void>::async([file = _file]() {
+      file->close();
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
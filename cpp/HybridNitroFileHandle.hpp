@@ -0,0 +1,42 @@
+//
+//  HybridNitroFileHandle.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroFileHandleSpec.hpp"
+#include "core/FileHandle.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The `NitroFileHandle` returned by `NitroFS.open(...)`.
+   * Every method runs on Nitro's thread pool; concurrent reads and writes are allowed.
+   * The descriptor is closed by `close()`, or when the handle is garbage collected.
+   */
+  class HybridNitroFileHandle: public HybridNitroFileHandleSpec {
+  public:
+    explicit HybridNitroFileHandle(std::shared_ptr<core::FileHandle> file);
+
+  public:
+    // Properties
+    std::string getPath() override;
+
+  public:
+    // Methods
+    std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> read(double offset, double length) override;
+    std::shared_ptr<Promise<void>> write(double offset, const std::shared_ptr<ArrayBuffer>& data) override;
+    std::shared_ptr<Promise<double>> size() override;
+    std::shared_ptr<Promise<void>> truncate(double length) override;
+    std::shared_ptr<Promise<void>> sync() override;
+    std::shared_ptr<Promise<void>> close() override;
+
+  private:
+    std::shared_ptr<core::FileHandle> _file;
+  };
+
+} // namespace margelo::nitro::nitrofs
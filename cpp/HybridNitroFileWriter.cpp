@@ -0,0 +1,37 @@
+//
+//  HybridNitroFileWriter.cpp
+//  NitroFS
+//
+
+#include "HybridNitroFileWriter.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  HybridNitroFileWriter::HybridNitroFileWriter(std::shared_ptr<core::FileWriter> writer): HybridObject(TAG), _writer(std::move(writer)) {}
+
+  std::string HybridNitroFileWriter::getPath() {
+    return _writer->path();
+  }
+
+  void HybridNitroFileWriter::write(const std::string& data) {
+    _writer->append(data.data(), data.size());
+  }
+
+  void HybridNitroFileWriter::writeBuffer(const std::shared_ptr<ArrayBuffer>& data) {
+    // Called on the JS thread, so even a JS-owned ArrayBuffer can be read here; it is copied into the buffer.
+    _writer->append(data->data(), data->size());
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileWriter::flush() {
+    return Promise<void>::async([writer = _writer]() {
+      writer->flush();
+    });
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroFileWriter::close() {
+    return Promise<void>::async([writer = _writer]() {
+      writer->close();
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,40 @@
+//
+//  HybridNitroFileWriter.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroFileWriterSpec.hpp"
+#include "core/FileWriter.hpp"
+
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The `NitroFileWriter` returned by `NitroFS.createFileWriter(...)`.
+   * `write` and `writeBuffer` only copy into the native buffer, so they run synchronously on the JS thread.
+   * A writer that is garbage collected still writes out its buffer, but its errors are lost.
+   */
+  class HybridNitroFileWriter: public HybridNitroFileWriterSpec {
+  public:
+    explicit HybridNitroFileWriter(std::shared_ptr<core::FileWriter> writer);
+
+  public:
+    // Properties
+    std::string getPath() override;
+
+  public:
+    // Methods
+    void write(const std::string& data) override;
+    void writeBuffer(const std::shared_ptr<ArrayBuffer>& data) override;
+    std::shared_ptr<Promise<void>> flush() override;
+    std::shared_ptr<Promise<void>> close() override;
+
+  private:
+    std::shared_ptr<core::FileWriter> _writer;
+  };
+
+} // namespace margelo::nitro::nitrofs
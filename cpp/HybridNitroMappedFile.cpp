@@ -0,0 +1,32 @@
+//
+//  HybridNitroMappedFile.cpp
+//  NitroFS
+//
+
+#include "HybridNitroMappedFile.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  HybridNitroMappedFile::HybridNitroMappedFile(std::shared_ptr<core::MappedFile> file): HybridObject(TAG), _file(std::move(file)) {
+    _buffer = ArrayBuffer::wrap(_file->data(), _file->size(), [file = _file]() {});
+  }
+
+  std::shared_ptr<ArrayBuffer> HybridNitroMappedFile::getBuffer() {
+    return _buffer;
+  }
+
+  double HybridNitroMappedFile::getOffset() {
+    return static_cast<double>(_file->offset());
+  }
+
+  bool HybridNitroMappedFile::getReadOnly() {
+    return _file->readOnly();
+  }
+
+  std::shared_ptr<Promise<void>> HybridNitroMappedFile::sync() {
+    return Promise<void>::async([file = _file]() {
+      file->sync();
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,40 @@
+//
+//  HybridNitroMappedFile.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroMappedFileSpec.hpp"
+#include "core/MappedFile.hpp"
+
+#include <memory>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The `NitroMappedFile` returned by `NitroFS.mapFile(...)`.
+   *
+   * `buffer` points straight into the mapping. The `ArrayBuffer` holds its own
+   * reference to the mapping, so it stays valid even after this object is collected.
+   */
+  class HybridNitroMappedFile: public HybridNitroMappedFileSpec {
+  public:
+    explicit HybridNitroMappedFile(std::shared_ptr<core::MappedFile> file);
+
+  public:
+    // Properties
+    std::shared_ptr<ArrayBuffer> getBuffer() override;
+    double getOffset() override;
+    bool getReadOnly() override;
+
+  public:
+    // Methods
+    std::shared_ptr<Promise<void>> sync() override;
+
+  private:
+    std::shared_ptr<core::MappedFile> _file;
+    std::shared_ptr<ArrayBuffer> _buffer;
+  };
+
+} // namespace margelo::nitro::nitrofs
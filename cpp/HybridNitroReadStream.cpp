@@ -0,0 +1,96 @@
+//
+//  HybridNitroReadStream.cpp
+//  NitroFS
+//
+
+#include "HybridNitroReadStream.hpp"
+
+#include "core/Base64.hpp"
+#include "core/ByteBuffer.hpp"
+#include "core/Text.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  HybridNitroReadStream::HybridNitroReadStream(std::shared_ptr<core::ReadStream> stream, NitroFileEncoding encoding):
+    HybridObject(TAG), _stream(std::move(stream)), _remainder(std::make_shared<Remainder>()), _encoding(encoding) {}
+
+  HybridNitroReadStream::~HybridNitroReadStream() {
+    // Pending `read` promises keep the stream alive, so this only stops the read-ahead of an abandoned stream.
+    _stream->close();
+  }
+
+  std::string HybridNitroReadStream::getPath() {
+    return _stream->path();
+  }
+
+  std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> HybridNitroReadStream::read() {
+    using Result = std::optional<std::shared_ptr<ArrayBuffer>>;
+    return Promise<Result>::async([stream = _stream, remainder = _remainder]() -> Result {
+      std::lock_guard lock(remainder->mutex);
+      if (!remainder->bytes.empty()) {
+        std::string bytes = std::move(remainder->bytes);
+        remainder->bytes.clear();
+        return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+      }
+      std::optional<core::ByteBuffer> chunk = stream->next();
+      if (!chunk.has_value()) {
+        return std::nullopt;
+      }
+      // The chunk was read straight into the memory that backs the JS ArrayBuffer.
+      size_t size = chunk->size();
+      uint8_t* data = chunk->release();
+      return ArrayBuffer::wrap(data, size, [data]() { std::free(data); });
+    });
+  }
+
+  std::shared_ptr<Promise<std::optional<std::string>>> HybridNitroReadStream::readString() {
+    using Result = std::optional<std::string>;
+    return Promise<Result>::async([stream = _stream, remainder = _remainder, encoding = _encoding]() -> Result {
+      std::lock_guard lock(remainder->mutex);
+      std::string& bytes = remainder->bytes;
+      while (true) {
+        std::optional<core::ByteBuffer> chunk = stream->next();
+        if (chunk.has_value()) {
+          bytes.append(reinterpret_cast<const char*>(chunk->data()), chunk->size());
+        } else if (bytes.empty()) {
+          return std::nullopt;
+        }
+        // Hold back what can't be decoded on its own yet; the last chunk takes everything.
+        size_t keep = 0;
+        if (chunk.has_value()) {
+          switch (encoding) {
+            case NitroFileEncoding::BASE64:
+              keep = bytes.size() % 3;
+              break;
+            case NitroFileEncoding::UTF8:
+              keep = core::incompleteUtf8SuffixLength(bytes);
+              break;
+            case NitroFileEncoding::ASCII:
+              break;
+          }
+          if (keep == bytes.size()) {
+            continue;
+          }
+        }
+        std::string text = bytes.substr(0, bytes.size() - keep);
+        bytes.erase(0, bytes.size() - keep);
+        switch (encoding) {
+          case NitroFileEncoding::BASE64:
+            return core::base64::encode(text);
+          case NitroFileEncoding::ASCII:
+            core::sanitizeAscii(text);
+            return text;
+          case NitroFileEncoding::UTF8:
+            core::sanitizeUtf8(text);
+            return text;
+        }
+        return text;
+      }
+    });
+  }
+
+  void HybridNitroReadStream::close() {
+    _stream->close();
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,54 @@
+//
+//  HybridNitroReadStream.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroReadStreamSpec.hpp"
+#include "NitroFileEncoding.hpp"
+#include "core/ReadStream.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The `NitroReadStream` returned by `NitroFS.createReadStream(...)`.
+   * `read`/`readString` wait on Nitro's thread pool for the next chunk, which also lets the
+   * reader thread continue once it was paused at the high-water mark.
+   */
+  class HybridNitroReadStream: public HybridNitroReadStreamSpec {
+  public:
+    HybridNitroReadStream(std::shared_ptr<core::ReadStream> stream, NitroFileEncoding encoding);
+    ~HybridNitroReadStream() override;
+
+  public:
+    // Properties
+    std::string getPath() override;
+
+  public:
+    // Methods
+    std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> read() override;
+    std::shared_ptr<Promise<std::optional<std::string>>> readString() override;
+    void close() override;
+
+  private:
+    /**
+     * Bytes that `readString` held back because they don't form a whole character
+     * (or base64 group) yet. They are handed out first by the next `read` or `readString`.
+     */
+    struct Remainder {
+      std::mutex mutex;
+      std::string bytes;
+    };
+
+  private:
+    std::shared_ptr<core::ReadStream> _stream;
+    std::shared_ptr<Remainder> _remainder;
+    NitroFileEncoding _encoding;
+  };
+
+} // namespace margelo::nitro::nitrofs
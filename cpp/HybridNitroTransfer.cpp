@@ -0,0 +1,178 @@
+//
+//  HybridNitroTransfer.cpp
+//  NitroFS
+//
+
+#include "HybridNitroTransfer.hpp"
+
+#include <cerrno>
+#include <mutex>
+#include <optional>
+#include <system_error>
+
+namespace margelo::nitro::nitrofs {
+
+  namespace {
+    core::TransferPriority toCorePriority(NitroTransferPriority priority) {
+      return priority == NitroTransferPriority::PREFETCH ? core::TransferPriority::Prefetch : core::TransferPriority::UserVisible;
+    }
+
+    NitroTransferState toNitroState(core::TransferState state) {
+      switch (state) {
+        case core::TransferState::Queued: return NitroTransferState::QUEUED;
+        case core::TransferState::Running: return NitroTransferState::RUNNING;
+        case core::TransferState::Paused: return NitroTransferState::PAUSED;
+        case core::TransferState::Completed: return NitroTransferState::COMPLETED;
+        case core::TransferState::Failed: return NitroTransferState::FAILED;
+        case core::TransferState::Cancelled: return NitroTransferState::CANCELLED;
+      }
+      return NitroTransferState::RUNNING;
+    }
+  } // namespace
+
+  /**
+   * Everything the queue's callbacks need, kept apart from the handle so a dropped handle doesn't take the
+   * transfer down with it.
+   */
+  struct HybridNitroTransfer::State: std::enable_shared_from_this<State> {
+    std::shared_ptr<core::TransferQueue> queue;
+    std::string url;
+    Attempt attempt;
+    std::function<void()> onCancelled;
+    core::TransferQueue::Id id = 0;
+    std::shared_ptr<Promise<NitroFile>> result = Promise<NitroFile>::create();
+
+    std::mutex mutex;
+    NitroTransferPriority priority = NitroTransferPriority::USERVISIBLE;
+    /** Set once, when the transfer completes, fails or is cancelled. */
+    std::optional<NitroTransferState> settled;
+
+    /** Returns `false` if the transfer had already settled. */
+    bool settle(NitroTransferState state) {
+      std::lock_guard lock(mutex);
+      if (settled.has_value()) {
+        return false;
+      }
+      settled = state;
+      return true;
+    }
+
+    void start(core::TransferQueue::Id transferId) {
+      std::shared_ptr<Promise<NitroFile>> pending;
+      try {
+        pending = attempt(static_cast<double>(transferId));
+      } catch (...) {
+        pending = Promise<NitroFile>::rejected(std::current_exception());
+      }
+      pending->addOnResolvedListener([self = shared_from_this(), transferId](const NitroFile& file) {
+        self->queue->finished(transferId, true);
+        if (self->settle(NitroTransferState::COMPLETED)) {
+          self->result->resolve(file);
+        }
+      });
+      pending->addOnRejectedListener([self = shared_from_this(), transferId](const std::exception_ptr& error) {
+        switch (self->queue->finished(transferId, false)) {
+          case core::TransferState::Failed:
+            if (self->settle(NitroTransferState::FAILED)) {
+              self->result->reject(error);
+            }
+            break;
+          case core::TransferState::Cancelled:
+            self->cancelled();
+            break;
+          default:
+            // Stopped by a pause: a later attempt settles it, if it is ever resumed.
+            break;
+        }
+      });
+    }
+
+    void cancelled() {
+      if (!settle(NitroTransferState::CANCELLED)) {
+        return;
+      }
+      if (onCancelled) {
+        try {
+          onCancelled();
+        } catch (...) {
+          // Leftovers are only untidy; the transfer is cancelled either way.
+        }
+      }
+      result->reject(std::make_exception_ptr(std::system_error(ECANCELED, std::generic_category(), "transfer(" + url + ")")));
+    }
+  };
+
+  HybridNitroTransfer::HybridNitroTransfer(const std::shared_ptr<core::TransferQueue>& queue, const std::string& url, NitroTransferPriority priority,
+                                           Attempt attempt, Stop stop, std::function<void()> onCancelled)
+      : HybridObject(TAG), _state(std::make_shared<State>()) {
+    _state->queue = queue;
+    _state->url = url;
+    _state->attempt = std::move(attempt);
+    _state->onCancelled = std::move(onCancelled);
+    _state->priority = priority;
+
+    core::TransferJob job;
+    job.host = core::TransferQueue::hostOf(url);
+    job.start = [state = _state](core::TransferQueue::Id transferId) {
+      state->start(transferId);
+    };
+    job.stop = [stop = std::move(stop)](core::TransferQueue::Id transferId) {
+      stop(static_cast<double>(transferId));
+    };
+    _state->id = queue->add(std::move(job), toCorePriority(priority));
+  }
+
+  HybridNitroTransfer::~HybridNitroTransfer() {
+    // Nothing could resume it any more.
+    if (_state->queue->state(_state->id) == core::TransferState::Paused) {
+      cancel();
+    }
+  }
+
+  double HybridNitroTransfer::getId() {
+    return static_cast<double>(_state->id);
+  }
+
+  NitroTransferState HybridNitroTransfer::getState() {
+    {
+      std::lock_guard lock(_state->mutex);
+      if (_state->settled.has_value()) {
+        return *_state->settled;
+      }
+    }
+    // Only unknown to the queue in the moment between an attempt ending and the transfer settling.
+    return toNitroState(_state->queue->state(_state->id).value_or(core::TransferState::Running));
+  }
+
+  NitroTransferPriority HybridNitroTransfer::getPriority() {
+    std::lock_guard lock(_state->mutex);
+    return _state->priority;
+  }
+
+  std::shared_ptr<Promise<NitroFile>> HybridNitroTransfer::result() {
+    return _state->result;
+  }
+
+  void HybridNitroTransfer::pause() {
+    _state->queue->pause(_state->id);
+  }
+
+  void HybridNitroTransfer::resume() {
+    _state->queue->resume(_state->id);
+  }
+
+  void HybridNitroTransfer::cancel() {
+    if (_state->queue->cancel(_state->id)) {
+      _state->cancelled();
+    }
+  }
+
+  void HybridNitroTransfer::setPriority(NitroTransferPriority priority) {
+    {
+      std::lock_guard lock(_state->mutex);
+      _state->priority = priority;
+    }
+    _state->queue->setPriority(_state->id, toCorePriority(priority));
+  }
+
+} // namespace margelo::nitro::nitrofs
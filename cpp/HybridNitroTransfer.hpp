@@ -0,0 +1,58 @@
+//
+//  HybridNitroTransfer.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "HybridNitroTransferSpec.hpp"
+#include "core/TransferQueue.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * The `NitroTransfer` returned by `NitroFS.enqueueDownload(...)` and `NitroFS.enqueueUpload(...)`, and the one
+   * behind every `downloadFile` and `uploadFile`. The queue keeps the transfer going until it settles, so the
+   * handle can be dropped.
+   *
+   * Each time the queue starts the transfer, `attempt` runs it on the platform under the queue's id, which is
+   * also what `stop` cancels it by. Pausing stops the attempt; resuming starts a new one, which picks up a
+   * download from its checkpoint but sends an upload again from the start.
+   */
+  class HybridNitroTransfer: public HybridNitroTransferSpec {
+  public:
+    using Attempt = std::function<std::shared_ptr<Promise<NitroFile>>(double /* transferId */)>;
+    using Stop = std::function<void(double /* transferId */)>;
+
+    /**
+     * Adds the transfer to `queue`. `onCancelled` cleans up what a cancelled transfer leaves behind.
+     */
+    HybridNitroTransfer(const std::shared_ptr<core::TransferQueue>& queue, const std::string& url, NitroTransferPriority priority,
+                        Attempt attempt, Stop stop, std::function<void()> onCancelled);
+    /** A transfer still paused when its handle is garbage collected is cancelled, as nothing could resume it. */
+    ~HybridNitroTransfer() override;
+
+  public:
+    // Properties
+    double getId() override;
+    NitroTransferState getState() override;
+    NitroTransferPriority getPriority() override;
+
+  public:
+    // Methods
+    std::shared_ptr<Promise<NitroFile>> result() override;
+    void pause() override;
+    void resume() override;
+    void cancel() override;
+    void setPriority(NitroTransferPriority priority) override;
+
+  private:
+    struct State;
+    std::shared_ptr<State> _state;
+  };
+
+} // namespace margelo::nitro::nitrofs
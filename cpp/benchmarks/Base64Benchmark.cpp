@@ -0,0 +1,112 @@
+//
+//  Base64Benchmark.cpp
+//  NitroFS
+//
+//  Host benchmark for core/Base64: every kernel this CPU supports, single-threaded
+//  and through the public (multi-core) API, plus the chunked file paths.
+//  Build with `-DNITROFS_BUILD_BENCHMARKS=ON` and run `./Base64Benchmark [sizeInMB...]`.
+//
+
+#include "core/Base64.hpp"
+#include "core/Base64Kernels.hpp"
+#include "core/FileSystem.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  constexpr int kIterations = 5;
+
+  template <typename Fn>
+  double bestSeconds(Fn&& fn) {
+    double best = 1e9;
+    for (int i = 0; i < kIterations; i++) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count());
+    }
+    return best;
+  }
+
+  void report(const char* name, size_t bytes, double seconds) {
+    std::printf("  %-28s %8.2f ms  %8.0f MB/s\n", name, seconds * 1000.0, static_cast<double>(bytes) / seconds / 1e6);
+  }
+
+  void encodeSerial(const base64::detail::Kernels& kernels, const std::string& raw, std::string& encoded) {
+    size_t i = kernels.encode(reinterpret_cast<const uint8_t*>(raw.data()), raw.size(), encoded.data());
+    // Finish like base64::encode does, so every kernel does the same amount of work.
+    base64::detail::scalarKernels().encode(reinterpret_cast<const uint8_t*>(raw.data()) + i, raw.size() - i, encoded.data() + i / 3 * 4);
+  }
+
+  void decodeSerial(const base64::detail::Kernels& kernels, const std::string& encoded, std::string& decoded) {
+    auto* out = reinterpret_cast<uint8_t*>(decoded.data());
+    size_t i = kernels.decode(encoded.data(), encoded.size(), out);
+    base64::detail::scalarKernels().decode(encoded.data() + i, encoded.size() - i, out + i / 4 * 3);
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(static_cast<size_t>(std::atof(argv[i]) * 1024 * 1024));
+  }
+  if (sizes.empty()) {
+    sizes = {1 * 1024 * 1024, 20 * 1024 * 1024, 80 * 1024 * 1024};
+  }
+
+  std::mt19937_64 random(42);
+  for (size_t size : sizes) {
+    // A multiple of 3 keeps padding out of the per-kernel loops.
+    size = size / 3 * 3;
+    std::string raw(size, '\0');
+    for (auto& c : raw) {
+      c = static_cast<char>(random());
+    }
+    std::string encoded = base64::encode(raw);
+    std::string scratch(encoded.size(), '\0');
+
+    std::printf("%.1f MB\n", static_cast<double>(size) / (1024 * 1024));
+    std::printf(" encode\n");
+    for (const auto* kernels : base64::detail::availableKernels()) {
+      report(kernels->name, size, bestSeconds([&] { encodeSerial(*kernels, raw, scratch); }));
+      if (scratch != encoded) {
+        std::printf("  !! %s produced different output\n", kernels->name);
+        return 1;
+      }
+    }
+    report("base64::encode (all cores)", size, bestSeconds([&] {
+      base64::encode(reinterpret_cast<const uint8_t*>(raw.data()), raw.size(), scratch.data());
+    }));
+
+    std::printf(" decode\n");
+    for (const auto* kernels : base64::detail::availableKernels()) {
+      scratch.assign(size, '\0');
+      report(kernels->name, size, bestSeconds([&] { decodeSerial(*kernels, encoded, scratch); }));
+      if (scratch != raw) {
+        std::printf("  !! %s produced different output\n", kernels->name);
+        return 1;
+      }
+    }
+    scratch.assign(base64::Decoder::maxDecodedLength(encoded.size()), '\0');
+    report("base64::Decoder (all cores)", size, bestSeconds([&] {
+      base64::Decoder().update(encoded, reinterpret_cast<uint8_t*>(scratch.data()));
+    }));
+
+    std::printf(" files\n");
+    std::string path = "/tmp/nitrofs-base64-benchmark.bin";
+    writeFile(path, raw);
+    report("readFile + encode", size, bestSeconds([&] { base64::encode(readFile(path)); }));
+    report("readFileBase64 (chunked)", size, bestSeconds([&] { readFileBase64(path); }));
+    report("decode + writeFile", size, bestSeconds([&] { writeFile(path, base64::decode(encoded)); }));
+    report("writeFileBase64 (chunked)", size, bestSeconds([&] { writeFileBase64(path, encoded); }));
+    removeAll(path);
+  }
+  return 0;
+}
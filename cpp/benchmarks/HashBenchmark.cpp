@@ -0,0 +1,100 @@
+//
+//  HashBenchmark.cpp
+//  NitroFS
+//
+//  Host benchmark for core/Hash: every algorithm with every kernel set this CPU supports on a
+//  buffer in memory, then `hashFile` (BLAKE3 on all cores) on the same data written to disk.
+//  Build with `-DNITROFS_BUILD_BENCHMARKS=ON` and run `./HashBenchmark [sizeInMB...]`.
+//
+
+#include "core/FileSystem.hpp"
+#include "core/Hash.hpp"
+#include "core/HashKernels.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  constexpr int kIterations = 5;
+
+  template <typename Fn>
+  double bestSeconds(Fn&& fn) {
+    double best = 1e9;
+    for (int i = 0; i < kIterations; i++) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count());
+    }
+    return best;
+  }
+
+  void report(const char* name, size_t bytes, double seconds) {
+    std::printf("  %-28s %8.2f ms  %8.0f MB/s\n", name, seconds * 1000.0, static_cast<double>(bytes) / seconds / 1e6);
+  }
+
+  struct Algorithm {
+    const char* name;
+    HashAlgorithm algorithm;
+  };
+
+  constexpr Algorithm kAlgorithms[] = {
+    {"sha256", HashAlgorithm::Sha256},
+    {"crc32c", HashAlgorithm::Crc32c},
+    {"xxh3", HashAlgorithm::Xxh3},
+    {"blake3", HashAlgorithm::Blake3},
+  };
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(static_cast<size_t>(std::atof(argv[i]) * 1024 * 1024));
+  }
+  if (sizes.empty()) {
+    sizes = {1 * 1024 * 1024, 64 * 1024 * 1024};
+  }
+
+  std::mt19937_64 random(42);
+  const std::string path = "/tmp/nitrofs-hash-benchmark.bin";
+  const auto& fastest = *hash::detail::availableKernels().front();
+  for (size_t size : sizes) {
+    std::string data(size, '\0');
+    for (auto& c : data) {
+      c = static_cast<char>(random());
+    }
+    writeFile(path, data);
+    std::printf("%.1f MB\n", static_cast<double>(size) / (1024 * 1024));
+
+    for (const Algorithm& algorithm : kAlgorithms) {
+      std::printf(" %s\n", algorithm.name);
+      std::string expected;
+      for (const auto* kernels : hash::detail::availableKernels()) {
+        hash::detail::setActiveKernels(*kernels);
+        std::string digest;
+        report(kernels->name, size, bestSeconds([&] { digest = hashBytes(data.data(), data.size(), algorithm.algorithm); }));
+        if (expected.empty()) {
+          expected = digest;
+        } else if (digest != expected) {
+          std::printf("  !! %s produced a different digest\n", kernels->name);
+          return 1;
+        }
+      }
+      hash::detail::setActiveKernels(fastest);
+      std::string digest;
+      report("hashFile", size, bestSeconds([&] { digest = hashFile(path, algorithm.algorithm); }));
+      if (digest != expected) {
+        std::printf("  !! hashFile produced a different digest\n");
+        return 1;
+      }
+    }
+  }
+  removeAll(path);
+  return 0;
+}
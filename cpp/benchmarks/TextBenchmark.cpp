@@ -0,0 +1,121 @@
+//
+//  TextBenchmark.cpp
+//  NitroFS
+//
+//  Host benchmark for the UTF-8 `readFile` path: every validation and line counting kernel this CPU supports,
+//  and the full read + validate against the old approach of appending 1KB chunks.
+//  Build with `-DNITROFS_BUILD_BENCHMARKS=ON` and run `./TextBenchmark [sizeInMB...]`.
+//
+
+#include "core/FileSystem.hpp"
+#include "core/Text.hpp"
+#include "core/TextKernels.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  constexpr int kIterations = 5;
+
+  template <typename Fn>
+  double bestSeconds(Fn&& fn) {
+    double best = 1e9;
+    for (int i = 0; i < kIterations; i++) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count());
+    }
+    return best;
+  }
+
+  void report(const char* name, size_t bytes, double seconds) {
+    std::printf("  %-30s %8.2f ms  %8.0f MB/s\n", name, seconds * 1000.0, static_cast<double>(bytes) / seconds / 1e6);
+  }
+
+  /**
+   * Text where roughly `nonAsciiPercent` of the characters are 2-, 3- or 4-byte sequences.
+   */
+  std::string makeText(size_t size, int nonAsciiPercent, std::mt19937& random) {
+    static const char* const kSamples[] = {"\xC3\xA9", "\xD0\x96", "\xE4\xB8\xAD", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+    std::string text;
+    text.reserve(size + 4);
+    while (text.size() < size) {
+      if (static_cast<int>(random() % 100) < nonAsciiPercent) {
+        text += kSamples[random() % 5];
+      } else {
+        text += static_cast<char>(random() % 64 == 0 ? '\n' : 'a' + random() % 26);
+      }
+    }
+    return text;
+  }
+
+  /**
+   * What the old Swift implementation did: 1KB reads, each appended to the result.
+   */
+  std::string readIn1KBChunks(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    std::string result;
+    char chunk[1024];
+    ssize_t length;
+    while ((length = ::read(fd, chunk, sizeof(chunk))) > 0) {
+      result += std::string(chunk, static_cast<size_t>(length));
+    }
+    ::close(fd);
+    return result;
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; i++) {
+    sizes.push_back(static_cast<size_t>(std::atof(argv[i]) * 1024 * 1024));
+  }
+  if (sizes.empty()) {
+    sizes = {1 * 1024 * 1024, 10 * 1024 * 1024, 100 * 1024 * 1024};
+  }
+
+  std::mt19937 random(42);
+  const std::string path = "/tmp/nitrofs-text-benchmark.txt";
+  for (size_t size : sizes) {
+    for (int nonAsciiPercent : {0, 20}) {
+      std::string text = makeText(size, nonAsciiPercent, random);
+      writeFile(path, text);
+      std::printf("%.1f MB, %d%% non-ASCII\n", static_cast<double>(size) / (1024 * 1024), nonAsciiPercent);
+
+      for (const auto* kernels : text::detail::availableKernels()) {
+        bool valid = true;
+        report((std::string("isValidUtf8 ") + kernels->name).c_str(), text.size(),
+               bestSeconds([&] { valid = kernels->isValidUtf8(text.data(), text.size()); }));
+        if (!valid) {
+          std::printf("  !! %s rejected valid UTF-8\n", kernels->name);
+          return 1;
+        }
+        size_t lineBreaks = 0;
+        report((std::string("countByte ") + kernels->name).c_str(), text.size(),
+               bestSeconds([&] { lineBreaks = kernels->countByte(text.data(), text.size(), '\n'); }));
+        if (lineBreaks != text::detail::scalarKernels().countByte(text.data(), text.size(), '\n')) {
+          std::printf("  !! %s miscounted line breaks\n", kernels->name);
+          return 1;
+        }
+      }
+      report("1KB chunks + append", text.size(), bestSeconds([&] { readIn1KBChunks(path); }));
+      report("readFile", text.size(), bestSeconds([&] { readFile(path); }));
+      report("readFile + sanitizeUtf8", text.size(), bestSeconds([&] {
+        std::string content = readFile(path);
+        sanitizeUtf8(content);
+      }));
+    }
+  }
+  removeAll(path);
+  return 0;
+}
@@ -0,0 +1,113 @@
+//
+//  ZipBenchmark.cpp
+//  NitroFS
+//
+//  Host benchmark for core/Zip: a content-pack-like tree of many small files plus a few large ones, zipped and
+//  unzipped with one thread and with all cores. Every extraction is compared with the source tree.
+//  Build with `-DNITROFS_BUILD_BENCHMARKS=ON` and run `./ZipBenchmark [fileCount] [largeFileSizeInMB]`.
+//
+
+#include "core/FileSystem.hpp"
+#include "core/Parallel.hpp"
+#include "core/Path.hpp"
+#include "core/Zip.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  constexpr int kIterations = 3;
+
+  template <typename Fn>
+  double bestSeconds(Fn&& fn) {
+    double best = 1e9;
+    for (int i = 0; i < kIterations; i++) {
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count());
+    }
+    return best;
+  }
+
+  void report(const char* name, size_t threads, uint64_t bytes, double seconds) {
+    std::printf("  %-8s %2zu threads %8.2f ms  %8.0f MB/s\n", name, threads, seconds * 1000.0, static_cast<double>(bytes) / seconds / 1e6);
+  }
+
+  /**
+   * Compressible but not trivially so: words from a small vocabulary with random bytes mixed in.
+   */
+  std::string makeContents(size_t size, std::mt19937_64& random) {
+    static const char* const kWords[] = {"texture ", "level ", "sprite ", "{\"id\": ", "0.5, ", "asset\n", "shader "};
+    std::string data;
+    data.reserve(size + 16);
+    while (data.size() < size) {
+      if (random() % 8 == 0) {
+        data.push_back(static_cast<char>(random()));
+      } else {
+        data += kWords[random() % 7];
+      }
+    }
+    data.resize(size);
+    return data;
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t fileCount = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 2000;
+  size_t largeSize = static_cast<size_t>((argc > 2 ? std::atof(argv[2]) : 32) * 1024 * 1024);
+
+  const std::string root = "/tmp/nitrofs-zip-benchmark";
+  const std::string source = join(root, "source");
+  const std::string archive = join(root, "pack.zip");
+  const std::string extracted = join(root, "extracted");
+  removeAll(root);
+
+  std::mt19937_64 random(42);
+  std::vector<std::string> paths;
+  uint64_t totalBytes = 0;
+  for (size_t i = 0; i < fileCount; i++) {
+    std::string path = join(source, "dir" + std::to_string(i % 50) + "/file" + std::to_string(i) + ".json");
+    std::string data = makeContents(1024 + random() % (64 * 1024), random);
+    writeFile(path, data);
+    paths.push_back(path);
+    totalBytes += data.size();
+  }
+  for (int i = 0; i < 4; i++) {
+    std::string path = join(source, "large" + std::to_string(i) + ".bin");
+    writeFile(path, makeContents(largeSize, random));
+    paths.push_back(path);
+    totalBytes += largeSize;
+  }
+  std::printf("%zu files, %.1f MB\n", paths.size(), static_cast<double>(totalBytes) / (1024 * 1024));
+
+  for (size_t threads : {size_t(1), hardwareConcurrency()}) {
+    ZipOptions zipOptions;
+    zipOptions.maxThreads = threads;
+    uint64_t archiveSize = 0;
+    report("zip", threads, totalBytes, bestSeconds([&] { archiveSize = zip(source, archive, zipOptions); }));
+    std::printf("  archive: %.1f MB\n", static_cast<double>(archiveSize) / (1024 * 1024));
+
+    UnzipOptions unzipOptions;
+    unzipOptions.maxThreads = threads;
+    report("unzip", threads, totalBytes, bestSeconds([&] {
+             removeAll(extracted);
+             unzip(archive, extracted, unzipOptions);
+           }));
+    for (const auto& path : paths) {
+      std::string copy = join(extracted, path.substr(source.size() + 1));
+      if (readFile(copy) != readFile(path)) {
+        std::printf("  !! %s differs after unzip\n", copy.c_str());
+        return 1;
+      }
+    }
+  }
+  removeAll(root);
+  return 0;
+}
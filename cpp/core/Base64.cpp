@@ -0,0 +1,264 @@
+//
+//  Base64.cpp
+//  NitroFS
+//
+
+#include "Base64.hpp"
+#include "Base64Kernels.hpp"
+#include "ByteBuffer.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+
+namespace margelo::nitro::nitrofs::core::base64 {
+
+  namespace {
+    constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    constexpr uint8_t kInvalid = 0xFF;
+    constexpr uint8_t kSkip = 0xFE;
+
+    // Below this a single core is faster than waking up threads. Each thread gets at least this much.
+    constexpr size_t kParallelThreshold = 1024 * 1024;
+
+    // `validate` decodes into a scratch buffer this many chars at a time.
+    constexpr size_t kValidateChunkSize = 256 * 1024;
+
+    constexpr std::array<uint8_t, 256> makeDecodeTable() {
+      std::array<uint8_t, 256> table{};
+      for (auto& value : table) {
+        value = kInvalid;
+      }
+      for (uint8_t i = 0; i < 64; i++) {
+        table[static_cast<uint8_t>(kAlphabet[i])] = i;
+      }
+      for (char c : {' ', '\t', '\r', '\n'}) {
+        table[static_cast<uint8_t>(c)] = kSkip;
+      }
+      return table;
+    }
+
+    constexpr auto kDecodeTable = makeDecodeTable();
+
+    [[noreturn]] void throwInvalid() {
+      throw std::invalid_argument("Invalid base64 data");
+    }
+
+    size_t encodeScalar(const uint8_t* input, size_t size, char* output) {
+      size_t i = 0;
+      for (; i + 3 <= size; i += 3) {
+        uint32_t triple = (uint32_t(input[i]) << 16) | (uint32_t(input[i + 1]) << 8) | input[i + 2];
+        *output++ = kAlphabet[(triple >> 18) & 0x3F];
+        *output++ = kAlphabet[(triple >> 12) & 0x3F];
+        *output++ = kAlphabet[(triple >> 6) & 0x3F];
+        *output++ = kAlphabet[triple & 0x3F];
+      }
+      return i;
+    }
+
+    size_t decodeScalar(const char* input, size_t size, uint8_t* output) {
+      size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        uint8_t a = kDecodeTable[static_cast<uint8_t>(input[i])];
+        uint8_t b = kDecodeTable[static_cast<uint8_t>(input[i + 1])];
+        uint8_t c = kDecodeTable[static_cast<uint8_t>(input[i + 2])];
+        uint8_t d = kDecodeTable[static_cast<uint8_t>(input[i + 3])];
+        // kInvalid and kSkip are the only values with the top bits set.
+        if ((a | b | c | d) & 0xC0) {
+          break;
+        }
+        uint32_t quartet = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | d;
+        *output++ = static_cast<uint8_t>(quartet >> 16);
+        *output++ = static_cast<uint8_t>(quartet >> 8);
+        *output++ = static_cast<uint8_t>(quartet);
+      }
+      return i;
+    }
+
+    const detail::Kernels kScalarKernels{"scalar", encodeScalar, decodeScalar};
+
+    std::atomic<const detail::Kernels*>& activeKernelsSlot() {
+      static std::atomic<const detail::Kernels*> slot{detail::availableKernels().front()};
+      return slot;
+    }
+
+    /**
+     * Encodes whole blocks with SIMD, then the remaining bytes (and padding) one triple at a time.
+     */
+    void encodeSerial(const detail::Kernels& kernels, const uint8_t* input, size_t size, char* output) {
+      size_t i = kernels.encode(input, size, output);
+      i += encodeScalar(input + i, size - i, output + i / 3 * 4);
+      output += i / 3 * 4;
+      size_t remaining = size - i;
+      if (remaining > 0) {
+        uint32_t triple = uint32_t(input[i]) << 16;
+        if (remaining == 2) {
+          triple |= uint32_t(input[i + 1]) << 8;
+        }
+        *output++ = kAlphabet[(triple >> 18) & 0x3F];
+        *output++ = kAlphabet[(triple >> 12) & 0x3F];
+        *output++ = remaining == 2 ? kAlphabet[(triple >> 6) & 0x3F] : '=';
+        *output++ = '=';
+      }
+    }
+
+    /**
+     * Decodes plain base64 (no whitespace, no padding) across threads.
+     * `size` must be a multiple of 4. Returns false, with `output` in an unspecified state,
+     * if anything else turned up, so the caller can redo the input with the lenient decoder.
+     */
+    bool decodeParallel(const detail::Kernels& kernels, const char* input, size_t size, uint8_t* output) {
+      size_t segmentSize = std::max(kParallelThreshold, size / hardwareConcurrency()) / 4 * 4;
+      size_t segmentCount = (size + segmentSize - 1) / segmentSize;
+      std::atomic<bool> plain{true};
+      parallelFor(segmentCount, hardwareConcurrency(), [&](size_t segment) {
+        size_t start = segment * segmentSize;
+        size_t length = std::min(segmentSize, size - start);
+        const char* in = input + start;
+        uint8_t* out = output + start / 4 * 3;
+        size_t i = kernels.decode(in, length, out);
+        i += decodeScalar(in + i, length - i, out + i / 4 * 3);
+        if (i != length) {
+          plain = false;
+        }
+      });
+      return plain;
+    }
+  } // namespace
+
+  namespace detail {
+    const Kernels& scalarKernels() {
+      return kScalarKernels;
+    }
+
+    std::vector<const Kernels*> availableKernels() {
+      std::vector<const Kernels*> kernels;
+      for (const Kernels* simd : {avx2Kernels(), ssse3Kernels(), neonKernels()}) {
+        if (simd != nullptr) {
+          kernels.push_back(simd);
+        }
+      }
+      kernels.push_back(&kScalarKernels);
+      return kernels;
+    }
+
+    const Kernels& activeKernels() {
+      return *activeKernelsSlot().load(std::memory_order_relaxed);
+    }
+
+    void setActiveKernels(const Kernels& kernels) {
+      activeKernelsSlot().store(&kernels, std::memory_order_relaxed);
+    }
+  } // namespace detail
+
+  void encode(const uint8_t* input, size_t size, char* output) {
+    const auto& kernels = detail::activeKernels();
+    if (size < 2 * kParallelThreshold) {
+      encodeSerial(kernels, input, size, output);
+      return;
+    }
+    // Segments are whole triples, so only the last one can produce padding.
+    size_t segmentSize = std::max(kParallelThreshold, size / hardwareConcurrency()) / 3 * 3;
+    size_t segmentCount = (size + segmentSize - 1) / segmentSize;
+    parallelFor(segmentCount, hardwareConcurrency(), [&](size_t segment) {
+      size_t start = segment * segmentSize;
+      encodeSerial(kernels, input + start, std::min(segmentSize, size - start), output + start / 3 * 4);
+    });
+  }
+
+  std::string encode(std::string_view input) {
+    std::string output(encodedLength(input.size()), '\0');
+    encode(reinterpret_cast<const uint8_t*>(input.data()), input.size(), output.data());
+    return output;
+  }
+
+  std::string decode(std::string_view input) {
+    std::string output(Decoder::maxDecodedLength(input.size()), '\0');
+    Decoder decoder;
+    size_t length = decoder.update(input, reinterpret_cast<uint8_t*>(output.data()));
+    decoder.finish();
+    output.resize(length);
+    return output;
+  }
+
+  void validate(std::string_view input) {
+    size_t chunkSize = std::min<size_t>(input.size(), kValidateChunkSize);
+    ByteBuffer scratch(Decoder::maxDecodedLength(chunkSize));
+    Decoder decoder;
+    for (size_t offset = 0; offset < input.size(); offset += chunkSize) {
+      decoder.update(input.substr(offset, chunkSize), scratch.data());
+    }
+    decoder.finish();
+  }
+
+  size_t Decoder::update(std::string_view input, uint8_t* output) {
+    const auto& kernels = detail::activeKernels();
+    const char* data = input.data();
+    size_t size = input.size();
+    size_t position = 0;
+    size_t written = 0;
+
+    // Fast path for big, well-formed chunks: everything but the last quartet (which may be padded)
+    // is decoded on all cores. Anything irregular falls through to the serial loop below.
+    if (_bits == 0 && _padding == 0 && size >= 2 * kParallelThreshold) {
+      size_t bulk = (size - 1) / 4 * 4;
+      if (decodeParallel(kernels, data, bulk, output)) {
+        position = bulk;
+        written = bulk / 4 * 3;
+      }
+    }
+
+    while (position < size) {
+      if (_bits == 0 && _padding == 0) {
+        size_t consumed = kernels.decode(data + position, size - position, output + written);
+        consumed += decodeScalar(data + position + consumed, size - position - consumed, output + written + consumed / 4 * 3);
+        position += consumed;
+        written += consumed / 4 * 3;
+      }
+      written += updateScalar(data, size, position, output + written);
+    }
+    return written;
+  }
+
+  /**
+   * Consumes chars one at a time until the next quartet boundary (where the block kernels can
+   * take over again) or the end of the input. Handles whitespace, padding and errors.
+   */
+  size_t Decoder::updateScalar(const char* input, size_t size, size_t& position, uint8_t* output) {
+    size_t written = 0;
+    while (position < size) {
+      char c = input[position++];
+      if (c == '=') {
+        _padding++;
+        continue;
+      }
+      uint8_t value = kDecodeTable[static_cast<uint8_t>(c)];
+      if (value == kSkip) {
+        continue;
+      }
+      if (value == kInvalid || _padding > 0) {
+        throwInvalid();
+      }
+      _accumulator = (_accumulator << 6) | value;
+      _bits += 6;
+      if (_bits >= 8) {
+        _bits -= 8;
+        output[written++] = static_cast<uint8_t>((_accumulator >> _bits) & 0xFF);
+      }
+      if (_bits == 0) {
+        break;
+      }
+    }
+    return written;
+  }
+
+  void Decoder::finish() const {
+    if (_padding > 2 || _bits >= 6) {
+      throwInvalid();
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core::base64
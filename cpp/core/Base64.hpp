@@ -0,0 +1,75 @@
+//
+//  Base64.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitrofs::core::base64 {
+
+  /**
+   * Number of characters `encode` produces for `size` input bytes (always padded).
+   */
+  constexpr size_t encodedLength(size_t size) {
+    return (size + 2) / 3 * 4;
+  }
+
+  /**
+   * Encodes `size` bytes from `input` into `output`, which must hold `encodedLength(size)` chars.
+   * Uses the fastest SIMD kernel for this CPU, and splits inputs of a few MB across cores.
+   */
+  void encode(const uint8_t* input, size_t size, char* output);
+
+  std::string encode(std::string_view input);
+
+  /**
+   * Decodes standard base64. Whitespace is ignored and padding is optional.
+   * Throws `std::invalid_argument` on any other character.
+   */
+  std::string decode(std::string_view input);
+
+  /**
+   * Throws what `decode` would for invalid `input`, without keeping the decoded bytes.
+   */
+  void validate(std::string_view input);
+
+  /**
+   * Incremental `decode` for input that arrives in chunks, e.g. to write a decoded
+   * file without holding the whole decoded copy in memory.
+   * Chunks may be split anywhere, even inside a quartet or a run of whitespace.
+   */
+  class Decoder {
+  public:
+    /**
+     * Upper bound of the bytes `update` writes for a chunk of `size` chars.
+     */
+    static constexpr size_t maxDecodedLength(size_t size) {
+      return (size + 3) / 4 * 3;
+    }
+
+    /**
+     * Decodes `input` into `output` (which must hold `maxDecodedLength(input.size())` bytes)
+     * and returns the number of bytes written. Throws `std::invalid_argument` on invalid input.
+     */
+    size_t update(std::string_view input, uint8_t* output);
+
+    /**
+     * Checks that the input did not end in the middle of a quartet.
+     */
+    void finish() const;
+
+  private:
+    size_t updateScalar(const char* input, size_t size, size_t& position, uint8_t* output);
+
+  private:
+    uint32_t _accumulator = 0;
+    int _bits = 0;
+    size_t _padding = 0;
+  };
+
+} // namespace margelo::nitro::nitrofs::core::base64
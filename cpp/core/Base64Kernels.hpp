@@ -0,0 +1,51 @@
+//
+//  Base64Kernels.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core::base64::detail {
+
+  /**
+   * A pair of block kernels for one instruction set.
+   *
+   * `encode` converts whole blocks of input bytes and returns how many bytes it consumed
+   * (always a multiple of 3). `decode` converts whole blocks of plain base64 — no whitespace,
+   * no padding — stops at the first block containing anything else, and returns how many
+   * chars it consumed (always a multiple of 4). Callers finish the remainder with scalar code.
+   *
+   * Kernels may store a few bytes past the output they report, but never past
+   * `encodedLength(size)` / `size / 4 * 3` bytes of `output`.
+   */
+  struct Kernels {
+    const char* name;
+    size_t (*encode)(const uint8_t* input, size_t size, char* output);
+    size_t (*decode)(const char* input, size_t size, uint8_t* output);
+  };
+
+  const Kernels& scalarKernels();
+
+  /**
+   * SIMD kernels, or `nullptr` if this build or the CPU running it lacks the instruction set.
+   */
+  const Kernels* ssse3Kernels();
+  const Kernels* avx2Kernels();
+  const Kernels* neonKernels();
+
+  /**
+   * Every kernel set usable on this CPU, fastest first. The last one is always `scalarKernels()`.
+   */
+  std::vector<const Kernels*> availableKernels();
+
+  /**
+   * The kernels used by `encode`/`decode`: the fastest available unless overridden (for benchmarks).
+   */
+  const Kernels& activeKernels();
+  void setActiveKernels(const Kernels& kernels);
+
+} // namespace margelo::nitro::nitrofs::core::base64::detail
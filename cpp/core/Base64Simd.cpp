@@ -0,0 +1,302 @@
+//
+//  Base64Simd.cpp
+//  NitroFS
+//
+//  SSSE3/AVX2 kernels (selected at runtime on x86) and NEON kernels (AArch64).
+//  The x86 kernels use per-function `target` attributes, so this file needs no extra compiler flags.
+//  Algorithms after Wojciech Muła & Daniel Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+//
+
+#include "Base64Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NITROFS_BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NITROFS_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace margelo::nitro::nitrofs::core::base64::detail {
+
+#if NITROFS_BASE64_X86
+
+  namespace {
+#define NITROFS_SSSE3 __attribute__((target("ssse3")))
+#define NITROFS_AVX2 __attribute__((target("avx2")))
+
+    // -- SSSE3 --
+
+    /**
+     * Splits 12 bytes (in the low 12 lanes) into 16 six-bit indices, one per byte.
+     */
+    NITROFS_SSSE3 inline __m128i encodeReshuffle(__m128i in) {
+      in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+      const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+      const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+      const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+      const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+      return _mm_or_si128(t1, t3);
+    }
+
+    /**
+     * Maps six-bit indices to ASCII by adding a per-range offset picked with one shuffle.
+     */
+    NITROFS_SSSE3 inline __m128i encodeTranslate(__m128i indices) {
+      // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+      __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+      const __m128i isUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+      range = _mm_or_si128(range, _mm_and_si128(isUpper, _mm_set1_epi8(13)));
+      const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+      return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+    }
+
+    /**
+     * Translates 16 chars to six-bit values. Returns false if any of them is not in the alphabet.
+     */
+    NITROFS_SSSE3 inline bool decodeTranslate(__m128i in, __m128i& values) {
+      const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+      const __m128i loNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+      // Each char is valid iff its low- and high-nibble class bits don't intersect.
+      const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+      const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+      if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+        return false;
+      }
+      const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m128i isSlash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+      values = _mm_add_epi8(in, _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, hiNibbles)));
+      return true;
+    }
+
+    /**
+     * Packs 16 six-bit values into 12 bytes (in the low 12 lanes).
+     */
+    NITROFS_SSSE3 inline __m128i decodeReshuffle(__m128i values) {
+      const __m128i mergedPairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+      const __m128i merged = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+      return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    NITROFS_SSSE3 size_t encodeSsse3(const uint8_t* input, size_t size, char* output) {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 12) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), encodeTranslate(encodeReshuffle(in)));
+        output += 16;
+      }
+      return i;
+    }
+
+    NITROFS_SSSE3 size_t decodeSsse3(const char* input, size_t size, uint8_t* output) {
+      size_t i = 0;
+      // Each store writes 16 bytes for 12 decoded ones; the extra input keeps that inside the output.
+      for (; i + 32 <= size; i += 16) {
+        __m128i values;
+        if (!decodeTranslate(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), values)) {
+          break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), decodeReshuffle(values));
+        output += 12;
+      }
+      return i;
+    }
+
+    // -- AVX2 --
+
+    NITROFS_AVX2 inline __m256i encodeReshuffle(__m256i in) {
+      in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+      const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+      const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+      const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+      const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+      return _mm256_or_si256(t1, t3);
+    }
+
+    NITROFS_AVX2 inline __m256i encodeTranslate(__m256i indices) {
+      __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+      const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+      range = _mm256_or_si256(range, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+      const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                               '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                               'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                               '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+      return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+    }
+
+    NITROFS_AVX2 size_t encodeAvx2(const uint8_t* input, size_t size, char* output) {
+      size_t i = 0;
+      // Two overlapping 16-byte loads put 12 input bytes into each 128-bit lane.
+      for (; i + 28 <= size; i += 24) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), encodeTranslate(encodeReshuffle(in)));
+        output += 32;
+      }
+      return i;
+    }
+
+    NITROFS_AVX2 size_t decodeAvx2(const char* input, size_t size, uint8_t* output) {
+      const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                             0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m256i packShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                   2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+      const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+
+      size_t i = 0;
+      // Each store writes 32 bytes for 24 decoded ones; the extra input keeps that inside the output.
+      for (; i + 64 <= size; i += 32) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibbleMask);
+        const __m256i loNibbles = _mm256_and_si256(in, nibbleMask);
+        const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+          break;
+        }
+        const __m256i isSlash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        const __m256i values = _mm256_add_epi8(in, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(isSlash, hiNibbles)));
+
+        const __m256i mergedPairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i merged = _mm256_madd_epi16(mergedPairs, _mm256_set1_epi32(0x00011000));
+        __m256i packed = _mm256_shuffle_epi8(merged, packShuffle);
+        // Close the 4-byte gap between the two 12-byte lane results.
+        packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), packed);
+        output += 24;
+      }
+      return i;
+    }
+
+#undef NITROFS_SSSE3
+#undef NITROFS_AVX2
+  } // namespace
+
+  const Kernels* ssse3Kernels() {
+    static const Kernels kernels{"ssse3", encodeSsse3, decodeSsse3};
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") ? &kernels : nullptr;
+  }
+
+  const Kernels* avx2Kernels() {
+    static const Kernels kernels{"avx2", encodeAvx2, decodeAvx2};
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? &kernels : nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#elif NITROFS_BASE64_NEON
+
+  namespace {
+    constexpr uint8_t kEncodeTable[64] = {
+      'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+      'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+      'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+      'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/',
+    };
+
+    // Six-bit values for ASCII 0..127, 0xFF for chars outside the alphabet.
+    constexpr uint8_t kDecodeTable[128] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 62,   0xFF, 0xFF, 0xFF, 63,
+      52,   53,   54,   55,   56,   57,   58,   59,   60,   61,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0,    1,    2,    3,    4,    5,    6,    7,    8,    9,    10,   11,   12,   13,   14,
+      15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+      41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+
+    size_t encodeNeon(const uint8_t* input, size_t size, char* output) {
+      const uint8x16x4_t table = vld1q_u8_x4(kEncodeTable);
+      const uint8x16_t mask = vdupq_n_u8(0x3F);
+      size_t i = 0;
+      for (; i + 48 <= size; i += 48) {
+        // De-interleaving load: val[0..2] hold bytes 0, 1 and 2 of 16 triples.
+        const uint8x16x3_t in = vld3q_u8(input + i);
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(in.val[0], 2);
+        indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+        indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+        indices.val[3] = vandq_u8(in.val[2], mask);
+        uint8x16x4_t out;
+        for (int k = 0; k < 4; k++) {
+          out.val[k] = vqtbl4q_u8(table, indices.val[k]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(output), out);
+        output += 64;
+      }
+      return i;
+    }
+
+    size_t decodeNeon(const char* input, size_t size, uint8_t* output) {
+      const uint8x16x4_t tableLo = vld1q_u8_x4(kDecodeTable);
+      const uint8x16x4_t tableHi = vld1q_u8_x4(kDecodeTable + 64);
+      const uint8x16_t offset = vdupq_n_u8(64);
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64) {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(input + i));
+        uint8x16x4_t values;
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (int k = 0; k < 4; k++) {
+          // Out-of-range indices yield 0, so exactly one of the two lookups contributes for ASCII input.
+          values.val[k] = vorrq_u8(vqtbl4q_u8(tableLo, in.val[k]), vqtbl4q_u8(tableHi, vsubq_u8(in.val[k], offset)));
+          // Bit 7 is set for 0xFF (not in the alphabet) and for non-ASCII chars.
+          invalid = vorrq_u8(invalid, vorrq_u8(values.val[k], in.val[k]));
+        }
+        if (vmaxvq_u8(invalid) & 0x80) {
+          break;
+        }
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(output, out);
+        output += 48;
+      }
+      return i;
+    }
+  } // namespace
+
+  const Kernels* ssse3Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* avx2Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    static const Kernels kernels{"neon", encodeNeon, decodeNeon};
+    return &kernels;
+  }
+
+#else
+
+  const Kernels* ssse3Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* avx2Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#endif
+
+} // namespace margelo::nitro::nitrofs::core::base64::detail
@@ -0,0 +1,78 @@
+//
+//  ByteBuffer.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * A `malloc`-backed byte buffer that is *not* zero-initialised.
+   * Ownership can be handed to another allocator-aware owner (e.g. an `ArrayBuffer`)
+   * with `release()`; the released pointer must be freed with `std::free`.
+   */
+  class ByteBuffer {
+  public:
+    ByteBuffer() = default;
+    explicit ByteBuffer(size_t size): _data(allocate(size)), _size(size) {}
+    ~ByteBuffer() { std::free(_data); }
+
+    ByteBuffer(const ByteBuffer&) = delete;
+    ByteBuffer& operator=(const ByteBuffer&) = delete;
+    ByteBuffer(ByteBuffer&& other) noexcept: _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) {}
+    ByteBuffer& operator=(ByteBuffer&& other) noexcept {
+      if (this != &other) {
+        std::free(_data);
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+      }
+      return *this;
+    }
+
+    uint8_t* data() noexcept { return _data; }
+    const uint8_t* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+
+    /**
+     * Grows or shrinks the buffer, keeping its first `min(size(), size)` bytes.
+     */
+    void resize(size_t size) {
+      if (size == _size) {
+        return;
+      }
+      // realloc(ptr, 0) is implementation-defined, so always keep at least one byte around.
+      auto* data = static_cast<uint8_t*>(std::realloc(_data, size == 0 ? 1 : size));
+      if (data == nullptr) {
+        throw std::bad_alloc();
+      }
+      _data = data;
+      _size = size;
+    }
+
+    uint8_t* release() noexcept {
+      _size = 0;
+      return std::exchange(_data, nullptr);
+    }
+
+  private:
+    static uint8_t* allocate(size_t size) {
+      auto* data = static_cast<uint8_t*>(std::malloc(size == 0 ? 1 : size));
+      if (data == nullptr) {
+        throw std::bad_alloc();
+      }
+      return data;
+    }
+
+  private:
+    uint8_t* _data = nullptr;
+    size_t _size = 0;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,405 @@
+//
+//  Compression.cpp
+//  NitroFS
+//
+
+#include "Compression.hpp"
+#include "ByteBuffer.hpp"
+#include "Parallel.hpp"
+
+#include <zlib.h>
+#ifdef NITROFS_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr size_t kOutputBufferSize = 256 * 1024;
+    // zlib counts bytes in 32-bit `uInt`s, so larger inputs are fed in slices.
+    constexpr size_t kMaxZlibInput = 1u << 30;
+    // With `threads = 0`, zstd only goes parallel for inputs of at least this size...
+    constexpr uint64_t kParallelThreshold = 4 * 1024 * 1024;
+    // ...and splits them into jobs of at least this size, so every worker gets one.
+    constexpr uint64_t kMinJobSize = 1024 * 1024;
+    constexpr uint64_t kMaxJobSize = 64 * 1024 * 1024;
+
+    const char* formatName(CompressionFormat format) {
+      switch (format) {
+        case CompressionFormat::Gzip:
+          return "gzip";
+        case CompressionFormat::Deflate:
+          return "deflate";
+        case CompressionFormat::Zstd:
+          return "zstd";
+      }
+      return "unknown";
+    }
+
+#ifndef NITROFS_HAS_ZSTD
+    [[noreturn]] void throwUnavailable(CompressionFormat format) {
+      throw std::runtime_error(std::string(formatName(format)) + " is not available in this build of NitroFS");
+    }
+#endif
+
+    [[noreturn]] void throwInvalidLevel(CompressionFormat format, int level, int min, int max) {
+      throw std::invalid_argument("Invalid " + std::string(formatName(format)) + " compression level " + std::to_string(level) +
+                                  ", expected " + std::to_string(min) + " to " + std::to_string(max));
+    }
+
+    [[noreturn]] void throwCorrupt(CompressionFormat format, const char* reason) {
+      throw std::invalid_argument("Invalid " + std::string(formatName(format)) + " data: " + (reason != nullptr ? reason : "corrupt stream"));
+    }
+
+    // 16 added to the window bits selects the gzip wrapper instead of zlib's.
+    int zlibWindowBits(CompressionFormat format) {
+      return format == CompressionFormat::Gzip ? MAX_WBITS + 16 : MAX_WBITS;
+    }
+
+#ifdef NITROFS_HAS_ZSTD
+    void checkZstd(size_t result, const char* operation) {
+      if (ZSTD_isError(result)) {
+        throw std::runtime_error(std::string(operation) + ": " + ZSTD_getErrorName(result));
+      }
+    }
+#endif
+  } // namespace
+
+  bool isCompressionAvailable(CompressionFormat format) {
+#ifdef NITROFS_HAS_ZSTD
+    constexpr bool hasZstd = true;
+#else
+    constexpr bool hasZstd = false;
+#endif
+    return format != CompressionFormat::Zstd || hasZstd;
+  }
+
+  std::optional<CompressionFormat> detectCompression(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+      return CompressionFormat::Gzip;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd) {
+      return CompressionFormat::Zstd;
+    }
+    // A zlib header: method 8 (deflate), a window of at most 32KB, and a check value making it a multiple of 31.
+    if (size >= 2 && (bytes[0] & 0x0f) == 8 && (bytes[0] >> 4) <= 7 && ((bytes[0] << 8) | bytes[1]) % 31 == 0) {
+      return CompressionFormat::Deflate;
+    }
+    return std::nullopt;
+  }
+
+  std::optional<uint64_t> decompressedSizeHint(CompressionFormat format, const void* head, size_t headSize, const void* tail,
+                                               size_t tailSize) {
+    switch (format) {
+      case CompressionFormat::Gzip: {
+        if (tailSize < 4) {
+          return std::nullopt;
+        }
+        const auto* isize = static_cast<const uint8_t*>(tail) + tailSize - 4;
+        return static_cast<uint64_t>(isize[0]) | (static_cast<uint64_t>(isize[1]) << 8) | (static_cast<uint64_t>(isize[2]) << 16) |
+               (static_cast<uint64_t>(isize[3]) << 24);
+      }
+      case CompressionFormat::Zstd: {
+#ifdef NITROFS_HAS_ZSTD
+        unsigned long long size = ZSTD_getFrameContentSize(head, headSize);
+        if (size != ZSTD_CONTENTSIZE_UNKNOWN && size != ZSTD_CONTENTSIZE_ERROR) {
+          return static_cast<uint64_t>(size);
+        }
+#endif
+        return std::nullopt;
+      }
+      case CompressionFormat::Deflate:
+        return std::nullopt;
+    }
+    return std::nullopt;
+  }
+
+  struct Compressor::State {
+    CompressionFormat format;
+    ByteBuffer output{kOutputBufferSize};
+    z_stream zlib{};
+    bool zlibReady = false;
+#ifdef NITROFS_HAS_ZSTD
+    ZSTD_CCtx* zstd = nullptr;
+#endif
+
+    ~State() {
+      if (zlibReady) {
+        ::deflateEnd(&zlib);
+      }
+#ifdef NITROFS_HAS_ZSTD
+      ZSTD_freeCCtx(zstd);
+#endif
+    }
+
+    void deflate(const uint8_t* data, size_t size, int flush, const ByteSink& sink) {
+      do {
+        size_t slice = std::min(size, kMaxZlibInput);
+        zlib.next_in = const_cast<Bytef*>(data);
+        zlib.avail_in = static_cast<uInt>(slice);
+        data += slice;
+        size -= slice;
+        int mode = size == 0 ? flush : Z_NO_FLUSH;
+        // zlib wants to be called again with the same flush mode for as long as it fills the whole output buffer.
+        do {
+          zlib.next_out = output.data();
+          zlib.avail_out = static_cast<uInt>(output.size());
+          if (::deflate(&zlib, mode) == Z_STREAM_ERROR) {
+            throw std::runtime_error("deflate failed");
+          }
+          size_t produced = output.size() - zlib.avail_out;
+          if (produced > 0) {
+            sink(output.data(), produced);
+          }
+        } while (zlib.avail_out == 0);
+      } while (size > 0);
+    }
+
+#ifdef NITROFS_HAS_ZSTD
+    void compressZstd(const uint8_t* data, size_t size, ZSTD_EndDirective mode, const ByteSink& sink) {
+      ZSTD_inBuffer input{data, size, 0};
+      while (true) {
+        ZSTD_outBuffer out{output.data(), output.size(), 0};
+        size_t remaining = ZSTD_compressStream2(zstd, &out, &input, mode);
+        checkZstd(remaining, "ZSTD_compressStream2");
+        if (out.pos > 0) {
+          sink(output.data(), out.pos);
+        }
+        // Flushing and ending are done once nothing is left in zstd's buffers, not just once the input is taken.
+        bool done = mode == ZSTD_e_continue ? input.pos == input.size : remaining == 0;
+        if (done) {
+          return;
+        }
+      }
+    }
+#endif
+  };
+
+  Compressor::Compressor(const CompressionOptions& options, std::optional<uint64_t> contentSize, uint64_t sizeHint)
+      : _state(std::make_unique<State>()) {
+    _state->format = options.format;
+    switch (options.format) {
+      case CompressionFormat::Gzip:
+      case CompressionFormat::Deflate: {
+        int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+        if (options.level.has_value() && (level < Z_NO_COMPRESSION || level > Z_BEST_COMPRESSION)) {
+          throwInvalidLevel(options.format, level, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
+        }
+        if (::deflateInit2(&_state->zlib, level, Z_DEFLATED, zlibWindowBits(options.format), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+          throw std::bad_alloc();
+        }
+        _state->zlibReady = true;
+        return;
+      }
+      case CompressionFormat::Zstd: {
+#ifdef NITROFS_HAS_ZSTD
+        int level = options.level.value_or(ZSTD_CLEVEL_DEFAULT);
+        if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()) {
+          throwInvalidLevel(options.format, level, ZSTD_minCLevel(), ZSTD_maxCLevel());
+        }
+        _state->zstd = ZSTD_createCCtx();
+        if (_state->zstd == nullptr) {
+          throw std::bad_alloc();
+        }
+        checkZstd(ZSTD_CCtx_setParameter(_state->zstd, ZSTD_c_compressionLevel, level), "ZSTD_c_compressionLevel");
+        checkZstd(ZSTD_CCtx_setParameter(_state->zstd, ZSTD_c_checksumFlag, 1), "ZSTD_c_checksumFlag");
+        if (contentSize.has_value()) {
+          checkZstd(ZSTD_CCtx_setPledgedSrcSize(_state->zstd, *contentSize), "ZSTD_CCtx_setPledgedSrcSize");
+        }
+        uint64_t expectedSize = std::max(contentSize.value_or(0), sizeHint);
+        size_t threads = options.threads;
+        if (threads == 0) {
+          threads = expectedSize >= kParallelThreshold ? hardwareConcurrency() : 1;
+        }
+        // nbWorkers = 0 compresses on the calling thread; 1 or more hands jobs to that many workers.
+        // A libzstd built without ZSTD_MULTITHREAD rejects it, which leaves the single-threaded default.
+        if (threads > 1 && !ZSTD_isError(ZSTD_CCtx_setParameter(_state->zstd, ZSTD_c_nbWorkers, static_cast<int>(threads))) &&
+            options.threads == 0) {
+          uint64_t jobSize = std::clamp(expectedSize / threads, kMinJobSize, kMaxJobSize);
+          ZSTD_CCtx_setParameter(_state->zstd, ZSTD_c_jobSize, static_cast<int>(jobSize));
+        }
+        return;
+#else
+        (void)contentSize;
+        (void)sizeHint;
+        throwUnavailable(options.format);
+#endif
+      }
+    }
+    throw std::invalid_argument("Invalid compression format");
+  }
+
+  Compressor::~Compressor() = default;
+
+  void Compressor::update(const void* data, size_t size, const ByteSink& sink) {
+    if (size == 0) {
+      return;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(data);
+#ifdef NITROFS_HAS_ZSTD
+    if (_state->zstd != nullptr) {
+      _state->compressZstd(bytes, size, ZSTD_e_continue, sink);
+      return;
+    }
+#endif
+    _state->deflate(bytes, size, Z_NO_FLUSH, sink);
+  }
+
+  void Compressor::flush(const ByteSink& sink) {
+#ifdef NITROFS_HAS_ZSTD
+    if (_state->zstd != nullptr) {
+      _state->compressZstd(nullptr, 0, ZSTD_e_flush, sink);
+      return;
+    }
+#endif
+    _state->deflate(nullptr, 0, Z_SYNC_FLUSH, sink);
+  }
+
+  void Compressor::finish(const ByteSink& sink) {
+#ifdef NITROFS_HAS_ZSTD
+    if (_state->zstd != nullptr) {
+      _state->compressZstd(nullptr, 0, ZSTD_e_end, sink);
+      return;
+    }
+#endif
+    _state->deflate(nullptr, 0, Z_FINISH, sink);
+  }
+
+  struct Decompressor::State {
+    CompressionFormat format;
+    ByteBuffer output{kOutputBufferSize};
+    z_stream zlib{};
+    bool zlibReady = false;
+#ifdef NITROFS_HAS_ZSTD
+    ZSTD_DCtx* zstd = nullptr;
+#endif
+    // Whether the last gzip member, deflate stream or zstd frame is complete.
+    bool ended = false;
+
+    ~State() {
+      if (zlibReady) {
+        ::inflateEnd(&zlib);
+      }
+#ifdef NITROFS_HAS_ZSTD
+      ZSTD_freeDCtx(zstd);
+#endif
+    }
+
+    void inflate(const uint8_t* data, size_t size, const ByteSink& sink) {
+      while (size > 0) {
+        size_t slice = std::min(size, kMaxZlibInput);
+        zlib.next_in = const_cast<Bytef*>(data);
+        zlib.avail_in = static_cast<uInt>(slice);
+        data += slice;
+        size -= slice;
+        while (true) {
+          if (ended && zlib.avail_in > 0) {
+            if (format != CompressionFormat::Gzip) {
+              throwCorrupt(format, "unexpected data after the end of the stream");
+            }
+            // The next member of a multi-member gzip file.
+            ::inflateReset(&zlib);
+            ended = false;
+          }
+          zlib.next_out = output.data();
+          zlib.avail_out = static_cast<uInt>(output.size());
+          int result = ::inflate(&zlib, Z_NO_FLUSH);
+          if (result == Z_NEED_DICT || result == Z_DATA_ERROR || result == Z_STREAM_ERROR) {
+            throwCorrupt(format, zlib.msg);
+          }
+          if (result == Z_MEM_ERROR) {
+            throw std::bad_alloc();
+          }
+          size_t produced = output.size() - zlib.avail_out;
+          if (produced > 0) {
+            sink(output.data(), produced);
+          }
+          if (result == Z_STREAM_END) {
+            ended = true;
+          }
+          // A full output buffer may mean more output is pending even without input.
+          if (zlib.avail_in == 0 && zlib.avail_out > 0) {
+            break;
+          }
+        }
+      }
+    }
+
+#ifdef NITROFS_HAS_ZSTD
+    void decompressZstd(const uint8_t* data, size_t size, const ByteSink& sink) {
+      ZSTD_inBuffer input{data, size, 0};
+      while (true) {
+        size_t consumed = input.pos;
+        ZSTD_outBuffer out{output.data(), output.size(), 0};
+        size_t result = ZSTD_decompressStream(zstd, &out, &input);
+        if (ZSTD_isError(result)) {
+          throwCorrupt(format, ZSTD_getErrorName(result));
+        }
+        if (out.pos > 0) {
+          sink(output.data(), out.pos);
+        }
+        // 0 means a frame was decoded and flushed completely; the next input byte starts a new frame.
+        // A call that made no progress returns the next frame's header size instead, which says nothing.
+        if (out.pos > 0 || input.pos > consumed) {
+          ended = result == 0;
+        }
+        if (input.pos == input.size && out.pos < out.size) {
+          return;
+        }
+      }
+    }
+#endif
+  };
+
+  Decompressor::Decompressor(CompressionFormat format): _state(std::make_unique<State>()) {
+    _state->format = format;
+    switch (format) {
+      case CompressionFormat::Gzip:
+      case CompressionFormat::Deflate:
+        if (::inflateInit2(&_state->zlib, zlibWindowBits(format)) != Z_OK) {
+          throw std::bad_alloc();
+        }
+        _state->zlibReady = true;
+        return;
+      case CompressionFormat::Zstd:
+#ifdef NITROFS_HAS_ZSTD
+        _state->zstd = ZSTD_createDCtx();
+        if (_state->zstd == nullptr) {
+          throw std::bad_alloc();
+        }
+        return;
+#else
+        throwUnavailable(format);
+#endif
+    }
+    throw std::invalid_argument("Invalid compression format");
+  }
+
+  Decompressor::~Decompressor() = default;
+
+  void Decompressor::update(const void* data, size_t size, const ByteSink& sink) {
+    if (size == 0) {
+      return;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(data);
+#ifdef NITROFS_HAS_ZSTD
+    if (_state->zstd != nullptr) {
+      _state->decompressZstd(bytes, size, sink);
+      return;
+    }
+#endif
+    _state->inflate(bytes, size, sink);
+  }
+
+  void Decompressor::finish() {
+    if (!_state->ended) {
+      throwCorrupt(_state->format, "unexpected end of data");
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
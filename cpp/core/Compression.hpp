@@ -0,0 +1,119 @@
+//
+//  Compression.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace margelo::nitro::nitrofs::core {
+
+  enum class CompressionFormat {
+    // gzip (RFC 1952), as written by `gzip` and used for `Content-Encoding: gzip`.
+    Gzip,
+    // zlib-wrapped deflate (RFC 1950), like `Content-Encoding: deflate` and Node's `zlib.deflate`.
+    Deflate,
+    // Zstandard frames (RFC 8878), with a content checksum.
+    Zstd,
+  };
+
+  struct CompressionOptions {
+    CompressionFormat format = CompressionFormat::Gzip;
+    /** The format's default level (6 for gzip and deflate, 3 for zstd) if empty. */
+    std::optional<int> level;
+    /**
+     * Threads compressing a zstd stream: 0 picks one per core once the input is large enough to split into jobs,
+     * 1 compresses on the calling thread. gzip and deflate always use one thread.
+     */
+    size_t threads = 0;
+  };
+
+  /**
+   * Whether this build can read and write `format`. gzip and deflate come from the system's zlib and are always
+   * available; zstd is only compiled in when the build finds libzstd (`NITROFS_HAS_ZSTD`).
+   */
+  bool isCompressionAvailable(CompressionFormat format);
+
+  /**
+   * Recognises compressed data by its first bytes (at least 4 for zstd).
+   */
+  std::optional<CompressionFormat> detectCompression(const void* data, size_t size);
+
+  /**
+   * The decompressed size a stream records, to size its output buffer: the content size in a zstd frame header, or
+   * the ISIZE in a gzip trailer (the size modulo 4GB). `head` and `tail` are the first and last bytes of the stream.
+   * Only a hint: concatenated frames and members only tell the size of the first (zstd) or last (gzip) one.
+   * Empty for deflate, which doesn't record it, and for zstd frames written without it.
+   */
+  std::optional<uint64_t> decompressedSizeHint(CompressionFormat format, const void* head, size_t headSize, const void* tail,
+                                               size_t tailSize);
+
+  /**
+   * Receives output as it is produced. `data` is only valid during the call.
+   */
+  using ByteSink = std::function<void(const uint8_t* data, size_t size)>;
+
+  /**
+   * Compresses one stream incrementally through a fixed-size output buffer, so memory use does not
+   * depend on the input size. Throws `std::invalid_argument` for an invalid level and `std::runtime_error`
+   * if the format is not available.
+   */
+  class Compressor {
+  public:
+    /**
+     * `contentSize` is the exact number of bytes that will be passed to `update`, if known; zstd records it in the
+     * frame header. `sizeHint` is an estimate for inputs that may still change, like a file being appended to.
+     * With `threads = 0`, zstd only goes parallel when one of them is large.
+     */
+    explicit Compressor(const CompressionOptions& options, std::optional<uint64_t> contentSize = std::nullopt, uint64_t sizeHint = 0);
+    ~Compressor();
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    void update(const void* data, size_t size, const ByteSink& sink);
+
+    /**
+     * Emits everything passed to `update` so far, so a reader can decompress all of it. The stream stays open,
+     * at the cost of a slightly worse ratio.
+     */
+    void flush(const ByteSink& sink);
+
+    /**
+     * Ends the stream. No other call is allowed afterwards.
+     */
+    void finish(const ByteSink& sink);
+
+  private:
+    struct State;
+    std::unique_ptr<State> _state;
+  };
+
+  /**
+   * Decompresses a stream incrementally. Concatenated gzip members and zstd frames are decoded one after another,
+   * like `gzip -d` and `zstd -d` do. Corrupt input throws `std::invalid_argument`.
+   */
+  class Decompressor {
+  public:
+    explicit Decompressor(CompressionFormat format);
+    ~Decompressor();
+    Decompressor(const Decompressor&) = delete;
+    Decompressor& operator=(const Decompressor&) = delete;
+
+    void update(const void* data, size_t size, const ByteSink& sink);
+
+    /**
+     * Throws `std::invalid_argument` if the input stopped in the middle of a stream.
+     */
+    void finish();
+
+  private:
+    struct State;
+    std::unique_ptr<State> _state;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,196 @@
+//
+//  CopyTree.cpp
+//  NitroFS
+//
+
+#include "CopyTree.hpp"
+#include "Errors.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Progress.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    struct CopyItem {
+      std::string srcPath;
+      std::string destPath;
+      FileType type = FileType::File;
+      uint64_t size = 0;
+    };
+
+    struct CopyPlan {
+      // Parents always come before their children.
+      std::vector<std::string> directories;
+      std::vector<CopyItem> files;
+    };
+
+    /**
+     * Lists the whole source tree up front, one task per directory.
+     */
+    CopyPlan planCopy(const std::string& srcPath, const std::string& destPath, size_t maxThreads) {
+      CopyPlan plan;
+      std::mutex mutex;
+      std::vector<std::pair<std::string, std::string>> initial;
+      initial.emplace_back(srcPath, destPath);
+      plan.directories.push_back(destPath);
+      parallelTasks(std::move(initial), maxThreads, [&](std::pair<std::string, std::string>& directory, auto& spawn) {
+        std::vector<std::string> directories;
+        std::vector<CopyItem> files;
+        for (auto& entry : readdir(directory.first, DirDetail::Stats)) {
+          std::string target = join(directory.second, entry.name);
+          if (entry.type == FileType::Directory) {
+            directories.push_back(target);
+            spawn(std::make_pair(std::move(entry.path), std::move(target)));
+          } else if (entry.type == FileType::Other) {
+            // FIFOs, sockets and device nodes have no contents to copy, and opening a FIFO would block.
+            continue;
+          } else {
+            files.push_back(CopyItem{std::move(entry.path), std::move(target), entry.type, entry.stat->size});
+          }
+        }
+        std::lock_guard lock(mutex);
+        plan.directories.insert(plan.directories.end(), std::make_move_iterator(directories.begin()), std::make_move_iterator(directories.end()));
+        plan.files.insert(plan.files.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+      });
+      // A path sorts after its own prefix, so sorting puts every parent before its children.
+      std::sort(plan.directories.begin(), plan.directories.end());
+      return plan;
+    }
+
+    void createDirectory(const std::string& path, ConflictPolicy conflict) {
+      if (::mkdir(path.c_str(), 0777) == 0) {
+        return;
+      }
+      if (errno != EEXIST) {
+        throwErrno("mkdir", path);
+      }
+      struct stat st {};
+      if (::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        return;
+      }
+      if (conflict != ConflictPolicy::Overwrite) {
+        throwError(EEXIST, "mkdir", path);
+      }
+      removeAll(path);
+      if (::mkdir(path.c_str(), 0777) != 0) {
+        throwErrno("mkdir", path);
+      }
+    }
+
+    /**
+     * Drops files that already exist at their destination (`Skip`), or fails on the first one (`Fail`).
+     */
+    void resolveConflicts(std::vector<CopyItem>& files, ConflictPolicy conflict) {
+      std::vector<std::string> destPaths;
+      destPaths.reserve(files.size());
+      for (const auto& file : files) {
+        destPaths.push_back(file.destPath);
+      }
+      std::vector<bool> existing = existsMany(destPaths);
+      size_t kept = 0;
+      for (size_t i = 0; i < files.size(); i++) {
+        if (!existing[i]) {
+          // Self-move-assignment would leave the strings empty.
+          if (kept != i) {
+            files[kept] = std::move(files[i]);
+          }
+          kept++;
+        } else if (conflict == ConflictPolicy::Fail) {
+          throwError(EEXIST, "copy", files[i].destPath);
+        }
+      }
+      files.resize(kept);
+    }
+
+    class ProgressReporter {
+    public:
+      ProgressReporter(const std::function<void(const CopyProgress&)>& onProgress, uint64_t totalBytes, uint64_t totalFiles)
+          : _onProgress(onProgress), _totalBytes(totalBytes), _totalFiles(totalFiles) {}
+
+      void fileDone(uint64_t size) {
+        uint64_t copiedBytes = _copiedBytes.fetch_add(size) + size;
+        uint64_t copiedFiles = _copiedFiles.fetch_add(1) + 1;
+        if (_onProgress) {
+          _throttle.maybeReport([&]() { _onProgress(CopyProgress{copiedBytes, _totalBytes, copiedFiles, _totalFiles}); });
+        }
+      }
+
+      void finish() {
+        if (_onProgress) {
+          _throttle.report([&]() { _onProgress(CopyProgress{_copiedBytes.load(), _totalBytes, _copiedFiles.load(), _totalFiles}); });
+        }
+      }
+
+    private:
+      const std::function<void(const CopyProgress&)>& _onProgress;
+      uint64_t _totalBytes;
+      uint64_t _totalFiles;
+      std::atomic<uint64_t> _copiedBytes{0};
+      std::atomic<uint64_t> _copiedFiles{0};
+      ProgressThrottle _throttle;
+    };
+  } // namespace
+
+  void copyTree(const std::string& srcPath, const std::string& destPath, const CopyTreeOptions& options) {
+    struct stat st {};
+    if (::lstat(srcPath.c_str(), &st) != 0) {
+      throwErrno("lstat", srcPath);
+    }
+
+    CopyPlan plan;
+    if (S_ISDIR(st.st_mode)) {
+      plan = planCopy(srcPath, destPath, options.maxThreads);
+      std::string parent = dirname(destPath);
+      if (!parent.empty()) {
+        mkdirs(parent);
+      }
+    } else if (S_ISREG(st.st_mode) || S_ISLNK(st.st_mode)) {
+      FileType type = S_ISLNK(st.st_mode) ? FileType::Symlink : FileType::File;
+      plan.files.push_back(CopyItem{srcPath, destPath, type, static_cast<uint64_t>(st.st_size)});
+    } else {
+      throwError(ENOTSUP, "copy", srcPath);
+    }
+
+    if (options.conflict != ConflictPolicy::Overwrite) {
+      resolveConflicts(plan.files, options.conflict);
+    }
+    for (const auto& directory : plan.directories) {
+      createDirectory(directory, options.conflict);
+    }
+
+    uint64_t totalBytes = 0;
+    for (const auto& file : plan.files) {
+      totalBytes += file.size;
+    }
+    ProgressReporter progress(options.onProgress, totalBytes, plan.files.size());
+    bool overwrite = options.conflict == ConflictPolicy::Overwrite;
+    parallelFor(plan.files.size(), options.maxThreads, [&](size_t i) {
+      const CopyItem& file = plan.files[i];
+      try {
+        if (file.type == FileType::Symlink) {
+          copySymlink(file.srcPath, file.destPath, overwrite);
+        } else {
+          copyFile(file.srcPath, file.destPath, overwrite);
+        }
+      } catch (const std::system_error& error) {
+        // Created by someone else since the conflict check.
+        if (options.conflict != ConflictPolicy::Skip || error.code().value() != EEXIST) {
+          throw;
+        }
+      }
+      progress.fileDone(file.size);
+    });
+    progress.finish();
+  }
+
+} // namespace margelo::nitro::nitrofs::core
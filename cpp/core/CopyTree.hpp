@@ -0,0 +1,52 @@
+//
+//  CopyTree.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "Parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * What `copyTree` does when a file or symlink already exists at its destination.
+   * Existing directories are always merged into.
+   */
+  enum class ConflictPolicy {
+    Overwrite,
+    Skip,
+    /** Fails with `EEXIST` before anything is copied. */
+    Fail,
+  };
+
+  struct CopyProgress {
+    uint64_t copiedBytes = 0;
+    uint64_t totalBytes = 0;
+    uint64_t copiedFiles = 0;
+    uint64_t totalFiles = 0;
+  };
+
+  struct CopyTreeOptions {
+    ConflictPolicy conflict = ConflictPolicy::Overwrite;
+    size_t maxThreads = hardwareConcurrency();
+    /** Called after every few files from the copying threads (never concurrently), and once at the end. */
+    std::function<void(const CopyProgress&)> onProgress;
+  };
+
+  /**
+   * Copies a file, symlink or whole directory tree. Symlinks are copied as links.
+   * FIFOs, sockets and device nodes inside the tree are skipped; as `srcPath` itself they fail with `ENOTSUP`.
+   *
+   * The source tree is listed first (in parallel), then the directory skeleton is created, and then
+   * the files are copied by up to `maxThreads` threads, each with `copyFile`'s in-kernel fast paths.
+   * Skipped files don't count towards `totalFiles`/`totalBytes`.
+   */
+  void copyTree(const std::string& srcPath, const std::string& destPath, const CopyTreeOptions& options = {});
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,26 @@
+//
+//  Errors.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Throws a `std::system_error` for the current `errno`.
+   * The message reads like `open(/path/to/file): No such file or directory`.
+   */
+  [[noreturn]] inline void throwErrno(const char* operation, const std::string& path) {
+    throw std::system_error(errno, std::generic_category(), std::string(operation) + "(" + path + ")");
+  }
+
+  [[noreturn]] inline void throwError(int code, const char* operation, const std::string& path) {
+    throw std::system_error(code, std::generic_category(), std::string(operation) + "(" + path + ")");
+  }
+
+} // namespace margelo::nitro::nitrofs::core
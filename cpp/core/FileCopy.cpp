@@ -0,0 +1,156 @@
+//
+//  FileCopy.cpp
+//  NitroFS
+//
+
+#include "FileCopy.hpp"
+#include "Errors.hpp"
+#include "FileIO.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#endif
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr size_t kCopyBufferSize = 1024 * 1024;
+    // Per call, so that a huge file doesn't block signals for seconds, and fits in `ssize_t` on 32-bit.
+    constexpr size_t kKernelCopyChunkSize = 1024 * 1024 * 1024;
+
+    /**
+     * Whether `code` means "not possible here" rather than a real I/O error, so the next method should be tried.
+     */
+    bool isUnsupported(int code) {
+      return code == ENOSYS || code == EOPNOTSUPP || code == ENOTSUP || code == EXDEV || code == EINVAL || code == ENOTTY || code == EBADF ||
+             code == EPERM;
+    }
+
+#ifdef __linux__
+    enum class KernelCopy {
+      Done,
+      Unsupported,
+    };
+
+    /**
+     * Runs `step(chunkSize)` until it reports EOF. Falls back only if the very first call is unsupported;
+     * once bytes moved, any error is real.
+     */
+    template <typename Step>
+    KernelCopy copyInKernel(Step&& step, const char* operation, const std::string& path) {
+      bool first = true;
+      while (true) {
+        ssize_t result = step(kKernelCopyChunkSize);
+        if (result < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          if (first && isUnsupported(errno)) {
+            return KernelCopy::Unsupported;
+          }
+          throwErrno(operation, path);
+        }
+        if (result == 0) {
+          return KernelCopy::Done;
+        }
+        first = false;
+      }
+    }
+#endif
+
+    void copyThroughBuffer(int srcFd, int destFd, const std::string& srcPath, const std::string& destPath) {
+      auto buffer = std::make_unique<char[]>(kCopyBufferSize);
+      while (size_t length = readFully(srcFd, buffer.get(), kCopyBufferSize, srcPath)) {
+        writeFully(destFd, buffer.get(), length, destPath);
+      }
+    }
+  } // namespace
+
+  CopyMethod copyFileData(int srcFd, int destFd, uint64_t size, const std::string& srcPath, const std::string& destPath) {
+    // procfs & co. report a size of 0 and don't support in-kernel copies, so empty files just take the buffer path.
+    if (size == 0) {
+      copyThroughBuffer(srcFd, destFd, srcPath, destPath);
+      return CopyMethod::Buffer;
+    }
+
+#if defined(__linux__)
+#ifdef FICLONE
+    if (::ioctl(destFd, FICLONE, srcFd) == 0) {
+      return CopyMethod::Clone;
+    }
+#endif
+    preallocate(destFd, size);
+#ifdef __NR_copy_file_range
+    // Called through syscall(), since older Android and glibc versions don't have a wrapper.
+    auto copyFileRange = [&](size_t chunk) {
+      return static_cast<ssize_t>(::syscall(__NR_copy_file_range, srcFd, nullptr, destFd, nullptr, chunk, 0));
+    };
+    if (copyInKernel(copyFileRange, "copy_file_range", destPath) == KernelCopy::Done) {
+      return CopyMethod::Kernel;
+    }
+#endif
+    auto sendFile = [&](size_t chunk) {
+      return ::sendfile(destFd, srcFd, nullptr, chunk);
+    };
+    if (copyInKernel(sendFile, "sendfile", destPath) == KernelCopy::Done) {
+      return CopyMethod::Sendfile;
+    }
+#elif defined(__APPLE__)
+    preallocate(destFd, size);
+    if (::fcopyfile(srcFd, destFd, nullptr, COPYFILE_DATA) == 0) {
+      return CopyMethod::Kernel;
+    }
+    if (!isUnsupported(errno)) {
+      throwErrno("fcopyfile", destPath);
+    }
+#endif
+    copyThroughBuffer(srcFd, destFd, srcPath, destPath);
+    return CopyMethod::Buffer;
+  }
+
+  bool cloneToNewFile(int srcFd, const std::string& destPath) {
+#ifdef __APPLE__
+    return ::fclonefileat(srcFd, AT_FDCWD, destPath.c_str(), 0) == 0;
+#else
+    (void)srcFd;
+    (void)destPath;
+    return false;
+#endif
+  }
+
+  void preallocate(int fd, uint64_t size) {
+    if (size == 0) {
+      return;
+    }
+#if defined(__linux__)
+    // Not posix_fallocate(), which emulates unsupported filesystems by writing zeros.
+    // FALLOC_FL_KEEP_SIZE, so that the file never looks longer than what was actually written.
+    ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+#elif defined(__APPLE__)
+    fstore_t store{};
+    store.fst_flags = F_ALLOCATECONTIG | F_ALLOCATEALL;
+    store.fst_posmode = F_PEOFPOSMODE;
+    store.fst_length = static_cast<off_t>(size);
+    if (::fcntl(fd, F_PREALLOCATE, &store) != 0) {
+      store.fst_flags = F_ALLOCATEALL;
+      ::fcntl(fd, F_PREALLOCATE, &store);
+    }
+#else
+    (void)fd;
+#endif
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,47 @@
+//
+//  FileCopy.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * How `copyFileData` ended up moving the bytes, fastest first.
+   */
+  enum class CopyMethod {
+    /** Shared extents (`FICLONE` / `fclonefileat`); no data was copied at all. */
+    Clone,
+    /** In-kernel copy (`copy_file_range` / `fcopyfile`). */
+    Kernel,
+    /** In-kernel copy through the page cache (`sendfile`). */
+    Sendfile,
+    /** `read`/`write` through a user-space buffer. */
+    Buffer,
+  };
+
+  /**
+   * Copies everything from `srcFd`'s current position to EOF into `destFd`, which should be empty.
+   * Tries a reflink first, then the in-kernel copies, and only falls back to a buffer when the
+   * filesystem (or kernel) supports none of them. `size` is the source's `st_size`, used as a hint.
+   */
+  CopyMethod copyFileData(int srcFd, int destFd, uint64_t size, const std::string& srcPath, const std::string& destPath);
+
+  /**
+   * Clones `srcFd` into `destPath`, which must not exist yet, with `fclonefileat` on APFS.
+   * The clone keeps the source's mode and timestamps. Returns `false` if cloning isn't possible,
+   * always on platforms where `copyFileData` clones between open files (`FICLONE`) instead.
+   */
+  bool cloneToNewFile(int srcFd, const std::string& destPath);
+
+  /**
+   * Reserves `size` bytes for `fd` up front, so a large copy doesn't fragment or run out of space halfway.
+   * Best effort: filesystems that can't preallocate are left alone.
+   */
+  void preallocate(int fd, uint64_t size);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,137 @@
+//
+//  FileHandle.cpp
+//  NitroFS
+//
+
+#include "FileHandle.hpp"
+#include "Errors.hpp"
+#include "FileIO.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    int openFlags(OpenMode mode) {
+      switch (mode) {
+        case OpenMode::Read:
+          return O_RDONLY;
+        case OpenMode::Write:
+          return O_RDWR;
+        case OpenMode::Create:
+          return O_RDWR | O_CREAT;
+        case OpenMode::Overwrite:
+          return O_RDWR | O_CREAT | O_TRUNC;
+      }
+      return O_RDONLY;
+    }
+  } // namespace
+
+  std::shared_ptr<FileHandle> FileHandle::open(const std::string& path, OpenMode mode) {
+    int flags = openFlags(mode);
+    if (flags & O_CREAT) {
+      std::string parent = dirname(path);
+      if (!parent.empty()) {
+        mkdirs(parent);
+      }
+    }
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0666);
+    if (fd < 0) {
+      throwErrno("open", path);
+    }
+    // Owned right away, so the descriptor is closed if the checks below throw.
+    std::shared_ptr<FileHandle> handle(new FileHandle(path, fd));
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      throwErrno("fstat", path);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "open", path);
+    }
+    return handle;
+  }
+
+  FileHandle::~FileHandle() {
+    if (_fd >= 0) {
+      ::close(_fd);
+    }
+  }
+
+  int FileHandle::fd(const char* operation) const {
+    if (_fd < 0) {
+      throwError(EBADF, operation, _path);
+    }
+    return _fd;
+  }
+
+  size_t FileHandle::read(uint64_t offset, void* buffer, size_t size) const {
+    std::shared_lock lock(_mutex);
+    return preadFully(fd("read"), buffer, size, offset, _path);
+  }
+
+  ByteBuffer FileHandle::read(uint64_t offset, size_t size) const {
+    std::shared_lock lock(_mutex);
+    int fd = this->fd("read");
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      throwErrno("fstat", _path);
+    }
+    if (S_ISREG(st.st_mode)) {
+      auto fileSize = static_cast<uint64_t>(st.st_size);
+      size = offset >= fileSize ? 0 : static_cast<size_t>(std::min<uint64_t>(size, fileSize - offset));
+    } else {
+      size = std::min(size, kMaxUnsizedRead);
+    }
+    ByteBuffer bytes(size);
+    bytes.resize(preadFully(fd, bytes.data(), size, offset, _path));
+    return bytes;
+  }
+
+  void FileHandle::write(uint64_t offset, const void* data, size_t size) const {
+    std::shared_lock lock(_mutex);
+    pwriteFully(fd("write"), data, size, offset, _path);
+  }
+
+  uint64_t FileHandle::size() const {
+    std::shared_lock lock(_mutex);
+    struct stat st {};
+    if (::fstat(fd("fstat"), &st) != 0) {
+      throwErrno("fstat", _path);
+    }
+    return static_cast<uint64_t>(st.st_size);
+  }
+
+  void FileHandle::truncate(uint64_t size) const {
+    std::shared_lock lock(_mutex);
+    if (::ftruncate(fd("ftruncate"), static_cast<off_t>(size)) != 0) {
+      throwErrno("ftruncate", _path);
+    }
+  }
+
+  void FileHandle::sync() const {
+    std::shared_lock lock(_mutex);
+    if (::fsync(fd("fsync")) != 0) {
+      throwErrno("fsync", _path);
+    }
+  }
+
+  void FileHandle::close() {
+    std::unique_lock lock(_mutex);
+    if (_fd < 0) {
+      return;
+    }
+    int fd = std::exchange(_fd, -1);
+    if (::close(fd) != 0 && errno != EINTR) {
+      throwErrno("close", _path);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,86 @@
+//
+//  FileHandle.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "ByteBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  enum class OpenMode {
+    /** Read only. The file must exist. */
+    Read,
+    /** Read and write. The file must exist. */
+    Write,
+    /** Read and write. The file (and its parent directories) are created if missing; contents are kept. */
+    Create,
+    /** Like `Create`, but the file is truncated to 0 bytes. */
+    Overwrite,
+  };
+
+  /**
+   * An open file descriptor for positional I/O (`pread`/`pwrite`), so callers can
+   * update a region of a large file without rewriting it.
+   *
+   * All methods are thread-safe. `close()` waits for in-flight operations to finish;
+   * anything called after it fails with `EBADF`.
+   */
+  class FileHandle {
+  public:
+    static std::shared_ptr<FileHandle> open(const std::string& path, OpenMode mode);
+
+    ~FileHandle();
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    const std::string& path() const noexcept { return _path; }
+
+    /**
+     * Reads up to `size` bytes at `offset`. Returns fewer bytes only at the end of the file.
+     */
+    size_t read(uint64_t offset, void* buffer, size_t size) const;
+
+    /**
+     * Like `read`, into a new buffer. The buffer is sized to what the file holds past `offset`
+     * (from `fstat`) rather than to `size`, so an oversized `size` costs nothing. Files without
+     * a size, like pipes, are read at most `kMaxUnsizedRead` bytes at a time.
+     */
+    ByteBuffer read(uint64_t offset, size_t size) const;
+
+    static constexpr size_t kMaxUnsizedRead = 16 * 1024 * 1024;
+
+    /**
+     * Writes all of `data` at `offset`, growing the file if needed.
+     */
+    void write(uint64_t offset, const void* data, size_t size) const;
+
+    uint64_t size() const;
+    void truncate(uint64_t size) const;
+
+    /**
+     * Flushes written data and metadata to storage (`fsync`).
+     */
+    void sync() const;
+
+    void close();
+
+  private:
+    FileHandle(std::string path, int fd): _path(std::move(path)), _fd(fd) {}
+
+    int fd(const char* operation) const;
+
+  private:
+    std::string _path;
+    mutable std::shared_mutex _mutex;
+    int _fd;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,103 @@
+//
+//  FileIO.cpp
+//  NitroFS
+//
+
+#include "FileIO.hpp"
+#include "Errors.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitrofs::core {
+
+  size_t readFully(int fd, void* buffer, size_t size, const std::string& path) {
+    auto* cursor = static_cast<char*>(buffer);
+    size_t total = 0;
+    while (total < size) {
+      ssize_t result = ::read(fd, cursor + total, size - total);
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        throwErrno("read", path);
+      }
+      if (result == 0) {
+        break;
+      }
+      total += static_cast<size_t>(result);
+    }
+    return total;
+  }
+
+  void writeFully(int fd, const void* data, size_t size, const std::string& path) {
+    const auto* cursor = static_cast<const char*>(data);
+    size_t total = 0;
+    while (total < size) {
+      ssize_t result = ::write(fd, cursor + total, size - total);
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        throwErrno("write", path);
+      }
+      total += static_cast<size_t>(result);
+    }
+  }
+
+  size_t preadFully(int fd, void* buffer, size_t size, uint64_t offset, const std::string& path) {
+    auto* cursor = static_cast<char*>(buffer);
+    size_t total = 0;
+    while (total < size) {
+      ssize_t result = ::pread(fd, cursor + total, size - total, static_cast<off_t>(offset + total));
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        throwErrno("pread", path);
+      }
+      if (result == 0) {
+        break;
+      }
+      total += static_cast<size_t>(result);
+    }
+    return total;
+  }
+
+  void pwriteFully(int fd, const void* data, size_t size, uint64_t offset, const std::string& path) {
+    const auto* cursor = static_cast<const char*>(data);
+    size_t total = 0;
+    while (total < size) {
+      ssize_t result = ::pwrite(fd, cursor + total, size - total, static_cast<off_t>(offset + total));
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        throwErrno("pwrite", path);
+      }
+      total += static_cast<size_t>(result);
+    }
+  }
+
+  void syncFile(int fd, SyncMode mode, const std::string& path) {
+    int result = 0;
+    switch (mode) {
+      case SyncMode::None:
+        return;
+      case SyncMode::Data:
+#ifdef __APPLE__
+        // Darwin's fdatasync is not part of the public SDK; plain fsync is the closest equivalent.
+        do { result = ::fsync(fd); } while (result != 0 && errno == EINTR);
+#else
+        do { result = ::fdatasync(fd); } while (result != 0 && errno == EINTR);
+#endif
+        break;
+      case SyncMode::Full:
+#ifdef __APPLE__
+        // fsync only reaches the drive's volatile cache on Apple platforms. Some filesystems
+        // (e.g. SMB or FAT) don't support F_FULLFSYNC, so those fall back to fsync.
+        if (::fcntl(fd, F_FULLFSYNC) == 0) {
+          return;
+        }
+#endif
+        do { result = ::fsync(fd); } while (result != 0 && errno == EINTR);
+        break;
+    }
+    if (result != 0) {
+      throwErrno(mode == SyncMode::Data ? "fdatasync" : "fsync", path);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
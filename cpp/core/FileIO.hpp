@@ -0,0 +1,52 @@
+//
+//  FileIO.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * How far `syncFile` pushes written data towards storage.
+   */
+  enum class SyncMode {
+    // Nothing; the kernel writes the data back whenever it likes.
+    None,
+    // The file contents, and only the metadata needed to read them back (`fdatasync`).
+    Data,
+    // Contents and all metadata (`fsync`). On Apple platforms also flushes the drive's cache (`F_FULLFSYNC`).
+    Full,
+  };
+
+  /**
+   * Reads until `size` bytes arrived or EOF, retrying on `EINTR` and short reads.
+   * Returns the number of bytes read. `path` is only used for error messages.
+   */
+  size_t readFully(int fd, void* buffer, size_t size, const std::string& path);
+
+  /**
+   * Writes all `size` bytes, retrying on `EINTR` and short writes.
+   */
+  void writeFully(int fd, const void* data, size_t size, const std::string& path);
+
+  /**
+   * `readFully` at `offset`, without moving the file position (`pread`).
+   */
+  size_t preadFully(int fd, void* buffer, size_t size, uint64_t offset, const std::string& path);
+
+  /**
+   * `writeFully` at `offset`, without moving the file position (`pwrite`).
+   */
+  void pwriteFully(int fd, const void* data, size_t size, uint64_t offset, const std::string& path);
+
+  /**
+   * Flushes `fd` according to `mode`, retrying on `EINTR`.
+   */
+  void syncFile(int fd, SyncMode mode, const std::string& path);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,653 @@
+//
+//  FileSystem.cpp
+//  NitroFS
+//
+
+#include "FileSystem.hpp"
+#include "Base64.hpp"
+#include "Errors.hpp"
+#include "FileCopy.hpp"
+#include "FileIO.hpp"
+#include "Parallel.hpp"
+#include "Path.hpp"
+#include "Stat.hpp"
+#include "UniqueFd.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr size_t kReadGrowSize = 64 * 1024;
+    // Large enough for base64::encode/decode to spread a chunk across cores, and a multiple of 3
+    // so that only the last chunk of a file gets padded.
+    constexpr size_t kBase64ChunkSize = 6 * 1024 * 1024;
+    static_assert(kBase64ChunkSize % 3 == 0);
+    // Compressed files are read this much at a time.
+    constexpr size_t kCompressedChunkSize = 1024 * 1024;
+    // Deflate's best case. A recorded size beyond this many times the file is corrupt or forged, and ignored.
+    constexpr uint64_t kMaxCompressionRatio = 1032;
+    // Each thread of statMany/existsMany takes this many paths at a time.
+    constexpr size_t kStatBatchSize = 512;
+
+    struct DirCloser {
+      void operator()(DIR* dir) const { ::closedir(dir); }
+    };
+    using UniqueDir = std::unique_ptr<DIR, DirCloser>;
+
+    bool isDotOrDotDot(const char* name) {
+      return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+    }
+
+    void ensureParentDirectory(const std::string& path) {
+      std::string parent = dirname(path);
+      if (!parent.empty()) {
+        mkdirs(parent);
+      }
+    }
+
+    UniqueFd openForReading(const std::string& path, struct stat& st) {
+      UniqueFd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+      if (!fd) {
+        throwErrno("open", path);
+      }
+      if (::fstat(fd.get(), &st) != 0) {
+        throwErrno("fstat", path);
+      }
+      if (S_ISDIR(st.st_mode)) {
+        throwError(EISDIR, "read", path);
+      }
+      return fd;
+    }
+
+    std::string temporaryPathFor(const std::string& path) {
+      static std::atomic<uint64_t> counter{0};
+      std::random_device random;
+      std::string parent = dirname(path);
+      std::string name = basename(path);
+      name.insert(0, 1, '.');
+      name += ".nitrofs-tmp-" + std::to_string(random()) + "-" + std::to_string(counter.fetch_add(1));
+      return parent.empty() ? name : join(parent, name);
+    }
+
+    void syncDirectory(const std::string& path, SyncMode mode) {
+      std::string directory = path.empty() ? "." : path;
+      UniqueFd fd(::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+      if (!fd) {
+        throwErrno("open", directory);
+      }
+      try {
+        syncFile(fd.get(), mode, directory);
+      } catch (const std::system_error& error) {
+        // Some filesystems can't sync a directory at all; the rename is as durable as they allow.
+        if (error.code().value() != EINVAL) {
+          throw;
+        }
+      }
+    }
+
+    /**
+     * The file a write goes to: `path` itself, or for atomic writes a temporary sibling that
+     * `commit` renames over it. A temporary file that was never committed is removed again.
+     * With `options.compression`, everything passed to `write` is compressed on the way.
+     */
+    class FileOutput {
+    public:
+      /**
+       * `expectedSize` is how much will be passed to `write`; `exactSize` says it is more than an estimate.
+       */
+      FileOutput(const std::string& path, const WriteOptions& options, uint64_t expectedSize, bool exactSize): _path(path), _options(options) {
+        if (options.compression.has_value()) {
+          // Before anything is opened, so an invalid level doesn't truncate the file.
+          std::optional<uint64_t> contentSize = exactSize ? std::optional(expectedSize) : std::nullopt;
+          _compressor = std::make_unique<Compressor>(*options.compression, contentSize, expectedSize);
+        }
+        ensureParentDirectory(path);
+        if (options.atomic) {
+          _tempPath = temporaryPathFor(path);
+          _fd = UniqueFd(::open(_tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666));
+          if (!_fd) {
+            int code = errno;
+            _tempPath.clear();
+            throwError(code, "open", path);
+          }
+          // Keep the permissions of the file being replaced. Best effort, like copyFile.
+          struct stat st {};
+          if (::stat(path.c_str(), &st) == 0) {
+            ::fchmod(_fd.get(), st.st_mode & 07777);
+          }
+        } else {
+          _fd = UniqueFd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666));
+          if (!_fd) {
+            throwErrno("open", path);
+          }
+        }
+        if (options.preallocate && expectedSize > 0 && !_compressor) {
+          preallocate(_fd.get(), expectedSize);
+        }
+      }
+
+      ~FileOutput() {
+        if (!_tempPath.empty()) {
+          ::unlink(_tempPath.c_str());
+        }
+      }
+
+      void write(const void* data, size_t size) {
+        if (_compressor) {
+          _compressor->update(data, size, [this](const uint8_t* bytes, size_t length) { writeRaw(bytes, length); });
+        } else {
+          writeRaw(data, size);
+        }
+      }
+
+      /** The bytes written to the file so far. */
+      uint64_t size() const { return _size; }
+
+      void commit() {
+        if (_compressor) {
+          _compressor->finish([this](const uint8_t* bytes, size_t length) { writeRaw(bytes, length); });
+        }
+        syncFile(_fd.get(), _options.sync, _path);
+        if (!_options.atomic) {
+          return;
+        }
+        if (::close(_fd.release()) != 0) {
+          throwErrno("close", _path);
+        }
+        if (::rename(_tempPath.c_str(), _path.c_str()) != 0) {
+          throwErrno("rename", _path);
+        }
+        _tempPath.clear();
+        if (_options.sync != SyncMode::None) {
+          syncDirectory(dirname(_path), _options.sync);
+        }
+      }
+
+    private:
+      void writeRaw(const void* data, size_t size) {
+        writeFully(_fd.get(), data, size, _path);
+        _size += size;
+      }
+
+    private:
+      const std::string& _path;
+      WriteOptions _options;
+      std::string _tempPath;
+      UniqueFd _fd;
+      std::unique_ptr<Compressor> _compressor;
+      uint64_t _size = 0;
+    };
+
+    /**
+     * Reads a whole file in one pass into a buffer sized from `fstat`.
+     * `st_size` is only a hint (e.g. procfs reports 0), so the buffer still grows until EOF.
+     */
+    template <typename Buffer>
+    Buffer readWholeFile(const std::string& path) {
+      struct stat st {};
+      UniqueFd fd = openForReading(path, st);
+
+      Buffer buffer;
+      buffer.resize(static_cast<size_t>(st.st_size));
+      size_t length = readFully(fd.get(), buffer.data(), buffer.size(), path);
+      while (length == buffer.size()) {
+        buffer.resize(buffer.size() + kReadGrowSize);
+        size_t extra = readFully(fd.get(), buffer.data() + length, kReadGrowSize, path);
+        length += extra;
+        if (extra < kReadGrowSize) {
+          break;
+        }
+      }
+      buffer.resize(length);
+      return buffer;
+    }
+
+    /**
+     * The size to start the output buffer of `readDecompressed` at: the size the stream records if it is plausible,
+     * otherwise the size of the file (the buffer doubles from there).
+     */
+    size_t decompressedBufferSize(int fd, const struct stat& st, CompressionFormat format, const std::string& path) {
+      auto fileSize = static_cast<uint64_t>(st.st_size);
+      size_t fallback = static_cast<size_t>(std::clamp<uint64_t>(fileSize, kReadGrowSize, SIZE_MAX));
+      if (!S_ISREG(st.st_mode) || fileSize == 0) {
+        return fallback;
+      }
+      // A zstd frame header is at most 18 bytes; the gzip trailer ends with 4.
+      uint8_t head[18];
+      uint8_t tail[4];
+      size_t headSize = preadFully(fd, head, sizeof(head), 0, path);
+      size_t tailSize = fileSize >= sizeof(tail) ? preadFully(fd, tail, sizeof(tail), fileSize - sizeof(tail), path) : 0;
+      std::optional<uint64_t> hint = decompressedSizeHint(format, head, headSize, tail, tailSize);
+      if (!hint.has_value() || *hint > fileSize * kMaxCompressionRatio || *hint > SIZE_MAX) {
+        return fallback;
+      }
+      return static_cast<size_t>(*hint);
+    }
+
+    /**
+     * Reads and decompresses a whole file, chunk by chunk, into a buffer sized by `decompressedBufferSize` that
+     * doubles whenever the output outgrows it.
+     */
+    template <typename Buffer>
+    Buffer readDecompressed(const std::string& path, CompressionFormat format) {
+      struct stat st {};
+      UniqueFd fd = openForReading(path, st);
+
+      Decompressor decompressor(format);
+      Buffer buffer;
+      buffer.resize(decompressedBufferSize(fd.get(), st, format, path));
+      size_t length = 0;
+      auto sink = [&](const uint8_t* data, size_t size) {
+        if (buffer.size() - length < size) {
+          buffer.resize(std::max({buffer.size() * 2, length + size, kReadGrowSize}));
+        }
+        std::memcpy(buffer.data() + length, data, size);
+        length += size;
+      };
+      ByteBuffer chunk(kCompressedChunkSize);
+      try {
+        while (true) {
+          size_t read = readFully(fd.get(), chunk.data(), chunk.size(), path);
+          decompressor.update(chunk.data(), read, sink);
+          if (read < chunk.size()) {
+            break;
+          }
+        }
+        decompressor.finish();
+      } catch (const std::invalid_argument& error) {
+        throw std::invalid_argument("decompress(" + path + "): " + error.what());
+      }
+      buffer.resize(length);
+      return buffer;
+    }
+
+    /**
+     * Resolves paths relative to an fd of their parent directory, which is kept open for as long as
+     * consecutive paths share it. This way the kernel walks the common prefix once per directory.
+     */
+    class ParentDirectory {
+    public:
+      /**
+       * Returns the directory fd to pass to `*at()` functions, and points `name` at the part of `path` relative to it.
+       * Falls back to `AT_FDCWD` and the full path if the directory can't be opened.
+       */
+      int resolve(const std::string& path, const char*& name) {
+        size_t slash = path.rfind('/');
+        if (slash == std::string::npos || slash + 1 == path.size()) {
+          name = path.c_str();
+          return AT_FDCWD;
+        }
+        std::string_view parent(path.data(), slash == 0 ? 1 : slash);
+        if (!_fd || parent != _path) {
+          _path.assign(parent);
+          _fd.reset(::open(_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        }
+        if (!_fd) {
+          name = path.c_str();
+          return AT_FDCWD;
+        }
+        name = path.c_str() + slash + 1;
+        return _fd.get();
+      }
+
+    private:
+      std::string _path;
+      UniqueFd _fd;
+    };
+
+    /**
+     * Runs `task(i, parent)` for every path, in batches of `kStatBatchSize` spread across threads.
+     */
+    template <typename Task>
+    void forEachPathBatch(size_t count, Task&& task) {
+      size_t batches = (count + kStatBatchSize - 1) / kStatBatchSize;
+      parallelFor(batches, hardwareConcurrency(), [&](size_t batch) {
+        ParentDirectory parent;
+        size_t end = std::min(count, (batch + 1) * kStatBatchSize);
+        for (size_t i = batch * kStatBatchSize; i < end; i++) {
+          task(i, parent);
+        }
+      });
+    }
+  } // namespace
+
+  bool exists(const std::string& path) {
+    return !path.empty() && ::access(path.c_str(), F_OK) == 0;
+  }
+
+  FileStat stat(const std::string& path) {
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+      throwErrno("stat", path);
+    }
+    return toFileStat(st);
+  }
+
+  std::vector<StatResult> statMany(const std::vector<std::string>& paths) {
+    std::vector<StatResult> results(paths.size());
+    forEachPathBatch(paths.size(), [&](size_t i, ParentDirectory& parent) {
+      if (paths[i].empty()) {
+        results[i].error = ENOENT;
+        return;
+      }
+      const char* name = nullptr;
+      int dirFd = parent.resolve(paths[i], name);
+      struct stat st {};
+      if (::fstatat(dirFd, name, &st, 0) != 0) {
+        results[i].error = errno;
+        return;
+      }
+      results[i].stat = toFileStat(st);
+    });
+    return results;
+  }
+
+  std::vector<bool> existsMany(const std::vector<std::string>& paths) {
+    // Not std::vector<bool>, whose packed bits can't be written from several threads.
+    std::vector<uint8_t> found(paths.size(), 0);
+    forEachPathBatch(paths.size(), [&](size_t i, ParentDirectory& parent) {
+      if (paths[i].empty()) {
+        return;
+      }
+      const char* name = nullptr;
+      int dirFd = parent.resolve(paths[i], name);
+      found[i] = ::faccessat(dirFd, name, F_OK, 0) == 0;
+    });
+    return std::vector<bool>(found.begin(), found.end());
+  }
+
+  void mkdirs(const std::string& path) {
+    if (path.empty()) {
+      throwError(ENOENT, "mkdir", path);
+    }
+    if (::mkdir(path.c_str(), 0777) == 0) {
+      return;
+    }
+    if (errno == ENOENT) {
+      std::string parent = dirname(path);
+      if (!parent.empty() && parent != path) {
+        mkdirs(parent);
+        if (::mkdir(path.c_str(), 0777) == 0 || errno == EEXIST) {
+          return;
+        }
+      }
+      throwErrno("mkdir", path);
+    }
+    if (errno != EEXIST) {
+      throwErrno("mkdir", path);
+    }
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+      throwErrno("stat", path);
+    }
+    if (!S_ISDIR(st.st_mode)) {
+      throwError(ENOTDIR, "mkdir", path);
+    }
+  }
+
+  std::vector<DirEntry> readdir(const std::string& path, DirDetail detail) {
+    UniqueDir dir(::opendir(path.c_str()));
+    if (dir == nullptr) {
+      throwErrno("opendir", path);
+    }
+
+    std::vector<DirEntry> entries;
+    while (true) {
+      errno = 0;
+      struct dirent* entry = ::readdir(dir.get());
+      if (entry == nullptr) {
+        if (errno != 0) {
+          throwErrno("readdir", path);
+        }
+        break;
+      }
+      if (isDotOrDotDot(entry->d_name)) {
+        continue;
+      }
+      DirEntry result{entry->d_name, join(path, entry->d_name), toFileType(entry->d_type), std::nullopt};
+      if (detail == DirDetail::Stats || (detail == DirDetail::Types && result.type == FileType::Unknown)) {
+        // Relative to the open directory, so the kernel doesn't walk `path` again for every entry.
+        struct stat st {};
+        if (::fstatat(::dirfd(dir.get()), entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+          if (errno == ENOENT) {
+            continue;
+          }
+          throwErrno("fstatat", result.path);
+        }
+        result.type = toFileType(st);
+        if (detail == DirDetail::Stats) {
+          result.stat = toFileStat(st);
+        }
+      }
+      entries.push_back(std::move(result));
+    }
+    return entries;
+  }
+
+  void rename(const std::string& oldPath, const std::string& newPath) {
+    if (::rename(oldPath.c_str(), newPath.c_str()) != 0) {
+      throwErrno("rename", oldPath);
+    }
+  }
+
+  bool removeAll(const std::string& path) {
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) != 0) {
+      if (errno == ENOENT) {
+        return false;
+      }
+      throwErrno("lstat", path);
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+      for (const auto& entry : readdir(path)) {
+        removeAll(entry.path);
+      }
+      if (::rmdir(path.c_str()) != 0) {
+        throwErrno("rmdir", path);
+      }
+    } else if (::unlink(path.c_str()) != 0) {
+      throwErrno("unlink", path);
+    }
+    return true;
+  }
+
+  std::string readFile(const std::string& path) {
+    return readWholeFile<std::string>(path);
+  }
+
+  ByteBuffer readFileBytes(const std::string& path) {
+    return readWholeFile<ByteBuffer>(path);
+  }
+
+  std::string readFileBase64(const std::string& path) {
+    struct stat st {};
+    UniqueFd fd = openForReading(path, st);
+
+    std::string output;
+    output.reserve(base64::encodedLength(static_cast<size_t>(st.st_size)));
+    ByteBuffer chunk(kBase64ChunkSize);
+    while (true) {
+      size_t length = readFully(fd.get(), chunk.data(), chunk.size(), path);
+      size_t offset = output.size();
+      output.resize(offset + base64::encodedLength(length));
+      base64::encode(chunk.data(), length, output.data() + offset);
+      if (length < chunk.size()) {
+        break;
+      }
+    }
+    return output;
+  }
+
+  std::string readFile(const std::string& path, CompressionFormat decompress) {
+    return readDecompressed<std::string>(path, decompress);
+  }
+
+  ByteBuffer readFileBytes(const std::string& path, CompressionFormat decompress) {
+    return readDecompressed<ByteBuffer>(path, decompress);
+  }
+
+  std::string readFileBase64(const std::string& path, CompressionFormat decompress) {
+    ByteBuffer bytes = readDecompressed<ByteBuffer>(path, decompress);
+    std::string output(base64::encodedLength(bytes.size()), '\0');
+    base64::encode(bytes.data(), bytes.size(), output.data());
+    return output;
+  }
+
+  void writeFile(const std::string& path, std::string_view data, const WriteOptions& options) {
+    FileOutput output(path, options, data.size(), true);
+    output.write(data.data(), data.size());
+    output.commit();
+  }
+
+  void writeFileBase64(const std::string& path, std::string_view data, const WriteOptions& options) {
+    if (!options.atomic) {
+      // The file is truncated when it is opened, so a bad payload must fail before that.
+      base64::validate(data);
+    }
+    FileOutput output(path, options, base64::Decoder::maxDecodedLength(data.size()), false);
+    base64::Decoder decoder;
+    size_t chunkSize = std::min(data.size(), kBase64ChunkSize);
+    ByteBuffer chunk(base64::Decoder::maxDecodedLength(chunkSize));
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize) {
+      size_t length = decoder.update(data.substr(offset, chunkSize), chunk.data());
+      output.write(chunk.data(), length);
+    }
+    decoder.finish();
+    output.commit();
+  }
+
+  void appendFile(const std::string& path, std::string_view data, SyncMode sync) {
+    ensureParentDirectory(path);
+    UniqueFd fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666));
+    if (!fd) {
+      throwErrno("open", path);
+    }
+    writeFully(fd.get(), data.data(), data.size(), path);
+    syncFile(fd.get(), sync, path);
+  }
+
+  uint64_t compressFile(const std::string& srcPath, const std::string& destPath, const CompressionOptions& compression,
+                        WriteOptions options) {
+    struct stat st {};
+    UniqueFd input = openForReading(srcPath, st);
+    options.compression = compression;
+    // The source may still grow (e.g. a log), so its size is only a hint for zstd.
+    FileOutput output(destPath, options, static_cast<uint64_t>(st.st_size), false);
+    ByteBuffer chunk(kCompressedChunkSize);
+    while (true) {
+      size_t length = readFully(input.get(), chunk.data(), chunk.size(), srcPath);
+      output.write(chunk.data(), length);
+      if (length < chunk.size()) {
+        break;
+      }
+    }
+    output.commit();
+    return output.size();
+  }
+
+  uint64_t decompressFile(const std::string& srcPath, const std::string& destPath, std::optional<CompressionFormat> format,
+                          WriteOptions options) {
+    struct stat st {};
+    UniqueFd input = openForReading(srcPath, st);
+    ByteBuffer chunk(kCompressedChunkSize);
+    size_t length = readFully(input.get(), chunk.data(), chunk.size(), srcPath);
+    if (!format.has_value()) {
+      format = detectCompression(chunk.data(), length);
+      if (!format.has_value()) {
+        throw std::invalid_argument("decompress(" + srcPath + "): not gzip, deflate or zstd data");
+      }
+    }
+    Decompressor decompressor(*format);
+    options.compression.reset();
+    FileOutput output(destPath, options, 0, false);
+    try {
+      while (true) {
+        decompressor.update(chunk.data(), length, [&](const uint8_t* data, size_t size) { output.write(data, size); });
+        if (length < chunk.size()) {
+          break;
+        }
+        length = readFully(input.get(), chunk.data(), chunk.size(), srcPath);
+      }
+      decompressor.finish();
+    } catch (const std::invalid_argument& error) {
+      throw std::invalid_argument("decompress(" + srcPath + "): " + error.what());
+    }
+    output.commit();
+    return output.size();
+  }
+
+  void copyFile(const std::string& srcPath, const std::string& destPath, bool overwrite) {
+    // O_NONBLOCK, so that opening a FIFO without a writer fails the type check below instead of hanging.
+    UniqueFd src(::open(srcPath.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC));
+    if (!src) {
+      throwErrno("open", srcPath);
+    }
+    struct stat st {};
+    if (::fstat(src.get(), &st) != 0) {
+      throwErrno("fstat", srcPath);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "copyFile", srcPath);
+    }
+    if (!S_ISREG(st.st_mode)) {
+      throwError(ENOTSUP, "copyFile", srcPath);
+    }
+    ::fcntl(src.get(), F_SETFL, ::fcntl(src.get(), F_GETFL) & ~O_NONBLOCK);
+    // Opening the destination with O_TRUNC would wipe the source if both are the same file,
+    // whether by the same path, a `..` detour or a hard link.
+    struct stat destSt {};
+    if (::stat(destPath.c_str(), &destSt) == 0 && destSt.st_dev == st.st_dev && destSt.st_ino == st.st_ino) {
+      throwError(EINVAL, "copyFile", destPath);
+    }
+
+    ensureParentDirectory(destPath);
+    if (cloneToNewFile(src.get(), destPath)) {
+      return;
+    }
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (overwrite ? O_TRUNC : O_EXCL);
+    UniqueFd dest(::open(destPath.c_str(), flags, st.st_mode & 0777));
+    if (!dest) {
+      throwErrno("open", destPath);
+    }
+    copyFileData(src.get(), dest.get(), static_cast<uint64_t>(st.st_size), srcPath, destPath);
+
+    // Best effort, like `cp -p`: filesystems such as FAT or FUSE-backed storage may refuse either call.
+    ::fchmod(dest.get(), st.st_mode & 07777);
+#ifdef __APPLE__
+    struct timespec times[2] = {st.st_atimespec, st.st_mtimespec};
+#else
+    struct timespec times[2] = {st.st_atim, st.st_mtim};
+#endif
+    ::futimens(dest.get(), times);
+  }
+
+  void copySymlink(const std::string& srcPath, const std::string& destPath, bool overwrite) {
+    std::string target(PATH_MAX, '\0');
+    ssize_t length = ::readlink(srcPath.c_str(), target.data(), target.size());
+    if (length < 0) {
+      throwErrno("readlink", srcPath);
+    }
+    target.resize(static_cast<size_t>(length));
+    if (overwrite) {
+      ::unlink(destPath.c_str());
+    }
+    if (::symlink(target.c_str(), destPath.c_str()) != 0) {
+      throwErrno("symlink", destPath);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
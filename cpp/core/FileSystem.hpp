@@ -0,0 +1,204 @@
+//
+//  FileSystem.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "ByteBuffer.hpp"
+#include "Compression.hpp"
+#include "FileIO.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * The subset of `stat(2)` that `NitroFileStat` exposes, plus the space actually allocated on disk, the mode and
+   * what identifies the file on disk. Timestamps are milliseconds since the epoch.
+   */
+  struct FileStat {
+    uint64_t size = 0;
+    uint64_t allocatedSize = 0;
+    /** `st_mode`: the file type and permission bits. */
+    uint32_t mode = 0;
+    /** `st_dev` and `st_ino`: the same pair is the same file, whatever the path. */
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    /** `st_nlink`: the number of hard links. */
+    uint64_t linkCount = 0;
+    double ctime = 0;
+    double mtime = 0;
+    bool isFile = false;
+    bool isDirectory = false;
+  };
+
+  /**
+   * One entry of `statMany`: `error` is 0 on success, otherwise the `errno` of the failed `stat`.
+   */
+  struct StatResult {
+    FileStat stat;
+    int error = 0;
+  };
+
+  enum class FileType {
+    Unknown,
+    File,
+    Directory,
+    Symlink,
+    Other,
+  };
+
+  /**
+   * How much `readdir` finds out about each entry.
+   */
+  enum class DirDetail {
+    /** Only names and paths; `type` is whatever `d_type` says, which may be `Unknown`. */
+    Names,
+    /** Like `Names`, but an `Unknown` type is resolved with `fstatat`. */
+    Types,
+    /** Every entry is `fstatat`'ed (without following symlinks) and gets a `stat`. */
+    Stats,
+  };
+
+  struct DirEntry {
+    std::string name;
+    std::string path;
+    FileType type = FileType::Unknown;
+    std::optional<FileStat> stat;
+  };
+
+  /**
+   * Local-filesystem operations backing `HybridNitroFS`.
+   * All paths are plain POSIX paths (see `toLocalPath`), and every failure
+   * is reported as a `std::system_error` carrying the `errno`.
+   */
+
+  bool exists(const std::string& path);
+
+  FileStat stat(const std::string& path);
+
+  /**
+   * `stat` for a whole batch of paths. Failures are reported per path instead of thrown.
+   * Consecutive paths in the same directory are resolved relative to one directory fd (`fstatat`),
+   * and large batches are split across threads.
+   */
+  std::vector<StatResult> statMany(const std::vector<std::string>& paths);
+
+  /**
+   * `exists` for a whole batch of paths, resolved like `statMany`.
+   */
+  std::vector<bool> existsMany(const std::vector<std::string>& paths);
+
+  /**
+   * Creates `path` and any missing parents. Succeeds if it already is a directory.
+   */
+  void mkdirs(const std::string& path);
+
+  /**
+   * Lists a directory without `.` and `..`. Entries that disappear while being stat'ed are skipped.
+   */
+  std::vector<DirEntry> readdir(const std::string& path, DirDetail detail = DirDetail::Names);
+
+  void rename(const std::string& oldPath, const std::string& newPath);
+
+  /**
+   * Removes a file, symlink or whole directory tree.
+   * Returns `false` if nothing existed at `path`.
+   */
+  bool removeAll(const std::string& path);
+
+  /**
+   * Reads the whole file in one pass, sized from `fstat`.
+   */
+  std::string readFile(const std::string& path);
+
+  /**
+   * Like `readFile`, but into an uninitialised buffer that can be handed off without copying.
+   */
+  ByteBuffer readFileBytes(const std::string& path);
+
+  /**
+   * Reads a file as base64. The file is encoded chunk by chunk straight into the result,
+   * so the raw bytes are never held in memory all at once.
+   */
+  std::string readFileBase64(const std::string& path);
+
+  /**
+   * `readFile`, `readFileBytes` and `readFileBase64` for a compressed file: the file is decompressed while it is read,
+   * so only the decompressed contents are held in memory. Corrupt data throws `std::invalid_argument`.
+   */
+  std::string readFile(const std::string& path, CompressionFormat decompress);
+  ByteBuffer readFileBytes(const std::string& path, CompressionFormat decompress);
+  std::string readFileBase64(const std::string& path, CompressionFormat decompress);
+
+  struct WriteOptions {
+    /**
+     * Write to a temporary file in the same directory and `rename` it over `path`, so readers
+     * (and a crash) only ever see the old or the new contents. A symlink at `path` is replaced, not followed.
+     */
+    bool atomic = false;
+    /**
+     * How the file is flushed before the write returns. For atomic writes the parent directory
+     * is synced after the rename as well, so the new name survives a power loss.
+     */
+    SyncMode sync = SyncMode::None;
+    /**
+     * Reserve the final size before writing.
+     */
+    bool preallocate = false;
+    /**
+     * Compress the data on its way to disk. `preallocate` is ignored then, as the compressed size isn't known up front.
+     */
+    std::optional<CompressionOptions> compression;
+  };
+
+  /**
+   * Creates or truncates `path` (and its parent directories) and writes `data` to it.
+   */
+  void writeFile(const std::string& path, std::string_view data, const WriteOptions& options = {});
+
+  /**
+   * Like `writeFile`, but decodes base64 `data` chunk by chunk while writing.
+   * Throws `std::invalid_argument` on invalid base64, leaving an existing file untouched.
+   */
+  void writeFileBase64(const std::string& path, std::string_view data, const WriteOptions& options = {});
+
+  /**
+   * Appends `data` to `path` with a single `write`, creating the file and its parent directories if needed.
+   */
+  void appendFile(const std::string& path, std::string_view data, SyncMode sync = SyncMode::None);
+
+  /**
+   * Compresses `srcPath` into `destPath` in fixed-size chunks. `options.compression` is replaced by `compression`.
+   * Returns the size of the compressed file.
+   */
+  uint64_t compressFile(const std::string& srcPath, const std::string& destPath, const CompressionOptions& compression,
+                        WriteOptions options = {});
+
+  /**
+   * Decompresses `srcPath` into `destPath` in fixed-size chunks, detecting the format from the first bytes if `format`
+   * is empty. Returns the size of the decompressed file.
+   */
+  uint64_t decompressFile(const std::string& srcPath, const std::string& destPath, std::optional<CompressionFormat> format,
+                          WriteOptions options = {});
+
+  /**
+   * Copies a single file, creating the parent directories of `destPath`.
+   * An existing `destPath` is overwritten, or fails with `EEXIST` if `overwrite` is false.
+   * Fails with `EINVAL` if `destPath` is the source file itself, and with `ENOTSUP` if the source is not
+   * a regular file (a FIFO, socket or device node).
+   */
+  void copyFile(const std::string& srcPath, const std::string& destPath, bool overwrite = true);
+
+  /**
+   * Creates a symlink at `destPath` with the same target as the one at `srcPath`.
+   */
+  void copySymlink(const std::string& srcPath, const std::string& destPath, bool overwrite = true);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,242 @@
+//
+//  FileWriter.cpp
+//  NitroFS
+//
+
+#include "FileWriter.hpp"
+#include "Errors.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Shared with the I/O thread, which keeps it alive until it has drained the buffer.
+   * Byte counts are positions in the stream of appended data: everything before `written`
+   * was handed to `write`, everything before `synced` is durable.
+   */
+  struct FileWriter::State {
+    std::string path;
+    FileWriterOptions options;
+    UniqueFd fd;
+    // Only used by the I/O thread.
+    std::unique_ptr<Compressor> compressor;
+
+    std::mutex mutex;
+    // Wakes the I/O thread.
+    std::condition_variable wake;
+    // Wakes `flush()`, `close()` and `append()` callers held back by `highWaterMark`.
+    std::condition_variable done;
+
+    std::string buffer;
+    std::chrono::steady_clock::time_point firstPendingAt;
+    uint64_t appended = 0;
+    uint64_t written = 0;
+    uint64_t syncRequested = 0;
+    uint64_t synced = 0;
+    std::exception_ptr error;
+    bool closing = false;
+    bool finished = false;
+
+    bool isDue() const {
+      return closing || buffer.size() >= options.bufferSize || syncRequested > synced;
+    }
+  };
+
+  void FileWriter::run(const std::shared_ptr<State>& state) {
+    // The two buffers trade places on every write, so appends keep going while one is on its way to disk.
+    std::string pending;
+    std::string compressed;
+    std::unique_lock lock(state->mutex);
+    while (true) {
+      if (!state->isDue()) {
+        if (state->buffer.empty()) {
+          state->wake.wait(lock, [&]() { return state->isDue() || !state->buffer.empty(); });
+          continue;
+        }
+        state->wake.wait_until(lock, state->firstPendingAt + state->options.flushInterval, [&]() { return state->isDue(); });
+      }
+
+      pending.swap(state->buffer);
+      uint64_t end = state->written + pending.size();
+      bool closing = state->closing;
+      bool sync = closing || state->syncRequested > state->synced;
+      lock.unlock();
+
+      std::exception_ptr error;
+      try {
+        // Every write-out flushes the compressor, so an empty one has nothing to add before the trailer.
+        if (state->compressor && (closing || !pending.empty())) {
+          auto sink = [&](const uint8_t* data, size_t size) { compressed.append(reinterpret_cast<const char*>(data), size); };
+          state->compressor->update(pending.data(), pending.size(), sink);
+          if (closing) {
+            state->compressor->finish(sink);
+          } else {
+            state->compressor->flush(sink);
+          }
+          writeFully(state->fd.get(), compressed.data(), compressed.size(), state->path);
+          compressed.clear();
+        } else if (!state->compressor) {
+          writeFully(state->fd.get(), pending.data(), pending.size(), state->path);
+        }
+        if (sync) {
+          syncFile(state->fd.get(), state->options.sync, state->path);
+        }
+        if (closing && ::close(state->fd.release()) != 0 && errno != EINTR) {
+          throwErrno("close", state->path);
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+      pending.clear();
+
+      lock.lock();
+      state->written = end;
+      if (error) {
+        state->error = error;
+      } else if (sync) {
+        // Everything appended up to the swap was in `pending`, so every flush waiting so far is covered.
+        state->synced = end;
+      }
+      if (error || closing) {
+        state->finished = true;
+        state->done.notify_all();
+        return;
+      }
+      state->done.notify_all();
+    }
+  }
+
+  std::shared_ptr<FileWriter> FileWriter::open(const std::string& path, const FileWriterOptions& options) {
+    std::unique_ptr<Compressor> compressor;
+    if (options.compression.has_value()) {
+      compressor = std::make_unique<Compressor>(*options.compression);
+    }
+    std::string parent = dirname(path);
+    if (!parent.empty()) {
+      mkdirs(parent);
+    }
+    UniqueFd fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666));
+    if (!fd) {
+      throwErrno("open", path);
+    }
+    if (options.compression.has_value() && options.compression->format == CompressionFormat::Deflate) {
+      struct stat st {};
+      if (::fstat(fd.get(), &st) != 0) {
+        throwErrno("fstat", path);
+      }
+      if (st.st_size > 0) {
+        throw std::invalid_argument("A deflate stream can't be appended to " + path + ", use gzip or zstd");
+      }
+    }
+    auto state = std::make_shared<State>();
+    state->path = path;
+    state->options = options;
+    state->options.bufferSize = std::max<size_t>(1, options.bufferSize);
+    state->options.highWaterMark = std::max(state->options.bufferSize, options.highWaterMark);
+    state->fd = std::move(fd);
+    state->compressor = std::move(compressor);
+    state->buffer.reserve(state->options.bufferSize);
+    return std::shared_ptr<FileWriter>(new FileWriter(std::move(state)));
+  }
+
+  FileWriter::FileWriter(std::shared_ptr<State> state): _state(std::move(state)) {
+    _thread = std::thread([state = _state]() { run(state); });
+  }
+
+  FileWriter::~FileWriter() {
+    {
+      std::lock_guard lock(_state->mutex);
+      _state->closing = true;
+    }
+    _state->wake.notify_one();
+    // Don't block whoever dropped the last reference on disk I/O; the thread owns the state.
+    if (_thread.joinable()) {
+      _thread.detach();
+    }
+  }
+
+  const std::string& FileWriter::path() const noexcept {
+    return _state->path;
+  }
+
+  void FileWriter::append(const void* data, size_t size) {
+    std::unique_lock lock(_state->mutex);
+    if (_state->error) {
+      std::rethrow_exception(_state->error);
+    }
+    if (_state->closing) {
+      throwError(EBADF, "append", _state->path);
+    }
+    if (_state->appended - _state->written >= _state->options.highWaterMark) {
+      // Whatever isn't written yet is either on its way to disk or past `bufferSize`, so the I/O thread is already on it.
+      _state->done.wait(lock, [&]() {
+        return _state->appended - _state->written < _state->options.highWaterMark || _state->error || _state->closing;
+      });
+      if (_state->error) {
+        std::rethrow_exception(_state->error);
+      }
+      if (_state->closing) {
+        throwError(EBADF, "append", _state->path);
+      }
+    }
+    bool wasEmpty = _state->buffer.empty();
+    if (wasEmpty) {
+      _state->firstPendingAt = std::chrono::steady_clock::now();
+    }
+    _state->buffer.append(static_cast<const char*>(data), size);
+    _state->appended += size;
+    // The I/O thread only needs to know when to start its timer, or that the buffer is full.
+    if (wasEmpty || _state->buffer.size() >= _state->options.bufferSize) {
+      lock.unlock();
+      _state->wake.notify_one();
+    }
+  }
+
+  void FileWriter::flush() {
+    std::unique_lock lock(_state->mutex);
+    if (_state->error) {
+      std::rethrow_exception(_state->error);
+    }
+    uint64_t target = _state->appended;
+    if (_state->synced >= target) {
+      return;
+    }
+    _state->syncRequested = std::max(_state->syncRequested, target);
+    _state->wake.notify_one();
+    _state->done.wait(lock, [&]() { return _state->synced >= target || _state->finished; });
+    if (_state->error) {
+      std::rethrow_exception(_state->error);
+    }
+  }
+
+  void FileWriter::close() {
+    {
+      std::lock_guard lock(_state->mutex);
+      _state->closing = true;
+    }
+    _state->wake.notify_one();
+    {
+      std::lock_guard lock(_threadMutex);
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+    std::lock_guard lock(_state->mutex);
+    if (_state->error) {
+      std::rethrow_exception(_state->error);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
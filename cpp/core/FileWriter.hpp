@@ -0,0 +1,93 @@
+//
+//  FileWriter.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "Compression.hpp"
+#include "FileIO.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct FileWriterOptions {
+    /** Once this many bytes are buffered, they are written out right away. */
+    size_t bufferSize = 64 * 1024;
+    /** The longest appended data waits in the buffer before it is written. */
+    std::chrono::milliseconds flushInterval{1000};
+    /**
+     * Once this many appended bytes are not yet written, `append` blocks until the I/O thread catches up,
+     * so a producer that outpaces the disk can't grow the buffers without bound. At least `bufferSize`.
+     */
+    size_t highWaterMark = 8 * 1024 * 1024;
+    /** How `flush()` and `close()` sync the file. Writes triggered by size or time are never synced. */
+    SyncMode sync = SyncMode::Data;
+    /**
+     * Compress everything appended. Each write-out is flushed through the compressor, so the file always
+     * decompresses up to the last write. Every writer adds a gzip member or zstd frame of its own, which
+     * decompress as one stream; deflate streams can't be continued, so deflate needs an empty file.
+     */
+    std::optional<CompressionOptions> compression;
+  };
+
+  /**
+   * Appends to a file through an in-memory buffer. A dedicated I/O thread writes the buffer out
+   * when it reaches `bufferSize` or its oldest byte is `flushInterval` old, so `append` never
+   * touches the disk; it only waits when the disk falls `highWaterMark` bytes behind.
+   * Concurrent `flush()` calls share a single sync (group commit).
+   *
+   * All methods are thread-safe. If a background write fails, the writer stops and every later
+   * call throws that error. A writer destroyed without `close()` still writes out and syncs its
+   * buffer on the I/O thread, but nobody waits for it.
+   */
+  class FileWriter {
+  public:
+    /**
+     * Opens `path` for appending, creating it and its parent directories if needed.
+     */
+    static std::shared_ptr<FileWriter> open(const std::string& path, const FileWriterOptions& options);
+
+    ~FileWriter();
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    const std::string& path() const noexcept;
+
+    /**
+     * Copies `data` into the buffer, first waiting for the I/O thread if `highWaterMark` bytes are
+     * still unwritten. Fails with `EBADF` after `close()`.
+     */
+    void append(const void* data, size_t size);
+
+    /**
+     * Blocks until everything appended before the call is written and synced.
+     */
+    void flush();
+
+    /**
+     * Writes out and syncs the buffer, then closes the file. Later calls do nothing.
+     */
+    void close();
+
+  private:
+    struct State;
+    explicit FileWriter(std::shared_ptr<State> state);
+
+    /** The I/O thread. */
+    static void run(const std::shared_ptr<State>& state);
+
+  private:
+    std::shared_ptr<State> _state;
+    std::mutex _threadMutex;
+    std::thread _thread;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
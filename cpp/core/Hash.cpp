@@ -0,0 +1,794 @@
+//
+//  Hash.cpp
+//  NitroFS
+//
+//  Streaming SHA-256, CRC-32C, XXH3-64 and BLAKE3 over the kernels in HashKernels.hpp.
+//  The portable kernels live here; HashSimd.cpp has the hardware ones.
+//
+
+#include "Hash.hpp"
+#include "ByteBuffer.hpp"
+#include "Errors.hpp"
+#include "FileIO.hpp"
+#include "HashKernels.hpp"
+#include "Parallel.hpp"
+#include "UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    using hash::detail::Kernels;
+
+    constexpr size_t kReadSize = 1024 * 1024;
+
+    inline uint32_t rotr32(uint32_t value, int bits) {
+      return (value >> bits) | (value << (32 - bits));
+    }
+
+    inline uint64_t rotl64(uint64_t value, int bits) {
+      return (value << bits) | (value >> (64 - bits));
+    }
+
+    inline uint32_t loadLe32(const uint8_t* p) {
+      return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 |
+             static_cast<uint32_t>(p[3]) << 24;
+    }
+
+    inline uint64_t loadLe64(const uint8_t* p) {
+      return static_cast<uint64_t>(loadLe32(p)) | static_cast<uint64_t>(loadLe32(p + 4)) << 32;
+    }
+
+    inline uint32_t loadBe32(const uint8_t* p) {
+      return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 | static_cast<uint32_t>(p[2]) << 8 |
+             static_cast<uint32_t>(p[3]);
+    }
+
+    inline void storeLe32(uint8_t* p, uint32_t value) {
+      for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+      }
+    }
+
+    /** `bytes` big-endian bytes of `value` as hex. */
+    std::string toHex(uint64_t value, int bytes) {
+      static const char kDigits[] = "0123456789abcdef";
+      std::string hex(static_cast<size_t>(bytes) * 2, '0');
+      for (int i = bytes * 2 - 1; i >= 0; i--, value >>= 4) {
+        hex[static_cast<size_t>(i)] = kDigits[value & 0xF];
+      }
+      return hex;
+    }
+
+    std::string toHex(const uint32_t* words, size_t count) {
+      std::string hex;
+      hex.reserve(count * 8);
+      for (size_t i = 0; i < count; i++) {
+        hex += toHex(words[i], 4);
+      }
+      return hex;
+    }
+
+    void sha256Scalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+      const auto& k = hash::detail::kSha256RoundConstants;
+      for (; blocks > 0; blocks--, data += 64) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+          w[i] = loadBe32(data + 4 * i);
+        }
+        for (int i = 16; i < 64; i++) {
+          uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+          uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+          w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; i++) {
+          uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+          uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+          h = g;
+          g = f;
+          f = e;
+          e = d + t1;
+          d = c;
+          c = b;
+          b = a;
+          a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+      }
+    }
+
+    class Sha256 {
+    public:
+      void update(const uint8_t* data, size_t size) {
+        const Kernels& kernels = hash::detail::activeKernels();
+        _length += size;
+        if (_buffered > 0) {
+          size_t take = std::min(size, sizeof(_buffer) - _buffered);
+          std::memcpy(_buffer + _buffered, data, take);
+          _buffered += take;
+          data += take;
+          size -= take;
+          if (_buffered < sizeof(_buffer)) {
+            return;
+          }
+          kernels.sha256(_state, _buffer, 1);
+          _buffered = 0;
+        }
+        size_t blocks = size / 64;
+        if (blocks > 0) {
+          kernels.sha256(_state, data, blocks);
+        }
+        std::memcpy(_buffer, data + blocks * 64, size - blocks * 64);
+        _buffered = size - blocks * 64;
+      }
+
+      std::string hexDigest() {
+        uint64_t bits = _length * 8;
+        // A 1 bit, zeros up to 8 bytes before a block boundary, then the message length in bits.
+        uint8_t padding[72] = {0x80};
+        size_t zeros = (_buffered < 56 ? 56 : 120) - _buffered;
+        for (int i = 0; i < 8; i++) {
+          padding[zeros + static_cast<size_t>(i)] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        }
+        update(padding, zeros + 8);
+        return toHex(_state, 8);
+      }
+
+    private:
+      uint32_t _state[8] = {
+        hash::detail::kSha256Initial[0], hash::detail::kSha256Initial[1], hash::detail::kSha256Initial[2],
+        hash::detail::kSha256Initial[3], hash::detail::kSha256Initial[4], hash::detail::kSha256Initial[5],
+        hash::detail::kSha256Initial[6], hash::detail::kSha256Initial[7],
+      };
+      uint8_t _buffer[64];
+      size_t _buffered = 0;
+      uint64_t _length = 0;
+    };
+
+    struct Crc32cTables {
+      uint32_t table[8][256];
+    };
+
+    // Slicing-by-8 tables for the reflected Castagnoli polynomial.
+    constexpr Crc32cTables makeCrc32cTables() {
+      Crc32cTables tables{};
+      for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+          crc = (crc >> 1) ^ (0x82f63b78 & (0u - (crc & 1)));
+        }
+        tables.table[0][i] = crc;
+      }
+      for (uint32_t i = 0; i < 256; i++) {
+        for (int slice = 1; slice < 8; slice++) {
+          uint32_t previous = tables.table[slice - 1][i];
+          tables.table[slice][i] = (previous >> 8) ^ tables.table[0][previous & 0xFF];
+        }
+      }
+      return tables;
+    }
+
+    constexpr Crc32cTables kCrc32cTables = makeCrc32cTables();
+
+    uint32_t crc32cScalar(uint32_t crc, const uint8_t* data, size_t size) {
+      const auto& t = kCrc32cTables.table;
+      for (; size >= 8; size -= 8, data += 8) {
+        uint32_t low = loadLe32(data) ^ crc;
+        uint32_t high = loadLe32(data + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+      }
+      for (; size > 0; size--, data++) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+      }
+      return crc;
+    }
+
+    class Crc32c {
+    public:
+      void update(const uint8_t* data, size_t size) {
+        _crc = hash::detail::activeKernels().crc32c(_crc, data, size);
+      }
+
+      std::string hexDigest() const {
+        return toHex(_crc ^ 0xFFFFFFFF, 4);
+      }
+
+    private:
+      uint32_t _crc = 0xFFFFFFFF;
+    };
+
+    constexpr uint32_t kPrime32_2 = 0x85ebca77;
+    constexpr uint32_t kPrime32_3 = 0xc2b2ae3d;
+    constexpr uint64_t kPrime64_1 = 0x9e3779b185ebca87;
+    constexpr uint64_t kPrime64_2 = 0xc2b2ae3d27d4eb4f;
+    constexpr uint64_t kPrime64_3 = 0x165667b19e3779f9;
+    constexpr uint64_t kPrime64_4 = 0x85ebca77c2b2ae63;
+    constexpr uint64_t kPrime64_5 = 0x27d4eb2f165667c5;
+
+    constexpr size_t kXxh3SecretSize = 192;
+    constexpr size_t kXxh3StripesPerBlock = (kXxh3SecretSize - 64) / 8;
+
+    // The default secret from the reference implementation.
+    alignas(64) constexpr uint8_t kXxh3Secret[kXxh3SecretSize] = {
+      0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+      0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+      0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+      0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+      0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+      0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+      0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+      0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+      0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+      0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+      0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+      0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+    };
+
+    /** The 128-bit product of `a` and `b`, with its halves xored together. */
+    inline uint64_t mul128Fold64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+      unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+      return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+      // 32-bit targets: schoolbook multiplication on 32-bit halves.
+      uint64_t lowLow = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+      uint64_t highLow = (a >> 32) * (b & 0xFFFFFFFF);
+      uint64_t lowHigh = (a & 0xFFFFFFFF) * (b >> 32);
+      uint64_t highHigh = (a >> 32) * (b >> 32);
+      uint64_t cross = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+      uint64_t upper = (highLow >> 32) + (cross >> 32) + highHigh;
+      uint64_t lower = (cross << 32) | (lowLow & 0xFFFFFFFF);
+      return lower ^ upper;
+#endif
+    }
+
+    inline uint64_t xxh64Avalanche(uint64_t hash) {
+      hash ^= hash >> 33;
+      hash *= kPrime64_2;
+      hash ^= hash >> 29;
+      hash *= kPrime64_3;
+      return hash ^ (hash >> 32);
+    }
+
+    inline uint64_t xxh3Avalanche(uint64_t hash) {
+      hash ^= hash >> 37;
+      hash *= 0x165667919e3779f9;
+      return hash ^ (hash >> 32);
+    }
+
+    inline uint64_t xxh3Mix16(const uint8_t* input, const uint8_t* secret) {
+      return mul128Fold64(loadLe64(input) ^ loadLe64(secret), loadLe64(input + 8) ^ loadLe64(secret + 8));
+    }
+
+    /** XXH3 of up to 240 bytes, which never touches the accumulators. */
+    uint64_t xxh3Short(const uint8_t* input, size_t length) {
+      const uint8_t* secret = kXxh3Secret;
+      if (length == 0) {
+        return xxh64Avalanche(loadLe64(secret + 56) ^ loadLe64(secret + 64));
+      }
+      if (length <= 3) {
+        uint32_t combined = static_cast<uint32_t>(input[0]) << 16 | static_cast<uint32_t>(input[length >> 1]) << 24 |
+                            static_cast<uint32_t>(input[length - 1]) | static_cast<uint32_t>(length) << 8;
+        return xxh64Avalanche(combined ^ static_cast<uint64_t>(loadLe32(secret) ^ loadLe32(secret + 4)));
+      }
+      if (length <= 8) {
+        uint64_t value = loadLe32(input + length - 4) + (static_cast<uint64_t>(loadLe32(input)) << 32);
+        uint64_t hash = value ^ (loadLe64(secret + 8) ^ loadLe64(secret + 16));
+        hash ^= rotl64(hash, 49) ^ rotl64(hash, 24);
+        hash *= 0x9fb21c651e98df25;
+        hash ^= (hash >> 35) + length;
+        hash *= 0x9fb21c651e98df25;
+        return hash ^ (hash >> 28);
+      }
+      if (length <= 16) {
+        uint64_t low = loadLe64(input) ^ (loadLe64(secret + 24) ^ loadLe64(secret + 32));
+        uint64_t high = loadLe64(input + length - 8) ^ (loadLe64(secret + 40) ^ loadLe64(secret + 48));
+        return xxh3Avalanche(length + __builtin_bswap64(low) + high + mul128Fold64(low, high));
+      }
+      uint64_t acc = length * kPrime64_1;
+      if (length <= 128) {
+        // Pairs of 16-byte lanes from both ends, meeting in the middle.
+        for (size_t i = 0; i < (length - 1) / 32 + 1; i++) {
+          acc += xxh3Mix16(input + 16 * i, secret + 32 * i);
+          acc += xxh3Mix16(input + length - 16 * (i + 1), secret + 32 * i + 16);
+        }
+        return xxh3Avalanche(acc);
+      }
+      for (size_t i = 0; i < 8; i++) {
+        acc += xxh3Mix16(input + 16 * i, secret + 16 * i);
+      }
+      uint64_t accEnd = xxh3Mix16(input + length - 16, secret + 136 - 17);
+      for (size_t i = 8; i < length / 16; i++) {
+        accEnd += xxh3Mix16(input + 16 * i, secret + 16 * (i - 8) + 3);
+      }
+      return xxh3Avalanche(xxh3Avalanche(acc) + accEnd);
+    }
+
+    void xxh3AccumulateScalar(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+      for (; stripes > 0; stripes--, data += 64, secret += 8) {
+        for (int i = 0; i < 8; i++) {
+          uint64_t value = loadLe64(data + 8 * i);
+          uint64_t key = value ^ loadLe64(secret + 8 * i);
+          acc[i ^ 1] += value;
+          acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+        }
+      }
+    }
+
+    void xxh3ScrambleScalar(uint64_t acc[8], const uint8_t* secret) {
+      for (int i = 0; i < 8; i++) {
+        uint64_t value = acc[i] ^ (acc[i] >> 47);
+        acc[i] = (value ^ loadLe64(secret + 8 * i)) * hash::detail::kXxh3Prime32;
+      }
+    }
+
+    /**
+     * XXH3 over a stream. The last stripe of the input is hashed differently from the others, so a stripe is only
+     * consumed once more data follows it, and the last 64 consumed bytes are kept in case the final stripe overlaps them.
+     */
+    class Xxh3 {
+    public:
+      void update(const uint8_t* data, size_t size) {
+        _length += size;
+        if (_buffered + size <= kBufferSize) {
+          std::memcpy(_buffer + _buffered, data, size);
+          _buffered += size;
+          return;
+        }
+        if (_buffered > 0) {
+          size_t fill = kBufferSize - _buffered;
+          std::memcpy(_buffer + _buffered, data, fill);
+          data += fill;
+          size -= fill;
+          consume(_buffer, kBufferSize / 64);
+          std::memcpy(_lastStripe, _buffer + kBufferSize - 64, 64);
+          _buffered = 0;
+        }
+        if (size > kBufferSize) {
+          size_t stripes = (size - 1) / 64;
+          consume(data, stripes);
+          std::memcpy(_lastStripe, data + stripes * 64 - 64, 64);
+          data += stripes * 64;
+          size -= stripes * 64;
+        }
+        std::memcpy(_buffer, data, size);
+        _buffered = size;
+      }
+
+      std::string hexDigest() {
+        if (_length <= 240) {
+          return toHex(xxh3Short(_buffer, _buffered), 8);
+        }
+        consume(_buffer, (_buffered - 1) / 64);
+        uint8_t lastStripe[64];
+        if (_buffered >= 64) {
+          std::memcpy(lastStripe, _buffer + _buffered - 64, 64);
+        } else {
+          std::memcpy(lastStripe, _lastStripe + _buffered, 64 - _buffered);
+          std::memcpy(lastStripe + 64 - _buffered, _buffer, _buffered);
+        }
+        hash::detail::activeKernels().xxh3Accumulate(_acc, lastStripe, kXxh3Secret + kXxh3SecretSize - 64 - 7, 1);
+
+        uint64_t hash = _length * kPrime64_1;
+        for (int i = 0; i < 4; i++) {
+          hash += mul128Fold64(_acc[2 * i] ^ loadLe64(kXxh3Secret + 11 + 16 * i),
+                               _acc[2 * i + 1] ^ loadLe64(kXxh3Secret + 11 + 16 * i + 8));
+        }
+        return toHex(xxh3Avalanche(hash), 8);
+      }
+
+    private:
+      // More than the 240 bytes hashed without accumulators, and a whole number of stripes.
+      static constexpr size_t kBufferSize = 256;
+
+      void consume(const uint8_t* data, size_t stripes) {
+        const Kernels& kernels = hash::detail::activeKernels();
+        while (stripes > 0) {
+          size_t count = std::min(stripes, kXxh3StripesPerBlock - _stripesInBlock);
+          kernels.xxh3Accumulate(_acc, data, kXxh3Secret + _stripesInBlock * 8, count);
+          _stripesInBlock += count;
+          data += count * 64;
+          stripes -= count;
+          if (_stripesInBlock == kXxh3StripesPerBlock) {
+            kernels.xxh3Scramble(_acc, kXxh3Secret + kXxh3SecretSize - 64);
+            _stripesInBlock = 0;
+          }
+        }
+      }
+
+      alignas(16) uint64_t _acc[8] = {kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+                                      kPrime64_4, kPrime32_2, kPrime64_5, hash::detail::kXxh3Prime32};
+      size_t _stripesInBlock = 0;
+      uint8_t _buffer[kBufferSize];
+      size_t _buffered = 0;
+      uint8_t _lastStripe[64];
+      uint64_t _length = 0;
+    };
+
+    constexpr size_t kBlake3ChunkSize = 1024;
+    constexpr uint8_t kChunkStart = 1 << 0;
+    constexpr uint8_t kChunkEnd = 1 << 1;
+    constexpr uint8_t kParent = 1 << 2;
+    constexpr uint8_t kRoot = 1 << 3;
+
+    inline void blake3G(uint32_t* v, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+      v[a] = v[a] + v[b] + x;
+      v[d] = rotr32(v[d] ^ v[a], 16);
+      v[c] = v[c] + v[d];
+      v[b] = rotr32(v[b] ^ v[c], 12);
+      v[a] = v[a] + v[b] + y;
+      v[d] = rotr32(v[d] ^ v[a], 8);
+      v[c] = v[c] + v[d];
+      v[b] = rotr32(v[b] ^ v[c], 7);
+    }
+
+    /** Compresses one block into the chaining value `cv`. */
+    void blake3Compress(uint32_t cv[8], const uint8_t block[64], uint32_t blockLength, uint64_t counter, uint8_t flags) {
+      uint32_t m[16];
+      for (int i = 0; i < 16; i++) {
+        m[i] = loadLe32(block + 4 * i);
+      }
+      const auto& iv = hash::detail::kBlake3Iv;
+      uint32_t v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        iv[0], iv[1], iv[2], iv[3], static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), blockLength, flags,
+      };
+      for (const auto& s : hash::detail::kBlake3Schedule) {
+        blake3G(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        blake3G(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        blake3G(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        blake3G(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        blake3G(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        blake3G(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        blake3G(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        blake3G(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+      }
+      for (int i = 0; i < 8; i++) {
+        cv[i] = v[i] ^ v[i + 8];
+      }
+    }
+
+    void blake3HashManyScalar(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8], uint64_t counter,
+                              bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+      for (size_t i = 0; i < count; i++, out += 32) {
+        uint32_t cv[8];
+        std::copy(key, key + 8, cv);
+        uint8_t blockFlags = flags | flagsStart;
+        for (size_t block = 0; block < blocks; block++) {
+          if (block + 1 == blocks) {
+            blockFlags |= flagsEnd;
+          }
+          blake3Compress(cv, inputs[i] + block * 64, 64, counter, blockFlags);
+          blockFlags = flags;
+        }
+        for (int word = 0; word < 8; word++) {
+          storeLe32(out + 4 * word, cv[word]);
+        }
+        if (incrementCounter) {
+          counter++;
+        }
+      }
+    }
+
+    using Blake3Cv = std::array<uint32_t, 8>;
+
+    Blake3Cv blake3Parent(const Blake3Cv& left, const Blake3Cv& right, uint8_t flags) {
+      uint8_t block[64];
+      for (int i = 0; i < 8; i++) {
+        storeLe32(block + 4 * i, left[static_cast<size_t>(i)]);
+        storeLe32(block + 32 + 4 * i, right[static_cast<size_t>(i)]);
+      }
+      Blake3Cv cv;
+      std::copy(std::begin(hash::detail::kBlake3Iv), std::end(hash::detail::kBlake3Iv), cv.begin());
+      blake3Compress(cv.data(), block, 64, 0, kParent | flags);
+      return cv;
+    }
+
+    /**
+     * BLAKE3 over a stream, following the reference implementation's incremental hasher: chunk chaining values go on a
+     * stack that is merged into parents as subtrees complete. A chunk is only finished once more data follows it, since
+     * the last one may be the root. Runs of whole chunks go through `blake3HashMany`, several at a time.
+     *
+     * A hasher can also cover one aligned subtree of a bigger input (`firstChunk`, `subtreeCv`), which is how
+     * `hashFile` spreads a large file over several threads.
+     */
+    class Blake3 {
+    public:
+      explicit Blake3(uint64_t firstChunk = 0): _chunkCounter(firstChunk) {
+        resetChunk();
+      }
+
+      void update(const uint8_t* data, size_t size) {
+        while (size > 0) {
+          if (chunkLength() == kBlake3ChunkSize) {
+            pushSubtree(finishChunk(0), 1);
+          }
+          if (chunkLength() == 0 && size > kBlake3ChunkSize) {
+            size_t chunks = std::min((size - 1) / kBlake3ChunkSize, kChunksPerBatch);
+            const uint8_t* inputs[kChunksPerBatch];
+            for (size_t i = 0; i < chunks; i++) {
+              inputs[i] = data + i * kBlake3ChunkSize;
+            }
+            uint8_t cvs[kChunksPerBatch * 32];
+            hash::detail::activeKernels().blake3HashMany(inputs, chunks, kBlake3ChunkSize / 64, hash::detail::kBlake3Iv, _chunkCounter,
+                                                         true, 0, kChunkStart, kChunkEnd, cvs);
+            for (size_t i = 0; i < chunks; i++) {
+              Blake3Cv cv;
+              for (size_t word = 0; word < 8; word++) {
+                cv[word] = loadLe32(cvs + 32 * i + 4 * word);
+              }
+              pushSubtree(cv, 1);
+            }
+            data += chunks * kBlake3ChunkSize;
+            size -= chunks * kBlake3ChunkSize;
+            continue;
+          }
+          if (_blockLength == 64) {
+            blake3Compress(_chunkCv.data(), _block, 64, _chunkCounter, startFlag());
+            _blocksCompressed++;
+            _blockLength = 0;
+          }
+          size_t take = std::min(size, 64 - _blockLength);
+          std::memcpy(_block + _blockLength, data, take);
+          _blockLength += take;
+          data += take;
+          size -= take;
+        }
+      }
+
+      /**
+       * Adds the chaining value of a whole subtree of `chunks` chunks (a power of two) that starts at the current chunk,
+       * which must be empty and aligned to `chunks`. More input must follow, since a subtree can't be the root.
+       */
+      void pushSubtree(Blake3Cv cv, uint64_t chunks) {
+        _chunkCounter += chunks;
+        // One stack entry per set bit of the chunk count; completing a subtree carries into its parents.
+        for (uint64_t total = _chunkCounter / chunks; (total & 1) == 0; total >>= 1) {
+          cv = blake3Parent(_stack.back(), cv, 0);
+          _stack.pop_back();
+        }
+        _stack.push_back(cv);
+        resetChunk();
+      }
+
+      /** The chaining value of everything hashed so far, as a subtree of a bigger input. */
+      Blake3Cv subtreeCv() {
+        Blake3Cv cv = finishChunk(0);
+        for (size_t i = _stack.size(); i > 0; i--) {
+          cv = blake3Parent(_stack[i - 1], cv, 0);
+        }
+        return cv;
+      }
+
+      std::string hexDigest() {
+        Blake3Cv cv;
+        if (_stack.empty()) {
+          cv = finishChunk(kRoot);
+        } else {
+          cv = finishChunk(0);
+          for (size_t i = _stack.size(); i > 1; i--) {
+            cv = blake3Parent(_stack[i - 1], cv, 0);
+          }
+          cv = blake3Parent(_stack.front(), cv, kRoot);
+        }
+        // The digest is the little-endian bytes of the chaining value.
+        for (auto& word : cv) {
+          word = __builtin_bswap32(word);
+        }
+        return toHex(cv.data(), cv.size());
+      }
+
+    private:
+      static constexpr size_t kChunksPerBatch = 16;
+
+      size_t chunkLength() const {
+        return _blocksCompressed * 64 + _blockLength;
+      }
+
+      uint8_t startFlag() const {
+        return _blocksCompressed == 0 ? kChunkStart : 0;
+      }
+
+      void resetChunk() {
+        std::copy(std::begin(hash::detail::kBlake3Iv), std::end(hash::detail::kBlake3Iv), _chunkCv.begin());
+        _blocksCompressed = 0;
+        _blockLength = 0;
+      }
+
+      Blake3Cv finishChunk(uint8_t flags) {
+        Blake3Cv cv = _chunkCv;
+        std::memset(_block + _blockLength, 0, 64 - _blockLength);
+        // A root chunk is compressed as output block 0, which is also the chunk counter of the only chunk that can be the root.
+        blake3Compress(cv.data(), _block, static_cast<uint32_t>(_blockLength), _chunkCounter, startFlag() | kChunkEnd | flags);
+        return cv;
+      }
+
+      std::vector<Blake3Cv> _stack;
+      uint64_t _chunkCounter;
+      Blake3Cv _chunkCv;
+      uint8_t _block[64];
+      size_t _blockLength = 0;
+      size_t _blocksCompressed = 0;
+    };
+
+    const Kernels kScalarKernels{"scalar", sha256Scalar, crc32cScalar, xxh3AccumulateScalar, xxh3ScrambleScalar, blake3HashManyScalar};
+
+    std::atomic<const Kernels*>& activeKernelsSlot() {
+      static std::atomic<const Kernels*> slot{hash::detail::availableKernels().front()};
+      return slot;
+    }
+
+    // 0 means `hardwareConcurrency()`.
+    std::atomic<size_t> blake3ThreadsOverride{0};
+
+    // Below this, or on a single core, BLAKE3 hashes the file on the calling thread.
+    constexpr uint64_t kParallelThreshold = 4 * 1024 * 1024;
+    // The smallest subtree handed to a thread.
+    constexpr uint64_t kMinSubtreeChunks = 256;
+
+    /** Feeds `length` bytes at `offset` (fewer if the file ends first) to `hasher`. */
+    template <typename Hasher>
+    void hashRange(int fd, const std::string& path, uint64_t offset, uint64_t length, Hasher& hasher) {
+      ByteBuffer block(static_cast<size_t>(std::min<uint64_t>(kReadSize, std::max<uint64_t>(1, length))));
+      while (length > 0) {
+        size_t size = preadFully(fd, block.data(), static_cast<size_t>(std::min<uint64_t>(block.size(), length)), offset, path);
+        if (size == 0) {
+          break;
+        }
+        hasher.update(block.data(), size);
+        offset += size;
+        length -= size;
+      }
+    }
+
+    /**
+     * Splits the range into equal, power-of-two-sized subtrees of the BLAKE3 tree, hashes all but the last one on
+     * separate threads, and finishes with the rest on the calling thread.
+     */
+    std::string hashBlake3Parallel(int fd, const std::string& path, uint64_t offset, uint64_t length, size_t threads) {
+      uint64_t chunks = (length + kBlake3ChunkSize - 1) / kBlake3ChunkSize;
+      // A few subtrees per thread, so threads that finish early can pick up more.
+      uint64_t subtreeChunks = std::max(kMinSubtreeChunks, std::bit_floor(chunks / (threads * 4)));
+      uint64_t subtreeSize = subtreeChunks * kBlake3ChunkSize;
+      // Every parallel subtree needs more data after it; the last one can be (part of) the root.
+      auto subtrees = static_cast<size_t>((length - 1) / subtreeSize);
+
+      std::vector<Blake3Cv> cvs(subtrees);
+      parallelFor(subtrees, threads, [&](size_t i) {
+        Blake3 hasher(i * subtreeChunks);
+        hashRange(fd, path, offset + i * subtreeSize, subtreeSize, hasher);
+        cvs[i] = hasher.subtreeCv();
+      });
+
+      Blake3 hasher;
+      for (const Blake3Cv& cv : cvs) {
+        hasher.pushSubtree(cv, subtreeChunks);
+      }
+      uint64_t done = subtrees * subtreeSize;
+      hashRange(fd, path, offset + done, length - done, hasher);
+      return hasher.hexDigest();
+    }
+
+    template <typename Hasher>
+    std::string hashFileWith(int fd, const std::string& path, uint64_t offset, uint64_t length) {
+      Hasher hasher;
+      hashRange(fd, path, offset, length, hasher);
+      return hasher.hexDigest();
+    }
+
+    template <typename Hasher>
+    std::string hashBytesWith(const void* data, size_t size) {
+      Hasher hasher;
+      hasher.update(static_cast<const uint8_t*>(data), size);
+      return hasher.hexDigest();
+    }
+  } // namespace
+
+  namespace hash::detail {
+    const Kernels& scalarKernels() {
+      return kScalarKernels;
+    }
+
+    std::vector<const Kernels*> availableKernels() {
+      std::vector<const Kernels*> kernels;
+      for (const Kernels* simd : {avx2Kernels(), sse42Kernels(), neonKernels()}) {
+        if (simd != nullptr) {
+          kernels.push_back(simd);
+        }
+      }
+      kernels.push_back(&kScalarKernels);
+      return kernels;
+    }
+
+    const Kernels& activeKernels() {
+      return *activeKernelsSlot().load(std::memory_order_relaxed);
+    }
+
+    void setActiveKernels(const Kernels& kernels) {
+      activeKernelsSlot().store(&kernels, std::memory_order_relaxed);
+    }
+
+    size_t blake3Threads() {
+      size_t threads = blake3ThreadsOverride.load(std::memory_order_relaxed);
+      return threads == 0 ? hardwareConcurrency() : threads;
+    }
+
+    void setBlake3Threads(size_t threads) {
+      blake3ThreadsOverride.store(threads, std::memory_order_relaxed);
+    }
+  } // namespace hash::detail
+
+  std::string hashFile(const std::string& path, HashAlgorithm algorithm, uint64_t offset, std::optional<uint64_t> length) {
+    UniqueFd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd) {
+      throwErrno("open", path);
+    }
+    struct stat st {};
+    if (::fstat(fd.get(), &st) != 0) {
+      throwErrno("fstat", path);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "open", path);
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    // Regular files are hashed up to the size they have now; anything else (e.g. a pipe) until EOF.
+    bool isRegular = S_ISREG(st.st_mode);
+    uint64_t end = isRegular ? static_cast<uint64_t>(st.st_size) : UINT64_MAX;
+    offset = std::min(offset, end);
+    uint64_t count = std::min(end - offset, length.value_or(UINT64_MAX));
+
+    switch (algorithm) {
+      case HashAlgorithm::Sha256:
+        return hashFileWith<Sha256>(fd.get(), path, offset, count);
+      case HashAlgorithm::Crc32c:
+        return hashFileWith<Crc32c>(fd.get(), path, offset, count);
+      case HashAlgorithm::Xxh3:
+        return hashFileWith<Xxh3>(fd.get(), path, offset, count);
+      case HashAlgorithm::Blake3: {
+        size_t threads = hash::detail::blake3Threads();
+        if (isRegular && threads > 1 && count >= kParallelThreshold) {
+          return hashBlake3Parallel(fd.get(), path, offset, count, threads);
+        }
+        return hashFileWith<Blake3>(fd.get(), path, offset, count);
+      }
+    }
+    throw std::invalid_argument("Unknown hash algorithm");
+  }
+
+  std::string hashBytes(const void* data, size_t size, HashAlgorithm algorithm) {
+    switch (algorithm) {
+      case HashAlgorithm::Sha256:
+        return hashBytesWith<Sha256>(data, size);
+      case HashAlgorithm::Crc32c:
+        return hashBytesWith<Crc32c>(data, size);
+      case HashAlgorithm::Xxh3:
+        return hashBytesWith<Xxh3>(data, size);
+      case HashAlgorithm::Blake3:
+        return hashBytesWith<Blake3>(data, size);
+    }
+    throw std::invalid_argument("Unknown hash algorithm");
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,41 @@
+//
+//  Hash.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  enum class HashAlgorithm {
+    Sha256,
+    // CRC-32C (Castagnoli), as used by iSCSI, ext4 and Google Cloud Storage.
+    Crc32c,
+    // XXH3, 64-bit, seed 0.
+    Xxh3,
+    // BLAKE3, 256-bit, unkeyed.
+    Blake3,
+  };
+
+  /**
+   * The digest of `length` bytes of `path` starting at `offset` (up to the end of the file if `length` is empty,
+   * or shorter if the file ends first), as lowercase hex. Integer checksums are written big-endian, like `crc32c`
+   * and `xxhsum` print them.
+   *
+   * The file is streamed in large blocks, so memory use is constant. BLAKE3 hashes subtrees of large files on
+   * several threads.
+   */
+  std::string hashFile(const std::string& path, HashAlgorithm algorithm, uint64_t offset = 0,
+                       std::optional<uint64_t> length = std::nullopt);
+
+  /**
+   * The digest of `size` bytes at `data`, like `hashFile`.
+   */
+  std::string hashBytes(const void* data, size_t size, HashAlgorithm algorithm);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,95 @@
+//
+//  HashKernels.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core::hash::detail {
+
+  inline constexpr uint32_t kSha256Initial[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+
+  inline constexpr uint32_t kSha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+  };
+
+  inline constexpr uint32_t kXxh3Prime32 = 0x9e3779b1;
+
+  // BLAKE3 uses the SHA-256 initial state as its IV.
+  inline constexpr const uint32_t (&kBlake3Iv)[8] = kSha256Initial;
+
+  // Which message word each round feeds to the G function: round 0 in order, then permuted once per round.
+  inline constexpr uint8_t kBlake3Schedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+  };
+
+  /**
+   * Hashing kernels for one instruction set. Each one handles its whole input.
+   */
+  struct Kernels {
+    const char* name;
+    /** Runs the SHA-256 compression function over `blocks` 64-byte blocks. */
+    void (*sha256)(uint32_t state[8], const uint8_t* data, size_t blocks);
+    /** Continues a CRC-32C over `data`. `crc` is the raw register: no initial or final inversion. */
+    uint32_t (*crc32c)(uint32_t crc, const uint8_t* data, size_t size);
+    /** Mixes `stripes` 64-byte stripes into the XXH3 accumulators; the secret advances 8 bytes per stripe. */
+    void (*xxh3Accumulate)(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes);
+    /** The XXH3 scramble after every block of stripes. */
+    void (*xxh3Scramble)(uint64_t acc[8], const uint8_t* secret);
+    /**
+     * Compresses `count` BLAKE3 inputs of `blocks` 64-byte blocks each, and writes each one's 32-byte chaining
+     * value to `out`. Input `i` uses `counter + i` if `incrementCounter` (chunks), else `counter` (parents).
+     * `flagsStart` and `flagsEnd` are added to the first and last block.
+     */
+    void (*blake3HashMany)(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8], uint64_t counter,
+                           bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out);
+  };
+
+  const Kernels& scalarKernels();
+
+  /**
+   * SIMD kernels, or `nullptr` if this build or the CPU running it lacks the instruction set.
+   * On x86 both use the SHA extensions if present. On ARM the SHA-256 and CRC-32C instructions are used if the CPU has them.
+   */
+  const Kernels* sse42Kernels();
+  const Kernels* avx2Kernels();
+  const Kernels* neonKernels();
+
+  /**
+   * Every kernel set usable on this CPU, fastest first. The last one is always `scalarKernels()`.
+   */
+  std::vector<const Kernels*> availableKernels();
+
+  /**
+   * The kernels used by `core/Hash.hpp`: the fastest available unless overridden (for benchmarks).
+   */
+  const Kernels& activeKernels();
+  void setActiveKernels(const Kernels& kernels);
+
+  /**
+   * The threads `hashFile` spreads a large file over for BLAKE3: one per core unless overridden (for tests and
+   * benchmarks). 1 hashes on the calling thread; setting 0 restores the default.
+   */
+  size_t blake3Threads();
+  void setBlake3Threads(size_t threads);
+
+} // namespace margelo::nitro::nitrofs::core::hash::detail
@@ -0,0 +1,724 @@
+//
+//  HashSimd.cpp
+//  NitroFS
+//
+//  Hardware hashing kernels: the x86 SHA extensions and SSE4.2 CRC32 instruction, the ARMv8 SHA-256 and CRC32
+//  instructions, and SSE2/AVX2/NEON versions of the XXH3 accumulator loop and of BLAKE3 (4 or 8 inputs per vector).
+//  The x86 kernels use per-function `target` attributes; on ARM, the SHA-256 and CRC32 kernels are only compiled
+//  when the compiler targets those extensions, and only used when the CPU reports them.
+//
+
+#include "HashKernels.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NITROFS_HASH_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NITROFS_HASH_NEON 1
+#include <arm_neon.h>
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define NITROFS_HASH_ARM_SHA2 1
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+#define NITROFS_HASH_ARM_CRC32 1
+#include <arm_acle.h>
+#endif
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace margelo::nitro::nitrofs::core::hash::detail {
+
+#if NITROFS_HASH_X86
+
+  namespace {
+#define NITROFS_SHA __attribute__((target("sha,sse4.1")))
+#define NITROFS_SSE42 __attribute__((target("sse4.2")))
+#define NITROFS_AVX2 __attribute__((target("avx2")))
+
+    bool hasShaExtensions() {
+      unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+      return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 && (ebx & (1u << 29)) != 0;
+    }
+
+    NITROFS_SHA inline void sha256Rounds(__m128i& abef, __m128i& cdgh, __m128i message, int group) {
+      const __m128i wk = _mm_add_epi32(message, _mm_loadu_si128(reinterpret_cast<const __m128i*>(kSha256RoundConstants + 4 * group)));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+    }
+
+    /** The next 4 message words, from the previous 16. */
+    NITROFS_SHA inline __m128i sha256Schedule(__m128i w0, __m128i w4, __m128i w8, __m128i w12) {
+      return _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w4), _mm_alignr_epi8(w12, w8, 4)), w12);
+    }
+
+    NITROFS_SHA void sha256ShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+      const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+      // The round instructions keep the state as ABEF and CDGH.
+      const __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+      const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+      __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+      __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+      for (; blocks > 0; blocks--, data += 64) {
+        const __m128i savedAbef = abef;
+        const __m128i savedCdgh = cdgh;
+        const auto* input = reinterpret_cast<const __m128i*>(data);
+        __m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(input), byteSwap);
+        __m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(input + 1), byteSwap);
+        __m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(input + 2), byteSwap);
+        __m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(input + 3), byteSwap);
+        sha256Rounds(abef, cdgh, m0, 0);
+        sha256Rounds(abef, cdgh, m1, 1);
+        sha256Rounds(abef, cdgh, m2, 2);
+        sha256Rounds(abef, cdgh, m3, 3);
+        for (int group = 4; group < 16; group += 4) {
+          m0 = sha256Schedule(m0, m1, m2, m3);
+          sha256Rounds(abef, cdgh, m0, group);
+          m1 = sha256Schedule(m1, m2, m3, m0);
+          sha256Rounds(abef, cdgh, m1, group + 1);
+          m2 = sha256Schedule(m2, m3, m0, m1);
+          sha256Rounds(abef, cdgh, m2, group + 2);
+          m3 = sha256Schedule(m3, m0, m1, m2);
+          sha256Rounds(abef, cdgh, m3, group + 3);
+        }
+        abef = _mm_add_epi32(abef, savedAbef);
+        cdgh = _mm_add_epi32(cdgh, savedCdgh);
+      }
+      const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+      const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+    }
+
+    NITROFS_SSE42 uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t size) {
+#if defined(__x86_64__)
+      uint64_t crc64 = crc;
+      for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+      }
+      crc = static_cast<uint32_t>(crc64);
+#endif
+      for (; size >= 4; size -= 4, data += 4) {
+        uint32_t word;
+        std::memcpy(&word, data, 4);
+        crc = _mm_crc32_u32(crc, word);
+      }
+      for (; size > 0; size--, data++) {
+        crc = _mm_crc32_u8(crc, *data);
+      }
+      return crc;
+    }
+
+    NITROFS_SSE42 void xxh3AccumulateSse2(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+      auto* accumulators = reinterpret_cast<__m128i*>(acc);
+      __m128i a[4];
+      for (int i = 0; i < 4; i++) {
+        a[i] = _mm_loadu_si128(accumulators + i);
+      }
+      for (; stripes > 0; stripes--, data += 64, secret += 8) {
+        for (int i = 0; i < 4; i++) {
+          const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i);
+          const __m128i key = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+          // Low times high 32 bits of each keyed lane, plus the neighbouring lane's raw value.
+          const __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+          a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+      }
+      for (int i = 0; i < 4; i++) {
+        _mm_storeu_si128(accumulators + i, a[i]);
+      }
+    }
+
+    NITROFS_SSE42 void xxh3ScrambleSse2(uint64_t acc[8], const uint8_t* secret) {
+      auto* accumulators = reinterpret_cast<__m128i*>(acc);
+      const __m128i prime = _mm_set1_epi32(static_cast<int>(kXxh3Prime32));
+      for (int i = 0; i < 4; i++) {
+        __m128i value = _mm_loadu_si128(accumulators + i);
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+        value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+        // 64 x 32-bit multiply from two 32 x 32-bit ones.
+        const __m128i low = _mm_mul_epu32(value, prime);
+        const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(accumulators + i, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+      }
+    }
+
+    NITROFS_AVX2 void xxh3AccumulateAvx2(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+      auto* accumulators = reinterpret_cast<__m256i*>(acc);
+      __m256i a[2] = {_mm256_loadu_si256(accumulators), _mm256_loadu_si256(accumulators + 1)};
+      for (; stripes > 0; stripes--, data += 64, secret += 8) {
+        for (int i = 0; i < 2; i++) {
+          const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data) + i);
+          const __m256i key = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+          const __m256i product = _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+          a[i] = _mm256_add_epi64(a[i], _mm256_add_epi64(product, _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+      }
+      _mm256_storeu_si256(accumulators, a[0]);
+      _mm256_storeu_si256(accumulators + 1, a[1]);
+    }
+
+    NITROFS_AVX2 void xxh3ScrambleAvx2(uint64_t acc[8], const uint8_t* secret) {
+      auto* accumulators = reinterpret_cast<__m256i*>(acc);
+      const __m256i prime = _mm256_set1_epi32(static_cast<int>(kXxh3Prime32));
+      for (int i = 0; i < 2; i++) {
+        __m256i value = _mm256_loadu_si256(accumulators + i);
+        value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+        value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+        const __m256i low = _mm256_mul_epu32(value, prime);
+        const __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm256_storeu_si256(accumulators + i, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+      }
+    }
+
+    NITROFS_SSE42 inline __m128i rotr16(__m128i x) {
+      return _mm_shuffle_epi8(x, _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+    }
+
+    NITROFS_SSE42 inline __m128i rotr8(__m128i x) {
+      return _mm_shuffle_epi8(x, _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1));
+    }
+
+    NITROFS_SSE42 inline __m128i rotr12(__m128i x) {
+      return _mm_or_si128(_mm_srli_epi32(x, 12), _mm_slli_epi32(x, 20));
+    }
+
+    NITROFS_SSE42 inline __m128i rotr7(__m128i x) {
+      return _mm_or_si128(_mm_srli_epi32(x, 7), _mm_slli_epi32(x, 25));
+    }
+
+    NITROFS_SSE42 inline void g4(__m128i* v, int a, int b, int c, int d, __m128i x, __m128i y) {
+      v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), x);
+      v[d] = rotr16(_mm_xor_si128(v[d], v[a]));
+      v[c] = _mm_add_epi32(v[c], v[d]);
+      v[b] = rotr12(_mm_xor_si128(v[b], v[c]));
+      v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), y);
+      v[d] = rotr8(_mm_xor_si128(v[d], v[a]));
+      v[c] = _mm_add_epi32(v[c], v[d]);
+      v[b] = rotr7(_mm_xor_si128(v[b], v[c]));
+    }
+
+    NITROFS_SSE42 inline void round4(__m128i* v, const __m128i* m, const uint8_t* s) {
+      g4(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+      g4(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+      g4(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+      g4(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+      g4(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+      g4(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+      g4(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+      g4(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    /** Rows of 4 words become columns: afterwards `r[i]` holds word `i` of each input row. */
+    NITROFS_SSE42 inline void transpose4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) {
+      const __m128i ab01 = _mm_unpacklo_epi32(r0, r1);
+      const __m128i ab23 = _mm_unpackhi_epi32(r0, r1);
+      const __m128i cd01 = _mm_unpacklo_epi32(r2, r3);
+      const __m128i cd23 = _mm_unpackhi_epi32(r2, r3);
+      r0 = _mm_unpacklo_epi64(ab01, cd01);
+      r1 = _mm_unpackhi_epi64(ab01, cd01);
+      r2 = _mm_unpacklo_epi64(ab23, cd23);
+      r3 = _mm_unpackhi_epi64(ab23, cd23);
+    }
+
+    /** BLAKE3 for 4 inputs at once, one per 32-bit lane. */
+    NITROFS_SSE42 void blake3Hash4Sse41(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                                        bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+      __m128i h[8];
+      for (int i = 0; i < 8; i++) {
+        h[i] = _mm_set1_epi32(static_cast<int>(key[i]));
+      }
+      uint64_t counters[4];
+      for (uint64_t lane = 0; lane < 4; lane++) {
+        counters[lane] = counter + (incrementCounter ? lane : 0);
+      }
+      const __m128i counterLow = _mm_set_epi32(static_cast<int>(counters[3]), static_cast<int>(counters[2]),
+                                               static_cast<int>(counters[1]), static_cast<int>(counters[0]));
+      const __m128i counterHigh = _mm_set_epi32(static_cast<int>(counters[3] >> 32), static_cast<int>(counters[2] >> 32),
+                                                static_cast<int>(counters[1] >> 32), static_cast<int>(counters[0] >> 32));
+      uint8_t blockFlags = flags | flagsStart;
+      for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+          blockFlags |= flagsEnd;
+        }
+        __m128i m[16];
+        for (int k = 0; k < 4; k++) {
+          for (int lane = 0; lane < 4; lane++) {
+            m[4 * k + lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inputs[lane] + block * 64 + 16 * k));
+          }
+          transpose4(m[4 * k], m[4 * k + 1], m[4 * k + 2], m[4 * k + 3]);
+        }
+        __m128i v[16] = {
+          h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+          _mm_set1_epi32(static_cast<int>(kBlake3Iv[0])), _mm_set1_epi32(static_cast<int>(kBlake3Iv[1])),
+          _mm_set1_epi32(static_cast<int>(kBlake3Iv[2])), _mm_set1_epi32(static_cast<int>(kBlake3Iv[3])),
+          counterLow, counterHigh, _mm_set1_epi32(64), _mm_set1_epi32(blockFlags),
+        };
+        // Spelled out so every message index is a constant.
+        round4(v, m, kBlake3Schedule[0]);
+        round4(v, m, kBlake3Schedule[1]);
+        round4(v, m, kBlake3Schedule[2]);
+        round4(v, m, kBlake3Schedule[3]);
+        round4(v, m, kBlake3Schedule[4]);
+        round4(v, m, kBlake3Schedule[5]);
+        round4(v, m, kBlake3Schedule[6]);
+        for (int i = 0; i < 8; i++) {
+          h[i] = _mm_xor_si128(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+      }
+      transpose4(h[0], h[1], h[2], h[3]);
+      transpose4(h[4], h[5], h[6], h[7]);
+      for (int lane = 0; lane < 4; lane++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * lane), h[lane]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * lane + 16), h[lane + 4]);
+      }
+    }
+
+    NITROFS_SSE42 void blake3HashManySse41(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8],
+                                           uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart,
+                                           uint8_t flagsEnd, uint8_t* out) {
+      for (; count >= 4; count -= 4, inputs += 4, out += 128) {
+        blake3Hash4Sse41(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+        if (incrementCounter) {
+          counter += 4;
+        }
+      }
+      scalarKernels().blake3HashMany(inputs, count, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+    }
+
+    NITROFS_AVX2 inline __m256i rotr16(__m256i x) {
+      return _mm256_shuffle_epi8(x, _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                                    13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+    }
+
+    NITROFS_AVX2 inline __m256i rotr8(__m256i x) {
+      return _mm256_shuffle_epi8(x, _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+                                                    12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1));
+    }
+
+    NITROFS_AVX2 inline __m256i rotr12(__m256i x) {
+      return _mm256_or_si256(_mm256_srli_epi32(x, 12), _mm256_slli_epi32(x, 20));
+    }
+
+    NITROFS_AVX2 inline __m256i rotr7(__m256i x) {
+      return _mm256_or_si256(_mm256_srli_epi32(x, 7), _mm256_slli_epi32(x, 25));
+    }
+
+    NITROFS_AVX2 inline void g8(__m256i* v, int a, int b, int c, int d, __m256i x, __m256i y) {
+      v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), x);
+      v[d] = rotr16(_mm256_xor_si256(v[d], v[a]));
+      v[c] = _mm256_add_epi32(v[c], v[d]);
+      v[b] = rotr12(_mm256_xor_si256(v[b], v[c]));
+      v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), y);
+      v[d] = rotr8(_mm256_xor_si256(v[d], v[a]));
+      v[c] = _mm256_add_epi32(v[c], v[d]);
+      v[b] = rotr7(_mm256_xor_si256(v[b], v[c]));
+    }
+
+    NITROFS_AVX2 inline void round8(__m256i* v, const __m256i* m, const uint8_t* s) {
+      g8(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+      g8(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+      g8(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+      g8(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+      g8(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+      g8(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+      g8(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+      g8(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    /** Rows of 8 words become columns: afterwards `r[i]` holds word `i` of each input row. */
+    NITROFS_AVX2 inline void transpose8(__m256i* r) {
+      __m256i t[8];
+      for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+      }
+      // Within each 128-bit half, rows 0-3 and 4-7 are transposed after this.
+      __m256i u[8];
+      for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+      }
+      for (int i = 0; i < 4; i++) {
+        r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+      }
+    }
+
+    /** BLAKE3 for 8 inputs at once, one per 32-bit lane. */
+    NITROFS_AVX2 void blake3Hash8Avx2(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                                      bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+      __m256i h[8];
+      for (int i = 0; i < 8; i++) {
+        h[i] = _mm256_set1_epi32(static_cast<int>(key[i]));
+      }
+      alignas(32) uint32_t counterLow[8];
+      alignas(32) uint32_t counterHigh[8];
+      for (uint64_t lane = 0; lane < 8; lane++) {
+        uint64_t value = counter + (incrementCounter ? lane : 0);
+        counterLow[lane] = static_cast<uint32_t>(value);
+        counterHigh[lane] = static_cast<uint32_t>(value >> 32);
+      }
+      uint8_t blockFlags = flags | flagsStart;
+      for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+          blockFlags |= flagsEnd;
+        }
+        __m256i m[16];
+        for (int k = 0; k < 2; k++) {
+          for (int lane = 0; lane < 8; lane++) {
+            m[8 * k + lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inputs[lane] + block * 64 + 32 * k));
+          }
+          transpose8(m + 8 * k);
+        }
+        __m256i v[16] = {
+          h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+          _mm256_set1_epi32(static_cast<int>(kBlake3Iv[0])), _mm256_set1_epi32(static_cast<int>(kBlake3Iv[1])),
+          _mm256_set1_epi32(static_cast<int>(kBlake3Iv[2])), _mm256_set1_epi32(static_cast<int>(kBlake3Iv[3])),
+          _mm256_load_si256(reinterpret_cast<const __m256i*>(counterLow)), _mm256_load_si256(reinterpret_cast<const __m256i*>(counterHigh)),
+          _mm256_set1_epi32(64), _mm256_set1_epi32(blockFlags),
+        };
+        round8(v, m, kBlake3Schedule[0]);
+        round8(v, m, kBlake3Schedule[1]);
+        round8(v, m, kBlake3Schedule[2]);
+        round8(v, m, kBlake3Schedule[3]);
+        round8(v, m, kBlake3Schedule[4]);
+        round8(v, m, kBlake3Schedule[5]);
+        round8(v, m, kBlake3Schedule[6]);
+        for (int i = 0; i < 8; i++) {
+          h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+      }
+      transpose8(h);
+      for (int lane = 0; lane < 8; lane++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32 * lane), h[lane]);
+      }
+    }
+
+    NITROFS_AVX2 void blake3HashManyAvx2(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8],
+                                         uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart,
+                                         uint8_t flagsEnd, uint8_t* out) {
+      for (; count >= 8; count -= 8, inputs += 8, out += 256) {
+        blake3Hash8Avx2(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+        if (incrementCounter) {
+          counter += 8;
+        }
+      }
+      blake3HashManySse41(inputs, count, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+    }
+
+#undef NITROFS_SHA
+#undef NITROFS_SSE42
+#undef NITROFS_AVX2
+  } // namespace
+
+  const Kernels* sse42Kernels() {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse4.2")) {
+      return nullptr;
+    }
+    static const Kernels kernels{"sse4.2", hasShaExtensions() ? sha256ShaNi : scalarKernels().sha256, crc32cSse42,
+                                 xxh3AccumulateSse2, xxh3ScrambleSse2, blake3HashManySse41};
+    return &kernels;
+  }
+
+  const Kernels* avx2Kernels() {
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("sse4.2")) {
+      return nullptr;
+    }
+    static const Kernels kernels{"avx2", hasShaExtensions() ? sha256ShaNi : scalarKernels().sha256, crc32cSse42,
+                                 xxh3AccumulateAvx2, xxh3ScrambleAvx2, blake3HashManyAvx2};
+    return &kernels;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#elif NITROFS_HASH_NEON
+
+  namespace {
+#if NITROFS_HASH_ARM_SHA2
+    bool hasSha2() {
+#if defined(__APPLE__)
+      // Every 64-bit Apple CPU has the ARMv8 crypto extensions.
+      return true;
+#elif defined(__linux__)
+      return (getauxval(AT_HWCAP) & (1 << 6)) != 0; // HWCAP_SHA2
+#else
+      return false;
+#endif
+    }
+
+    inline void sha256Rounds(uint32x4_t& abcd, uint32x4_t& efgh, uint32x4_t message, int group) {
+      const uint32x4_t wk = vaddq_u32(message, vld1q_u32(kSha256RoundConstants + 4 * group));
+      const uint32x4_t previous = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, previous, wk);
+    }
+
+    /** The next 4 message words, from the previous 16. */
+    inline uint32x4_t sha256Schedule(uint32x4_t w0, uint32x4_t w4, uint32x4_t w8, uint32x4_t w12) {
+      return vsha256su1q_u32(vsha256su0q_u32(w0, w4), w8, w12);
+    }
+
+    void sha256Arm(uint32_t state[8], const uint8_t* data, size_t blocks) {
+      uint32x4_t abcd = vld1q_u32(state);
+      uint32x4_t efgh = vld1q_u32(state + 4);
+      for (; blocks > 0; blocks--, data += 64) {
+        const uint32x4_t savedAbcd = abcd;
+        const uint32x4_t savedEfgh = efgh;
+        uint32x4_t m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+        uint32x4_t m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+        uint32x4_t m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+        uint32x4_t m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+        sha256Rounds(abcd, efgh, m0, 0);
+        sha256Rounds(abcd, efgh, m1, 1);
+        sha256Rounds(abcd, efgh, m2, 2);
+        sha256Rounds(abcd, efgh, m3, 3);
+        for (int group = 4; group < 16; group += 4) {
+          m0 = sha256Schedule(m0, m1, m2, m3);
+          sha256Rounds(abcd, efgh, m0, group);
+          m1 = sha256Schedule(m1, m2, m3, m0);
+          sha256Rounds(abcd, efgh, m1, group + 1);
+          m2 = sha256Schedule(m2, m3, m0, m1);
+          sha256Rounds(abcd, efgh, m2, group + 2);
+          m3 = sha256Schedule(m3, m0, m1, m2);
+          sha256Rounds(abcd, efgh, m3, group + 3);
+        }
+        abcd = vaddq_u32(abcd, savedAbcd);
+        efgh = vaddq_u32(efgh, savedEfgh);
+      }
+      vst1q_u32(state, abcd);
+      vst1q_u32(state + 4, efgh);
+    }
+#endif
+
+#if NITROFS_HASH_ARM_CRC32
+    bool hasCrc32() {
+#if defined(__APPLE__)
+      int value = 0;
+      size_t size = sizeof(value);
+      return sysctlbyname("hw.optional.armv8_crc32", &value, &size, nullptr, 0) == 0 && value != 0;
+#elif defined(__linux__)
+      return (getauxval(AT_HWCAP) & (1 << 7)) != 0; // HWCAP_CRC32
+#else
+      return false;
+#endif
+    }
+
+    uint32_t crc32cArm(uint32_t crc, const uint8_t* data, size_t size) {
+      for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+      }
+      for (; size > 0; size--, data++) {
+        crc = __crc32cb(crc, *data);
+      }
+      return crc;
+    }
+#endif
+
+    void xxh3AccumulateNeon(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+      uint64x2_t a[4];
+      for (int i = 0; i < 4; i++) {
+        a[i] = vld1q_u64(acc + 2 * i);
+      }
+      for (; stripes > 0; stripes--, data += 64, secret += 8) {
+        for (int i = 0; i < 4; i++) {
+          const uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(data + 16 * i));
+          const uint64x2_t key = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+          // Low times high 32 bits of each keyed lane, plus the neighbouring lane's raw value.
+          const uint64x2_t product = vmull_u32(vmovn_u64(key), vshrn_n_u64(key, 32));
+          a[i] = vaddq_u64(a[i], vaddq_u64(product, vextq_u64(value, value, 1)));
+        }
+      }
+      for (int i = 0; i < 4; i++) {
+        vst1q_u64(acc + 2 * i, a[i]);
+      }
+    }
+
+    void xxh3ScrambleNeon(uint64_t acc[8], const uint8_t* secret) {
+      const uint32x2_t prime = vdup_n_u32(kXxh3Prime32);
+      for (int i = 0; i < 4; i++) {
+        uint64x2_t value = vld1q_u64(acc + 2 * i);
+        value = veorq_u64(value, vshrq_n_u64(value, 47));
+        value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+        // 64 x 32-bit multiply from two 32 x 32-bit ones.
+        const uint64x2_t high = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+        vst1q_u64(acc + 2 * i, vmlal_u32(high, vmovn_u64(value), prime));
+      }
+    }
+
+    inline uint32x4_t rotr16(uint32x4_t x) {
+      return vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(x)));
+    }
+
+    inline uint32x4_t rotr12(uint32x4_t x) {
+      return vsriq_n_u32(vshlq_n_u32(x, 20), x, 12);
+    }
+
+    inline uint32x4_t rotr8(uint32x4_t x) {
+      return vsriq_n_u32(vshlq_n_u32(x, 24), x, 8);
+    }
+
+    inline uint32x4_t rotr7(uint32x4_t x) {
+      return vsriq_n_u32(vshlq_n_u32(x, 25), x, 7);
+    }
+
+    inline void g4(uint32x4_t* v, int a, int b, int c, int d, uint32x4_t x, uint32x4_t y) {
+      v[a] = vaddq_u32(vaddq_u32(v[a], v[b]), x);
+      v[d] = rotr16(veorq_u32(v[d], v[a]));
+      v[c] = vaddq_u32(v[c], v[d]);
+      v[b] = rotr12(veorq_u32(v[b], v[c]));
+      v[a] = vaddq_u32(vaddq_u32(v[a], v[b]), y);
+      v[d] = rotr8(veorq_u32(v[d], v[a]));
+      v[c] = vaddq_u32(v[c], v[d]);
+      v[b] = rotr7(veorq_u32(v[b], v[c]));
+    }
+
+    inline void round4(uint32x4_t* v, const uint32x4_t* m, const uint8_t* s) {
+      g4(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+      g4(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+      g4(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+      g4(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+      g4(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+      g4(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+      g4(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+      g4(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    /** Rows of 4 words become columns: afterwards `r[i]` holds word `i` of each input row. */
+    inline void transpose4(uint32x4_t& r0, uint32x4_t& r1, uint32x4_t& r2, uint32x4_t& r3) {
+      const uint32x4x2_t ab = vtrnq_u32(r0, r1);
+      const uint32x4x2_t cd = vtrnq_u32(r2, r3);
+      r0 = vcombine_u32(vget_low_u32(ab.val[0]), vget_low_u32(cd.val[0]));
+      r1 = vcombine_u32(vget_low_u32(ab.val[1]), vget_low_u32(cd.val[1]));
+      r2 = vcombine_u32(vget_high_u32(ab.val[0]), vget_high_u32(cd.val[0]));
+      r3 = vcombine_u32(vget_high_u32(ab.val[1]), vget_high_u32(cd.val[1]));
+    }
+
+    /** BLAKE3 for 4 inputs at once, one per 32-bit lane. */
+    void blake3Hash4Neon(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                         bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+      uint32x4_t h[8];
+      for (int i = 0; i < 8; i++) {
+        h[i] = vdupq_n_u32(key[i]);
+      }
+      uint32_t counterLow[4];
+      uint32_t counterHigh[4];
+      for (uint64_t lane = 0; lane < 4; lane++) {
+        uint64_t value = counter + (incrementCounter ? lane : 0);
+        counterLow[lane] = static_cast<uint32_t>(value);
+        counterHigh[lane] = static_cast<uint32_t>(value >> 32);
+      }
+      uint8_t blockFlags = flags | flagsStart;
+      for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+          blockFlags |= flagsEnd;
+        }
+        uint32x4_t m[16];
+        for (int k = 0; k < 4; k++) {
+          for (int lane = 0; lane < 4; lane++) {
+            m[4 * k + lane] = vreinterpretq_u32_u8(vld1q_u8(inputs[lane] + block * 64 + 16 * k));
+          }
+          transpose4(m[4 * k], m[4 * k + 1], m[4 * k + 2], m[4 * k + 3]);
+        }
+        uint32x4_t v[16] = {
+          h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+          vdupq_n_u32(kBlake3Iv[0]), vdupq_n_u32(kBlake3Iv[1]), vdupq_n_u32(kBlake3Iv[2]), vdupq_n_u32(kBlake3Iv[3]),
+          vld1q_u32(counterLow), vld1q_u32(counterHigh), vdupq_n_u32(64), vdupq_n_u32(blockFlags),
+        };
+        // Spelled out so every message index is a constant.
+        round4(v, m, kBlake3Schedule[0]);
+        round4(v, m, kBlake3Schedule[1]);
+        round4(v, m, kBlake3Schedule[2]);
+        round4(v, m, kBlake3Schedule[3]);
+        round4(v, m, kBlake3Schedule[4]);
+        round4(v, m, kBlake3Schedule[5]);
+        round4(v, m, kBlake3Schedule[6]);
+        for (int i = 0; i < 8; i++) {
+          h[i] = veorq_u32(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+      }
+      transpose4(h[0], h[1], h[2], h[3]);
+      transpose4(h[4], h[5], h[6], h[7]);
+      for (int lane = 0; lane < 4; lane++) {
+        vst1q_u8(out + 32 * lane, vreinterpretq_u8_u32(h[lane]));
+        vst1q_u8(out + 32 * lane + 16, vreinterpretq_u8_u32(h[lane + 4]));
+      }
+    }
+
+    void blake3HashManyNeon(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8], uint64_t counter,
+                            bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+      for (; count >= 4; count -= 4, inputs += 4, out += 128) {
+        blake3Hash4Neon(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+        if (incrementCounter) {
+          counter += 4;
+        }
+      }
+      scalarKernels().blake3HashMany(inputs, count, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+    }
+  } // namespace
+
+  const Kernels* sse42Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* avx2Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    static const Kernels kernels{
+      "neon",
+#if NITROFS_HASH_ARM_SHA2
+      hasSha2() ? sha256Arm : scalarKernels().sha256,
+#else
+      scalarKernels().sha256,
+#endif
+#if NITROFS_HASH_ARM_CRC32
+      hasCrc32() ? crc32cArm : scalarKernels().crc32c,
+#else
+      scalarKernels().crc32c,
+#endif
+      xxh3AccumulateNeon,
+      xxh3ScrambleNeon,
+      blake3HashManyNeon,
+    };
+    return &kernels;
+  }
+
+#else
+
+  const Kernels* sse42Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* avx2Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#endif
+
+} // namespace margelo::nitro::nitrofs::core::hash::detail
@@ -0,0 +1,276 @@
+//
+//  Lines.cpp
+//  NitroFS
+//
+
+#include "Lines.hpp"
+#include "ByteBuffer.hpp"
+#include "Errors.hpp"
+#include "FileIO.hpp"
+#include "Text.hpp"
+#include "UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr size_t kBlockSize = 1024 * 1024;
+    // The index keeps the offset of every this many lines, so a jump scans at most this many lines.
+    constexpr uint64_t kIndexStride = 1024;
+    constexpr size_t kMaxCachedIndexes = 8;
+
+    struct LineIndex {
+      dev_t device = 0;
+      ino_t inode = 0;
+      uint64_t size = 0;
+      uint64_t lineCount = 0;
+      // `checkpoints[i]` is where line `i * kIndexStride` starts.
+      std::vector<uint64_t> checkpoints{0};
+    };
+
+    /** The line starting at `offset`. */
+    struct LinePosition {
+      uint64_t line = 0;
+      uint64_t offset = 0;
+    };
+
+    std::mutex indexMutex;
+    // Most recently used first.
+    std::list<std::pair<std::string, std::shared_ptr<const LineIndex>>> indexCache;
+
+    /**
+     * The cached index of `path`, if it still describes the file's first `index->size` bytes
+     * (as far as we can tell without reading them: same inode, not shorter).
+     */
+    std::shared_ptr<const LineIndex> findIndex(const std::string& path, const struct stat& st) {
+      std::lock_guard lock(indexMutex);
+      for (auto it = indexCache.begin(); it != indexCache.end(); ++it) {
+        if (it->first != path) {
+          continue;
+        }
+        const LineIndex& index = *it->second;
+        if (index.device != st.st_dev || index.inode != st.st_ino || index.size > static_cast<uint64_t>(st.st_size)) {
+          indexCache.erase(it);
+          return nullptr;
+        }
+        indexCache.splice(indexCache.begin(), indexCache, it);
+        return indexCache.front().second;
+      }
+      return nullptr;
+    }
+
+    void storeIndex(const std::string& path, std::shared_ptr<const LineIndex> index) {
+      std::lock_guard lock(indexMutex);
+      indexCache.remove_if([&](const auto& entry) { return entry.first == path; });
+      indexCache.emplace_front(path, std::move(index));
+      if (indexCache.size() > kMaxCachedIndexes) {
+        indexCache.pop_back();
+      }
+    }
+
+    /**
+     * Scans forward from `from` to the start of line `target`, reading the file in large blocks and
+     * counting line breaks with SIMD (`countByte`). Only the block that holds the target is searched
+     * break by break. Stops at `size`; the result then is the position after the last line break.
+     * With `checkpoints`, the start of every `kIndexStride`th line on the way is appended to it.
+     */
+    LinePosition scanTo(int fd, const std::string& path, LinePosition from, uint64_t size, uint64_t target,
+                        std::vector<uint64_t>* checkpoints) {
+      LinePosition position = from;
+      uint64_t nextCheckpoint = (from.line / kIndexStride + 1) * kIndexStride;
+      ByteBuffer block(kBlockSize);
+      uint64_t offset = from.offset;
+      while (offset < size && position.line < target) {
+        size_t length = preadFully(fd, block.data(), static_cast<size_t>(std::min<uint64_t>(kBlockSize, size - offset)), offset, path);
+        if (length == 0) {
+          break;
+        }
+        const char* data = reinterpret_cast<const char*>(block.data());
+        const char* cursor = data;
+        const char* end = data + length;
+        size_t breaks = countByte(std::string_view(data, length), '\n');
+        uint64_t stop = checkpoints != nullptr ? std::min(target, nextCheckpoint) : target;
+        while (position.line + breaks >= stop) {
+          for (uint64_t i = position.line; i < stop; i++) {
+            cursor = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor))) + 1;
+            breaks--;
+          }
+          position = {stop, offset + static_cast<uint64_t>(cursor - data)};
+          if (stop == target) {
+            return position;
+          }
+          checkpoints->push_back(position.offset);
+          nextCheckpoint += kIndexStride;
+          stop = std::min(target, nextCheckpoint);
+        }
+        position.line += breaks;
+        offset += length;
+        if (breaks > 0) {
+          // The last line break is at most one line back from the end (no memrchr on Apple platforms).
+          const char* lineStart = end;
+          while (lineStart[-1] != '\n') {
+            lineStart--;
+          }
+          position.offset = offset - static_cast<uint64_t>(end - lineStart);
+        }
+      }
+      return position;
+    }
+
+    /** Number of lines, counting a last line without a line break. */
+    uint64_t lineCountAt(LinePosition end, uint64_t size) {
+      return end.line + (end.offset < size ? 1 : 0);
+    }
+
+    LinePosition startingPoint(const LineIndex* index, uint64_t line) {
+      if (index == nullptr) {
+        return {};
+      }
+      size_t checkpoint = static_cast<size_t>(std::min<uint64_t>(line / kIndexStride, index->checkpoints.size() - 1));
+      return {checkpoint * kIndexStride, index->checkpoints[checkpoint]};
+    }
+
+    UniqueFd openRegularFile(const std::string& path, struct stat& st) {
+      UniqueFd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+      if (!fd) {
+        throwErrno("open", path);
+      }
+      if (::fstat(fd.get(), &st) != 0) {
+        throwErrno("fstat", path);
+      }
+      if (S_ISDIR(st.st_mode)) {
+        throwError(EISDIR, "open", path);
+      }
+      return fd;
+    }
+  } // namespace
+
+  uint64_t readLines(const std::string& path, const ReadLinesOptions& options, const std::function<void(LineBatch&&)>& onBatch) {
+    struct stat st {};
+    UniqueFd fd = openRegularFile(path, st);
+    auto size = static_cast<uint64_t>(st.st_size);
+    if (options.maxLines == 0) {
+      return 0;
+    }
+    std::shared_ptr<const LineIndex> index = findIndex(path, st);
+
+    uint64_t startLine;
+    if (options.startLine >= 0) {
+      startLine = static_cast<uint64_t>(options.startLine);
+    } else {
+      uint64_t lineCount;
+      if (index != nullptr && index->size == size) {
+        lineCount = index->lineCount;
+      } else {
+        LinePosition end = scanTo(fd.get(), path, startingPoint(index.get(), UINT64_MAX), size, UINT64_MAX, nullptr);
+        lineCount = lineCountAt(end, size);
+      }
+      // -options.startLine can't overflow once it is unsigned.
+      uint64_t fromEnd = 0 - static_cast<uint64_t>(options.startLine);
+      startLine = lineCount > fromEnd ? lineCount - fromEnd : 0;
+    }
+
+    LinePosition start = scanTo(fd.get(), path, startingPoint(index.get(), startLine), size, startLine, nullptr);
+    if (start.line < startLine || start.offset >= size) {
+      return 0;
+    }
+
+    size_t batchSize = std::max<size_t>(1, options.batchSize);
+    uint64_t reported = 0;
+    LineBatch batch;
+    batch.firstLine = startLine;
+    auto report = [&](uint64_t lineStart, std::string_view text) {
+      if (!options.offsetsOnly) {
+        if (!text.empty() && text.back() == '\r') {
+          text.remove_suffix(1);
+        }
+        batch.lines.emplace_back(text);
+      }
+      batch.offsets.push_back(lineStart);
+      reported++;
+      if (batch.offsets.size() == batchSize) {
+        onBatch(std::move(batch));
+        batch = LineBatch();
+        batch.firstLine = startLine + reported;
+      }
+    };
+
+    ByteBuffer block(kBlockSize);
+    // The beginning of a line that continues in the next block.
+    std::string partial;
+    uint64_t lineStart = start.offset;
+    uint64_t offset = start.offset;
+    while (offset < size && reported < options.maxLines) {
+      size_t length = preadFully(fd.get(), block.data(), static_cast<size_t>(std::min<uint64_t>(kBlockSize, size - offset)), offset, path);
+      if (length == 0) {
+        break;
+      }
+      const char* data = reinterpret_cast<const char*>(block.data());
+      const char* cursor = data;
+      const char* end = data + length;
+      while (cursor < end && reported < options.maxLines) {
+        const auto* lineBreak = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (lineBreak == nullptr) {
+          if (!options.offsetsOnly) {
+            partial.append(cursor, static_cast<size_t>(end - cursor));
+          }
+          cursor = end;
+          break;
+        }
+        std::string_view text(cursor, static_cast<size_t>(lineBreak - cursor));
+        if (!partial.empty()) {
+          partial.append(text);
+          text = partial;
+        }
+        report(lineStart, text);
+        partial.clear();
+        cursor = lineBreak + 1;
+        lineStart = offset + static_cast<uint64_t>(cursor - data);
+      }
+      offset += static_cast<uint64_t>(cursor - data);
+    }
+    if (reported < options.maxLines && lineStart < offset) {
+      report(lineStart, partial);
+    }
+    if (!batch.offsets.empty()) {
+      onBatch(std::move(batch));
+    }
+    return reported;
+  }
+
+  uint64_t indexLines(const std::string& path) {
+    struct stat st {};
+    UniqueFd fd = openRegularFile(path, st);
+    auto size = static_cast<uint64_t>(st.st_size);
+    std::shared_ptr<const LineIndex> cached = findIndex(path, st);
+    if (cached != nullptr && cached->size == size) {
+      return cached->lineCount;
+    }
+
+    auto index = std::make_shared<LineIndex>();
+    index->device = st.st_dev;
+    index->inode = st.st_ino;
+    index->size = size;
+    LinePosition from;
+    if (cached != nullptr) {
+      // The file grew: keep what was indexed, and continue from the last checkpoint.
+      index->checkpoints = cached->checkpoints;
+      from = startingPoint(cached.get(), UINT64_MAX);
+    }
+    LinePosition end = scanTo(fd.get(), path, from, size, UINT64_MAX, &index->checkpoints);
+    index->lineCount = lineCountAt(end, size);
+    storeIndex(path, index);
+    return index->lineCount;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
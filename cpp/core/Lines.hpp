@@ -0,0 +1,50 @@
+//
+//  Lines.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct ReadLinesOptions {
+    /** The first line to read (0-based). Negative values count from the end: -1 is the last line. */
+    int64_t startLine = 0;
+    uint64_t maxLines = UINT64_MAX;
+    /** Lines per `onBatch` call. */
+    size_t batchSize = 1000;
+    /** Only report where lines start, without copying their text. */
+    bool offsetsOnly = false;
+  };
+
+  struct LineBatch {
+    uint64_t firstLine = 0;
+    /** Without the line break (`\n` or `\r\n`). Empty if `offsetsOnly`. */
+    std::vector<std::string> lines;
+    /** Byte offset of each line in the file. */
+    std::vector<uint64_t> offsets;
+  };
+
+  /**
+   * Streams lines of a text file in batches. Lines are separated by `\n`; a last line without one still counts.
+   * Returns the number of lines reported.
+   *
+   * If `indexLines` was called for `path` before, reading jumps close to `startLine` instead of
+   * scanning from the start of the file.
+   */
+  uint64_t readLines(const std::string& path, const ReadLinesOptions& options, const std::function<void(LineBatch&&)>& onBatch);
+
+  /**
+   * Builds (or, for a file that grew, extends) the line index of `path`, and returns its number of lines.
+   * Indexes are kept in memory for a few recently indexed files, and they're only used while the file keeps
+   * its size, or grows (e.g. a log being appended to).
+   */
+  uint64_t indexLines(const std::string& path);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,80 @@
+//
+//  MappedFile.cpp
+//  NitroFS
+//
+
+#include "MappedFile.hpp"
+#include "Errors.hpp"
+#include "UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitrofs::core {
+
+  std::shared_ptr<MappedFile> MappedFile::open(const std::string& path, uint64_t offset, std::optional<uint64_t> length, bool readOnly) {
+    UniqueFd fd(::open(path.c_str(), (readOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC));
+    if (!fd) {
+      throwErrno("open", path);
+    }
+    struct stat st {};
+    if (::fstat(fd.get(), &st) != 0) {
+      throwErrno("fstat", path);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "mmap", path);
+    }
+
+    auto fileSize = static_cast<uint64_t>(st.st_size);
+    if (offset > fileSize || (length.has_value() && *length > fileSize - offset)) {
+      throwError(EINVAL, "mmap", path);
+    }
+    uint64_t size = length.value_or(fileSize - offset);
+    if (size > SIZE_MAX) {
+      throwError(EFBIG, "mmap", path);
+    }
+
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->_path = path;
+    file->_offset = offset;
+    file->_size = static_cast<size_t>(size);
+    file->_readOnly = readOnly;
+    if (size == 0) {
+      // mmap rejects empty mappings; an empty file still maps to an empty buffer.
+      return file;
+    }
+
+    // mmap offsets must be page-aligned, so map from the page containing `offset`.
+    auto pageSize = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    uint64_t alignedOffset = offset - offset % pageSize;
+    size_t delta = static_cast<size_t>(offset - alignedOffset);
+    size_t mappingSize = file->_size + delta;
+    int flags = readOnly ? MAP_PRIVATE : MAP_SHARED;
+    void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, flags, fd.get(), static_cast<off_t>(alignedOffset));
+    if (mapping == MAP_FAILED) {
+      throwErrno("mmap", path);
+    }
+    file->_mapping = mapping;
+    file->_mappingSize = mappingSize;
+    file->_data = static_cast<uint8_t*>(mapping) + delta;
+    return file;
+  }
+
+  MappedFile::~MappedFile() {
+    if (_mapping != nullptr) {
+      ::munmap(_mapping, _mappingSize);
+    }
+  }
+
+  void MappedFile::sync() const {
+    if (_readOnly || _mapping == nullptr) {
+      return;
+    }
+    if (::msync(_mapping, _mappingSize, MS_SYNC) != 0) {
+      throwErrno("msync", _path);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
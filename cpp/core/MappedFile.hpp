@@ -0,0 +1,61 @@
+//
+//  MappedFile.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * A file (or a byte range of it) mapped into memory with `mmap`.
+   * Pages are faulted in on first access and, as long as they are clean, can be
+   * dropped by the OS under memory pressure. The mapping lives until the object is destroyed.
+   *
+   * Truncating the file while it is mapped makes accesses past the new end raise `SIGBUS`.
+   */
+  class MappedFile {
+  public:
+    /**
+     * Maps `length` bytes starting at `offset` (which does not need to be page-aligned).
+     * Without a `length` the rest of the file is mapped.
+     *
+     * A `readOnly` mapping is private: writes through `data()` are allowed but stay in memory
+     * (copy-on-write) and never reach the file. Otherwise the mapping is shared with the file.
+     */
+    static std::shared_ptr<MappedFile> open(const std::string& path, uint64_t offset, std::optional<uint64_t> length, bool readOnly);
+
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    uint8_t* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    uint64_t offset() const noexcept { return _offset; }
+    bool readOnly() const noexcept { return _readOnly; }
+
+    /**
+     * Flushes modified pages back to the file (`msync(MS_SYNC)`). A no-op for read-only mappings.
+     */
+    void sync() const;
+
+  private:
+    MappedFile() = default;
+
+  private:
+    std::string _path;
+    void* _mapping = nullptr;
+    size_t _mappingSize = 0;
+    uint8_t* _data = nullptr;
+    size_t _size = 0;
+    uint64_t _offset = 0;
+    bool _readOnly = true;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,114 @@
+//
+//  MimeTypes.cpp
+//  NitroFS
+//
+
+#include "MimeTypes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    // Sorted by extension so lookups can binary search.
+    constexpr std::array<std::pair<std::string_view, std::string_view>, 62> kMimeTypes = {{
+      {"3gp", "video/3gpp"},
+      {"aac", "audio/aac"},
+      {"avi", "video/x-msvideo"},
+      {"bmp", "image/bmp"},
+      {"css", "text/css"},
+      {"csv", "text/csv"},
+      {"db", "application/vnd.sqlite3"},
+      {"doc", "application/msword"},
+      {"docx", "application/vnd.openxmlformats-officedocument.wordprocessingml.document"},
+      {"epub", "application/epub+zip"},
+      {"flac", "audio/flac"},
+      {"gif", "image/gif"},
+      {"gz", "application/gzip"},
+      {"heic", "image/heic"},
+      {"heif", "image/heif"},
+      {"htm", "text/html"},
+      {"html", "text/html"},
+      {"ico", "image/x-icon"},
+      {"jpeg", "image/jpeg"},
+      {"jpg", "image/jpeg"},
+      {"js", "text/javascript"},
+      {"json", "application/json"},
+      {"log", "text/plain"},
+      {"m4a", "audio/mp4"},
+      {"m4v", "video/x-m4v"},
+      {"md", "text/markdown"},
+      {"mkv", "video/x-matroska"},
+      {"mov", "video/quicktime"},
+      {"mp3", "audio/mpeg"},
+      {"mp4", "video/mp4"},
+      {"mpeg", "video/mpeg"},
+      {"odp", "application/vnd.oasis.opendocument.presentation"},
+      {"ods", "application/vnd.oasis.opendocument.spreadsheet"},
+      {"odt", "application/vnd.oasis.opendocument.text"},
+      {"oga", "audio/ogg"},
+      {"ogg", "audio/ogg"},
+      {"ogv", "video/ogg"},
+      {"otf", "font/otf"},
+      {"pdf", "application/pdf"},
+      {"png", "image/png"},
+      {"ppt", "application/vnd.ms-powerpoint"},
+      {"pptx", "application/vnd.openxmlformats-officedocument.presentationml.presentation"},
+      {"rar", "application/vnd.rar"},
+      {"readme", "text/plain"},
+      {"rtf", "application/rtf"},
+      {"sql", "application/sql"},
+      {"sqlite", "application/vnd.sqlite3"},
+      {"sqlite3", "application/vnd.sqlite3"},
+      {"svg", "image/svg+xml"},
+      {"tar", "application/x-tar"},
+      {"tif", "image/tiff"},
+      {"tiff", "image/tiff"},
+      {"ttf", "font/ttf"},
+      {"txt", "text/plain"},
+      {"wav", "audio/wav"},
+      {"webm", "video/webm"},
+      {"webp", "image/webp"},
+      {"xls", "application/vnd.ms-excel"},
+      {"xlsx", "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet"},
+      {"xml", "application/xml"},
+      {"yaml", "text/yaml"},
+      {"yml", "text/yaml"},
+    }};
+
+    static_assert(std::is_sorted(kMimeTypes.begin(), kMimeTypes.end()), "kMimeTypes must be sorted by extension");
+
+    // Longest extension in the table is 7 characters ("sqlite3").
+    constexpr size_t kMaxExtensionLength = 8;
+  } // namespace
+
+  std::string_view mimeTypeForFileName(std::string_view fileName) {
+    size_t slash = fileName.rfind('/');
+    if (slash != std::string_view::npos) {
+      fileName = fileName.substr(slash + 1);
+    }
+    size_t dot = fileName.rfind('.');
+    if (dot == std::string_view::npos || dot == 0 || fileName.size() - dot - 1 > kMaxExtensionLength) {
+      return kDefaultMimeType;
+    }
+
+    char buffer[kMaxExtensionLength];
+    size_t length = fileName.size() - dot - 1;
+    for (size_t i = 0; i < length; i++) {
+      char c = fileName[dot + 1 + i];
+      buffer[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    std::string_view extension(buffer, length);
+
+    auto it = std::lower_bound(kMimeTypes.begin(), kMimeTypes.end(), extension, [](const auto& entry, std::string_view key) {
+      return entry.first < key;
+    });
+    if (it == kMimeTypes.end() || it->first != extension) {
+      return kDefaultMimeType;
+    }
+    return it->second;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
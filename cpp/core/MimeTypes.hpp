@@ -0,0 +1,20 @@
+//
+//  MimeTypes.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <string_view>
+
+namespace margelo::nitro::nitrofs::core {
+
+  constexpr std::string_view kDefaultMimeType = "application/octet-stream";
+
+  /**
+   * Guesses the MIME type of `fileName` from its extension.
+   * Returns `kDefaultMimeType` for unknown or missing extensions.
+   */
+  std::string_view mimeTypeForFileName(std::string_view fileName);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,200 @@
+//
+//  Parallel.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * `std::thread::hardware_concurrency()`, but never 0.
+   */
+  inline size_t hardwareConcurrency() {
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  /**
+   * Runs `task(i)` for every `i` in `[0, count)` on up to `maxThreads` threads, the calling thread included.
+   * Tasks are handed out one index at a time, so uneven tasks still balance.
+   * The first exception thrown by a task is rethrown once every thread has stopped.
+   */
+  template <typename Task>
+  void parallelFor(size_t count, size_t maxThreads, Task&& task) {
+    size_t threadCount = std::min(count, std::max<size_t>(1, maxThreads));
+    if (threadCount <= 1) {
+      for (size_t i = 0; i < count; i++) {
+        task(i);
+      }
+      return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+      while (!failed.load(std::memory_order_relaxed)) {
+        size_t i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= count) {
+          return;
+        }
+        try {
+          task(i);
+        } catch (...) {
+          std::lock_guard lock(errorMutex);
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; i++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  namespace detail {
+    /**
+     * One worker's tasks. The owner takes the newest task (depth first, warm caches),
+     * idle workers steal the oldest one (the biggest remaining subtree, usually).
+     */
+    template <typename Task>
+    class TaskDeque {
+    public:
+      void push(Task&& task) {
+        std::lock_guard lock(_mutex);
+        _tasks.push_back(std::move(task));
+      }
+
+      std::optional<Task> pop() {
+        std::lock_guard lock(_mutex);
+        if (_tasks.empty()) {
+          return std::nullopt;
+        }
+        Task task = std::move(_tasks.back());
+        _tasks.pop_back();
+        return task;
+      }
+
+      std::optional<Task> steal() {
+        std::lock_guard lock(_mutex);
+        if (_tasks.empty()) {
+          return std::nullopt;
+        }
+        Task task = std::move(_tasks.front());
+        _tasks.pop_front();
+        return task;
+      }
+
+    private:
+      std::mutex _mutex;
+      std::deque<Task> _tasks;
+    };
+  } // namespace detail
+
+  /**
+   * Runs `run(task, spawn)` for every task in `initial`, and for every task passed to `spawn(Task)` along the way,
+   * on up to `maxThreads` work-stealing threads (the calling thread included). Returns once no task is left.
+   * Meant for trees whose shape is only known while walking them, e.g. one task per directory.
+   * The first exception thrown by a task is rethrown once every thread has stopped; queued tasks are dropped.
+   */
+  template <typename Task, typename Run>
+  void parallelTasks(std::vector<Task> initial, size_t maxThreads, Run&& run) {
+    size_t threadCount = std::max<size_t>(1, maxThreads);
+    std::vector<std::unique_ptr<detail::TaskDeque<Task>>> deques;
+    deques.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+      deques.push_back(std::make_unique<detail::TaskDeque<Task>>());
+    }
+
+    // `pending` counts queued and running tasks; the work is done when it drops to 0.
+    std::atomic<size_t> pending{initial.size()};
+    std::atomic<size_t> queued{initial.size()};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    for (size_t i = 0; i < initial.size(); i++) {
+      deques[i % threadCount]->push(std::move(initial[i]));
+    }
+
+    auto isDone = [&]() {
+      return pending.load() == 0 || failed.load();
+    };
+    auto worker = [&](size_t index) {
+      auto spawn = [&](Task task) {
+        pending.fetch_add(1);
+        deques[index]->push(std::move(task));
+        queued.fetch_add(1);
+        if (threadCount > 1) {
+          std::lock_guard lock(mutex);
+          wakeUp.notify_one();
+        }
+      };
+      while (!isDone()) {
+        std::optional<Task> task = deques[index]->pop();
+        for (size_t i = 1; !task.has_value() && i < threadCount; i++) {
+          task = deques[(index + i) % threadCount]->steal();
+        }
+        if (!task.has_value()) {
+          std::unique_lock lock(mutex);
+          wakeUp.wait(lock, [&]() { return queued.load() > 0 || isDone(); });
+          continue;
+        }
+        queued.fetch_sub(1);
+        try {
+          run(*task, spawn);
+        } catch (...) {
+          std::lock_guard lock(mutex);
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+        if (pending.fetch_sub(1) == 1 || failed.load()) {
+          std::lock_guard lock(mutex);
+          wakeUp.notify_all();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; i++) {
+      threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
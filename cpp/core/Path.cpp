@@ -0,0 +1,108 @@
+//
+//  Path.cpp
+//  NitroFS
+//
+
+#include "Path.hpp"
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr std::string_view kContentScheme = "content://";
+    constexpr std::string_view kFileScheme = "file://";
+
+    int hexValue(char c) {
+      if (c >= '0' && c <= '9') return c - '0';
+      if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+      return -1;
+    }
+
+    std::string percentDecode(std::string_view input) {
+      std::string output;
+      output.reserve(input.size());
+      for (size_t i = 0; i < input.size(); i++) {
+        if (input[i] == '%' && i + 2 < input.size()) {
+          int high = hexValue(input[i + 1]);
+          int low = hexValue(input[i + 2]);
+          if (high >= 0 && low >= 0) {
+            output.push_back(static_cast<char>((high << 4) | low));
+            i += 2;
+            continue;
+          }
+        }
+        output.push_back(input[i]);
+      }
+      return output;
+    }
+
+    std::string_view stripTrailingSeparators(std::string_view path) {
+      while (path.size() > 1 && path.back() == '/') {
+        path.remove_suffix(1);
+      }
+      return path;
+    }
+  } // namespace
+
+  bool isContentUri(std::string_view path) {
+    return path.starts_with(kContentScheme);
+  }
+
+  std::string toLocalPath(std::string_view path) {
+    if (!path.starts_with(kFileScheme)) {
+      return std::string(path);
+    }
+    std::string_view rest = path.substr(kFileScheme.size());
+    // file:///path has an empty authority, file://localhost/path a named one.
+    size_t slash = rest.find('/');
+    rest = slash == std::string_view::npos ? std::string_view() : rest.substr(slash);
+    size_t query = rest.find_first_of("?#");
+    if (query != std::string_view::npos) {
+      rest = rest.substr(0, query);
+    }
+    return percentDecode(rest);
+  }
+
+  std::string dirname(std::string_view path) {
+    path = stripTrailingSeparators(path);
+    size_t slash = path.rfind('/');
+    if (slash == std::string_view::npos) {
+      return "";
+    }
+    if (slash == 0) {
+      return "/";
+    }
+    return std::string(stripTrailingSeparators(path.substr(0, slash)));
+  }
+
+  std::string basename(std::string_view path) {
+    path = stripTrailingSeparators(path);
+    if (path == "/") {
+      return "";
+    }
+    size_t slash = path.rfind('/');
+    return std::string(slash == std::string_view::npos ? path : path.substr(slash + 1));
+  }
+
+  std::string extname(std::string_view path) {
+    std::string name = basename(path);
+    size_t dot = name.rfind('.');
+    // A leading dot marks a hidden file (".gitignore"), not an extension.
+    if (dot == std::string::npos || dot == 0) {
+      return "";
+    }
+    return name.substr(dot + 1);
+  }
+
+  std::string join(std::string_view directory, std::string_view name) {
+    std::string result;
+    result.reserve(directory.size() + name.size() + 1);
+    result.append(directory);
+    if (!result.empty() && result.back() != '/') {
+      result.push_back('/');
+    }
+    result.append(name);
+    return result;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,45 @@
+//
+//  Path.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Whether `path` is an Android `content://` URI.
+   * These cannot be opened with POSIX calls and have to go through the platform layer.
+   */
+  bool isContentUri(std::string_view path);
+
+  /**
+   * Turns a `file://` URI into a plain filesystem path (percent-decoded).
+   * Anything else is returned as-is.
+   */
+  std::string toLocalPath(std::string_view path);
+
+  /**
+   * The parent directory of `path`, or an empty string if it has none.
+   */
+  std::string dirname(std::string_view path);
+
+  /**
+   * The last component of `path`, including its extension.
+   */
+  std::string basename(std::string_view path);
+
+  /**
+   * The extension of the last component of `path`, without the leading dot.
+   */
+  std::string extname(std::string_view path);
+
+  /**
+   * Joins `directory` and `name` with exactly one separator.
+   */
+  std::string join(std::string_view directory, std::string_view name);
+
+} // namespace margelo::nitro::nitrofs::core
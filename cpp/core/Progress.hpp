@@ -0,0 +1,54 @@
+//
+//  Progress.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Rate-limits progress reports coming from several worker threads.
+   * Reports never run concurrently, so a callback doesn't have to be thread-safe.
+   */
+  class ProgressThrottle {
+  public:
+    explicit ProgressThrottle(std::chrono::milliseconds interval = std::chrono::milliseconds(100)): _interval(interval) {}
+
+    /**
+     * Runs `report()` unless another thread is reporting right now, or the last report was less than `interval` ago.
+     */
+    template <typename Report>
+    void maybeReport(Report&& report) {
+      std::unique_lock lock(_mutex, std::try_to_lock);
+      if (!lock.owns_lock()) {
+        return;
+      }
+      auto now = std::chrono::steady_clock::now();
+      if (now - _lastReport < _interval) {
+        return;
+      }
+      _lastReport = now;
+      report();
+    }
+
+    /**
+     * Runs `report()` unconditionally, e.g. for the final 100%.
+     */
+    template <typename Report>
+    void report(Report&& report) {
+      std::lock_guard lock(_mutex);
+      _lastReport = std::chrono::steady_clock::now();
+      report();
+    }
+
+  private:
+    std::chrono::milliseconds _interval;
+    std::mutex _mutex;
+    std::chrono::steady_clock::time_point _lastReport;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
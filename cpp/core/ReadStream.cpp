@@ -0,0 +1,174 @@
+//
+//  ReadStream.cpp
+//  NitroFS
+//
+
+#include "ReadStream.hpp"
+#include "Errors.hpp"
+#include "FileIO.hpp"
+#include "UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Shared with the reader thread, which keeps it (and the descriptor) alive until it notices `closed`.
+   */
+  struct ReadStream::State {
+    std::string path;
+    ReadStreamOptions options;
+    UniqueFd fd;
+    uint64_t end = 0;
+    /** Pipes and character devices can't `pread`: they're read in order, dropping the bytes before `start`. */
+    bool seekable = true;
+    /** Only touched by the reader thread. */
+    uint64_t skip = 0;
+
+    std::mutex mutex;
+    // Wakes the reader thread once a chunk was consumed.
+    std::condition_variable wake;
+    // Wakes `next()` once a chunk arrived.
+    std::condition_variable ready;
+
+    std::deque<ByteBuffer> chunks;
+    uint64_t position = 0;
+    std::exception_ptr error;
+    bool finished = false;
+    bool closed = false;
+  };
+
+  void ReadStream::run(const std::shared_ptr<State>& state) {
+    std::unique_lock lock(state->mutex);
+    while (true) {
+      state->wake.wait(lock, [&]() { return state->closed || state->chunks.size() < state->options.highWaterMark; });
+      if (state->closed) {
+        return;
+      }
+      uint64_t offset = state->position;
+      size_t size = static_cast<size_t>(std::min<uint64_t>(state->options.chunkSize, state->end - offset));
+      if (size == 0) {
+        state->finished = true;
+        state->ready.notify_all();
+        return;
+      }
+      lock.unlock();
+
+      ByteBuffer chunk;
+      std::exception_ptr error;
+      try {
+        chunk = ByteBuffer(size);
+        if (state->seekable) {
+          chunk.resize(preadFully(state->fd.get(), chunk.data(), size, offset, state->path));
+        } else {
+          while (state->skip > 0) {
+            size_t dropped = readFully(state->fd.get(), chunk.data(), static_cast<size_t>(std::min<uint64_t>(state->skip, size)), state->path);
+            state->skip = dropped == 0 ? 0 : state->skip - dropped;
+          }
+          chunk.resize(readFully(state->fd.get(), chunk.data(), size, state->path));
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      lock.lock();
+      if (error || chunk.size() == 0) {
+        // A file that shrank while being read just ends early.
+        state->error = error;
+        state->finished = true;
+        state->ready.notify_all();
+        return;
+      }
+      state->position += chunk.size();
+      state->chunks.push_back(std::move(chunk));
+      state->ready.notify_one();
+    }
+  }
+
+  std::shared_ptr<ReadStream> ReadStream::open(const std::string& path, const ReadStreamOptions& options) {
+    UniqueFd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd) {
+      throwErrno("open", path);
+    }
+    struct stat st {};
+    if (::fstat(fd.get(), &st) != 0) {
+      throwErrno("fstat", path);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "open", path);
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    // Best effort: lets the kernel read further ahead than it would for random access.
+    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    auto state = std::make_shared<State>();
+    state->path = path;
+    state->options = options;
+    state->options.chunkSize = std::max<size_t>(1, options.chunkSize);
+    state->options.highWaterMark = std::max<size_t>(1, options.highWaterMark);
+    state->fd = std::move(fd);
+    // Regular files are read up to the size they have now; anything else (e.g. a pipe) until EOF.
+    uint64_t fileEnd = S_ISREG(st.st_mode) ? static_cast<uint64_t>(st.st_size) : UINT64_MAX;
+    state->end = std::min(options.end.value_or(UINT64_MAX), fileEnd);
+    state->position = std::min(options.start, state->end);
+    state->seekable = S_ISREG(st.st_mode) || S_ISBLK(st.st_mode);
+    state->skip = state->seekable ? 0 : state->position;
+    return std::shared_ptr<ReadStream>(new ReadStream(std::move(state)));
+  }
+
+  ReadStream::ReadStream(std::shared_ptr<State> state): _state(std::move(state)) {
+    // Never joined: close() must not block on an in-flight read, so the thread owns the state instead.
+    std::thread([state = _state]() { run(state); }).detach();
+  }
+
+  ReadStream::~ReadStream() {
+    close();
+  }
+
+  const std::string& ReadStream::path() const noexcept {
+    return _state->path;
+  }
+
+  std::optional<ByteBuffer> ReadStream::next() {
+    std::unique_lock lock(_state->mutex);
+    _state->ready.wait(lock, [&]() { return _state->closed || !_state->chunks.empty() || _state->finished; });
+    if (_state->closed) {
+      throwError(EBADF, "read", _state->path);
+    }
+    if (!_state->chunks.empty()) {
+      ByteBuffer chunk = std::move(_state->chunks.front());
+      _state->chunks.pop_front();
+      lock.unlock();
+      _state->wake.notify_one();
+      return chunk;
+    }
+    if (_state->error) {
+      std::rethrow_exception(_state->error);
+    }
+    return std::nullopt;
+  }
+
+  void ReadStream::close() {
+    {
+      std::lock_guard lock(_state->mutex);
+      if (_state->closed) {
+        return;
+      }
+      _state->closed = true;
+      _state->chunks.clear();
+    }
+    _state->wake.notify_one();
+    _state->ready.notify_all();
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,65 @@
+//
+//  ReadStream.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "ByteBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct ReadStreamOptions {
+    size_t chunkSize = 64 * 1024;
+    uint64_t start = 0;
+    /** One past the last byte to read, or the end of the file. */
+    std::optional<uint64_t> end;
+    /** How many chunks are read ahead of the consumer before reading pauses. */
+    size_t highWaterMark = 4;
+  };
+
+  /**
+   * Reads a range of a file in fixed-size chunks on a dedicated thread, at most
+   * `highWaterMark` chunks ahead of `next()`, so memory stays bounded however large the file is.
+   *
+   * All methods are thread-safe. A read error is thrown from `next()` once the chunks before it were consumed.
+   */
+  class ReadStream {
+  public:
+    static std::shared_ptr<ReadStream> open(const std::string& path, const ReadStreamOptions& options);
+
+    ~ReadStream();
+    ReadStream(const ReadStream&) = delete;
+    ReadStream& operator=(const ReadStream&) = delete;
+
+    const std::string& path() const noexcept;
+
+    /**
+     * The next chunk, waiting for it to be read if needed. `std::nullopt` at the end of the range.
+     * Fails with `EBADF` after `close()`.
+     */
+    std::optional<ByteBuffer> next();
+
+    /**
+     * Stops reading and drops the chunks read ahead. Does not wait for an in-flight read.
+     */
+    void close();
+
+  private:
+    struct State;
+    explicit ReadStream(std::shared_ptr<State> state);
+
+    /** The reader thread. */
+    static void run(const std::shared_ptr<State>& state);
+
+  private:
+    std::shared_ptr<State> _state;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,255 @@
+//
+//  Remove.cpp
+//  NitroFS
+//
+
+#include "Remove.hpp"
+#include "Errors.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Progress.hpp"
+#include "Stat.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    struct DirCloser {
+      void operator()(DIR* dir) const { ::closedir(dir); }
+    };
+    using UniqueDir = std::unique_ptr<DIR, DirCloser>;
+
+    /**
+     * A directory that can be removed once its own files and all of its subdirectories are gone.
+     */
+    struct RemoveNode {
+      std::string path;
+      std::shared_ptr<RemoveNode> parent;
+      // Its own listing, plus one per subdirectory still being removed.
+      std::atomic<size_t> pending{1};
+    };
+
+    bool isDotOrDotDot(const char* name) {
+      return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+    }
+
+    /**
+     * Unlinks every non-directory in `node` relative to the directory's fd, and spawns a task per subdirectory.
+     * Returns the number of entries unlinked.
+     */
+    template <typename Spawn>
+    uint64_t removeFiles(const std::shared_ptr<RemoveNode>& node, Spawn& spawn) {
+      UniqueDir dir(::opendir(node->path.c_str()));
+      if (dir == nullptr) {
+        if (errno == ENOENT) {
+          return 0;
+        }
+        throwErrno("opendir", node->path);
+      }
+      int dirFd = ::dirfd(dir.get());
+      uint64_t removed = 0;
+      while (true) {
+        errno = 0;
+        struct dirent* entry = ::readdir(dir.get());
+        if (entry == nullptr) {
+          if (errno != 0) {
+            throwErrno("readdir", node->path);
+          }
+          break;
+        }
+        if (isDotOrDotDot(entry->d_name)) {
+          continue;
+        }
+        FileType type = toFileType(entry->d_type);
+        if (type == FileType::Unknown) {
+          struct stat st {};
+          if (::fstatat(dirFd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            if (errno == ENOENT) {
+              continue;
+            }
+            throwErrno("fstatat", join(node->path, entry->d_name));
+          }
+          type = toFileType(st);
+        }
+        if (type == FileType::Directory) {
+          auto child = std::make_shared<RemoveNode>();
+          child->path = join(node->path, entry->d_name);
+          child->parent = node;
+          node->pending.fetch_add(1);
+          spawn(std::move(child));
+        } else if (::unlinkat(dirFd, entry->d_name, 0) == 0) {
+          removed++;
+        } else if (errno != ENOENT) {
+          throwErrno("unlink", join(node->path, entry->d_name));
+        }
+      }
+      return removed;
+    }
+
+    constexpr std::string_view kTrashPrefix = ".nitrofs-trash-";
+
+    std::string trashPathFor(const std::string& path) {
+      static std::atomic<uint64_t> counter{0};
+      std::random_device random;
+      std::string parent = dirname(path);
+      std::string name = std::string(kTrashPrefix) + std::to_string(random()) + "-" + std::to_string(counter.fetch_add(1));
+      return parent.empty() ? name : join(parent, name);
+    }
+
+    /**
+     * Trash directories that a thread of this process is removing right now, so that sweeps leave them alone.
+     */
+    class ActiveTrash {
+    public:
+      static ActiveTrash& shared() {
+        static ActiveTrash trash;
+        return trash;
+      }
+
+      /**
+       * Returns `false` if `path` is already claimed.
+       */
+      bool claim(const std::string& path) {
+        std::lock_guard lock(_mutex);
+        return _paths.insert(path).second;
+      }
+
+      void release(const std::string& path) {
+        std::lock_guard lock(_mutex);
+        _paths.erase(path);
+      }
+
+    private:
+      std::mutex _mutex;
+      std::set<std::string> _paths;
+    };
+
+    uint64_t removeTrash(const std::string& trashPath) {
+      RemoveOptions options;
+      options.recursive = true;
+      // Leave the cores to the foreground; nobody is waiting for this.
+      options.maxThreads = 1;
+      return removeTree(trashPath, options);
+    }
+  } // namespace
+
+  uint64_t removeTree(const std::string& path, const RemoveOptions& options) {
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) != 0) {
+      if (errno == ENOENT) {
+        return 0;
+      }
+      throwErrno("lstat", path);
+    }
+    if (!S_ISDIR(st.st_mode)) {
+      if (::unlink(path.c_str()) != 0) {
+        throwErrno("unlink", path);
+      }
+      return 1;
+    }
+    if (!options.recursive) {
+      if (::rmdir(path.c_str()) != 0) {
+        throwErrno("rmdir", path);
+      }
+      return 1;
+    }
+
+    std::atomic<uint64_t> removed{0};
+    ProgressThrottle throttle;
+    auto reportProgress = [&]() {
+      if (options.onProgress) {
+        throttle.maybeReport([&]() { options.onProgress(removed.load()); });
+      }
+    };
+    // Removes every directory whose last subdirectory just went away, walking up the tree.
+    auto finish = [&](std::shared_ptr<RemoveNode> node) {
+      while (node != nullptr && node->pending.fetch_sub(1) == 1) {
+        if (::rmdir(node->path.c_str()) != 0 && errno != ENOENT) {
+          throwErrno("rmdir", node->path);
+        }
+        removed.fetch_add(1);
+        node = node->parent;
+      }
+    };
+
+    std::vector<std::shared_ptr<RemoveNode>> initial;
+    initial.push_back(std::make_shared<RemoveNode>());
+    initial.back()->path = path;
+    parallelTasks(std::move(initial), options.maxThreads, [&](std::shared_ptr<RemoveNode>& node, auto& spawn) {
+      removed.fetch_add(removeFiles(node, spawn));
+      finish(node);
+      reportProgress();
+    });
+    if (options.onProgress) {
+      throttle.report([&]() { options.onProgress(removed.load()); });
+    }
+    return removed;
+  }
+
+  bool removeInBackground(const std::string& path) {
+    std::string trashPath = trashPathFor(path);
+    if (::rename(path.c_str(), trashPath.c_str()) != 0) {
+      if (errno == ENOENT) {
+        return false;
+      }
+      throwErrno("rename", path);
+    }
+    ActiveTrash::shared().claim(trashPath);
+    std::thread([trashPath = std::move(trashPath)]() {
+      try {
+        removeTrash(trashPath);
+      } catch (...) {
+        // Nobody to report to; whatever is left is picked up by a later sweep.
+      }
+      ActiveTrash::shared().release(trashPath);
+      try {
+        std::string parent = dirname(trashPath);
+        sweepTrash(parent.empty() ? "." : parent);
+      } catch (...) {
+        // Same as above.
+      }
+    }).detach();
+    return true;
+  }
+
+  size_t sweepTrash(const std::string& directory) {
+    std::vector<DirEntry> entries;
+    try {
+      entries = readdir(directory);
+    } catch (const std::system_error& error) {
+      if (error.code().value() == ENOENT || error.code().value() == ENOTDIR) {
+        return 0;
+      }
+      throw;
+    }
+    size_t swept = 0;
+    for (const auto& entry : entries) {
+      if (!entry.name.starts_with(kTrashPrefix) || !ActiveTrash::shared().claim(entry.path)) {
+        continue;
+      }
+      try {
+        swept += removeTrash(entry.path) > 0 ? 1 : 0;
+      } catch (...) {
+        ActiveTrash::shared().release(entry.path);
+        throw;
+      }
+      ActiveTrash::shared().release(entry.path);
+    }
+    return swept;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,47 @@
+//
+//  Remove.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "Parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct RemoveOptions {
+    /** Remove directories with everything in them. Without it, only files, symlinks and empty directories are removed. */
+    bool recursive = false;
+    size_t maxThreads = hardwareConcurrency();
+    /** Called with the number of entries removed so far, at most every 100ms (never concurrently), and once at the end. */
+    std::function<void(uint64_t)> onProgress;
+  };
+
+  /**
+   * Removes `path`. Directory trees are removed with one work-stealing task per directory: files are
+   * `unlinkat`'ed relative to their directory's fd while it is listed, and each directory is removed
+   * as soon as its last subdirectory is gone.
+   * Returns the number of entries removed, `path` included; 0 if nothing existed at `path`.
+   */
+  uint64_t removeTree(const std::string& path, const RemoveOptions& options = {});
+
+  /**
+   * Moves `path` out of the way into a hidden sibling directory, and removes it on a detached thread.
+   * Returns once `path` is gone from its place. Returns `false` if nothing existed at `path`.
+   * If the app exits first, the leftovers stay in a `.nitrofs-trash-*` directory next to `path`;
+   * the thread sweeps such leftovers from earlier runs out of the same directory once it is done.
+   */
+  bool removeInBackground(const std::string& path);
+
+  /**
+   * Removes the `.nitrofs-trash-*` directories in `directory` that no `removeInBackground` of this
+   * process is still working on, e.g. because the app was killed mid-way. Returns how many were removed.
+   */
+  size_t sweepTrash(const std::string& directory);
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,75 @@
+//
+//  Stat.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "FileSystem.hpp"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Conversions from raw `stat(2)` and `readdir(3)` results, shared by the core sources.
+   */
+
+  inline double toMilliseconds(const struct timespec& time) {
+    return static_cast<double>(time.tv_sec) * 1000.0 + static_cast<double>(time.tv_nsec) / 1'000'000.0;
+  }
+
+  inline FileStat toFileStat(const struct stat& st) {
+    FileStat result;
+    result.size = static_cast<uint64_t>(st.st_size);
+    // `st_blocks` is always in 512-byte units, whatever the filesystem's block size.
+    result.allocatedSize = static_cast<uint64_t>(st.st_blocks) * 512;
+    result.mode = static_cast<uint32_t>(st.st_mode);
+    result.device = static_cast<uint64_t>(st.st_dev);
+    result.inode = static_cast<uint64_t>(st.st_ino);
+    result.linkCount = static_cast<uint64_t>(st.st_nlink);
+#ifdef __APPLE__
+    result.ctime = toMilliseconds(st.st_birthtimespec);
+    result.mtime = toMilliseconds(st.st_mtimespec);
+#else
+    result.ctime = toMilliseconds(st.st_ctim);
+    result.mtime = toMilliseconds(st.st_mtim);
+#endif
+    result.isFile = S_ISREG(st.st_mode);
+    result.isDirectory = S_ISDIR(st.st_mode);
+    return result;
+  }
+
+  inline FileType toFileType(const struct stat& st) {
+    if (S_ISREG(st.st_mode)) {
+      return FileType::File;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      return FileType::Directory;
+    }
+    if (S_ISLNK(st.st_mode)) {
+      return FileType::Symlink;
+    }
+    return FileType::Other;
+  }
+
+  /**
+   * The type from a `dirent`'s `d_type`, which some filesystems leave as `DT_UNKNOWN`.
+   */
+  inline FileType toFileType(unsigned char dType) {
+    switch (dType) {
+      case DT_REG:
+        return FileType::File;
+      case DT_DIR:
+        return FileType::Directory;
+      case DT_LNK:
+        return FileType::Symlink;
+      case DT_UNKNOWN:
+        return FileType::Unknown;
+      default:
+        return FileType::Other;
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,210 @@
+//
+//  Text.cpp
+//  NitroFS
+//
+
+#include "Text.hpp"
+#include "TextKernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr char kReplacementCharacter[] = "\xEF\xBF\xBD"; // U+FFFD
+
+    /**
+     * Length of the well-formed UTF-8 sequence starting at `text[0]` (which must be non-ASCII),
+     * or, if it is ill-formed, the negated length of its maximal valid prefix (at least 1 byte).
+     * See "U+FFFD Substitution of Maximal Subparts" in chapter 3 of the Unicode standard.
+     */
+    int sequenceLength(const uint8_t* text, size_t size) {
+      uint8_t lead = text[0];
+      int length;
+      uint8_t secondMin = 0x80;
+      uint8_t secondMax = 0xBF;
+      if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+      } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) secondMin = 0xA0; // overlong
+        if (lead == 0xED) secondMax = 0x9F; // surrogates
+      } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) secondMin = 0x90; // overlong
+        if (lead == 0xF4) secondMax = 0x8F; // above U+10FFFF
+      } else {
+        return -1;
+      }
+      for (int i = 1; i < length; i++) {
+        if (static_cast<size_t>(i) >= size) {
+          return -i;
+        }
+        uint8_t byte = text[i];
+        uint8_t min = i == 1 ? secondMin : 0x80;
+        uint8_t max = i == 1 ? secondMax : 0xBF;
+        if (byte < min || byte > max) {
+          return -i;
+        }
+      }
+      return length;
+    }
+
+    size_t asciiPrefixLengthScalar(const char* text, size_t size) {
+      size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, text + i, sizeof(word));
+        if (word & 0x8080808080808080ULL) {
+          break;
+        }
+      }
+      while (i < size && static_cast<unsigned char>(text[i]) < 0x80) {
+        i++;
+      }
+      return i;
+    }
+
+    bool isValidUtf8Scalar(const char* text, size_t size) {
+      const auto* bytes = reinterpret_cast<const uint8_t*>(text);
+      size_t i = 0;
+      while (i < size) {
+        i += asciiPrefixLengthScalar(text + i, size - i);
+        if (i == size) {
+          break;
+        }
+        int length = sequenceLength(bytes + i, size - i);
+        if (length < 0) {
+          return false;
+        }
+        i += static_cast<size_t>(length);
+      }
+      return true;
+    }
+
+    size_t countByteScalar(const char* text, size_t size, char byte) {
+      size_t count = 0;
+      for (size_t i = 0; i < size; i++) {
+        count += text[i] == byte;
+      }
+      return count;
+    }
+
+    const text::detail::Kernels kScalarKernels{"scalar", asciiPrefixLengthScalar, isValidUtf8Scalar, countByteScalar};
+
+    std::atomic<const text::detail::Kernels*>& activeKernelsSlot() {
+      static std::atomic<const text::detail::Kernels*> slot{text::detail::availableKernels().front()};
+      return slot;
+    }
+  } // namespace
+
+  namespace text::detail {
+    const Kernels& scalarKernels() {
+      return kScalarKernels;
+    }
+
+    std::vector<const Kernels*> availableKernels() {
+      std::vector<const Kernels*> kernels;
+      for (const Kernels* simd : {ssse3Kernels(), neonKernels()}) {
+        if (simd != nullptr) {
+          kernels.push_back(simd);
+        }
+      }
+      kernels.push_back(&kScalarKernels);
+      return kernels;
+    }
+
+    const Kernels& activeKernels() {
+      return *activeKernelsSlot().load(std::memory_order_relaxed);
+    }
+
+    void setActiveKernels(const Kernels& kernels) {
+      activeKernelsSlot().store(&kernels, std::memory_order_relaxed);
+    }
+  } // namespace text::detail
+
+  size_t asciiPrefixLength(std::string_view text) {
+    return text::detail::activeKernels().asciiPrefixLength(text.data(), text.size());
+  }
+
+  bool isValidUtf8(std::string_view text) {
+    return text::detail::activeKernels().isValidUtf8(text.data(), text.size());
+  }
+
+  size_t countByte(std::string_view text, char byte) {
+    return text::detail::activeKernels().countByte(text.data(), text.size(), byte);
+  }
+
+  void sanitizeUtf8(std::string& text) {
+    if (isValidUtf8(text)) {
+      return;
+    }
+    const auto* bytes = reinterpret_cast<const uint8_t*>(text.data());
+    size_t size = text.size();
+    std::string result;
+    // Each replaced byte grows by at most 2 (1 byte -> 3-byte U+FFFD); most input needs far less.
+    result.reserve(size + size / 8);
+    size_t i = 0;
+    while (i < size) {
+      size_t ascii = asciiPrefixLength(std::string_view(text).substr(i));
+      result.append(text, i, ascii);
+      i += ascii;
+      if (i == size) {
+        break;
+      }
+      int length = sequenceLength(bytes + i, size - i);
+      if (length > 0) {
+        result.append(text, i, static_cast<size_t>(length));
+        i += static_cast<size_t>(length);
+      } else {
+        result.append(kReplacementCharacter);
+        i += static_cast<size_t>(-length);
+      }
+    }
+    text = std::move(result);
+  }
+
+  size_t incompleteUtf8SuffixLength(std::string_view text) {
+    size_t limit = std::min<size_t>(3, text.size());
+    for (size_t back = 1; back <= limit; back++) {
+      auto byte = static_cast<unsigned char>(text[text.size() - back]);
+      if ((byte & 0xC0) == 0x80) {
+        continue;
+      }
+      size_t expected = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+      return expected > back ? back : 0;
+    }
+    return 0;
+  }
+
+  std::string utf8ToAscii(std::string_view utf8) {
+    std::string ascii;
+    ascii.reserve(utf8.size());
+    size_t i = 0;
+    while (i < utf8.size()) {
+      size_t run = asciiPrefixLength(utf8.substr(i));
+      ascii.append(utf8.data() + i, run);
+      i += run;
+      for (; i < utf8.size() && static_cast<unsigned char>(utf8[i]) >= 0x80; i++) {
+        // Lead byte of a multi-byte sequence; its continuation bytes are dropped.
+        if ((static_cast<unsigned char>(utf8[i]) & 0xC0) != 0x80) {
+          ascii.push_back('?');
+        }
+      }
+    }
+    return ascii;
+  }
+
+  void sanitizeAscii(std::string& bytes) {
+    size_t i = asciiPrefixLength(bytes);
+    for (; i < bytes.size(); i++) {
+      auto byte = static_cast<unsigned char>(bytes[i]);
+      // Branch-free so the compiler can vectorise the rest of the string.
+      bytes[i] = static_cast<char>(byte < 0x80 ? byte : '?');
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
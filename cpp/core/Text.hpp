@@ -0,0 +1,52 @@
+//
+//  Text.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Length of the leading run of US-ASCII bytes in `text`.
+   */
+  size_t asciiPrefixLength(std::string_view text);
+
+  /**
+   * Whether `text` is well-formed UTF-8 (no overlongs, surrogates or code points above U+10FFFF).
+   * Uses SIMD when the CPU has it; pure ASCII input runs at memory bandwidth.
+   */
+  bool isValidUtf8(std::string_view text);
+
+  /**
+   * Number of times `byte` occurs in `text`, e.g. to count lines. Uses SIMD when the CPU has it.
+   */
+  size_t countByte(std::string_view text, char byte);
+
+  /**
+   * Makes `text` well-formed UTF-8 by replacing each invalid sequence with U+FFFD,
+   * the same way `TextDecoder` does. Valid input is left untouched and not copied.
+   */
+  void sanitizeUtf8(std::string& text);
+
+  /**
+   * Length of a multi-byte sequence that is cut off at the end of `text`, or 0.
+   * Used to split a stream of UTF-8 into chunks without breaking a character apart.
+   */
+  size_t incompleteUtf8SuffixLength(std::string_view text);
+
+  /**
+   * Converts UTF-8 text to US-ASCII, replacing every non-ASCII character with `?`.
+   */
+  std::string utf8ToAscii(std::string_view utf8);
+
+  /**
+   * Replaces every byte outside of US-ASCII with `?`, in place.
+   */
+  void sanitizeAscii(std::string& bytes);
+
+} // namespace margelo::nitro::nitrofs::core
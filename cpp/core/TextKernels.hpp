@@ -0,0 +1,42 @@
+//
+//  TextKernels.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core::text::detail {
+
+  /**
+   * Text scanning kernels for one instruction set. Each one handles the whole input, tail included.
+   */
+  struct Kernels {
+    const char* name;
+    size_t (*asciiPrefixLength)(const char* text, size_t size);
+    bool (*isValidUtf8)(const char* text, size_t size);
+    size_t (*countByte)(const char* text, size_t size, char byte);
+  };
+
+  const Kernels& scalarKernels();
+
+  /**
+   * SIMD kernels, or `nullptr` if this build or the CPU running it lacks the instruction set.
+   */
+  const Kernels* ssse3Kernels();
+  const Kernels* neonKernels();
+
+  /**
+   * Every kernel set usable on this CPU, fastest first. The last one is always `scalarKernels()`.
+   */
+  std::vector<const Kernels*> availableKernels();
+
+  /**
+   * The kernels used by `core/Text.hpp`: the fastest available unless overridden (for benchmarks).
+   */
+  const Kernels& activeKernels();
+  void setActiveKernels(const Kernels& kernels);
+
+} // namespace margelo::nitro::nitrofs::core::text::detail
@@ -0,0 +1,345 @@
+//
+//  TextSimd.cpp
+//  NitroFS
+//
+//  SSSE3 (selected at runtime on x86) and NEON (AArch64) text kernels.
+//  UTF-8 validation follows John Keiser & Daniel Lemire, "Validating UTF-8 In Less Than One
+//  Instruction Per Byte": three nibble lookups classify every byte pair, and a separate check
+//  makes sure 3- and 4-byte sequences get their continuation bytes.
+//
+
+#include "TextKernels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NITROFS_TEXT_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NITROFS_TEXT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace margelo::nitro::nitrofs::core::text::detail {
+
+#if NITROFS_TEXT_X86 || NITROFS_TEXT_NEON
+
+  namespace {
+    constexpr size_t kWindowSize = 64 * 1024;
+
+    // Error classes for a (previous byte, current byte) pair; a pair is invalid if all three lookups agree.
+    constexpr uint8_t kTooShort = 1 << 0;    // 11______ 0_______ / 11______ 11______
+    constexpr uint8_t kTooLong = 1 << 1;     // 0_______ 10______
+    constexpr uint8_t kOverlong3 = 1 << 2;   // 11100000 100_____
+    constexpr uint8_t kTooLarge = 1 << 3;    // 11110100 1001____ and above
+    constexpr uint8_t kSurrogate = 1 << 4;   // 11101101 101_____
+    constexpr uint8_t kOverlong2 = 1 << 5;   // 1100000_ 10______
+    constexpr uint8_t kTooLarge1000 = 1 << 6; // 11110101 1000____ and above
+    constexpr uint8_t kOverlong4 = 1 << 6;   // 11110000 1000____
+    constexpr uint8_t kTwoConts = 1 << 7;    // 10______ 10______
+    constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+    // Indexed by the high nibble of the previous byte.
+    alignas(16) constexpr uint8_t kByte1High[16] = {
+      kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+      kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+      kTooShort | kOverlong2,
+      kTooShort,
+      kTooShort | kOverlong3 | kSurrogate,
+      kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+    };
+
+    // Indexed by the low nibble of the previous byte.
+    alignas(16) constexpr uint8_t kByte1Low[16] = {
+      kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+      kCarry | kOverlong2,
+      kCarry,
+      kCarry,
+      kCarry | kTooLarge,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+    };
+
+    // Indexed by the high nibble of the current byte.
+    alignas(16) constexpr uint8_t kByte2High[16] = {
+      kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      kTooShort, kTooShort, kTooShort, kTooShort,
+    };
+
+    // A block ending in any byte above these still expects continuation bytes.
+    alignas(16) constexpr uint8_t kIncompleteMax[16] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+    };
+  } // namespace
+
+#endif
+
+#if NITROFS_TEXT_X86
+
+  namespace {
+#define NITROFS_SSSE3 __attribute__((target("ssse3")))
+
+    NITROFS_SSSE3 inline __m128i highNibbles(__m128i bytes) {
+      return _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F));
+    }
+
+    NITROFS_SSSE3 inline __m128i lookup(const uint8_t* table, __m128i indices) {
+      return _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(table)), indices);
+    }
+
+    /**
+     * Returns a non-zero vector if `input` (preceded by `previous`) contains an invalid sequence.
+     */
+    NITROFS_SSSE3 inline __m128i checkBlock(__m128i input, __m128i previous) {
+      const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+      const __m128i byte1High = lookup(kByte1High, highNibbles(prev1));
+      const __m128i byte1Low = lookup(kByte1Low, _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+      const __m128i byte2High = lookup(kByte2High, highNibbles(input));
+      const __m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+      // Bytes two or three places after a 3- or 4-byte lead must be continuations (and vice versa).
+      const __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+      const __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+      const __m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+      const __m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+      const __m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(static_cast<char>(0x80)));
+      return _mm_xor_si128(must23, specialCases);
+    }
+
+    NITROFS_SSSE3 size_t asciiPrefixLengthSsse3(const char* text, size_t size) {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+        if (mask != 0) {
+          return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+      }
+      while (i < size && static_cast<unsigned char>(text[i]) < 0x80) {
+        i++;
+      }
+      return i;
+    }
+
+    NITROFS_SSSE3 bool isValidUtf8Ssse3(const char* text, size_t size) {
+      const __m128i incompleteMax = _mm_load_si128(reinterpret_cast<const __m128i*>(kIncompleteMax));
+      __m128i error = _mm_setzero_si128();
+      __m128i previous = _mm_setzero_si128();
+      __m128i previousIncomplete = _mm_setzero_si128();
+
+      size_t i = 0;
+      while (i < size) {
+        // Checked for errors once per window, so invalid files are not scanned to the end.
+        size_t windowEnd = std::min(size, i + kWindowSize);
+        while (i < windowEnd) {
+          if (i + 64 <= windowEnd) {
+            const auto* blocks = reinterpret_cast<const __m128i*>(text + i);
+            const __m128i a = _mm_loadu_si128(blocks);
+            const __m128i b = _mm_loadu_si128(blocks + 1);
+            const __m128i c = _mm_loadu_si128(blocks + 2);
+            const __m128i d = _mm_loadu_si128(blocks + 3);
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) == 0) {
+              // All ASCII: only a sequence left open by the previous block can be wrong.
+              error = _mm_or_si128(error, previousIncomplete);
+              previousIncomplete = _mm_setzero_si128();
+              previous = d;
+              i += 64;
+              continue;
+            }
+          }
+
+          __m128i input;
+          if (i + 16 <= size) {
+            input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+          } else {
+            // Zero padding is ASCII, so a sequence cut off by the end of the input shows up as too short.
+            alignas(16) uint8_t tail[16] = {};
+            std::memcpy(tail, text + i, size - i);
+            input = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+          }
+          if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, previousIncomplete);
+            previousIncomplete = _mm_setzero_si128();
+          } else {
+            error = _mm_or_si128(error, checkBlock(input, previous));
+            previousIncomplete = _mm_subs_epu8(input, incompleteMax);
+          }
+          previous = input;
+          i += 16;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) {
+          return false;
+        }
+      }
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(previousIncomplete, _mm_setzero_si128())) == 0xFFFF;
+    }
+
+    NITROFS_SSSE3 size_t countByteSsse3(const char* text, size_t size, char byte) {
+      const __m128i needle = _mm_set1_epi8(byte);
+      size_t count = 0;
+      size_t i = 0;
+      for (; i + 64 <= size; i += 64) {
+        const auto* blocks = reinterpret_cast<const __m128i*>(text + i);
+        // One 64-bit mask per 64 bytes, so a single popcount covers four loads.
+        uint64_t mask = static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(blocks), needle)));
+        mask |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(blocks + 1), needle))) << 16;
+        mask |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(blocks + 2), needle))) << 32;
+        mask |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(blocks + 3), needle))) << 48;
+        count += static_cast<size_t>(__builtin_popcountll(mask));
+      }
+      for (; i < size; i++) {
+        count += text[i] == byte;
+      }
+      return count;
+    }
+
+#undef NITROFS_SSSE3
+  } // namespace
+
+  const Kernels* ssse3Kernels() {
+    static const Kernels kernels{"ssse3", asciiPrefixLengthSsse3, isValidUtf8Ssse3, countByteSsse3};
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") ? &kernels : nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#elif NITROFS_TEXT_NEON
+
+  namespace {
+    inline uint8x16_t checkBlock(uint8x16_t input, uint8x16_t previous) {
+      const uint8x16_t prev1 = vextq_u8(previous, input, 15);
+      const uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(kByte1High), vshrq_n_u8(prev1, 4));
+      const uint8x16_t byte1Low = vqtbl1q_u8(vld1q_u8(kByte1Low), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+      const uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(kByte2High), vshrq_n_u8(input, 4));
+      const uint8x16_t specialCases = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+      const uint8x16_t prev2 = vextq_u8(previous, input, 14);
+      const uint8x16_t prev3 = vextq_u8(previous, input, 13);
+      const uint8x16_t isThirdByte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+      const uint8x16_t isFourthByte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+      const uint8x16_t must23 = vandq_u8(vorrq_u8(isThirdByte, isFourthByte), vdupq_n_u8(0x80));
+      return veorq_u8(must23, specialCases);
+    }
+
+    size_t asciiPrefixLengthNeon(const char* text, size_t size) {
+      size_t i = 0;
+      for (; i + 16 <= size; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(text + i))) >= 0x80) {
+          break;
+        }
+      }
+      while (i < size && static_cast<unsigned char>(text[i]) < 0x80) {
+        i++;
+      }
+      return i;
+    }
+
+    bool isValidUtf8Neon(const char* text, size_t size) {
+      const uint8x16_t incompleteMax = vld1q_u8(kIncompleteMax);
+      uint8x16_t error = vdupq_n_u8(0);
+      uint8x16_t previous = vdupq_n_u8(0);
+      uint8x16_t previousIncomplete = vdupq_n_u8(0);
+
+      size_t i = 0;
+      while (i < size) {
+        // Checked for errors once per window, so invalid files are not scanned to the end.
+        size_t windowEnd = std::min(size, i + kWindowSize);
+        while (i < windowEnd) {
+          if (i + 64 <= windowEnd) {
+            const uint8x16x4_t blocks = vld1q_u8_x4(reinterpret_cast<const uint8_t*>(text + i));
+            const uint8x16_t any = vorrq_u8(vorrq_u8(blocks.val[0], blocks.val[1]), vorrq_u8(blocks.val[2], blocks.val[3]));
+            if (vmaxvq_u8(any) < 0x80) {
+              // All ASCII: only a sequence left open by the previous block can be wrong.
+              error = vorrq_u8(error, previousIncomplete);
+              previousIncomplete = vdupq_n_u8(0);
+              previous = blocks.val[3];
+              i += 64;
+              continue;
+            }
+          }
+
+          uint8x16_t input;
+          if (i + 16 <= size) {
+            input = vld1q_u8(reinterpret_cast<const uint8_t*>(text + i));
+          } else {
+            // Zero padding is ASCII, so a sequence cut off by the end of the input shows up as too short.
+            uint8_t tail[16] = {};
+            std::memcpy(tail, text + i, size - i);
+            input = vld1q_u8(tail);
+          }
+          if (vmaxvq_u8(input) < 0x80) {
+            error = vorrq_u8(error, previousIncomplete);
+            previousIncomplete = vdupq_n_u8(0);
+          } else {
+            error = vorrq_u8(error, checkBlock(input, previous));
+            previousIncomplete = vqsubq_u8(input, incompleteMax);
+          }
+          previous = input;
+          i += 16;
+        }
+        if (vmaxvq_u8(error) != 0) {
+          return false;
+        }
+      }
+      return vmaxvq_u8(previousIncomplete) == 0;
+    }
+
+    size_t countByteNeon(const char* text, size_t size, char byte) {
+      const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(byte));
+      size_t count = 0;
+      size_t i = 0;
+      while (i + 16 <= size) {
+        // Matches are 0xFF, so subtracting them counts up by one; widened before the lanes can overflow.
+        uint8x16_t counts = vdupq_n_u8(0);
+        size_t batchEnd = std::min(size - size % 16, i + 255 * 16);
+        for (; i < batchEnd; i += 16) {
+          counts = vsubq_u8(counts, vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(text + i)), needle));
+        }
+        count += vaddlvq_u8(counts);
+      }
+      for (; i < size; i++) {
+        count += text[i] == byte;
+      }
+      return count;
+    }
+  } // namespace
+
+  const Kernels* ssse3Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    static const Kernels kernels{"neon", asciiPrefixLengthNeon, isValidUtf8Neon, countByteNeon};
+    return &kernels;
+  }
+
+#else
+
+  const Kernels* ssse3Kernels() {
+    return nullptr;
+  }
+
+  const Kernels* neonKernels() {
+    return nullptr;
+  }
+
+#endif
+
+} // namespace margelo::nitro::nitrofs::core::text::detail
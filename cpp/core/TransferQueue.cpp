@@ -0,0 +1,272 @@
+//
+//  TransferQueue.cpp
+//  NitroFS
+//
+
+#include "TransferQueue.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace margelo::nitro::nitrofs::core {
+
+  TransferLimits TransferQueue::limits() const {
+    std::lock_guard lock(_mutex);
+    return _limits;
+  }
+
+  void TransferQueue::setLimits(const TransferLimits& limits) {
+    std::vector<std::function<void()>> starts;
+    {
+      std::lock_guard lock(_mutex);
+      _limits = limits;
+      starts = takeStartable();
+    }
+    run(starts);
+  }
+
+  TransferQueue::Id TransferQueue::add(TransferJob job, TransferPriority priority) {
+    std::vector<std::function<void()>> starts;
+    Id id;
+    {
+      std::lock_guard lock(_mutex);
+      id = _nextId++;
+      _entries.emplace(id, Entry{std::move(job), priority});
+      waiting(priority).insert(id);
+      starts = takeStartable();
+    }
+    run(starts);
+    return id;
+  }
+
+  TransferState TransferQueue::finished(Id id, bool succeeded) {
+    std::vector<std::function<void()>> starts;
+    // Destroyed outside the lock, as the callbacks may own whatever holds the queue.
+    TransferJob retired;
+    TransferState state;
+    {
+      std::lock_guard lock(_mutex);
+      auto found = _entries.find(id);
+      if (found == _entries.end() || !found->second.active) {
+        return succeeded ? TransferState::Completed : TransferState::Failed;
+      }
+      Entry& entry = found->second;
+      release(entry);
+      if (succeeded) {
+        state = TransferState::Completed;
+      } else if (entry.state == TransferState::Running) {
+        state = TransferState::Failed;
+      } else {
+        state = entry.state;
+      }
+      if (state == TransferState::Queued) {
+        waiting(entry.priority).insert(id);
+      } else if (state != TransferState::Paused) {
+        retired = std::move(entry.job);
+        _entries.erase(found);
+      }
+      starts = takeStartable();
+    }
+    run(starts);
+    return state;
+  }
+
+  bool TransferQueue::pause(Id id) {
+    std::function<void(Id)> stop;
+    {
+      std::lock_guard lock(_mutex);
+      auto found = _entries.find(id);
+      if (found == _entries.end()) {
+        return false;
+      }
+      Entry& entry = found->second;
+      switch (entry.state) {
+        case TransferState::Queued:
+          // An active entry is still stopping from an earlier pause, so it isn't in the line.
+          if (!entry.active) {
+            waiting(entry.priority).erase(id);
+          }
+          break;
+        case TransferState::Running:
+          stop = entry.job.stop;
+          break;
+        default:
+          return false;
+      }
+      entry.state = TransferState::Paused;
+    }
+    if (stop) {
+      stop(id);
+    }
+    return true;
+  }
+
+  bool TransferQueue::resume(Id id) {
+    std::vector<std::function<void()>> starts;
+    {
+      std::lock_guard lock(_mutex);
+      auto found = _entries.find(id);
+      if (found == _entries.end() || found->second.state != TransferState::Paused) {
+        return false;
+      }
+      Entry& entry = found->second;
+      entry.state = TransferState::Queued;
+      // Otherwise `finished` puts it back in line once the stopped attempt has ended.
+      if (!entry.active) {
+        waiting(entry.priority).insert(id);
+        starts = takeStartable();
+      }
+    }
+    run(starts);
+    return true;
+  }
+
+  bool TransferQueue::cancel(Id id) {
+    std::function<void(Id)> stop;
+    TransferJob retired;
+    bool gone = false;
+    {
+      std::lock_guard lock(_mutex);
+      auto found = _entries.find(id);
+      if (found == _entries.end()) {
+        return false;
+      }
+      Entry& entry = found->second;
+      if (entry.active) {
+        if (entry.state == TransferState::Running) {
+          stop = entry.job.stop;
+        }
+        entry.state = TransferState::Cancelled;
+      } else {
+        waiting(entry.priority).erase(id);
+        retired = std::move(entry.job);
+        _entries.erase(found);
+        gone = true;
+      }
+    }
+    if (stop) {
+      stop(id);
+    }
+    return gone;
+  }
+
+  void TransferQueue::setPriority(Id id, TransferPriority priority) {
+    std::vector<std::function<void()>> starts;
+    {
+      std::lock_guard lock(_mutex);
+      auto found = _entries.find(id);
+      if (found == _entries.end() || found->second.priority == priority) {
+        return;
+      }
+      Entry& entry = found->second;
+      if (entry.active) {
+        // The slot moves along, so `release` counts it against the right class.
+        if (priority == TransferPriority::Prefetch) {
+          _activePrefetch++;
+        } else {
+          _activePrefetch--;
+        }
+      } else if (entry.state == TransferState::Queued) {
+        waiting(entry.priority).erase(id);
+        waiting(priority).insert(id);
+      }
+      entry.priority = priority;
+      starts = takeStartable();
+    }
+    run(starts);
+  }
+
+  std::optional<TransferState> TransferQueue::state(Id id) const {
+    std::lock_guard lock(_mutex);
+    auto found = _entries.find(id);
+    if (found == _entries.end()) {
+      return std::nullopt;
+    }
+    return found->second.state;
+  }
+
+  std::optional<TransferPriority> TransferQueue::priority(Id id) const {
+    std::lock_guard lock(_mutex);
+    auto found = _entries.find(id);
+    if (found == _entries.end()) {
+      return std::nullopt;
+    }
+    return found->second.priority;
+  }
+
+  std::string TransferQueue::hostOf(const std::string& url) {
+    size_t start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    size_t end = url.find_first_of("/?#", start);
+    std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+      authority.erase(0, at + 1);
+    }
+    std::transform(authority.begin(), authority.end(), authority.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+    return authority;
+  }
+
+  std::vector<std::function<void()>> TransferQueue::takeStartable() {
+    std::vector<std::function<void()>> starts;
+    size_t maxConcurrent = std::max<size_t>(1, _limits.maxConcurrent);
+    size_t maxPerHost = std::max<size_t>(1, _limits.maxPerHost);
+    size_t maxPrefetch = std::max<size_t>(1, maxConcurrent / 2);
+    for (TransferPriority priority : {TransferPriority::UserVisible, TransferPriority::Prefetch}) {
+      bool prefetch = priority == TransferPriority::Prefetch;
+      if (prefetch && !_waitingUserVisible.empty()) {
+        break;
+      }
+      std::set<Id>& line = waiting(priority);
+      for (auto it = line.begin(); it != line.end() && _active < maxConcurrent;) {
+        if (prefetch && _activePrefetch >= maxPrefetch) {
+          break;
+        }
+        Id id = *it;
+        Entry& entry = _entries.at(id);
+        auto host = _activeByHost.find(entry.job.host);
+        if (host != _activeByHost.end() && host->second >= maxPerHost) {
+          ++it;
+          continue;
+        }
+        _activeByHost[entry.job.host]++;
+        _active++;
+        if (prefetch) {
+          _activePrefetch++;
+        }
+        entry.state = TransferState::Running;
+        entry.active = true;
+        starts.emplace_back([start = entry.job.start, id]() {
+          start(id);
+        });
+        it = line.erase(it);
+      }
+    }
+    return starts;
+  }
+
+  void TransferQueue::release(Entry& entry) {
+    entry.active = false;
+    _active--;
+    if (entry.priority == TransferPriority::Prefetch) {
+      _activePrefetch--;
+    }
+    auto host = _activeByHost.find(entry.job.host);
+    if (host != _activeByHost.end() && --host->second == 0) {
+      _activeByHost.erase(host);
+    }
+  }
+
+  std::set<TransferQueue::Id>& TransferQueue::waiting(TransferPriority priority) {
+    return priority == TransferPriority::Prefetch ? _waitingPrefetch : _waitingUserVisible;
+  }
+
+  void TransferQueue::run(const std::vector<std::function<void()>>& starts) {
+    for (const auto& start : starts) {
+      start();
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::core
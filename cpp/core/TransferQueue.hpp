@@ -0,0 +1,131 @@
+//
+//  TransferQueue.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  enum class TransferPriority {
+    /** Something the user is waiting on. Always starts before any prefetch. */
+    UserVisible,
+    /** Speculative work. Only starts while no user-visible transfer is waiting. */
+    Prefetch,
+  };
+
+  enum class TransferState { Queued, Running, Paused, Completed, Failed, Cancelled };
+
+  struct TransferLimits {
+    /** Transfers running at once, across all hosts. */
+    size_t maxConcurrent = 8;
+    /** Transfers running at once to one host. */
+    size_t maxPerHost = 6;
+  };
+
+  /**
+   * What the queue needs to drive one transfer. The callbacks are called without any lock held,
+   * from whichever thread made room for the transfer.
+   */
+  struct TransferJob {
+    /** The scheme-less authority transfers are counted against, see `TransferQueue::hostOf`. */
+    std::string host;
+    /** Starts an attempt. Its end, however it comes, must be reported through `TransferQueue::finished`. */
+    std::function<void(uint64_t /* id */)> start;
+    /** Asks the running attempt to stop early. It still reports its end through `finished`. */
+    std::function<void(uint64_t /* id */)> stop;
+  };
+
+  /**
+   * Schedules network transfers under a global and a per-host concurrency cap.
+   *
+   * Waiting transfers start in order of arrival within their priority, skipping those whose host is at its
+   * cap, so one busy host doesn't hold up the others. Prefetches never take more than half of the slots, so
+   * a user-visible transfer that arrives finds one free or waits for at most one to finish.
+   *
+   * A transfer stays known to the queue until it completes, fails or is cancelled; pausing it stops its
+   * attempt and frees its slot, and resuming puts it back in its old place in the line. All methods are
+   * thread-safe.
+   */
+  class TransferQueue {
+  public:
+    using Id = uint64_t;
+
+    TransferQueue() = default;
+    TransferQueue(const TransferQueue&) = delete;
+    TransferQueue& operator=(const TransferQueue&) = delete;
+
+    TransferLimits limits() const;
+    /** Takes effect for transfers that start from now on; running ones are never stopped for it. */
+    void setLimits(const TransferLimits& limits);
+
+    /** Queues a transfer, starting it right away if there is room. */
+    Id add(TransferJob job, TransferPriority priority);
+
+    /**
+     * Reports the end of an attempt, and returns what became of the transfer: `Completed` or `Failed`,
+     * `Cancelled` if it was cancelled meanwhile, or `Paused` or `Queued` if it was paused (and resumed)
+     * meanwhile, in which case it runs again once resumed and there is room. A success always completes.
+     */
+    TransferState finished(Id id, bool succeeded);
+
+    /** Returns `false` if the transfer was neither waiting nor running. */
+    bool pause(Id id);
+    /** Returns `false` if the transfer wasn't paused. */
+    bool resume(Id id);
+    /**
+     * Returns `true` if the transfer is gone right away. If an attempt is still running, it is stopped,
+     * and the `Cancelled` comes out of `finished`.
+     */
+    bool cancel(Id id);
+    void setPriority(Id id, TransferPriority priority);
+
+    /** `std::nullopt` once the transfer has completed, failed or been cancelled. */
+    std::optional<TransferState> state(Id id) const;
+    std::optional<TransferPriority> priority(Id id) const;
+
+    /**
+     * The lowercased `host[:port]` of a URL, without user info. Transfers to the same one share a cap.
+     */
+    static std::string hostOf(const std::string& url);
+
+  private:
+    struct Entry {
+      TransferJob job;
+      TransferPriority priority;
+      TransferState state = TransferState::Queued;
+      /** An attempt is in flight, which holds a slot even if the transfer was paused or cancelled. */
+      bool active = false;
+    };
+
+    /** Marks every transfer that fits as running and returns their starts. Needs `_mutex`. */
+    std::vector<std::function<void()>> takeStartable();
+    /** Gives back the slot of an attempt that ended. Needs `_mutex`. */
+    void release(Entry& entry);
+    std::set<Id>& waiting(TransferPriority priority);
+    static void run(const std::vector<std::function<void()>>& starts);
+
+  private:
+    mutable std::mutex _mutex;
+    TransferLimits _limits;
+    Id _nextId = 1;
+    std::unordered_map<Id, Entry> _entries;
+    /** Ids only grow, so each set is in order of arrival. */
+    std::set<Id> _waitingUserVisible;
+    std::set<Id> _waitingPrefetch;
+    std::unordered_map<std::string, size_t> _activeByHost;
+    size_t _active = 0;
+    size_t _activePrefetch = 0;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
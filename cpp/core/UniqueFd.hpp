@@ -0,0 +1,47 @@
+//
+//  UniqueFd.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include <unistd.h>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  /**
+   * Owns a POSIX file descriptor and closes it when it goes out of scope.
+   */
+  class UniqueFd {
+  public:
+    UniqueFd() = default;
+    explicit UniqueFd(int fd): _fd(fd) {}
+    ~UniqueFd() { reset(); }
+
+    UniqueFd(const UniqueFd&) = delete;
+    UniqueFd& operator=(const UniqueFd&) = delete;
+    UniqueFd(UniqueFd&& other) noexcept: _fd(std::exchange(other._fd, -1)) {}
+    UniqueFd& operator=(UniqueFd&& other) noexcept {
+      if (this != &other) {
+        reset(std::exchange(other._fd, -1));
+      }
+      return *this;
+    }
+
+    int get() const noexcept { return _fd; }
+    explicit operator bool() const noexcept { return _fd >= 0; }
+
+    int release() noexcept { return std::exchange(_fd, -1); }
+    void reset(int fd = -1) noexcept {
+      if (_fd >= 0) {
+        ::close(_fd);
+      }
+      _fd = fd;
+    }
+
+  private:
+    int _fd = -1;
+  };
+
+} // namespace margelo::nitro::nitrofs::core
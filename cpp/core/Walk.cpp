@@ -0,0 +1,324 @@
+//
+//  Walk.cpp
+//  NitroFS
+//
+
+#include "Walk.hpp"
+#include "Errors.hpp"
+#include "Stat.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <system_error>
+#include <utility>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    /**
+     * A directory on the way down to a task, kept while following symlinks so that a link to one of them is
+     * recognised as a cycle.
+     */
+    struct Ancestor {
+      uint64_t device = 0;
+      uint64_t inode = 0;
+      std::shared_ptr<const Ancestor> parent;
+    };
+
+    bool isAncestor(const Ancestor* ancestor, const struct stat& st) {
+      for (; ancestor != nullptr; ancestor = ancestor->parent.get()) {
+        if (ancestor->device == static_cast<uint64_t>(st.st_dev) && ancestor->inode == static_cast<uint64_t>(st.st_ino)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    struct WalkTask {
+      std::string path;
+      size_t depth = 0;
+      /** The task's own directory and those above it. Only set while following symlinks. */
+      std::shared_ptr<const Ancestor> ancestors;
+    };
+
+    /**
+     * Whether a subdirectory that fails with `code` is skipped rather than failing the whole walk.
+     */
+    bool isSkippable(int code) {
+      return code == EACCES || code == EPERM || code == ENOENT || code == ENOTDIR || code == ELOOP;
+    }
+
+    /**
+     * The hard-linked files counted so far, so that one with several links is counted once, like `du` does.
+     */
+    class LinkedFiles {
+    public:
+      /**
+       * Returns `false` if the file was counted before, under another name.
+       */
+      bool insert(const FileStat& stat) {
+        std::lock_guard lock(_mutex);
+        return _counted.emplace(stat.device, stat.inode).second;
+      }
+
+    private:
+      std::mutex _mutex;
+      std::set<std::pair<uint64_t, uint64_t>> _counted;
+    };
+
+    /**
+     * Collects entries from all workers and hands out full batches, one at a time.
+     */
+    class BatchSink {
+    public:
+      BatchSink(size_t batchSize, const std::function<void(std::vector<DirEntry>&&)>& onBatch): _batchSize(std::max<size_t>(1, batchSize)), _onBatch(onBatch) {}
+
+      void add(std::vector<DirEntry>&& entries) {
+        std::lock_guard lock(_mutex);
+        for (auto& entry : entries) {
+          _batch.push_back(std::move(entry));
+          _count++;
+          if (_batch.size() >= _batchSize) {
+            flushLocked();
+          }
+        }
+      }
+
+      uint64_t finish() {
+        std::lock_guard lock(_mutex);
+        if (!_batch.empty()) {
+          flushLocked();
+        }
+        return _count;
+      }
+
+    private:
+      void flushLocked() {
+        std::vector<DirEntry> batch;
+        batch.reserve(_batchSize);
+        std::swap(batch, _batch);
+        _onBatch(std::move(batch));
+      }
+
+    private:
+      size_t _batchSize;
+      const std::function<void(std::vector<DirEntry>&&)>& _onBatch;
+      std::mutex _mutex;
+      std::vector<DirEntry> _batch;
+      uint64_t _count = 0;
+    };
+
+    /**
+     * Keeps the `k` largest entries seen so far. `offer` only takes the lock for entries that could make the cut.
+     */
+    class LargestEntries {
+    public:
+      explicit LargestEntries(size_t k): _k(k) {}
+
+      void offer(const std::string& path, uint64_t size) {
+        if (_k == 0 || size < _threshold.load(std::memory_order_relaxed)) {
+          return;
+        }
+        std::lock_guard lock(_mutex);
+        _heap.push_back(DiskUsageEntry{path, size});
+        std::push_heap(_heap.begin(), _heap.end(), isLarger);
+        if (_heap.size() > _k) {
+          std::pop_heap(_heap.begin(), _heap.end(), isLarger);
+          _heap.pop_back();
+        }
+        if (_heap.size() == _k) {
+          _threshold = _heap.front().size;
+        }
+      }
+
+      std::vector<DiskUsageEntry> take() {
+        std::lock_guard lock(_mutex);
+        std::sort_heap(_heap.begin(), _heap.end(), isLarger);
+        return std::move(_heap);
+      }
+
+    private:
+      // A min-heap, so the smallest of the k largest is at the front.
+      static bool isLarger(const DiskUsageEntry& lhs, const DiskUsageEntry& rhs) {
+        return lhs.size > rhs.size;
+      }
+
+    private:
+      size_t _k;
+      std::atomic<uint64_t> _threshold{0};
+      std::mutex _mutex;
+      std::vector<DiskUsageEntry> _heap;
+    };
+
+    /**
+     * A directory whose subtree total is known once its own listing and all of its subdirectories are done.
+     */
+    struct UsageNode {
+      std::string path;
+      std::shared_ptr<UsageNode> parent;
+      std::atomic<uint64_t> size{0};
+      // Its own listing, plus one per subdirectory still being counted.
+      std::atomic<size_t> pending{1};
+    };
+  } // namespace
+
+  uint64_t walk(const std::string& root, const WalkOptions& options, const std::function<void(std::vector<DirEntry>&&)>& onBatch) {
+    DirDetail detail = options.detail == DirDetail::Stats ? DirDetail::Stats : DirDetail::Types;
+    BatchSink sink(options.batchSize, onBatch);
+    std::shared_ptr<const Ancestor> rootAncestor;
+    if (options.followSymlinks) {
+      struct stat st {};
+      if (::stat(root.c_str(), &st) != 0) {
+        throwErrno("stat", root);
+      }
+      rootAncestor = std::make_shared<Ancestor>(Ancestor{static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino), nullptr});
+    }
+    if (options.maxDepth == 0) {
+      return 0;
+    }
+
+    std::vector<WalkTask> initial;
+    initial.push_back(WalkTask{root, 0, std::move(rootAncestor)});
+    parallelTasks(std::move(initial), options.maxThreads, [&](WalkTask& task, auto& spawn) {
+      std::vector<DirEntry> entries;
+      try {
+        entries = readdir(task.path, detail);
+      } catch (const std::system_error& error) {
+        if (task.depth == 0 || !isSkippable(error.code().value())) {
+          throw;
+        }
+        return;
+      }
+
+      std::vector<DirEntry> reported;
+      reported.reserve(entries.size());
+      for (auto& entry : entries) {
+        if (options.exclude && options.exclude(entry)) {
+          continue;
+        }
+        std::shared_ptr<const Ancestor> ancestors;
+        if (options.followSymlinks && (entry.type == FileType::Symlink || entry.type == FileType::Directory)) {
+          struct stat st {};
+          if (::stat(entry.path.c_str(), &st) == 0) {
+            if (entry.type == FileType::Symlink) {
+              entry.type = toFileType(st);
+              if (entry.stat.has_value()) {
+                entry.stat = toFileStat(st);
+              }
+            }
+            if (entry.type == FileType::Directory) {
+              if (isAncestor(task.ancestors.get(), st)) {
+                // A link to a directory it is inside of: report it, but don't walk into it again.
+                entry.type = FileType::Symlink;
+              } else {
+                ancestors = std::make_shared<Ancestor>(
+                  Ancestor{static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino), task.ancestors});
+              }
+            }
+          }
+        }
+        if (entry.type == FileType::Directory && task.depth + 1 < options.maxDepth) {
+          spawn(WalkTask{entry.path, task.depth + 1, std::move(ancestors)});
+        }
+        if (!options.filter || options.filter(entry)) {
+          reported.push_back(std::move(entry));
+        }
+      }
+      sink.add(std::move(reported));
+    });
+    return sink.finish();
+  }
+
+  DiskUsage diskUsage(const std::string& path, size_t maxThreads, size_t topK) {
+    DiskUsage usage;
+    struct stat rootStat {};
+    if (::lstat(path.c_str(), &rootStat) != 0) {
+      throwErrno("lstat", path);
+    }
+    if (!S_ISDIR(rootStat.st_mode)) {
+      FileStat stat = toFileStat(rootStat);
+      usage.size = stat.size;
+      usage.allocatedSize = stat.allocatedSize;
+      usage.fileCount = 1;
+      if (topK > 0) {
+        usage.largestFiles.push_back(DiskUsageEntry{path, stat.size});
+      }
+      return usage;
+    }
+
+    std::atomic<uint64_t> size{0};
+    std::atomic<uint64_t> allocatedSize{0};
+    std::atomic<uint64_t> fileCount{0};
+    std::atomic<uint64_t> directoryCount{0};
+    LargestEntries largestFiles(topK);
+    LargestEntries largestDirectories(topK);
+    LinkedFiles linkedFiles;
+
+    // Passes a finished directory's total up the tree, finishing parents whose last subdirectory this was.
+    auto finish = [&](std::shared_ptr<UsageNode> node) {
+      while (node != nullptr && node->pending.fetch_sub(1) == 1) {
+        uint64_t total = node->size.load();
+        if (node->parent == nullptr) {
+          break;
+        }
+        largestDirectories.offer(node->path, total);
+        node->parent->size.fetch_add(total);
+        node = node->parent;
+      }
+    };
+
+    std::vector<std::shared_ptr<UsageNode>> initial;
+    initial.push_back(std::make_shared<UsageNode>());
+    initial.back()->path = path;
+    parallelTasks(std::move(initial), maxThreads, [&](std::shared_ptr<UsageNode>& node, auto& spawn) {
+      std::vector<DirEntry> entries;
+      try {
+        entries = readdir(node->path, DirDetail::Stats);
+      } catch (const std::system_error& error) {
+        if (node->parent == nullptr || !isSkippable(error.code().value())) {
+          throw;
+        }
+        finish(node);
+        return;
+      }
+
+      uint64_t filesSize = 0;
+      for (auto& entry : entries) {
+        const FileStat& stat = *entry.stat;
+        if (entry.type == FileType::File && stat.linkCount > 1 && !linkedFiles.insert(stat)) {
+          continue;
+        }
+        allocatedSize.fetch_add(stat.allocatedSize, std::memory_order_relaxed);
+        if (entry.type == FileType::Directory) {
+          directoryCount.fetch_add(1, std::memory_order_relaxed);
+          auto child = std::make_shared<UsageNode>();
+          child->path = std::move(entry.path);
+          child->parent = node;
+          node->pending.fetch_add(1);
+          spawn(std::move(child));
+        } else {
+          fileCount.fetch_add(1, std::memory_order_relaxed);
+          filesSize += stat.size;
+          largestFiles.offer(entry.path, stat.size);
+        }
+      }
+      size.fetch_add(filesSize, std::memory_order_relaxed);
+      node->size.fetch_add(filesSize);
+      finish(node);
+    });
+
+    usage.size = size;
+    usage.allocatedSize = allocatedSize;
+    usage.fileCount = fileCount;
+    usage.directoryCount = directoryCount;
+    usage.largestFiles = largestFiles.take();
+    usage.largestDirectories = largestDirectories.take();
+    return usage;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,72 @@
+//
+//  Walk.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "FileSystem.hpp"
+#include "Parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct WalkOptions {
+    /** How many levels below the root are listed; 1 lists only the root's own entries. */
+    size_t maxDepth = SIZE_MAX;
+    /**
+     * Descend into symlinked directories and report symlinks as what they point to, like `find -L`. A link to a
+     * directory it is inside of is reported as a symlink and not walked again.
+     */
+    bool followSymlinks = false;
+    /** `Names` is treated like `Types`, since the walk needs every entry's type anyway. */
+    DirDetail detail = DirDetail::Types;
+    /** Entries for which this returns `true` are neither reported nor descended into. */
+    std::function<bool(const DirEntry&)> exclude;
+    /** Entries for which this returns `false` are not reported, but directories are still descended into. */
+    std::function<bool(const DirEntry&)> filter;
+    size_t batchSize = 1000;
+    size_t maxThreads = hardwareConcurrency();
+  };
+
+  /**
+   * Lists a directory tree with one work-stealing task per directory, handing the entries to `onBatch`
+   * in batches of up to `batchSize` while the walk goes on. `onBatch` is never called concurrently.
+   * Errors listing the root are thrown; subdirectories that vanish or can't be read are skipped.
+   * Returns the number of entries reported.
+   */
+  uint64_t walk(const std::string& root, const WalkOptions& options, const std::function<void(std::vector<DirEntry>&&)>& onBatch);
+
+  struct DiskUsageEntry {
+    std::string path;
+    uint64_t size = 0;
+  };
+
+  /**
+   * Totals for a directory tree. The root itself is not counted in `directoryCount` or `largestDirectories`.
+   */
+  struct DiskUsage {
+    uint64_t size = 0;
+    uint64_t allocatedSize = 0;
+    uint64_t fileCount = 0;
+    uint64_t directoryCount = 0;
+    /** Largest first. */
+    std::vector<DiskUsageEntry> largestFiles;
+    /** Largest first, by the total size of everything below them. */
+    std::vector<DiskUsageEntry> largestDirectories;
+  };
+
+  /**
+   * Adds up the sizes of everything below `path` on up to `maxThreads` threads, without following symlinks.
+   * Every non-directory counts as a file; one with several hard links counts once, under the first name found.
+   * Subdirectories that vanish or can't be read are skipped like in `walk`.
+   * `topK` is the number of `largestFiles` and `largestDirectories` to keep.
+   */
+  DiskUsage diskUsage(const std::string& path, size_t maxThreads, size_t topK);
+
+} // namespace margelo::nitro::nitrofs::core
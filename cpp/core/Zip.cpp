@@ -0,0 +1,1178 @@
+//
+//  Zip.cpp
+//  NitroFS
+//
+
+#include "Zip.hpp"
+#include "ByteBuffer.hpp"
+#include "Compression.hpp"
+#include "Errors.hpp"
+#include "FileCopy.hpp"
+#include "FileIO.hpp"
+#include "FileSystem.hpp"
+#include "Path.hpp"
+#include "Progress.hpp"
+#include "Stat.hpp"
+#include "UniqueFd.hpp"
+#include "Walk.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::core {
+
+  namespace {
+    constexpr uint32_t kLocalHeaderSignature = 0x04034b50;
+    constexpr uint32_t kCentralHeaderSignature = 0x02014b50;
+    constexpr uint32_t kEndSignature = 0x06054b50;
+    constexpr uint32_t kZip64EndSignature = 0x06064b50;
+    constexpr uint32_t kZip64LocatorSignature = 0x07064b50;
+    constexpr size_t kLocalHeaderSize = 30;
+    constexpr size_t kCentralHeaderSize = 46;
+    constexpr size_t kEndSize = 22;
+    constexpr size_t kZip64EndSize = 56;
+    constexpr size_t kZip64LocatorSize = 20;
+    constexpr uint16_t kZip64ExtraId = 0x0001;
+    // Info-ZIP's extended timestamp ("UT"): flags, then the mtime in seconds since the epoch if bit 0 is set.
+    constexpr uint16_t kTimestampExtraId = 0x5455;
+    constexpr size_t kTimestampExtraSize = 9;
+    constexpr uint16_t kMethodStored = 0;
+    constexpr uint16_t kMethodDeflated = 8;
+    constexpr uint16_t kFlagEncrypted = 1 << 0;
+    constexpr uint16_t kFlagUtf8 = 1 << 11;
+    // Archives made on these hosts keep the Unix mode in the upper half of the external attributes.
+    constexpr uint16_t kHostUnix = 3;
+    constexpr uint16_t kHostMacOS = 19;
+    constexpr uint16_t kVersion = 20;
+    constexpr uint16_t kVersionZip64 = 45;
+    constexpr uint32_t kMax16 = 0xFFFF;
+    constexpr uint32_t kMax32 = 0xFFFFFFFF;
+    // Entries that may deflate to 4GB or more get zip64 sizes in their local header, which is written before that is known.
+    constexpr uint64_t kZip64LocalThreshold = 0xFF000000;
+    // Files are split into chunks of this size for parallel deflate.
+    constexpr size_t kChunkSize = 1024 * 1024;
+    // Deflate's window: every chunk but a file's first is primed with this much of the data before it.
+    constexpr size_t kDictionarySize = 32 * 1024;
+    // Entries are read from the archive and inflated this much at a time.
+    constexpr size_t kReadSize = 256 * 1024;
+    constexpr size_t kWriteBufferSize = 1024 * 1024;
+    // One round of zip() deflates up to this many chunks per thread before they are written out...
+    constexpr size_t kBatchChunksPerThread = 2;
+    // ...but never more than this many entries, however small they are.
+    constexpr size_t kMaxBatchChunks = 4096;
+
+    uint16_t load16(const uint8_t* data) {
+      return static_cast<uint16_t>(data[0] | (data[1] << 8));
+    }
+
+    uint32_t load32(const uint8_t* data) {
+      return static_cast<uint32_t>(load16(data)) | (static_cast<uint32_t>(load16(data + 2)) << 16);
+    }
+
+    uint64_t load64(const uint8_t* data) {
+      return static_cast<uint64_t>(load32(data)) | (static_cast<uint64_t>(load32(data + 4)) << 32);
+    }
+
+    void append16(std::string& out, uint32_t value) {
+      out.push_back(static_cast<char>(value & 0xFF));
+      out.push_back(static_cast<char>((value >> 8) & 0xFF));
+    }
+
+    void append32(std::string& out, uint64_t value) {
+      append16(out, static_cast<uint32_t>(value & 0xFFFF));
+      append16(out, static_cast<uint32_t>((value >> 16) & 0xFFFF));
+    }
+
+    void append64(std::string& out, uint64_t value) {
+      append32(out, value & kMax32);
+      append32(out, value >> 32);
+    }
+
+    class ProgressReporter {
+    public:
+      ProgressReporter(const std::function<void(const ZipProgress&)>& onProgress, uint64_t totalBytes, uint64_t totalEntries)
+          : _onProgress(onProgress), _totalBytes(totalBytes), _totalEntries(totalEntries) {}
+
+      void bytesDone(uint64_t size) {
+        _processedBytes.fetch_add(size, std::memory_order_relaxed);
+        if (_onProgress) {
+          _throttle.maybeReport([&]() { _onProgress(current()); });
+        }
+      }
+
+      void entryDone() {
+        _processedEntries.fetch_add(1, std::memory_order_relaxed);
+        if (_onProgress) {
+          _throttle.maybeReport([&]() { _onProgress(current()); });
+        }
+      }
+
+      void finish() {
+        if (_onProgress) {
+          _throttle.report([&]() { _onProgress(current()); });
+        }
+      }
+
+    private:
+      ZipProgress current() const {
+        return ZipProgress{_processedBytes.load(), _totalBytes, _processedEntries.load(), _totalEntries};
+      }
+
+    private:
+      const std::function<void(const ZipProgress&)>& _onProgress;
+      uint64_t _totalBytes;
+      uint64_t _totalEntries;
+      std::atomic<uint64_t> _processedBytes{0};
+      std::atomic<uint64_t> _processedEntries{0};
+      ProgressThrottle _throttle;
+    };
+
+    struct InflateStream {
+      z_stream stream {};
+      ~InflateStream() { inflateEnd(&stream); }
+    };
+
+    struct DeflateStream {
+      z_stream stream {};
+      ~DeflateStream() { deflateEnd(&stream); }
+    };
+
+    struct ZipEntry {
+      std::string name;
+      uint16_t flags = 0;
+      uint16_t method = 0;
+      uint32_t crc = 0;
+      uint64_t compressedSize = 0;
+      uint64_t size = 0;
+      uint64_t localHeaderOffset = 0;
+      /** The Unix mode, if the archive was made on a Unix-like system. */
+      uint32_t mode = 0;
+      /** Milliseconds since the epoch, from the extended timestamp if there is one, otherwise from the MS-DOS time. */
+      double mtime = 0;
+    };
+
+    struct CentralDirectory {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      uint64_t entries = 0;
+    };
+
+    [[noreturn]] void throwInvalid(const std::string& archivePath, const std::string& reason) {
+      throw std::invalid_argument("unzip(" + archivePath + "): " + reason);
+    }
+
+    /**
+     * Finds the end of central directory record, which ends the archive followed only by a comment of up to 64KB,
+     * and the zip64 record it points to if the directory's size, offset or entry count didn't fit.
+     */
+    CentralDirectory findCentralDirectory(int fd, uint64_t archiveSize, const std::string& archivePath) {
+      size_t tailSize = static_cast<size_t>(std::min<uint64_t>(archiveSize, kEndSize + kMax16));
+      if (tailSize < kEndSize) {
+        throwInvalid(archivePath, "not a zip archive");
+      }
+      uint64_t tailOffset = archiveSize - tailSize;
+      std::vector<uint8_t> tail(tailSize);
+      if (preadFully(fd, tail.data(), tail.size(), tailOffset, archivePath) != tail.size()) {
+        throwInvalid(archivePath, "truncated archive");
+      }
+      size_t end = SIZE_MAX;
+      for (size_t i = tailSize - kEndSize + 1; i-- > 0;) {
+        if (load32(&tail[i]) == kEndSignature && i + kEndSize + load16(&tail[i + 20]) <= tailSize) {
+          end = i;
+          break;
+        }
+      }
+      if (end == SIZE_MAX) {
+        throwInvalid(archivePath, "not a zip archive");
+      }
+
+      const uint8_t* record = &tail[end];
+      if (load16(record + 4) != 0 || load16(record + 6) != 0) {
+        throwInvalid(archivePath, "multi-volume archives are not supported");
+      }
+      CentralDirectory directory{load32(record + 16), load32(record + 12), load16(record + 10)};
+      uint64_t endOffset = tailOffset + end;
+      if ((directory.entries == kMax16 || directory.size == kMax32 || directory.offset == kMax32) && endOffset >= kZip64LocatorSize) {
+        uint8_t locator[kZip64LocatorSize];
+        if (preadFully(fd, locator, sizeof(locator), endOffset - kZip64LocatorSize, archivePath) == sizeof(locator) &&
+            load32(locator) == kZip64LocatorSignature) {
+          uint64_t zip64Offset = load64(locator + 8);
+          uint8_t zip64End[kZip64EndSize];
+          if (zip64Offset > endOffset || preadFully(fd, zip64End, sizeof(zip64End), zip64Offset, archivePath) != sizeof(zip64End) ||
+              load32(zip64End) != kZip64EndSignature) {
+            throwInvalid(archivePath, "corrupt zip64 end of central directory");
+          }
+          directory.entries = load64(zip64End + 32);
+          directory.size = load64(zip64End + 40);
+          directory.offset = load64(zip64End + 48);
+          endOffset = zip64Offset;
+        }
+      }
+      if (directory.offset > endOffset || directory.size > endOffset - directory.offset) {
+        throwInvalid(archivePath, "central directory out of bounds");
+      }
+      return directory;
+    }
+
+    /**
+     * The MS-DOS date and time, which are in local time, in milliseconds since the epoch.
+     */
+    double fromDosTime(uint16_t dosTime, uint16_t dosDate) {
+      struct tm local {};
+      local.tm_year = (dosDate >> 9) + 80;
+      local.tm_mon = ((dosDate >> 5) & 0xF) - 1;
+      local.tm_mday = dosDate & 0x1F;
+      local.tm_hour = dosTime >> 11;
+      local.tm_min = (dosTime >> 5) & 0x3F;
+      local.tm_sec = (dosTime & 0x1F) * 2;
+      local.tm_isdst = -1;
+      time_t seconds = mktime(&local);
+      return seconds == -1 ? 0 : static_cast<double>(seconds) * 1000.0;
+    }
+
+    /**
+     * Replaces the sizes and offset that didn't fit in 32 bits with the values from the zip64 extra field,
+     * and the MS-DOS time with the extended timestamp.
+     */
+    void readExtraFields(const uint8_t* extra, size_t length, ZipEntry& entry, const std::string& archivePath) {
+      while (length >= 4) {
+        uint16_t id = load16(extra);
+        size_t size = load16(extra + 2);
+        if (size > length - 4) {
+          return;
+        }
+        if (id == kTimestampExtraId && size >= 5 && (extra[4] & 1) != 0) {
+          entry.mtime = static_cast<double>(static_cast<int32_t>(load32(extra + 5))) * 1000.0;
+        }
+        if (id == kZip64ExtraId) {
+          const uint8_t* field = extra + 4;
+          const uint8_t* fieldEnd = field + size;
+          for (uint64_t* value : {&entry.size, &entry.compressedSize, &entry.localHeaderOffset}) {
+            if (*value != kMax32) {
+              continue;
+            }
+            if (fieldEnd - field < 8) {
+              throwInvalid(archivePath, "corrupt zip64 extra field for " + entry.name);
+            }
+            *value = load64(field);
+            field += 8;
+          }
+        }
+        extra += 4 + size;
+        length -= 4 + size;
+      }
+    }
+
+    std::vector<ZipEntry> readEntries(int fd, uint64_t archiveSize, const std::string& archivePath) {
+      CentralDirectory directory = findCentralDirectory(fd, archiveSize, archivePath);
+      if (directory.size > SIZE_MAX) {
+        throwInvalid(archivePath, "central directory too large");
+      }
+      std::vector<uint8_t> data(static_cast<size_t>(directory.size));
+      if (preadFully(fd, data.data(), data.size(), directory.offset, archivePath) != data.size()) {
+        throwInvalid(archivePath, "truncated central directory");
+      }
+
+      std::vector<ZipEntry> entries;
+      entries.reserve(static_cast<size_t>(std::min<uint64_t>(directory.entries, data.size() / kCentralHeaderSize)));
+      size_t position = 0;
+      for (uint64_t i = 0; i < directory.entries; i++) {
+        if (data.size() - position < kCentralHeaderSize || load32(&data[position]) != kCentralHeaderSignature) {
+          throwInvalid(archivePath, "corrupt central directory");
+        }
+        const uint8_t* header = &data[position];
+        size_t nameLength = load16(header + 28);
+        size_t extraLength = load16(header + 30);
+        size_t commentLength = load16(header + 32);
+        if (data.size() - position - kCentralHeaderSize < nameLength + extraLength + commentLength) {
+          throwInvalid(archivePath, "corrupt central directory");
+        }
+        ZipEntry entry;
+        entry.flags = load16(header + 8);
+        entry.method = load16(header + 10);
+        entry.crc = load32(header + 16);
+        entry.compressedSize = load32(header + 20);
+        entry.size = load32(header + 24);
+        entry.localHeaderOffset = load32(header + 42);
+        entry.mtime = fromDosTime(load16(header + 12), load16(header + 14));
+        uint16_t host = load16(header + 4) >> 8;
+        if (host == kHostUnix || host == kHostMacOS) {
+          entry.mode = load32(header + 38) >> 16;
+        }
+        const uint8_t* name = header + kCentralHeaderSize;
+        entry.name.assign(reinterpret_cast<const char*>(name), nameLength);
+        readExtraFields(name + nameLength, extraLength, entry, archivePath);
+        entries.push_back(std::move(entry));
+        position += kCentralHeaderSize + nameLength + extraLength + commentLength;
+      }
+      return entries;
+    }
+
+    /**
+     * The entry's path relative to the destination, with empty and `.` components dropped.
+     * Absolute paths and `..` components would let an archive write anywhere (a "zip slip"), so they throw.
+     */
+    std::string relativeEntryPath(const std::string& name, const std::string& archivePath) {
+      if (name.empty() || name.front() == '/' || name.find('\0') != std::string::npos) {
+        throwInvalid(archivePath, "unsafe entry path \"" + name + "\"");
+      }
+      std::string result;
+      size_t start = 0;
+      while (start < name.size()) {
+        size_t end = std::min(name.find('/', start), name.size());
+        std::string_view component(name.data() + start, end - start);
+        if (component == "..") {
+          throwInvalid(archivePath, "unsafe entry path \"" + name + "\"");
+        }
+        if (!component.empty() && component != ".") {
+          if (!result.empty()) {
+            result.push_back('/');
+          }
+          result.append(component);
+        }
+        start = end + 1;
+      }
+      return result;
+    }
+
+    /**
+     * Streams an entry's uncompressed data to `sink`, then checks its size and CRC-32.
+     */
+    void readEntryData(int fd, uint64_t archiveSize, const std::string& archivePath, const ZipEntry& entry, const ByteSink& sink) {
+      uint8_t header[kLocalHeaderSize];
+      if (entry.localHeaderOffset > archiveSize ||
+          preadFully(fd, header, sizeof(header), entry.localHeaderOffset, archivePath) != sizeof(header) ||
+          load32(header) != kLocalHeaderSignature) {
+        throwInvalid(archivePath, "corrupt local header for " + entry.name);
+      }
+      uint64_t offset = entry.localHeaderOffset + kLocalHeaderSize + load16(header + 26) + load16(header + 28);
+      if (offset > archiveSize || entry.compressedSize > archiveSize - offset) {
+        throwInvalid(archivePath, "truncated data for " + entry.name);
+      }
+
+      uint32_t crc = crc32(0, nullptr, 0);
+      uint64_t produced = 0;
+      auto emit = [&](const uint8_t* data, size_t size) {
+        produced += size;
+        if (produced > entry.size) {
+          throwInvalid(archivePath, entry.name + " is larger than its recorded size");
+        }
+        crc = crc32(crc, data, static_cast<uInt>(size));
+        sink(data, size);
+      };
+      uint64_t remaining = entry.compressedSize;
+      ByteBuffer input(static_cast<size_t>(std::min<uint64_t>(kReadSize, std::max<uint64_t>(remaining, 1))));
+      auto readInput = [&]() {
+        size_t length = static_cast<size_t>(std::min<uint64_t>(input.size(), remaining));
+        if (preadFully(fd, input.data(), length, offset, archivePath) != length) {
+          throwInvalid(archivePath, "truncated data for " + entry.name);
+        }
+        offset += length;
+        remaining -= length;
+        return length;
+      };
+
+      if (entry.method == kMethodStored) {
+        while (remaining > 0) {
+          size_t length = readInput();
+          emit(input.data(), length);
+        }
+      } else {
+        InflateStream inflater;
+        z_stream& stream = inflater.stream;
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+          throw std::runtime_error("inflateInit2 failed");
+        }
+        ByteBuffer output(kReadSize);
+        int result = Z_OK;
+        while (result != Z_STREAM_END) {
+          if (stream.avail_in == 0) {
+            if (remaining == 0) {
+              throwInvalid(archivePath, "truncated data for " + entry.name);
+            }
+            stream.avail_in = static_cast<uInt>(readInput());
+            stream.next_in = input.data();
+          }
+          stream.next_out = output.data();
+          stream.avail_out = static_cast<uInt>(output.size());
+          result = inflate(&stream, Z_NO_FLUSH);
+          if (result != Z_OK && result != Z_STREAM_END) {
+            throwInvalid(archivePath, "corrupt data for " + entry.name + (stream.msg != nullptr ? std::string(": ") + stream.msg : ""));
+          }
+          emit(output.data(), output.size() - stream.avail_out);
+        }
+      }
+      if (produced != entry.size) {
+        throwInvalid(archivePath, entry.name + " is smaller than its recorded size");
+      }
+      if (crc != entry.crc) {
+        throwInvalid(archivePath, "CRC mismatch for " + entry.name);
+      }
+    }
+
+    /**
+     * Where an archive is extracted to. Entries are resolved one component at a time from a descriptor of `destDir`,
+     * with O_NOFOLLOW, so a symlink already inside it (left there by an earlier archive, say) can't carry an entry
+     * outside. Such entries are rejected, as libarchive's secure mode does. `destDir` itself may be a symlink.
+     */
+    class Destination {
+    public:
+      Destination(const std::string& destDir, const std::string& archivePath): _destDir(destDir), _archivePath(archivePath) {
+        mkdirs(destDir);
+        _root.reset(::open(destDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (!_root) {
+          throwErrno("open", destDir);
+        }
+      }
+
+      /**
+       * Opens the directory at `relative` ("" for `destDir`), creating any component that is missing. `entryName`
+       * is the entry it is for, for errors.
+       */
+      UniqueFd openDirectory(std::string_view relative, const std::string& entryName) const {
+        UniqueFd current(::openat(_root.get(), ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (!current) {
+          throwErrno("open", _destDir);
+        }
+        size_t start = 0;
+        while (start < relative.size()) {
+          size_t end = std::min(relative.find('/', start), relative.size());
+          std::string name(relative.substr(start, end - start));
+          std::string path = join(_destDir, relative.substr(0, end));
+          UniqueFd next(::openat(current.get(), name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+          if (!next && errno == ENOENT) {
+            if (::mkdirat(current.get(), name.c_str(), 0777) != 0 && errno != EEXIST) {
+              throwErrno("mkdir", path);
+            }
+            next.reset(::openat(current.get(), name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC));
+          }
+          if (!next) {
+            int error = errno;
+            struct stat st {};
+            if (::fstatat(current.get(), name.c_str(), &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISLNK(st.st_mode)) {
+              throwInvalid(_archivePath, entryName + " would be extracted through the symlink " + path);
+            }
+            throwError(error, "open", path);
+          }
+          current = std::move(next);
+          start = end + 1;
+        }
+        return current;
+      }
+
+      /**
+       * Creates or truncates `name` in `directory`. A symlink already there is replaced rather than followed.
+       */
+      UniqueFd createFile(int directory, const std::string& name, const std::string& path) const {
+        UniqueFd fd(::openat(directory, name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0666));
+        if (!fd && errno == ELOOP) {
+          ::unlinkat(directory, name.c_str(), 0);
+          fd.reset(::openat(directory, name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, 0666));
+        }
+        if (!fd) {
+          throwErrno("open", path);
+        }
+        return fd;
+      }
+
+      /**
+       * Creates the symlink `name` in `directory`, replacing whatever file or symlink is already there.
+       */
+      void createSymlink(int directory, const std::string& name, const std::string& target, const std::string& path) const {
+        if (::symlinkat(target.c_str(), directory, name.c_str()) != 0) {
+          if (errno != EEXIST || ::unlinkat(directory, name.c_str(), 0) != 0 ||
+              ::symlinkat(target.c_str(), directory, name.c_str()) != 0) {
+            throwErrno("symlink", path);
+          }
+        }
+      }
+
+    private:
+      std::string _destDir;
+      std::string _archivePath;
+      UniqueFd _root;
+    };
+
+    /**
+     * The entry's permission bits, without setuid, setgid and sticky, or 0 if the archive doesn't have them.
+     */
+    mode_t permissions(const ZipEntry& entry) {
+      return static_cast<mode_t>(entry.mode & 0777);
+    }
+
+    timespec toTimespec(double milliseconds) {
+      double seconds = std::floor(milliseconds / 1000.0);
+      return timespec{static_cast<time_t>(seconds), static_cast<long>((milliseconds - seconds * 1000.0) * 1'000'000.0)};
+    }
+
+    /**
+     * Restores the mode and mtime of an extracted file or directory, open as `fd`. Like unzip(1), this is best
+     * effort: some filesystems (FAT on SD cards) refuse both, and the data is there either way.
+     */
+    void restoreMetadata(int fd, const ZipEntry& entry) {
+      const timespec times[2] = {{0, UTIME_OMIT}, toTimespec(entry.mtime)};
+      if (entry.mode != 0) {
+        ::fchmod(fd, permissions(entry));
+      }
+      ::futimens(fd, times);
+    }
+
+    /**
+     * Restores the mtime of the symlink `name` in `directory`, without following it.
+     */
+    void restoreSymlinkTime(int directory, const std::string& name, const ZipEntry& entry) {
+      const timespec times[2] = {{0, UTIME_OMIT}, toTimespec(entry.mtime)};
+      ::utimensat(directory, name.c_str(), times, AT_SYMLINK_NOFOLLOW);
+    }
+
+    struct ZipItem {
+      std::string path;
+      /** The name in the archive; directories end with `/`. */
+      std::string name;
+      FileType type = FileType::File;
+      uint64_t size = 0;
+      double mtime = 0;
+      uint32_t mode = 0;
+    };
+
+    /**
+     * One piece of an entry, deflated on its own. Directories and symlinks are a single chunk.
+     */
+    struct Chunk {
+      size_t item = 0;
+      uint64_t offset = 0;
+      size_t length = 0;
+      bool last = false;
+      /** What goes into the archive: deflated data, or the raw bytes if `stored`. */
+      ByteBuffer data;
+      /** The raw bytes of a deflated chunk that didn't shrink. */
+      ByteBuffer raw;
+      uint32_t crc = 0;
+      bool stored = false;
+    };
+
+    struct CentralRecord {
+      std::string name;
+      uint32_t mode = 0;
+      uint16_t method = kMethodStored;
+      uint16_t dosTime = 0;
+      uint16_t dosDate = 0;
+      /** The mtime for the extended timestamp, in seconds since the epoch. */
+      uint32_t unixTime = 0;
+      uint32_t crc = 0;
+      uint64_t compressedSize = 0;
+      uint64_t size = 0;
+      uint64_t localHeaderOffset = 0;
+      /** The local header has a zip64 extra field for the sizes. */
+      bool zip64 = false;
+    };
+
+    std::vector<ZipItem> planZip(const std::string& srcPath, const std::string& archivePath, size_t maxThreads) {
+      struct stat st {};
+      if (::lstat(srcPath.c_str(), &st) != 0) {
+        throwErrno("lstat", srcPath);
+      }
+      std::vector<ZipItem> items;
+      if (!S_ISDIR(st.st_mode)) {
+        FileType type = toFileType(st);
+        if (type != FileType::File && type != FileType::Symlink) {
+          throwError(EINVAL, "zip", srcPath);
+        }
+        FileStat stat = toFileStat(st);
+        items.push_back(ZipItem{srcPath, basename(srcPath), type, stat.size, stat.mtime, stat.mode});
+        return items;
+      }
+
+      WalkOptions walkOptions;
+      walkOptions.detail = DirDetail::Stats;
+      walkOptions.maxThreads = maxThreads;
+      // An earlier version of the archive inside the tree must not end up in the new one.
+      walkOptions.exclude = [&](const DirEntry& entry) { return entry.path == archivePath; };
+      size_t prefixLength = join(srcPath, "").size();
+      walk(srcPath, walkOptions, [&](std::vector<DirEntry>&& entries) {
+        for (auto& entry : entries) {
+          // Sockets and FIFOs have no contents to archive.
+          if (entry.type == FileType::Other || entry.type == FileType::Unknown || !entry.stat.has_value()) {
+            continue;
+          }
+          ZipItem item{std::move(entry.path), {}, entry.type, entry.stat->size, entry.stat->mtime, entry.stat->mode};
+          item.name = item.path.substr(prefixLength);
+          if (item.type == FileType::Directory) {
+            item.name.push_back('/');
+            item.size = 0;
+          }
+          items.push_back(std::move(item));
+        }
+      });
+      std::sort(items.begin(), items.end(), [](const ZipItem& lhs, const ZipItem& rhs) { return lhs.name < rhs.name; });
+      return items;
+    }
+
+    /**
+     * Reads `length` bytes of `item` at `offset`, failing if the file shrank since it was planned.
+     */
+    ByteBuffer readItemData(const ZipItem& item, uint64_t offset, size_t length) {
+      ByteBuffer data(length);
+      if (length > 0) {
+        UniqueFd fd(::open(item.path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (!fd) {
+          throwErrno("open", item.path);
+        }
+        if (preadFully(fd.get(), data.data(), length, offset, item.path) != length) {
+          throw std::runtime_error("zip(" + item.path + "): the file shrank while it was being archived");
+        }
+      }
+      return data;
+    }
+
+    /**
+     * Replaces a deflated chunk with its raw bytes, for entries that turned out to be stored.
+     */
+    void storeChunk(const ZipItem& item, Chunk& chunk) {
+      if (chunk.stored) {
+        return;
+      }
+      if (chunk.raw.size() == chunk.length) {
+        chunk.data = std::move(chunk.raw);
+      } else {
+        chunk.data = readItemData(item, chunk.offset, chunk.length);
+        if (crc32(0, chunk.data.data(), static_cast<uInt>(chunk.length)) != chunk.crc) {
+          throw std::runtime_error("zip(" + item.path + "): the file changed while it was being archived");
+        }
+      }
+      chunk.stored = true;
+    }
+
+    /**
+     * Reads and deflates one chunk. A file's chunks are raw deflate streams ending in a sync flush (the last one in
+     * a final block), so they can be concatenated into one stream; each is primed with the data before it.
+     */
+    void compressChunk(const ZipItem& item, Chunk& chunk, int level) {
+      if (item.type == FileType::Directory) {
+        chunk.stored = true;
+        return;
+      }
+      if (item.type == FileType::Symlink) {
+        std::string target(PATH_MAX, '\0');
+        ssize_t length = ::readlink(item.path.c_str(), target.data(), target.size());
+        if (length < 0) {
+          throwErrno("readlink", item.path);
+        }
+        chunk.length = static_cast<size_t>(length);
+        chunk.data = ByteBuffer(chunk.length);
+        std::memcpy(chunk.data.data(), target.data(), chunk.length);
+        chunk.crc = crc32(0, chunk.data.data(), static_cast<uInt>(chunk.length));
+        chunk.stored = true;
+        return;
+      }
+
+      size_t dictionary = level == 0 ? 0 : static_cast<size_t>(std::min<uint64_t>(chunk.offset, kDictionarySize));
+      ByteBuffer input = readItemData(item, chunk.offset - dictionary, dictionary + chunk.length);
+      const uint8_t* data = input.data() + dictionary;
+      chunk.crc = crc32(0, data, static_cast<uInt>(chunk.length));
+      if (level == 0) {
+        chunk.data = std::move(input);
+        chunk.stored = true;
+        return;
+      }
+
+      DeflateStream deflater;
+      z_stream& stream = deflater.stream;
+      if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+      }
+      if (dictionary > 0) {
+        deflateSetDictionary(&stream, input.data(), static_cast<uInt>(dictionary));
+      }
+      // deflateBound includes room for a zlib header this stream doesn't have, which covers the sync flush marker.
+      ByteBuffer output(deflateBound(&stream, static_cast<uLong>(chunk.length)) + 16);
+      stream.next_in = const_cast<uint8_t*>(data);
+      stream.avail_in = static_cast<uInt>(chunk.length);
+      stream.next_out = output.data();
+      stream.avail_out = static_cast<uInt>(output.size());
+      while (true) {
+        int result = deflate(&stream, chunk.last ? Z_FINISH : Z_SYNC_FLUSH);
+        if (result == Z_STREAM_ERROR) {
+          throw std::runtime_error("deflate failed");
+        }
+        if (chunk.last ? result == Z_STREAM_END : stream.avail_in == 0 && stream.avail_out > 0) {
+          break;
+        }
+        size_t used = output.size() - stream.avail_out;
+        output.resize(output.size() * 2);
+        stream.next_out = output.data() + used;
+        stream.avail_out = static_cast<uInt>(output.size() - used);
+      }
+      output.resize(output.size() - stream.avail_out);
+
+      // A chunk that doesn't shrink is kept raw, in case its entry ends up stored (see `zip`).
+      if (output.size() >= chunk.length) {
+        if (dictionary > 0) {
+          std::memmove(input.data(), input.data() + dictionary, chunk.length);
+        }
+        input.resize(chunk.length);
+        chunk.raw = std::move(input);
+      }
+      chunk.data = std::move(output);
+    }
+
+    /**
+     * MS-DOS date and time in local time, as zip stores them, clamped to the representable 1980-2107.
+     */
+    void toDosTime(double mtime, uint16_t& dosTime, uint16_t& dosDate) {
+      time_t seconds = static_cast<time_t>(mtime / 1000.0);
+      struct tm local {};
+      if (localtime_r(&seconds, &local) == nullptr || local.tm_year < 80) {
+        dosTime = 0;
+        dosDate = (1 << 5) | 1;
+        return;
+      }
+      int year = std::min(local.tm_year - 80, 127);
+      dosTime = static_cast<uint16_t>((local.tm_hour << 11) | (local.tm_min << 5) | (local.tm_sec / 2));
+      dosDate = static_cast<uint16_t>((year << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+    }
+
+    void appendTimestampExtra(std::string& out, const CentralRecord& record) {
+      append16(out, kTimestampExtraId);
+      append16(out, kTimestampExtraSize - 4);
+      out.push_back(1);
+      append32(out, record.unixTime);
+    }
+
+    std::string localHeader(const CentralRecord& record) {
+      std::string header;
+      header.reserve(kLocalHeaderSize + record.name.size() + 20 + kTimestampExtraSize);
+      append32(header, kLocalHeaderSignature);
+      append16(header, record.zip64 ? kVersionZip64 : kVersion);
+      append16(header, kFlagUtf8);
+      append16(header, record.method);
+      append16(header, record.dosTime);
+      append16(header, record.dosDate);
+      append32(header, record.crc);
+      append32(header, record.zip64 ? kMax32 : record.compressedSize);
+      append32(header, record.zip64 ? kMax32 : record.size);
+      append16(header, static_cast<uint32_t>(record.name.size()));
+      append16(header, static_cast<uint32_t>((record.zip64 ? 20 : 0) + kTimestampExtraSize));
+      header += record.name;
+      if (record.zip64) {
+        append16(header, kZip64ExtraId);
+        append16(header, 16);
+        append64(header, record.size);
+        append64(header, record.compressedSize);
+      }
+      appendTimestampExtra(header, record);
+      return header;
+    }
+
+    void appendCentralHeader(std::string& out, const CentralRecord& record) {
+      bool sizesInExtra = record.zip64 || record.size >= kMax32 || record.compressedSize >= kMax32;
+      bool offsetInExtra = record.localHeaderOffset >= kMax32;
+      std::string extra;
+      if (sizesInExtra) {
+        append64(extra, record.size);
+        append64(extra, record.compressedSize);
+      }
+      if (offsetInExtra) {
+        append64(extra, record.localHeaderOffset);
+      }
+      append32(out, kCentralHeaderSignature);
+      append16(out, (kHostUnix << 8) | kVersionZip64);
+      append16(out, extra.empty() ? kVersion : kVersionZip64);
+      append16(out, kFlagUtf8);
+      append16(out, record.method);
+      append16(out, record.dosTime);
+      append16(out, record.dosDate);
+      append32(out, record.crc);
+      append32(out, sizesInExtra ? kMax32 : record.compressedSize);
+      append32(out, sizesInExtra ? kMax32 : record.size);
+      append16(out, static_cast<uint32_t>(record.name.size()));
+      append16(out, static_cast<uint32_t>((extra.empty() ? 0 : extra.size() + 4) + kTimestampExtraSize));
+      // Comment length, disk number and internal attributes.
+      append16(out, 0);
+      append16(out, 0);
+      append16(out, 0);
+      // The Unix mode, plus the MS-DOS directory attribute for readers that ignore it.
+      append32(out, (static_cast<uint64_t>(record.mode) << 16) | (S_ISDIR(record.mode) ? 0x10 : 0));
+      append32(out, offsetInExtra ? kMax32 : record.localHeaderOffset);
+      out += record.name;
+      if (!extra.empty()) {
+        append16(out, kZip64ExtraId);
+        append16(out, static_cast<uint32_t>(extra.size()));
+        out += extra;
+      }
+      appendTimestampExtra(out, record);
+    }
+
+    /**
+     * The archive being written, through a buffer. It is removed again unless `commit` is reached.
+     */
+    class ArchiveWriter {
+    public:
+      explicit ArchiveWriter(const std::string& path): _path(path) {
+        std::string parent = dirname(path);
+        if (!parent.empty()) {
+          mkdirs(parent);
+        }
+        _fd = UniqueFd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666));
+        if (!_fd) {
+          throwErrno("open", path);
+        }
+        _buffer.reserve(kWriteBufferSize);
+      }
+
+      ~ArchiveWriter() {
+        if (!_committed) {
+          _fd.reset();
+          ::unlink(_path.c_str());
+        }
+      }
+
+      uint64_t offset() const { return _flushed + _buffer.size(); }
+
+      void append(const void* data, size_t size) {
+        if (_buffer.size() + size > kWriteBufferSize) {
+          flush();
+        }
+        if (size >= kWriteBufferSize) {
+          writeFully(_fd.get(), data, size, _path);
+          _flushed += size;
+          return;
+        }
+        _buffer.append(static_cast<const char*>(data), size);
+      }
+
+      void append(const std::string& data) { append(data.data(), data.size()); }
+
+      /**
+       * Overwrites bytes appended earlier, like a local header whose sizes weren't known when it was written.
+       */
+      void patch(uint64_t offset, const std::string& data) {
+        flush();
+        pwriteFully(_fd.get(), data.data(), data.size(), offset, _path);
+      }
+
+      /**
+       * Drops everything from `offset` on, so it can be written again.
+       */
+      void truncate(uint64_t offset) {
+        flush();
+        if (::ftruncate(_fd.get(), static_cast<off_t>(offset)) != 0) {
+          throwErrno("ftruncate", _path);
+        }
+        if (::lseek(_fd.get(), static_cast<off_t>(offset), SEEK_SET) < 0) {
+          throwErrno("lseek", _path);
+        }
+        _flushed = offset;
+      }
+
+      void commit() {
+        flush();
+        if (::close(_fd.release()) != 0) {
+          throwErrno("close", _path);
+        }
+        _committed = true;
+      }
+
+    private:
+      void flush() {
+        if (!_buffer.empty()) {
+          writeFully(_fd.get(), _buffer.data(), _buffer.size(), _path);
+          _flushed += _buffer.size();
+          _buffer.clear();
+        }
+      }
+
+    private:
+      const std::string& _path;
+      UniqueFd _fd;
+      std::string _buffer;
+      uint64_t _flushed = 0;
+      bool _committed = false;
+    };
+
+    /**
+     * Replaces the deflated entry written last, starting at `record.localHeaderOffset`, with its raw bytes.
+     */
+    void rewriteStored(ArchiveWriter& writer, const ZipItem& item, CentralRecord& record) {
+      writer.truncate(record.localHeaderOffset);
+      record.method = kMethodStored;
+      record.compressedSize = record.size;
+      writer.append(localHeader(record));
+      uint32_t crc = crc32(0, nullptr, 0);
+      for (uint64_t offset = 0; offset < record.size; offset += kChunkSize) {
+        size_t length = static_cast<size_t>(std::min<uint64_t>(kChunkSize, record.size - offset));
+        ByteBuffer data = readItemData(item, offset, length);
+        crc = crc32(crc, data.data(), static_cast<uInt>(length));
+        writer.append(data.data(), length);
+      }
+      if (crc != record.crc) {
+        throw std::runtime_error("zip(" + item.path + "): the file changed while it was being archived");
+      }
+    }
+
+    void appendEndOfCentralDirectory(std::string& out, uint64_t entries, uint64_t directoryOffset, uint64_t directorySize) {
+      uint64_t zip64EndOffset = directoryOffset + directorySize;
+      if (entries >= kMax16 || directoryOffset >= kMax32 || directorySize >= kMax32) {
+        append32(out, kZip64EndSignature);
+        append64(out, kZip64EndSize - 12);
+        append16(out, (kHostUnix << 8) | kVersionZip64);
+        append16(out, kVersionZip64);
+        append32(out, 0);
+        append32(out, 0);
+        append64(out, entries);
+        append64(out, entries);
+        append64(out, directorySize);
+        append64(out, directoryOffset);
+        append32(out, kZip64LocatorSignature);
+        append32(out, 0);
+        append64(out, zip64EndOffset);
+        append32(out, 1);
+      }
+      append32(out, kEndSignature);
+      append16(out, 0);
+      append16(out, 0);
+      append16(out, static_cast<uint32_t>(std::min<uint64_t>(entries, kMax16)));
+      append16(out, static_cast<uint32_t>(std::min<uint64_t>(entries, kMax16)));
+      append32(out, std::min<uint64_t>(directorySize, kMax32));
+      append32(out, std::min<uint64_t>(directoryOffset, kMax32));
+      append16(out, 0);
+    }
+  } // namespace
+
+  uint64_t unzip(const std::string& archivePath, const std::string& destDir, const UnzipOptions& options) {
+    UniqueFd fd(::open(archivePath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd) {
+      throwErrno("open", archivePath);
+    }
+    struct stat st {};
+    if (::fstat(fd.get(), &st) != 0) {
+      throwErrno("fstat", archivePath);
+    }
+    if (S_ISDIR(st.st_mode)) {
+      throwError(EISDIR, "read", archivePath);
+    }
+    uint64_t archiveSize = static_cast<uint64_t>(st.st_size);
+    std::vector<ZipEntry> entries = readEntries(fd.get(), archiveSize, archivePath);
+
+    // Every entry is checked before anything is written. A path that appears twice is extracted from its last entry.
+    std::vector<std::string> relatives(entries.size());
+    // Directories to create, each with the entry that needs it.
+    std::vector<std::pair<std::string, size_t>> directories;
+    std::unordered_map<std::string_view, size_t> latest;
+    std::vector<size_t> directoryEntries;
+    for (size_t i = 0; i < entries.size(); i++) {
+      const ZipEntry& entry = entries[i];
+      std::string relative = relativeEntryPath(entry.name, archivePath);
+      if (relative.empty()) {
+        continue;
+      }
+      bool isDirectory = entry.name.back() == '/' || S_ISDIR(entry.mode);
+      if (!isDirectory && (entry.flags & kFlagEncrypted) != 0) {
+        throwInvalid(archivePath, entry.name + " is encrypted, which is not supported");
+      }
+      if (!isDirectory && entry.method != kMethodStored && entry.method != kMethodDeflated) {
+        throwInvalid(archivePath, entry.name + " uses unsupported compression method " + std::to_string(entry.method));
+      }
+      if (S_ISLNK(entry.mode) && entry.size > PATH_MAX) {
+        throwInvalid(archivePath, "symlink " + entry.name + " is too long");
+      }
+      relatives[i] = std::move(relative);
+      if (isDirectory) {
+        directories.emplace_back(relatives[i], i);
+        directoryEntries.push_back(i);
+      } else {
+        directories.emplace_back(dirname(relatives[i]), i);
+        latest[relatives[i]] = i;
+      }
+    }
+    std::vector<size_t> files;
+    std::vector<size_t> symlinks;
+    uint64_t totalBytes = 0;
+    for (const auto& [path, i] : latest) {
+      (S_ISLNK(entries[i].mode) ? symlinks : files).push_back(i);
+      totalBytes += entries[i].size;
+    }
+    // Largest first, so that one big entry doesn't start last and keep a single thread busy at the end.
+    std::sort(files.begin(), files.end(), [&](size_t lhs, size_t rhs) {
+      return entries[lhs].compressedSize != entries[rhs].compressedSize ? entries[lhs].compressedSize > entries[rhs].compressedSize : lhs < rhs;
+    });
+    std::sort(symlinks.begin(), symlinks.end());
+
+    Destination destination(destDir, archivePath);
+    std::sort(directories.begin(), directories.end());
+    directories.erase(std::unique(directories.begin(), directories.end(), [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }),
+                      directories.end());
+    for (const auto& [directory, i] : directories) {
+      destination.openDirectory(directory, entries[i].name);
+    }
+
+    ProgressReporter progress(options.onProgress, totalBytes, files.size() + symlinks.size());
+    parallelFor(files.size(), options.maxThreads, [&](size_t i) {
+      const ZipEntry& entry = entries[files[i]];
+      const std::string& relative = relatives[files[i]];
+      std::string path = join(destDir, relative);
+      UniqueFd parent = destination.openDirectory(dirname(relative), entry.name);
+      UniqueFd out = destination.createFile(parent.get(), basename(relative), path);
+      preallocate(out.get(), entry.size);
+      readEntryData(fd.get(), archiveSize, archivePath, entry, [&](const uint8_t* data, size_t size) {
+        writeFully(out.get(), data, size, path);
+        progress.bytesDone(size);
+      });
+      restoreMetadata(out.get(), entry);
+      progress.entryDone();
+    });
+    for (size_t i : symlinks) {
+      std::string target;
+      readEntryData(fd.get(), archiveSize, archivePath, entries[i], [&](const uint8_t* data, size_t size) {
+        target.append(reinterpret_cast<const char*>(data), size);
+        progress.bytesDone(size);
+      });
+      const std::string& relative = relatives[i];
+      UniqueFd parent = destination.openDirectory(dirname(relative), entries[i].name);
+      std::string name = basename(relative);
+      destination.createSymlink(parent.get(), name, target, join(destDir, relative));
+      restoreSymlinkTime(parent.get(), name, entries[i]);
+      progress.entryDone();
+    }
+    // Directories last, deepest first: creating their contents changed their mtime, and a read-only mode would
+    // have stopped it.
+    std::sort(directoryEntries.begin(), directoryEntries.end(), [&](size_t lhs, size_t rhs) { return relatives[lhs] > relatives[rhs]; });
+    for (size_t i : directoryEntries) {
+      restoreMetadata(destination.openDirectory(relatives[i], entries[i].name).get(), entries[i]);
+    }
+    progress.finish();
+    return files.size() + symlinks.size();
+  }
+
+  uint64_t zip(const std::string& srcPath, const std::string& archivePath, const ZipOptions& options) {
+    if (options.level.has_value() && (*options.level < 0 || *options.level > 9)) {
+      throw std::invalid_argument("Invalid zip compression level " + std::to_string(*options.level) + ", expected 0-9");
+    }
+    int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+    size_t maxThreads = std::max<size_t>(1, options.maxThreads);
+    std::vector<ZipItem> items = planZip(srcPath, archivePath, maxThreads);
+
+    uint64_t totalBytes = 0;
+    for (const auto& item : items) {
+      totalBytes += item.size;
+    }
+    ProgressReporter progress(options.onProgress, totalBytes, items.size());
+    ArchiveWriter writer(archivePath);
+    std::vector<CentralRecord> records;
+    records.reserve(items.size());
+
+    std::vector<bool> storedItems(items.size(), level == 0);
+    // Deflate a batch of chunks in parallel, write it out in order, repeat. Memory stays bounded by the batch size.
+    const size_t batchBytes = maxThreads * kBatchChunksPerThread * kChunkSize;
+    std::vector<Chunk> batch;
+    size_t nextItem = 0;
+    uint64_t nextOffset = 0;
+    while (nextItem < items.size()) {
+      batch.clear();
+      size_t plannedBytes = 0;
+      while (nextItem < items.size() && batch.size() < kMaxBatchChunks && plannedBytes < batchBytes) {
+        const ZipItem& item = items[nextItem];
+        Chunk chunk;
+        chunk.item = nextItem;
+        chunk.offset = nextOffset;
+        if (item.type == FileType::File) {
+          chunk.length = static_cast<size_t>(std::min<uint64_t>(kChunkSize, item.size - nextOffset));
+        }
+        chunk.last = item.type != FileType::File || nextOffset + chunk.length >= item.size;
+        plannedBytes += chunk.length;
+        if (chunk.last) {
+          nextItem++;
+          nextOffset = 0;
+        } else {
+          nextOffset += chunk.length;
+        }
+        batch.push_back(std::move(chunk));
+      }
+
+      parallelFor(batch.size(), maxThreads, [&](size_t i) {
+        compressChunk(items[batch[i].item], batch[i], storedItems[batch[i].item] ? 0 : level);
+      });
+
+      for (Chunk& chunk : batch) {
+        const ZipItem& item = items[chunk.item];
+        bool first = chunk.offset == 0;
+        // The first chunk is the sample: an entry whose first 1MB doesn't shrink (media, archives) is stored,
+        // and its later chunks skip deflate.
+        if (first && !chunk.stored && chunk.data.size() >= chunk.length) {
+          storedItems[chunk.item] = true;
+        }
+        if (storedItems[chunk.item]) {
+          storeChunk(item, chunk);
+        }
+        if (first) {
+          CentralRecord record;
+          record.name = item.name;
+          record.mode = (item.type == FileType::Directory ? S_IFDIR : item.type == FileType::Symlink ? S_IFLNK : S_IFREG) | (item.mode & 07777);
+          record.method = chunk.stored ? kMethodStored : kMethodDeflated;
+          record.localHeaderOffset = writer.offset();
+          record.zip64 = !chunk.last && item.size > kZip64LocalThreshold;
+          toDosTime(item.mtime, record.dosTime, record.dosDate);
+          record.unixTime = static_cast<uint32_t>(std::clamp(std::floor(item.mtime / 1000.0), 0.0, static_cast<double>(INT32_MAX)));
+          records.push_back(std::move(record));
+        }
+        CentralRecord& record = records.back();
+        record.crc = static_cast<uint32_t>(crc32_combine(record.crc, chunk.crc, static_cast<z_off_t>(chunk.length)));
+        record.size += chunk.length;
+        record.compressedSize += chunk.data.size();
+        if (!record.zip64 && (record.size >= kMax32 || record.compressedSize >= kMax32)) {
+          throw std::runtime_error("zip(" + item.path + "): the file grew while it was being archived");
+        }
+        if (first) {
+          writer.append(localHeader(record));
+        }
+        writer.append(chunk.data.data(), chunk.data.size());
+        if (chunk.last && !first) {
+          if (record.method == kMethodDeflated && record.compressedSize >= record.size) {
+            // The sample shrank, but the entry as a whole didn't.
+            rewriteStored(writer, item, record);
+          } else {
+            writer.patch(record.localHeaderOffset, localHeader(record));
+          }
+        }
+        chunk.data = ByteBuffer();
+        progress.bytesDone(chunk.length);
+        if (chunk.last) {
+          progress.entryDone();
+        }
+      }
+    }
+
+    uint64_t directoryOffset = writer.offset();
+    std::string directory;
+    for (const auto& record : records) {
+      appendCentralHeader(directory, record);
+      if (directory.size() >= kWriteBufferSize) {
+        writer.append(directory);
+        directory.clear();
+      }
+    }
+    writer.append(directory);
+    std::string end;
+    appendEndOfCentralDirectory(end, records.size(), directoryOffset, writer.offset() - directoryOffset);
+    writer.append(end);
+    uint64_t archiveSize = writer.offset();
+    writer.commit();
+    progress.finish();
+    return archiveSize;
+  }
+
+} // namespace margelo::nitro::nitrofs::core
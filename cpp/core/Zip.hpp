@@ -0,0 +1,66 @@
+//
+//  Zip.hpp
+//  NitroFS
+//
+
+#pragma once
+
+#include "Parallel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs::core {
+
+  struct ZipProgress {
+    /** Uncompressed bytes extracted or read so far. */
+    uint64_t processedBytes = 0;
+    uint64_t totalBytes = 0;
+    uint64_t processedEntries = 0;
+    uint64_t totalEntries = 0;
+  };
+
+  struct UnzipOptions {
+    size_t maxThreads = hardwareConcurrency();
+    /** Called every few chunks from the extracting threads (never concurrently), and once at the end. */
+    std::function<void(const ZipProgress&)> onProgress;
+  };
+
+  /**
+   * Extracts a zip archive (stored and deflated entries, zip64 included) into `destDir`, overwriting existing files.
+   *
+   * The central directory is read once, every entry is checked, and the directory skeleton is created before any data
+   * is written. The files are then inflated by up to `maxThreads` threads, largest first, each straight into a
+   * preallocated file. Symlinks are created last, so no entry is ever written through one. Permission bits (never
+   * setuid, setgid or sticky) and mtimes are restored where the archive has them, directories' after their contents.
+   * Entries that would land outside `destDir`, or reach it through a symlink already inside it, throw
+   * `std::invalid_argument`, as do encrypted entries, unknown methods and corrupt data. Returns the number of entries
+   * extracted.
+   */
+  uint64_t unzip(const std::string& archivePath, const std::string& destDir, const UnzipOptions& options = {});
+
+  struct ZipOptions {
+    /** The deflate level, 0 (store only) to 9. zlib's default (6) if empty. */
+    std::optional<int> level;
+    size_t maxThreads = hardwareConcurrency();
+    /** Called every few chunks from the calling thread, and once at the end. */
+    std::function<void(const ZipProgress&)> onProgress;
+  };
+
+  /**
+   * Creates a zip archive at `archivePath` from a file, or from a directory tree whose entries are stored relative
+   * to `srcPath`. Symlinks are stored as links. Each entry keeps its Unix mode and its mtime, as an MS-DOS time and
+   * as an extended timestamp.
+   *
+   * Files are split into 1MB chunks that are deflated on up to `maxThreads` threads (each chunk primed with the
+   * 32KB before it, so the ratio stays close to single-threaded deflate) one batch at a time, and each batch is then
+   * written out sequentially, in order. Entries that don't shrink are stored: an entry whose first chunk doesn't
+   * shrink skips deflate for the rest, and one that only turns out larger at the end is rewritten stored.
+   * Returns the size of the archive.
+   */
+  uint64_t zip(const std::string& srcPath, const std::string& archivePath, const ZipOptions& options = {});
+
+} // namespace margelo::nitro::nitrofs::core
@@ -0,0 +1,92 @@
+//
+//  Base64Test.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/Base64.hpp"
+#include "core/Base64Kernels.hpp"
+
+#include <random>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  std::string randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::string bytes(size, '\0');
+    for (char& c : bytes) {
+      c = static_cast<char>(random());
+    }
+    return bytes;
+  }
+} // namespace
+
+TEST(encodesRfc4648Vectors) {
+  CHECK_EQ(base64::encode(""), std::string(""));
+  CHECK_EQ(base64::encode("f"), std::string("Zg=="));
+  CHECK_EQ(base64::encode("fo"), std::string("Zm8="));
+  CHECK_EQ(base64::encode("foo"), std::string("Zm9v"));
+  CHECK_EQ(base64::encode("foob"), std::string("Zm9vYg=="));
+  CHECK_EQ(base64::encode("fooba"), std::string("Zm9vYmE="));
+  CHECK_EQ(base64::encode("foobar"), std::string("Zm9vYmFy"));
+}
+
+TEST(decodesWithWhitespaceAndWithoutPadding) {
+  CHECK_EQ(base64::decode("Zm9vYmFy"), std::string("foobar"));
+  CHECK_EQ(base64::decode("Zm9v\r\nYmE="), std::string("fooba"));
+  CHECK_EQ(base64::decode("Zm9vYg"), std::string("foob"));
+  CHECK_EQ(base64::decode(" Z g = = "), std::string("f"));
+}
+
+TEST(rejectsInvalidInput) {
+  CHECK_THROWS(base64::decode("Zm9v!"), std::invalid_argument);
+  CHECK_THROWS(base64::decode("Z"), std::invalid_argument);
+  CHECK_THROWS(base64::decode("Zg==Zg=="), std::invalid_argument);
+}
+
+TEST(everyKernelMatchesScalar) {
+  // Sizes around the SIMD block sizes, plus one large enough to be split across threads.
+  for (size_t size : {0, 1, 2, 3, 11, 12, 13, 23, 24, 25, 47, 48, 49, 95, 96, 97, 1000, 4 * 1024 * 1024 + 7}) {
+    std::string raw = randomBytes(size, static_cast<uint32_t>(size));
+    std::string expected;
+    for (const auto* kernels : base64::detail::availableKernels()) {
+      base64::detail::setActiveKernels(*kernels);
+      std::string encoded = base64::encode(raw);
+      if (expected.empty()) {
+        expected = encoded;
+      }
+      CHECK_EQ(encoded.size(), base64::encodedLength(size));
+      CHECK(encoded == expected);
+      CHECK(base64::decode(encoded) == raw);
+    }
+  }
+  base64::detail::setActiveKernels(*base64::detail::availableKernels().front());
+}
+
+TEST(decoderHandlesChunksSplitAnywhere) {
+  std::string raw = randomBytes(1000, 42);
+  std::string encoded = base64::encode(raw);
+  encoded.insert(100, 1, '\n');
+  for (size_t chunk : {1, 3, 4, 5, 64, 333}) {
+    base64::Decoder decoder;
+    std::string decoded;
+    for (size_t i = 0; i < encoded.size(); i += chunk) {
+      std::string_view part = std::string_view(encoded).substr(i, chunk);
+      size_t offset = decoded.size();
+      decoded.resize(offset + base64::Decoder::maxDecodedLength(part.size()));
+      size_t written = decoder.update(part, reinterpret_cast<uint8_t*>(decoded.data() + offset));
+      decoded.resize(offset + written);
+    }
+    decoder.finish();
+    CHECK(decoded == raw);
+  }
+}
+
+TEST(decoderRejectsTruncatedQuartet) {
+  base64::Decoder decoder;
+  uint8_t output[8];
+  decoder.update("Zm9vY", output);
+  CHECK_THROWS(decoder.finish(), std::invalid_argument);
+}
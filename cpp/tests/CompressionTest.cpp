@@ -0,0 +1,185 @@
+//
+//  CompressionTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/Compression.hpp"
+#include "core/FileSystem.hpp"
+
+#include <random>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  std::vector<CompressionFormat> availableFormats() {
+    std::vector<CompressionFormat> formats;
+    for (auto format : {CompressionFormat::Gzip, CompressionFormat::Deflate, CompressionFormat::Zstd}) {
+      if (isCompressionAvailable(format)) {
+        formats.push_back(format);
+      }
+    }
+    return formats;
+  }
+
+  std::string sample(size_t size) {
+    std::mt19937 random(7);
+    std::string text;
+    while (text.size() < size) {
+      text += "entry " + std::to_string(random() % 1000) + ": something happened\n";
+    }
+    text.resize(size);
+    return text;
+  }
+
+  ByteSink appendTo(std::string& out) {
+    return [&out](const uint8_t* data, size_t size) { out.append(reinterpret_cast<const char*>(data), size); };
+  }
+
+  std::string compress(const std::string& input, const CompressionOptions& options) {
+    std::string out;
+    Compressor compressor(options, input.size());
+    // Uneven pieces, to cross the output buffer at odd places.
+    for (size_t offset = 0; offset < input.size(); offset += 100'003) {
+      compressor.update(input.data() + offset, std::min<size_t>(100'003, input.size() - offset), appendTo(out));
+    }
+    compressor.finish(appendTo(out));
+    return out;
+  }
+
+  std::string decompress(const std::string& input, CompressionFormat format) {
+    std::string out;
+    Decompressor decompressor(format);
+    for (size_t offset = 0; offset < input.size(); offset += 777) {
+      decompressor.update(input.data() + offset, std::min<size_t>(777, input.size() - offset), appendTo(out));
+    }
+    decompressor.finish();
+    return out;
+  }
+} // namespace
+
+TEST(roundTripsEveryFormat) {
+  CHECK(isCompressionAvailable(CompressionFormat::Gzip));
+  CHECK(isCompressionAvailable(CompressionFormat::Deflate));
+  std::string input = sample(3'000'000);
+  for (auto format : availableFormats()) {
+    for (size_t threads : {size_t(0), size_t(1), size_t(4)}) {
+      CompressionOptions options;
+      options.format = format;
+      options.threads = threads;
+      std::string compressed = compress(input, options);
+      CHECK(compressed.size() < input.size() / 4);
+      CHECK(detectCompression(compressed.data(), compressed.size()) == format);
+      CHECK(decompress(compressed, format) == input);
+    }
+    CompressionOptions options;
+    options.format = format;
+    CHECK(decompress(compress("", options), format).empty());
+  }
+  CHECK(!detectCompression("plain text", 10).has_value());
+}
+
+TEST(flushedPrefixDecodesAndStreamsConcatenate) {
+  for (auto format : availableFormats()) {
+    CompressionOptions options;
+    options.format = format;
+    std::string out;
+    Compressor compressor(options);
+    compressor.update("first ", 6, appendTo(out));
+    compressor.flush(appendTo(out));
+
+    // Everything before the flush decodes without the end of the stream.
+    std::string prefix;
+    Decompressor partial(format);
+    partial.update(out.data(), out.size(), appendTo(prefix));
+    CHECK_EQ(prefix, std::string("first "));
+    CHECK_THROWS(partial.finish(), std::invalid_argument);
+
+    compressor.update("second", 6, appendTo(out));
+    compressor.finish(appendTo(out));
+    CHECK_EQ(decompress(out, format), std::string("first second"));
+
+    // Deflate is a single zlib stream; gzip members and zstd frames can follow each other.
+    if (format != CompressionFormat::Deflate) {
+      CHECK_EQ(decompress(out + compress("third", options), format), std::string("first secondthird"));
+    }
+  }
+}
+
+TEST(rejectsBadInputAndLevels) {
+  for (auto format : availableFormats()) {
+    CompressionOptions options;
+    options.format = format;
+    std::string compressed = compress(sample(100'000), options);
+    std::string corrupt = compressed;
+    corrupt[corrupt.size() / 2] ^= 0x55;
+    corrupt[corrupt.size() / 2 + 1] ^= 0x55;
+    CHECK_THROWS(decompress(corrupt, format), std::invalid_argument);
+    CHECK_THROWS(decompress(compressed.substr(0, compressed.size() - 4), format), std::invalid_argument);
+
+    options.level = 99;
+    CHECK_THROWS(Compressor(options), std::invalid_argument);
+  }
+}
+
+TEST(compressesFiles) {
+  TempDir dir;
+  std::string input = sample(2'500'000);
+  writeFile(dir / "log.txt", input);
+  for (auto format : availableFormats()) {
+    CompressionOptions options;
+    options.format = format;
+    uint64_t size = compressFile(dir / "log.txt", dir / "log.packed", options);
+    CHECK_EQ(size, stat(dir / "log.packed").size);
+    // The format is detected from the first bytes.
+    CHECK_EQ(decompressFile(dir / "log.packed", dir / "log.out", std::nullopt), uint64_t(input.size()));
+    CHECK(readFile(dir / "log.out") == input);
+  }
+  CHECK_ERRNO(compressFile(dir / "missing", dir / "out", CompressionOptions()), ENOENT);
+}
+
+TEST(decompressedSizeHints) {
+  std::string input = sample(300'000);
+  for (auto format : availableFormats()) {
+    CompressionOptions options;
+    options.format = format;
+    std::string compressed = compress(input, options);
+    auto hint = decompressedSizeHint(format, compressed.data(), compressed.size(), compressed.data(), compressed.size());
+    if (format == CompressionFormat::Deflate) {
+      CHECK(!hint.has_value());
+    } else {
+      CHECK(hint == uint64_t(input.size()));
+    }
+  }
+  // A zstd stream of unknown length has no content size in its header.
+  if (isCompressionAvailable(CompressionFormat::Zstd)) {
+    CompressionOptions options;
+    options.format = CompressionFormat::Zstd;
+    std::string streamed;
+    Compressor compressor(options);
+    compressor.update(input.data(), input.size(), appendTo(streamed));
+    compressor.finish(appendTo(streamed));
+    CHECK(!decompressedSizeHint(CompressionFormat::Zstd, streamed.data(), streamed.size(), nullptr, 0).has_value());
+  }
+}
+
+TEST(readsCompressedFilesWhateverTheyRecord) {
+  TempDir dir;
+  std::string first = sample(200'000);
+  std::string second = sample(3'000'000);
+  for (auto format : availableFormats()) {
+    CompressionOptions options;
+    options.format = format;
+    writeFile(dir / "one.packed", compress(second, options));
+    CHECK(readFile(dir / "one.packed", format) == second);
+    CHECK(readFileBytes(dir / "one.packed", format).size() == second.size());
+    if (format == CompressionFormat::Deflate) {
+      continue;
+    }
+    // The recorded size only covers one member or frame; the rest still has to fit.
+    writeFile(dir / "two.packed", compress(first, options) + compress(second, options));
+    CHECK(readFile(dir / "two.packed", format) == first + second);
+  }
+}
@@ -0,0 +1,73 @@
+//
+//  CopyTreeTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/CopyTree.hpp"
+#include "core/FileSystem.hpp"
+
+#include <cerrno>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  void makeTree(const TempDir& dir) {
+    writeFile(dir / "src/a.txt", "a");
+    writeFile(dir / "src/sub/b.txt", std::string(100'000, 'b'));
+    writeFile(dir / "src/sub/deeper/c.txt", "c");
+    mkdirs(dir / "src/empty");
+    CHECK(::symlink("a.txt", (dir / "src/link").c_str()) == 0);
+  }
+} // namespace
+
+TEST(copiesTreesWithSymlinksAndProgress) {
+  TempDir dir;
+  makeTree(dir);
+  CopyProgress last;
+  copyTree(dir / "src", dir / "out/dest", {.conflict = ConflictPolicy::Overwrite, .maxThreads = 4,
+                                            .onProgress = [&](const CopyProgress& progress) { last = progress; }});
+  CHECK_EQ(readFile(dir / "out/dest/a.txt"), std::string("a"));
+  CHECK_EQ(readFile(dir / "out/dest/sub/b.txt").size(), size_t(100'000));
+  CHECK_EQ(readFile(dir / "out/dest/sub/deeper/c.txt"), std::string("c"));
+  CHECK(stat(dir / "out/dest/empty").isDirectory);
+  char target[16] = {};
+  CHECK_EQ(::readlink((dir / "out/dest/link").c_str(), target, sizeof(target)), ssize_t(5));
+  CHECK_EQ(std::string(target), std::string("a.txt"));
+  CHECK_EQ(last.copiedFiles, uint64_t(4));
+  CHECK_EQ(last.totalFiles, uint64_t(4));
+  CHECK_EQ(last.copiedBytes, last.totalBytes);
+}
+
+TEST(conflictPolicies) {
+  TempDir dir;
+  makeTree(dir);
+  writeFile(dir / "dest/a.txt", "existing");
+
+  CHECK_ERRNO(copyTree(dir / "src", dir / "dest", {.conflict = ConflictPolicy::Fail, .maxThreads = 2, .onProgress = {}}), EEXIST);
+  CHECK(!exists(dir / "dest/sub/b.txt"));
+
+  copyTree(dir / "src", dir / "dest", {.conflict = ConflictPolicy::Skip, .maxThreads = 2, .onProgress = {}});
+  CHECK_EQ(readFile(dir / "dest/a.txt"), std::string("existing"));
+  CHECK_EQ(readFile(dir / "dest/sub/deeper/c.txt"), std::string("c"));
+
+  copyTree(dir / "src", dir / "dest");
+  CHECK_EQ(readFile(dir / "dest/a.txt"), std::string("a"));
+}
+
+TEST(skipsSpecialFilesInsteadOfBlocking) {
+  TempDir dir;
+  makeTree(dir);
+  // Opening this FIFO for reading would block forever, as nothing ever writes to it.
+  CHECK(::mkfifo((dir / "src/sub/fifo").c_str(), 0600) == 0);
+  copyTree(dir / "src", dir / "dest");
+  CHECK(exists(dir / "dest/sub/b.txt"));
+  CHECK(!exists(dir / "dest/sub/fifo"));
+
+  CHECK_ERRNO(copyTree(dir / "src/sub/fifo", dir / "fifo-copy"), ENOTSUP);
+  CHECK_ERRNO(copyFile(dir / "src/sub/fifo", dir / "fifo-copy"), ENOTSUP);
+}
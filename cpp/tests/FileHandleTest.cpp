@@ -0,0 +1,54 @@
+//
+//  FileHandleTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileHandle.hpp"
+#include "core/FileSystem.hpp"
+
+#include <cerrno>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  std::string toString(const ByteBuffer& bytes) {
+    return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+} // namespace
+
+TEST(readsAndWritesAtOffsets) {
+  TempDir dir;
+  auto file = FileHandle::open(dir / "sub/file", OpenMode::Create);
+  file->write(0, "hello world", 11);
+  file->write(6, "there", 5);
+  CHECK_EQ(file->size(), uint64_t(11));
+  CHECK_EQ(toString(file->read(0, 11)), std::string("hello there"));
+  CHECK_EQ(toString(file->read(6, 100)), std::string("there"));
+  file->truncate(5);
+  CHECK_EQ(readFile(dir / "sub/file"), std::string("hello"));
+}
+
+TEST(oversizedReadIsClampedToTheFile) {
+  TempDir dir;
+  writeFile(dir / "file", "0123456789");
+  auto file = FileHandle::open(dir / "file", OpenMode::Read);
+  // A terabyte-sized request only allocates what is actually there.
+  ByteBuffer bytes = file->read(4, size_t(1) << 40);
+  CHECK_EQ(toString(bytes), std::string("456789"));
+  CHECK_EQ(file->read(10, size_t(1) << 40).size(), size_t(0));
+  CHECK_EQ(file->read(uint64_t(1) << 50, 10).size(), size_t(0));
+}
+
+TEST(closedHandleFailsWithEbadf) {
+  TempDir dir;
+  writeFile(dir / "file", "x");
+  auto file = FileHandle::open(dir / "file", OpenMode::Read);
+  file->close();
+  file->close();
+  CHECK_ERRNO(file->read(0, 1), EBADF);
+  CHECK_ERRNO(FileHandle::open(dir.path(), OpenMode::Read), EISDIR);
+  CHECK_ERRNO(FileHandle::open(dir / "missing", OpenMode::Write), ENOENT);
+}
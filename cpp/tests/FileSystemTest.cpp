@@ -0,0 +1,161 @@
+//
+//  FileSystemTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+
+#include <cerrno>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+TEST(writesAndReadsFiles) {
+  TempDir dir;
+  std::string path = dir / "nested/deeper/file.txt";
+  writeFile(path, "hello world");
+  CHECK(exists(path));
+  CHECK_EQ(readFile(path), std::string("hello world"));
+
+  ByteBuffer bytes = readFileBytes(path);
+  CHECK_EQ(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), std::string_view("hello world"));
+  CHECK_EQ(readFileBase64(path), std::string("aGVsbG8gd29ybGQ="));
+
+  writeFile(path, "short");
+  CHECK_EQ(readFile(path), std::string("short"));
+  writeFileBase64(path, "aGk=");
+  CHECK_EQ(readFile(path), std::string("hi"));
+  appendFile(path, "!");
+  CHECK_EQ(readFile(path), std::string("hi!"));
+}
+
+TEST(atomicWriteReplacesFile) {
+  TempDir dir;
+  std::string path = dir / "file.txt";
+  writeFile(path, "old");
+  writeFile(path, "new contents", {.atomic = true, .sync = SyncMode::Full, .preallocate = false, .compression = std::nullopt});
+  CHECK_EQ(readFile(path), std::string("new contents"));
+  // No temporary file is left next to it.
+  CHECK_EQ(readdir(dir.path()).size(), size_t(1));
+}
+
+TEST(invalidBase64LeavesTheFileAlone) {
+  TempDir dir;
+  std::string path = dir / "file.txt";
+  writeFile(path, "keep me");
+  // Invalid only near the end, past the first chunk.
+  std::string payload = std::string(400'000, 'A') + "*AAA";
+  for (bool atomic : {false, true}) {
+    CHECK_THROWS(writeFileBase64(path, payload, {.atomic = atomic, .sync = SyncMode::None, .preallocate = false, .compression = std::nullopt}),
+                 std::invalid_argument);
+    CHECK_EQ(readFile(path), std::string("keep me"));
+    // A quartet cut short.
+    CHECK_THROWS(writeFileBase64(path, "aGk=aG", {.atomic = atomic, .sync = SyncMode::None, .preallocate = false, .compression = std::nullopt}),
+                 std::invalid_argument);
+    CHECK_EQ(readFile(path), std::string("keep me"));
+  }
+  CHECK_EQ(readdir(dir.path()).size(), size_t(1));
+}
+
+TEST(statsFilesAndDirectories) {
+  TempDir dir;
+  writeFile(dir / "file", std::string(1000, 'x'));
+  FileStat file = stat(dir / "file");
+  CHECK(file.isFile);
+  CHECK(!file.isDirectory);
+  CHECK_EQ(file.size, uint64_t(1000));
+  CHECK(file.mtime > 0);
+
+  FileStat directory = stat(dir.path());
+  CHECK(directory.isDirectory);
+  CHECK_ERRNO(stat(dir / "missing"), ENOENT);
+  CHECK_ERRNO(readFile(dir / "missing"), ENOENT);
+}
+
+TEST(statManyReportsErrorsPerPath) {
+  TempDir dir;
+  writeFile(dir / "a", "1");
+  writeFile(dir / "b", "22");
+  auto results = statMany({dir / "a", dir / "missing", dir / "b"});
+  CHECK_EQ(results.size(), size_t(3));
+  CHECK_EQ(results[0].error, 0);
+  CHECK_EQ(results[0].stat.size, uint64_t(1));
+  CHECK_EQ(results[1].error, ENOENT);
+  CHECK_EQ(results[2].stat.size, uint64_t(2));
+  CHECK(existsMany({dir / "a", dir / "missing"}) == std::vector<bool>({true, false}));
+}
+
+TEST(readdirListsEntriesWithTypes) {
+  TempDir dir;
+  writeFile(dir / "file", "abc");
+  mkdirs(dir / "sub");
+  CHECK(::symlink("file", (dir / "link").c_str()) == 0);
+
+  auto entries = readdir(dir.path(), DirDetail::Stats);
+  CHECK_EQ(entries.size(), size_t(3));
+  for (const DirEntry& entry : entries) {
+    CHECK_EQ(entry.path, dir / entry.name);
+    CHECK(entry.stat.has_value());
+    if (entry.name == "file") {
+      CHECK(entry.type == FileType::File);
+      CHECK_EQ(entry.stat->size, uint64_t(3));
+    } else if (entry.name == "sub") {
+      CHECK(entry.type == FileType::Directory);
+    } else {
+      CHECK(entry.type == FileType::Symlink);
+    }
+  }
+}
+
+TEST(mkdirsIsIdempotent) {
+  TempDir dir;
+  mkdirs(dir / "a/b/c");
+  mkdirs(dir / "a/b/c");
+  CHECK(stat(dir / "a/b/c").isDirectory);
+  writeFile(dir / "file", "");
+  CHECK_ERRNO(mkdirs(dir / "file/sub"), ENOTDIR);
+}
+
+TEST(copiesFiles) {
+  TempDir dir;
+  std::string contents(300'000, '\0');
+  for (size_t i = 0; i < contents.size(); i++) {
+    contents[i] = static_cast<char>(i * 31);
+  }
+  writeFile(dir / "src", contents);
+  copyFile(dir / "src", dir / "out/dest");
+  CHECK(readFile(dir / "out/dest") == contents);
+
+  writeFile(dir / "other", "other");
+  CHECK_ERRNO(copyFile(dir / "other", dir / "out/dest", false), EEXIST);
+  copyFile(dir / "other", dir / "out/dest", true);
+  CHECK_EQ(readFile(dir / "out/dest"), std::string("other"));
+  CHECK_ERRNO(copyFile(dir / "missing", dir / "x"), ENOENT);
+}
+
+TEST(renamesAndRemoves) {
+  TempDir dir;
+  writeFile(dir / "tree/a/b/file", "x");
+  writeFile(dir / "tree/top", "y");
+  rename(dir / "tree", dir / "moved");
+  CHECK(!exists(dir / "tree"));
+  CHECK_EQ(readFile(dir / "moved/a/b/file"), std::string("x"));
+
+  CHECK(removeAll(dir / "moved"));
+  CHECK(!exists(dir / "moved"));
+  CHECK(!removeAll(dir / "moved"));
+}
+
+TEST(copyFileOntoItselfKeepsTheSource) {
+  TempDir dir;
+  writeFile(dir / "sub/src", "precious");
+  CHECK(::link((dir / "sub/src").c_str(), (dir / "hardlink").c_str()) == 0);
+  CHECK_ERRNO(copyFile(dir / "sub/src", dir / "sub/src"), EINVAL);
+  CHECK_ERRNO(copyFile(dir / "sub/src", dir / "sub/../sub/src"), EINVAL);
+  CHECK_ERRNO(copyFile(dir / "sub/src", dir / "hardlink"), EINVAL);
+  CHECK_EQ(readFile(dir / "sub/src"), std::string("precious"));
+}
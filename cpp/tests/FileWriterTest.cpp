@@ -0,0 +1,132 @@
+//
+//  FileWriterTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/FileWriter.hpp"
+#include "core/UniqueFd.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  FileWriterOptions smallBuffers() {
+    FileWriterOptions options;
+    options.bufferSize = 16;
+    options.flushInterval = std::chrono::milliseconds(10'000);
+    return options;
+  }
+} // namespace
+
+TEST(flushMakesEverythingAppendedBeforeItDurable) {
+  TempDir dir;
+  auto writer = FileWriter::open(dir / "log/file", smallBuffers());
+  writer->append("first ", 6);
+  writer->flush();
+  // Flushed even though neither the buffer size nor the interval was reached.
+  CHECK_EQ(readFile(dir / "log/file"), std::string("first "));
+  writer->append("second", 6);
+  writer->close();
+  CHECK_EQ(readFile(dir / "log/file"), std::string("first second"));
+  CHECK_ERRNO(writer->append("x", 1), EBADF);
+  writer->close();
+}
+
+TEST(concurrentFlushesKeepAppendOrder) {
+  TempDir dir;
+  auto writer = FileWriter::open(dir / "file", smallBuffers());
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{false};
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 200; i++) {
+        std::string line = std::to_string(t) + ":" + std::to_string(i) + "\n";
+        writer->append(line.data(), line.size());
+        if (i % 10 == 0) {
+          writer->flush();
+          // Everything this thread appended so far must be on disk now.
+          if (readFile(dir / "file").find(line) == std::string::npos) {
+            failed = true;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  writer->close();
+  CHECK(!failed);
+  std::string contents = readFile(dir / "file");
+  // Each thread's lines appear in the order it appended them.
+  for (int t = 0; t < 4; t++) {
+    size_t position = 0;
+    for (int i = 0; i < 200; i++) {
+      std::string line = std::to_string(t) + ":" + std::to_string(i) + "\n";
+      size_t found = contents.find(line, position);
+      CHECK(found != std::string::npos);
+      position = found + line.size();
+    }
+  }
+}
+
+TEST(appendBlocksAtHighWaterMark) {
+  TempDir dir;
+  std::string fifo = dir / "fifo";
+  CHECK(::mkfifo(fifo.c_str(), 0600) == 0);
+
+  // Nothing reads from the FIFO until told to, so the I/O thread stalls once the pipe is full.
+  std::atomic<bool> startReading{false};
+  std::string received;
+  std::thread reader([&]() {
+    UniqueFd fd(::open(fifo.c_str(), O_RDONLY | O_CLOEXEC));
+    while (!startReading) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    char chunk[65536];
+    ssize_t n;
+    while ((n = ::read(fd.get(), chunk, sizeof(chunk))) > 0) {
+      received.append(chunk, static_cast<size_t>(n));
+    }
+  });
+
+  FileWriterOptions options;
+  options.bufferSize = 4096;
+  options.highWaterMark = 64 * 1024;
+  // A FIFO can't be fsync'ed.
+  options.sync = SyncMode::None;
+  auto writer = FileWriter::open(fifo, options);
+  constexpr size_t kChunk = 1024;
+  constexpr size_t kTotal = 4 * 1024 * 1024;
+  std::atomic<size_t> appended{0};
+  std::thread producer([&]() {
+    std::string chunk(kChunk, 'x');
+    for (size_t i = 0; i < kTotal / kChunk; i++) {
+      writer->append(chunk.data(), chunk.size());
+      appended += kChunk;
+    }
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  // Held back at the pipe's capacity plus roughly one high water mark, far short of everything.
+  size_t stalledAt = appended;
+
+  startReading = true;
+  producer.join();
+  writer->close();
+  reader.join();
+  CHECK(stalledAt < 1024 * 1024);
+  CHECK_EQ(received.size(), kTotal);
+}
@@ -0,0 +1,120 @@
+//
+//  HashTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/Hash.hpp"
+#include "core/HashKernels.hpp"
+
+#include <array>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  struct Vector {
+    size_t size;
+    const char* sha256;
+    const char* crc32c;
+    const char* xxh3;
+    const char* blake3;
+  };
+
+  // Inputs are `i % 251` for each byte, as in the BLAKE3 test vectors. The sizes straddle the block, stripe and
+  // chunk boundaries of every algorithm, and the last one is large enough for `hashFile`'s parallel BLAKE3.
+  const std::array<Vector, 11> kVectors = {{
+    {0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "00000000", "2d06800538d394c2",
+     "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+    {3, "ae4b3280e56e2faf83f414a6e3dabe9d5fbe18976544c05fed121accb85b53fc", "92fd4bfa", "5f4299fc161c9cbb",
+     "e1be4d7a8ab5560aa4199eea339849ba8e293d55ca0a81006726d184519e647f"},
+    {64, "fdeab9acf3710362bd2658cdc9a29e8f9c757fcf9811603a8c447cd1d9151108", "fb6d36eb", "6187eb9089b0ed55",
+     "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98"},
+    {65, "4bfd2c8b6f1eec7a2afeb48b934ee4b2694182027e6d0fc075074f2fabb31781", "694420fa", "6928c76ce90422d0",
+     "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee"},
+    {240, "abf4bafcddb38bbf3855e47b5e61b75dedbcf42aa44ffd4bb85d0b08d97e2682", "9f4f71d6", "375a384d957fe865",
+     "45e1a0dc23dbe51733d7269a3c0f519c2a63b0718835b2b537677eba734db0d8"},
+    {241, "211882aeac8a599b0a55ec280e1a978923edef69cd86541bcbd58db864c45eac", "54fe7516", "02e8cd95421c6d02",
+     "749b36ae651c22e8567db692a6876e0ca4fd3daeb7aa8fa3ab2f642ccc69a8f6"},
+    {1024, "2bce1ba628720664be4b9fdd77aae0678e5f0f3f02fc6ff641ec879094f6a404", "2af62c0c", "e5d78bafa45b2aa5",
+     "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+    {1025, "bc0b6b10b89b9487a12fda2a8cc13194e7091c217aabf8b92846274026f4bcd0", "c8d03add", "e95c42288f28186e",
+     "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+    {65537, "237356e18b503616912abb8ffaed3a72591e397d4ac294c4637917d48a3f529d", "4537bb82", "70331d53d92bbc56",
+     "7c99f9840a73dfcb6e5bfe4ff6d1558acab7e015640790c26411818bdbe17eca"},
+    {1049576, "5c552b3cb24ce48cdddbc3ffc5bc53ddfc557b33d4a9ec5422861e0ef9b14311", "1ce55874", "eab111e9e39d74ea",
+     "ad6644fef4a9c205339552c5b223063192e390ec085ca87b409efc35d7f6fea1"},
+    {4194305, "f4711f6bc42a8dc6520e30e306743855a82c7bdecd6e7d3edfb04b6f4524f7bd", "a5989e9c", "101c2cdd9b96e8e8",
+     "0460893a0170917e0d568bb27c0287984d4f7e9d59eafb95e6fb3c01ec611eab"},
+  }};
+
+  std::string pattern(size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+      data[i] = static_cast<char>(i % 251);
+    }
+    return data;
+  }
+
+  void checkVectors() {
+    std::string data = pattern(kVectors.back().size);
+    for (const auto& vector : kVectors) {
+      CHECK_EQ(hashBytes(data.data(), vector.size, HashAlgorithm::Sha256), std::string(vector.sha256));
+      CHECK_EQ(hashBytes(data.data(), vector.size, HashAlgorithm::Crc32c), std::string(vector.crc32c));
+      CHECK_EQ(hashBytes(data.data(), vector.size, HashAlgorithm::Xxh3), std::string(vector.xxh3));
+      CHECK_EQ(hashBytes(data.data(), vector.size, HashAlgorithm::Blake3), std::string(vector.blake3));
+    }
+  }
+} // namespace
+
+TEST(knownAnswers) {
+  CHECK_EQ(hashBytes("abc", 3, HashAlgorithm::Sha256), std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+  CHECK_EQ(hashBytes("123456789", 9, HashAlgorithm::Crc32c), std::string("e3069283"));
+  checkVectors();
+}
+
+TEST(everyKernelAgrees) {
+  const auto& active = hash::detail::activeKernels();
+  for (const auto* kernels : hash::detail::availableKernels()) {
+    hash::detail::setActiveKernels(*kernels);
+    checkVectors();
+  }
+  hash::detail::setActiveKernels(active);
+}
+
+TEST(hashesFiles) {
+  TempDir dir;
+  const Vector& large = kVectors.back();
+  std::string data = pattern(large.size);
+  writeFile(dir / "data.bin", data);
+  CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Sha256), std::string(large.sha256));
+  CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Crc32c), std::string(large.crc32c));
+  CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Xxh3), std::string(large.xxh3));
+  CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Blake3), std::string(large.blake3));
+
+  // A range, and one that runs past the end of the file.
+  for (auto algorithm : {HashAlgorithm::Sha256, HashAlgorithm::Crc32c, HashAlgorithm::Xxh3, HashAlgorithm::Blake3}) {
+    CHECK_EQ(hashFile(dir / "data.bin", algorithm, 1000, 2'000'000), hashBytes(data.data() + 1000, 2'000'000, algorithm));
+    CHECK_EQ(hashFile(dir / "data.bin", algorithm, large.size - 10, 100), hashBytes(data.data() + large.size - 10, 10, algorithm));
+  }
+  CHECK_ERRNO(hashFile(dir / "missing", HashAlgorithm::Sha256), ENOENT);
+}
+
+TEST(blake3FilesHashTheSameOnAnyNumberOfThreads) {
+  TempDir dir;
+  const Vector& large = kVectors.back();
+  std::string data = pattern(9 * 1024 * 1024 + 77);
+  writeFile(dir / "data.bin", data);
+  for (size_t threads : {size_t(1), size_t(2), size_t(3)}) {
+    hash::detail::setBlake3Threads(threads);
+    CHECK_EQ(hash::detail::blake3Threads(), threads);
+    CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Blake3, 0, large.size), std::string(large.blake3));
+    CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Blake3), hashBytes(data.data(), data.size(), HashAlgorithm::Blake3));
+    // A range that starts and ends mid-chunk, so subtrees don't line up with the file.
+    CHECK_EQ(hashFile(dir / "data.bin", HashAlgorithm::Blake3, 1000, 6'000'001),
+             hashBytes(data.data() + 1000, 6'000'001, HashAlgorithm::Blake3));
+  }
+  hash::detail::setBlake3Threads(0);
+}
@@ -0,0 +1,122 @@
+//
+//  LinesTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/Lines.hpp"
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  struct Read {
+    std::vector<std::string> lines;
+    std::vector<uint64_t> offsets;
+    uint64_t firstLine = UINT64_MAX;
+    uint64_t count = 0;
+  };
+
+  Read readAll(const std::string& path, const ReadLinesOptions& options) {
+    Read read;
+    read.count = readLines(path, options, [&](LineBatch&& batch) {
+      CHECK(!batch.offsets.empty());
+      CHECK(batch.offsets.size() <= options.batchSize);
+      CHECK_EQ(batch.firstLine, (read.firstLine == UINT64_MAX ? batch.firstLine : read.firstLine) + read.offsets.size());
+      if (read.firstLine == UINT64_MAX) {
+        read.firstLine = batch.firstLine;
+      }
+      CHECK_EQ(batch.lines.size(), options.offsetsOnly ? size_t(0) : batch.offsets.size());
+      read.lines.insert(read.lines.end(), batch.lines.begin(), batch.lines.end());
+      read.offsets.insert(read.offsets.end(), batch.offsets.begin(), batch.offsets.end());
+    });
+    CHECK_EQ(read.count, uint64_t(read.offsets.size()));
+    return read;
+  }
+
+  std::string numbered(int count) {
+    std::string text;
+    for (int i = 0; i < count; i++) {
+      text += "line " + std::to_string(i) + "\n";
+    }
+    return text;
+  }
+} // namespace
+
+TEST(readsLinesAndOffsets) {
+  TempDir dir;
+  writeFile(dir / "mixed.txt", "one\r\ntwo\n\nlast");
+  Read read = readAll(dir / "mixed.txt", ReadLinesOptions());
+  CHECK_EQ(read.count, uint64_t(4));
+  CHECK_EQ(read.lines[0], std::string("one"));
+  CHECK_EQ(read.lines[1], std::string("two"));
+  CHECK_EQ(read.lines[2], std::string(""));
+  CHECK_EQ(read.lines[3], std::string("last"));
+  CHECK_EQ(read.offsets[1], uint64_t(5));
+  CHECK_EQ(read.offsets[3], uint64_t(10));
+
+  writeFile(dir / "empty.txt", "");
+  CHECK_EQ(readAll(dir / "empty.txt", ReadLinesOptions()).count, uint64_t(0));
+  CHECK_ERRNO(readAll(dir / "missing.txt", ReadLinesOptions()), ENOENT);
+}
+
+TEST(startLineAndMaxLines) {
+  TempDir dir;
+  writeFile(dir / "lines.txt", numbered(10'000));
+
+  ReadLinesOptions options;
+  options.batchSize = 64;
+  options.startLine = 9'000;
+  options.maxLines = 5;
+  Read read = readAll(dir / "lines.txt", options);
+  CHECK_EQ(read.firstLine, uint64_t(9'000));
+  CHECK_EQ(read.lines.size(), size_t(5));
+  CHECK_EQ(read.lines[0], std::string("line 9000"));
+
+  // From the end.
+  options.startLine = -3;
+  options.maxLines = UINT64_MAX;
+  read = readAll(dir / "lines.txt", options);
+  CHECK_EQ(read.firstLine, uint64_t(9'997));
+  CHECK_EQ(read.lines.back(), std::string("line 9999"));
+
+  // Past the end.
+  options.startLine = 20'000;
+  CHECK_EQ(readAll(dir / "lines.txt", options).count, uint64_t(0));
+
+  options = ReadLinesOptions();
+  options.offsetsOnly = true;
+  options.batchSize = 1000;
+  read = readAll(dir / "lines.txt", options);
+  CHECK_EQ(read.count, uint64_t(10'000));
+  CHECK_EQ(read.offsets[10], uint64_t(numbered(10).size()));
+}
+
+TEST(indexFollowsAppends) {
+  TempDir dir;
+  writeFile(dir / "log.txt", numbered(50'000));
+  CHECK_EQ(indexLines(dir / "log.txt"), uint64_t(50'000));
+
+  ReadLinesOptions options;
+  options.startLine = 40'000;
+  options.maxLines = 1;
+  Read read = readAll(dir / "log.txt", options);
+  CHECK_EQ(read.lines[0], std::string("line 40000"));
+  CHECK_EQ(read.offsets[0], uint64_t(numbered(40'000).size()));
+
+  // Appending extends the index instead of invalidating it.
+  appendFile(dir / "log.txt", "tail 1\ntail 2\n");
+  CHECK_EQ(indexLines(dir / "log.txt"), uint64_t(50'002));
+  options.startLine = -1;
+  read = readAll(dir / "log.txt", options);
+  CHECK_EQ(read.lines[0], std::string("tail 2"));
+
+  // A rewritten file is scanned again.
+  writeFile(dir / "log.txt", numbered(3));
+  CHECK_EQ(indexLines(dir / "log.txt"), uint64_t(3));
+  options.startLine = 2;
+  read = readAll(dir / "log.txt", options);
+  CHECK_EQ(read.lines[0], std::string("line 2"));
+}
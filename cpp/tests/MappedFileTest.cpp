@@ -0,0 +1,66 @@
+//
+//  MappedFileTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/MappedFile.hpp"
+
+#include <cstring>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  std::string contents(const MappedFile& file) {
+    return std::string(reinterpret_cast<const char*>(file.data()), file.size());
+  }
+} // namespace
+
+TEST(mapsUnalignedRanges) {
+  TempDir dir;
+  std::string data;
+  for (int i = 0; i < 20'000; i++) {
+    data.push_back(static_cast<char>('a' + i % 26));
+  }
+  writeFile(dir / "data.txt", data);
+
+  auto whole = MappedFile::open(dir / "data.txt", 0, std::nullopt, true);
+  CHECK(contents(*whole) == data);
+  // Offsets don't need to be page-aligned.
+  auto range = MappedFile::open(dir / "data.txt", 4099, 5000, true);
+  CHECK_EQ(range->offset(), uint64_t(4099));
+  CHECK(contents(*range) == data.substr(4099, 5000));
+  auto tail = MappedFile::open(dir / "data.txt", 19'990, std::nullopt, true);
+  CHECK(contents(*tail) == data.substr(19'990));
+
+  writeFile(dir / "empty.txt", "");
+  CHECK_EQ(MappedFile::open(dir / "empty.txt", 0, std::nullopt, true)->size(), size_t(0));
+}
+
+TEST(writesReachTheFileOnlyWhenShared) {
+  TempDir dir;
+  writeFile(dir / "data.txt", "hello world");
+
+  auto privateMapping = MappedFile::open(dir / "data.txt", 0, std::nullopt, true);
+  CHECK(privateMapping->readOnly());
+  std::memcpy(privateMapping->data(), "HELLO", 5);
+  privateMapping->sync();
+  CHECK_EQ(readFile(dir / "data.txt"), std::string("hello world"));
+
+  auto shared = MappedFile::open(dir / "data.txt", 6, 5, false);
+  std::memcpy(shared->data(), "WORLD", 5);
+  shared->sync();
+  CHECK_EQ(readFile(dir / "data.txt"), std::string("hello WORLD"));
+}
+
+TEST(rejectsBadRanges) {
+  TempDir dir;
+  writeFile(dir / "data.txt", "0123456789");
+  CHECK_ERRNO(MappedFile::open(dir / "data.txt", 11, std::nullopt, true), EINVAL);
+  CHECK_ERRNO(MappedFile::open(dir / "data.txt", 5, 6, true), EINVAL);
+  CHECK_ERRNO(MappedFile::open(dir / "missing", 0, std::nullopt, true), ENOENT);
+  CHECK_ERRNO(MappedFile::open(dir.path(), 0, std::nullopt, true), EISDIR);
+}
@@ -0,0 +1,46 @@
+//
+//  PathTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/Path.hpp"
+
+using namespace margelo::nitro::nitrofs::core;
+
+TEST(detectsContentUris) {
+  CHECK(isContentUri("content://media/external/images/1"));
+  CHECK(!isContentUri("file:///data/file.txt"));
+  CHECK(!isContentUri("/data/content://x"));
+}
+
+TEST(convertsFileUrisToPaths) {
+  CHECK_EQ(toLocalPath("file:///data/user/0/file.txt"), std::string("/data/user/0/file.txt"));
+  CHECK_EQ(toLocalPath("file://localhost/tmp/a"), std::string("/tmp/a"));
+  CHECK_EQ(toLocalPath("file:///tmp/with%20space%2Fslash"), std::string("/tmp/with space/slash"));
+  CHECK_EQ(toLocalPath("file:///tmp/a.txt?query#fragment"), std::string("/tmp/a.txt"));
+  // Malformed escapes are kept as-is.
+  CHECK_EQ(toLocalPath("file:///tmp/100%"), std::string("/tmp/100%"));
+  CHECK_EQ(toLocalPath("file:///tmp/%zz"), std::string("/tmp/%zz"));
+  CHECK_EQ(toLocalPath("/already/a/path"), std::string("/already/a/path"));
+}
+
+TEST(splitsPaths) {
+  CHECK_EQ(dirname("/a/b/c.txt"), std::string("/a/b"));
+  CHECK_EQ(dirname("/a/b//"), std::string("/a"));
+  CHECK_EQ(dirname("/a"), std::string("/"));
+  CHECK_EQ(dirname("a"), std::string(""));
+  CHECK_EQ(basename("/a/b/c.txt"), std::string("c.txt"));
+  CHECK_EQ(basename("/a/b/"), std::string("b"));
+  CHECK_EQ(basename("/"), std::string(""));
+  CHECK_EQ(extname("/a/b/c.tar.gz"), std::string("gz"));
+  CHECK_EQ(extname("/a/.gitignore"), std::string(""));
+  CHECK_EQ(extname("/a/Makefile"), std::string(""));
+}
+
+TEST(joinsWithOneSeparator) {
+  CHECK_EQ(join("/a", "b"), std::string("/a/b"));
+  CHECK_EQ(join("/a/", "b"), std::string("/a/b"));
+  CHECK_EQ(join("", "b"), std::string("b"));
+}
@@ -0,0 +1,98 @@
+//
+//  ReadStreamTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/ReadStream.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <thread>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  std::string readAll(ReadStream& stream, size_t chunkSize) {
+    std::string result;
+    while (auto chunk = stream.next()) {
+      CHECK(chunk->size() > 0);
+      CHECK(chunk->size() <= chunkSize);
+      result.append(reinterpret_cast<const char*>(chunk->data()), chunk->size());
+    }
+    // The end stays the end.
+    CHECK(!stream.next().has_value());
+    return result;
+  }
+} // namespace
+
+TEST(readsRangesInChunks) {
+  TempDir dir;
+  std::string data;
+  for (int i = 0; i < 100'000; i++) {
+    data.push_back(static_cast<char>(i * 7));
+  }
+  writeFile(dir / "data.bin", data);
+
+  ReadStreamOptions options;
+  options.chunkSize = 4096;
+  options.highWaterMark = 2;
+  auto stream = ReadStream::open(dir / "data.bin", options);
+  CHECK_EQ(stream->path(), dir / "data.bin");
+  CHECK(readAll(*stream, options.chunkSize) == data);
+
+  options.start = 1000;
+  options.end = 50'001;
+  stream = ReadStream::open(dir / "data.bin", options);
+  CHECK(readAll(*stream, options.chunkSize) == data.substr(1000, 49'001));
+
+  // Past the end of the file, and an empty range.
+  options.start = 99'990;
+  options.end = 200'000;
+  stream = ReadStream::open(dir / "data.bin", options);
+  CHECK(readAll(*stream, options.chunkSize) == data.substr(99'990));
+  options.start = 500;
+  options.end = 500;
+  stream = ReadStream::open(dir / "data.bin", options);
+  CHECK(readAll(*stream, options.chunkSize).empty());
+}
+
+TEST(readsPipesUntilEof) {
+  TempDir dir;
+  CHECK(::mkfifo((dir / "fifo").c_str(), 0600) == 0);
+  std::thread writer([&]() {
+    int fd = ::open((dir / "fifo").c_str(), O_WRONLY);
+    for (int i = 0; i < 100; i++) {
+      CHECK_EQ(::write(fd, "0123456789", 10), ssize_t(10));
+    }
+    ::close(fd);
+  });
+  ReadStreamOptions options;
+  options.chunkSize = 64;
+  // The bytes before `start` are read and dropped.
+  options.start = 5;
+  auto stream = ReadStream::open(dir / "fifo", options);
+  std::string result = readAll(*stream, options.chunkSize);
+  writer.join();
+  CHECK_EQ(result.size(), size_t(995));
+  CHECK_EQ(result.substr(0, 10), std::string("5678901234"));
+}
+
+TEST(closeAndOpenErrors) {
+  TempDir dir;
+  writeFile(dir / "data.bin", std::string(1'000'000, 'x'));
+  auto stream = ReadStream::open(dir / "data.bin", ReadStreamOptions());
+  CHECK(stream->next().has_value());
+  stream->close();
+  CHECK_ERRNO(stream->next(), EBADF);
+  // Closing twice is fine.
+  stream->close();
+
+  CHECK_ERRNO(ReadStream::open(dir / "missing", ReadStreamOptions()), ENOENT);
+  CHECK_ERRNO(ReadStream::open(dir.path(), ReadStreamOptions()), EISDIR);
+}
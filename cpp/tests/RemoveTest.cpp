@@ -0,0 +1,82 @@
+//
+//  RemoveTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/Remove.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  void makeTree(const std::string& root, int directories, int filesPerDirectory) {
+    for (int d = 0; d < directories; d++) {
+      for (int f = 0; f < filesPerDirectory; f++) {
+        writeFile(root + "/d" + std::to_string(d) + "/nested/f" + std::to_string(f), "x");
+      }
+    }
+  }
+
+  bool waitUntilGone(const std::string& path) {
+    for (int i = 0; i < 500 && exists(path); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return !exists(path);
+  }
+} // namespace
+
+TEST(removesTreesAndCountsEntries) {
+  TempDir dir;
+  makeTree(dir / "tree", 10, 5);
+  uint64_t lastProgress = 0;
+  RemoveOptions options;
+  options.recursive = true;
+  options.maxThreads = 4;
+  options.onProgress = [&](uint64_t removed) { lastProgress = removed; };
+  // 50 files, 10 `nested` and 10 `d*` directories, and the root.
+  CHECK_EQ(removeTree(dir / "tree", options), uint64_t(71));
+  CHECK_EQ(lastProgress, uint64_t(71));
+  CHECK(!exists(dir / "tree"));
+  CHECK_EQ(removeTree(dir / "tree", options), uint64_t(0));
+}
+
+TEST(nonRecursiveRemoveKeepsNonEmptyDirectories) {
+  TempDir dir;
+  writeFile(dir / "tree/file", "x");
+  CHECK_ERRNO(removeTree(dir / "tree"), ENOTEMPTY);
+  CHECK_EQ(removeTree(dir / "tree/file"), uint64_t(1));
+  CHECK_EQ(removeTree(dir / "tree"), uint64_t(1));
+}
+
+TEST(backgroundRemoveSweepsStaleTrash) {
+  TempDir dir;
+  makeTree(dir / "tree", 3, 3);
+  // What a background rm that was killed mid-way leaves behind.
+  makeTree(dir / ".nitrofs-trash-123-0", 2, 2);
+  CHECK(removeInBackground(dir / "tree"));
+  CHECK(!exists(dir / "tree"));
+  CHECK(waitUntilGone(dir / ".nitrofs-trash-123-0"));
+  for (int i = 0; i < 500 && !readdir(dir.path()).empty(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  CHECK(readdir(dir.path()).empty());
+  CHECK(!removeInBackground(dir / "tree"));
+}
+
+TEST(sweepTrashOnlyTouchesTrash) {
+  TempDir dir;
+  makeTree(dir / ".nitrofs-trash-1-1", 1, 1);
+  writeFile(dir / ".nitrofs-trash-2-2", "a file left by a background rm of a file");
+  writeFile(dir / "keep/file", "x");
+  CHECK_EQ(sweepTrash(dir.path()), size_t(2));
+  CHECK_EQ(readdir(dir.path()).size(), size_t(1));
+  CHECK(exists(dir / "keep/file"));
+  CHECK_EQ(sweepTrash(dir / "missing"), size_t(0));
+}
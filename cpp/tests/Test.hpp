@@ -0,0 +1,133 @@
+//
+//  Test.hpp
+//  NitroFS
+//
+//  A minimal test harness for the host unit tests, so they build without any
+//  dependency beyond the core itself. Each `*Test.cpp` becomes one ctest executable.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace margelo::nitro::nitrofs::test {
+
+  struct TestCase {
+    const char* name;
+    void (*run)();
+  };
+
+  std::vector<TestCase>& registry();
+
+  inline bool registerTest(const char* name, void (*run)()) {
+    registry().push_back({name, run});
+    return true;
+  }
+
+  /**
+   * Thrown by a failed `CHECK`; aborts the current test only.
+   */
+  struct Failure: std::exception {
+    std::string message;
+    explicit Failure(std::string message): message(std::move(message)) {}
+    const char* what() const noexcept override { return message.c_str(); }
+  };
+
+  [[noreturn]] inline void fail(const char* file, int line, const std::string& message) {
+    throw Failure(std::string(file) + ":" + std::to_string(line) + ": " + message);
+  }
+
+  template <typename T>
+  std::string describe(const T& value) {
+    if constexpr (requires(std::ostream& out) { out << value; }) {
+      std::ostringstream out;
+      out << value;
+      return out.str();
+    } else {
+      return "<value>";
+    }
+  }
+
+  /**
+   * A fresh directory under `$TMPDIR` that is removed with everything in it when the test ends.
+   */
+  class TempDir {
+  public:
+    TempDir();
+    ~TempDir();
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    const std::string& path() const { return _path; }
+    std::string operator/(const std::string& name) const { return _path + "/" + name; }
+
+  private:
+    std::string _path;
+  };
+
+} // namespace margelo::nitro::nitrofs::test
+
+#define NITROFS_TEST_CONCAT_(a, b) a##b
+#define NITROFS_TEST_CONCAT(a, b) NITROFS_TEST_CONCAT_(a, b)
+
+#define TEST(name)                                                                                                     \
+  static void name();                                                                                                  \
+  static const bool NITROFS_TEST_CONCAT(name, _registered) = ::margelo::nitro::nitrofs::test::registerTest(#name, name); \
+  static void name()
+
+#define CHECK(condition)                                                                                               \
+  do {                                                                                                                 \
+    if (!(condition)) {                                                                                                \
+      ::margelo::nitro::nitrofs::test::fail(__FILE__, __LINE__, "CHECK(" #condition ") failed");                       \
+    }                                                                                                                  \
+  } while (false)
+
+#define CHECK_EQ(actual, expected)                                                                                     \
+  do {                                                                                                                 \
+    const auto& actual_ = (actual);                                                                                    \
+    const auto& expected_ = (expected);                                                                                \
+    if (!(actual_ == expected_)) {                                                                                     \
+      ::margelo::nitro::nitrofs::test::fail(__FILE__, __LINE__,                                                        \
+                                            "CHECK_EQ(" #actual ", " #expected ") failed: " +                          \
+                                                ::margelo::nitro::nitrofs::test::describe(actual_) + " != " +          \
+                                                ::margelo::nitro::nitrofs::test::describe(expected_));                 \
+    }                                                                                                                  \
+  } while (false)
+
+#define CHECK_THROWS(expression, Exception)                                                                            \
+  do {                                                                                                                 \
+    bool threw_ = false;                                                                                               \
+    try {                                                                                                              \
+      (void)(expression);                                                                                              \
+    } catch (const Exception&) {                                                                                       \
+      threw_ = true;                                                                                                   \
+    }                                                                                                                  \
+    if (!threw_) {                                                                                                     \
+      ::margelo::nitro::nitrofs::test::fail(__FILE__, __LINE__, #expression " did not throw " #Exception);             \
+    }                                                                                                                  \
+  } while (false)
+
+/**
+ * Like `CHECK_THROWS`, for a `std::system_error` carrying the `errno` value `errorCode`.
+ */
+#define CHECK_ERRNO(expression, errorCode)                                                                             \
+  do {                                                                                                                 \
+    int error_ = 0;                                                                                                    \
+    try {                                                                                                              \
+      (void)(expression);                                                                                              \
+    } catch (const std::system_error& e) {                                                                             \
+      error_ = e.code().value();                                                                                       \
+    }                                                                                                                  \
+    if (error_ != (errorCode)) {                                                                                       \
+      ::margelo::nitro::nitrofs::test::fail(__FILE__, __LINE__,                                                        \
+                                            #expression " failed with errno " + std::to_string(error_) +               \
+                                                ", expected " #errorCode);                                             \
+    }                                                                                                                  \
+  } while (false)
@@ -0,0 +1,70 @@
+//
+//  TestMain.cpp
+//  NitroFS
+//
+//  Runs every test registered in the executable, or only those whose name
+//  contains one of the command-line arguments.
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace margelo::nitro::nitrofs::test {
+
+  std::vector<TestCase>& registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+  }
+
+  TempDir::TempDir() {
+    const char* base = std::getenv("TMPDIR");
+    std::string pattern = std::string(base != nullptr && *base != '\0' ? base : "/tmp") + "/nitrofs-test-XXXXXX";
+    if (::mkdtemp(pattern.data()) == nullptr) {
+      throw std::runtime_error("mkdtemp(" + pattern + ") failed");
+    }
+    _path = pattern;
+  }
+
+  TempDir::~TempDir() {
+    try {
+      core::removeAll(_path);
+    } catch (...) {
+      // Leave it for the OS to clean up rather than masking the test result.
+    }
+  }
+
+} // namespace margelo::nitro::nitrofs::test
+
+int main(int argc, char** argv) {
+  using namespace margelo::nitro::nitrofs::test;
+
+  int passed = 0;
+  int failed = 0;
+  for (const TestCase& test : registry()) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc && !selected; i++) {
+      selected = std::strstr(test.name, argv[i]) != nullptr;
+    }
+    if (!selected) {
+      continue;
+    }
+    try {
+      test.run();
+      passed++;
+      std::printf("[ PASS ] %s\n", test.name);
+    } catch (const Failure& e) {
+      failed++;
+      std::printf("[ FAIL ] %s\n  %s\n", test.name, e.what());
+    } catch (const std::exception& e) {
+      failed++;
+      std::printf("[ FAIL ] %s\n  unexpected exception: %s\n", test.name, e.what());
+    }
+  }
+  std::printf("%d passed, %d failed\n", passed, failed);
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,94 @@
+//
+//  TextTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/Text.hpp"
+#include "core/TextKernels.hpp"
+
+#include <random>
+
+using namespace margelo::nitro::nitrofs::core;
+
+namespace {
+  /**
+   * Runs `check` once with every kernel set this CPU supports.
+   */
+  template <typename Fn>
+  void forEachKernel(Fn&& check) {
+    for (const auto* kernels : text::detail::availableKernels()) {
+      text::detail::setActiveKernels(*kernels);
+      check();
+    }
+    text::detail::setActiveKernels(*text::detail::availableKernels().front());
+  }
+
+  /**
+   * Pads `text` on both sides so the interesting bytes land in the middle of a SIMD block.
+   */
+  std::string padded(std::string_view text) {
+    return std::string(37, 'a') + std::string(text) + std::string(29, 'b');
+  }
+} // namespace
+
+TEST(validatesUtf8) {
+  forEachKernel([] {
+    CHECK(isValidUtf8(""));
+    CHECK(isValidUtf8(padded("h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80")));
+    CHECK(!isValidUtf8(padded("\xC0\xAF")));         // overlong '/'
+    CHECK(!isValidUtf8(padded("\xED\xA0\x80")));     // surrogate
+    CHECK(!isValidUtf8(padded("\xF4\x90\x80\x80"))); // above U+10FFFF
+    CHECK(!isValidUtf8(padded("\x80")));             // stray continuation
+    CHECK(!isValidUtf8(std::string(40, 'a') + "\xE2\x82")); // truncated at the end
+  });
+}
+
+TEST(asciiPrefixStopsAtFirstNonAsciiByte) {
+  forEachKernel([] {
+    CHECK_EQ(asciiPrefixLength(""), size_t(0));
+    CHECK_EQ(asciiPrefixLength(std::string(100, 'x')), size_t(100));
+    CHECK_EQ(asciiPrefixLength(std::string(70, 'x') + "\xC3\xA9"), size_t(70));
+  });
+}
+
+TEST(countsBytes) {
+  std::mt19937 random(7);
+  std::string text(10'000, '\0');
+  size_t expected = 0;
+  for (char& c : text) {
+    c = static_cast<char>(random() % 16 == 0 ? '\n' : 'a' + random() % 26);
+    expected += c == '\n';
+  }
+  forEachKernel([&] {
+    CHECK_EQ(countByte(text, '\n'), expected);
+    CHECK_EQ(countByte(std::string_view(text).substr(3, 61), '\n'), text::detail::scalarKernels().countByte(text.data() + 3, 61, '\n'));
+    CHECK_EQ(countByte(std::string(300, '\xFF'), '\xFF'), size_t(300));
+  });
+}
+
+TEST(sanitizeUtf8ReplacesInvalidSequences) {
+  std::string valid = "caf\xC3\xA9";
+  sanitizeUtf8(valid);
+  CHECK_EQ(valid, std::string("caf\xC3\xA9"));
+
+  std::string invalid = "a\xFF" "b\xE2\x82" "c\xC0\xAF";
+  sanitizeUtf8(invalid);
+  // Like TextDecoder: one U+FFFD per maximal invalid subpart.
+  CHECK_EQ(invalid, std::string("a\xEF\xBF\xBD" "b\xEF\xBF\xBD" "c\xEF\xBF\xBD\xEF\xBF\xBD"));
+}
+
+TEST(findsIncompleteSuffix) {
+  CHECK_EQ(incompleteUtf8SuffixLength("abc"), size_t(0));
+  CHECK_EQ(incompleteUtf8SuffixLength("abc\xE2\x82"), size_t(2));
+  CHECK_EQ(incompleteUtf8SuffixLength("abc\xE2\x82\xAC"), size_t(0));
+  CHECK_EQ(incompleteUtf8SuffixLength("\xF0"), size_t(1));
+}
+
+TEST(convertsToAscii) {
+  CHECK_EQ(utf8ToAscii("caf\xC3\xA9 \xF0\x9F\x98\x80!"), std::string("caf? ?!"));
+  std::string bytes = "a\x80z";
+  sanitizeAscii(bytes);
+  CHECK_EQ(bytes, std::string("a?z"));
+}
@@ -0,0 +1,182 @@
+//
+//  WalkTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/Walk.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  /**
+   * Every reported entry, by path relative to `root`, and the number of times each was reported.
+   */
+  std::map<std::string, int> walkAll(const std::string& root, WalkOptions options) {
+    std::map<std::string, int> seen;
+    uint64_t count = walk(root, options, [&](std::vector<DirEntry>&& batch) {
+      CHECK(!batch.empty());
+      CHECK(batch.size() <= options.batchSize);
+      for (const auto& entry : batch) {
+        seen[entry.path.substr(root.size() + 1)]++;
+      }
+    });
+    uint64_t reported = 0;
+    for (const auto& [path, times] : seen) {
+      CHECK_EQ(times, 1);
+      reported += static_cast<uint64_t>(times);
+    }
+    CHECK_EQ(count, reported);
+    return seen;
+  }
+
+  void makeTree(const TempDir& dir) {
+    for (int i = 0; i < 20; i++) {
+      writeFile(dir / ("tree/a/file" + std::to_string(i)), std::string(static_cast<size_t>(i), 'x'));
+    }
+    writeFile(dir / "tree/a/b/c/deep.txt", "deep");
+    writeFile(dir / "tree/skip/hidden.txt", "hidden");
+    writeFile(dir / "tree/top.txt", "top");
+  }
+} // namespace
+
+TEST(walksEveryEntryOnce) {
+  TempDir dir;
+  makeTree(dir);
+  WalkOptions options;
+  options.batchSize = 7;
+  options.maxThreads = 4;
+  auto seen = walkAll(dir / "tree", options);
+  // a with its 20 files, a/b, a/b/c and deep.txt, skip and hidden.txt, and top.txt.
+  CHECK_EQ(seen.size(), size_t(27));
+  CHECK(seen.count("a/b/c/deep.txt") == 1);
+  CHECK(seen.count("skip/hidden.txt") == 1);
+}
+
+TEST(maxDepthExcludeAndFilter) {
+  TempDir dir;
+  makeTree(dir);
+  WalkOptions options;
+  options.maxDepth = 1;
+  auto seen = walkAll(dir / "tree", options);
+  CHECK_EQ(seen.size(), size_t(3));
+
+  options = WalkOptions();
+  options.exclude = [](const DirEntry& entry) { return entry.name == "skip"; };
+  seen = walkAll(dir / "tree", options);
+  CHECK(seen.count("skip") == 0);
+  CHECK(seen.count("skip/hidden.txt") == 0);
+
+  // Filtered directories are still descended into.
+  options = WalkOptions();
+  options.filter = [](const DirEntry& entry) { return entry.type == FileType::File; };
+  seen = walkAll(dir / "tree", options);
+  CHECK_EQ(seen.size(), size_t(23));
+  CHECK(seen.count("a/b/c/deep.txt") == 1);
+  CHECK(seen.count("a/b") == 0);
+}
+
+TEST(statsAndSymlinks) {
+  TempDir dir;
+  makeTree(dir);
+  CHECK(::symlink("..", (dir / "tree/a/b/loop").c_str()) == 0);
+
+  WalkOptions options;
+  options.detail = DirDetail::Stats;
+  std::vector<DirEntry> entries;
+  walk(dir / "tree", options, [&](std::vector<DirEntry>&& batch) { std::move(batch.begin(), batch.end(), std::back_inserter(entries)); });
+  for (const auto& entry : entries) {
+    CHECK(entry.stat.has_value());
+    if (entry.name == "deep.txt") {
+      CHECK_EQ(entry.stat->size, uint64_t(4));
+    }
+    if (entry.name == "loop") {
+      CHECK(entry.type == FileType::Symlink);
+    }
+  }
+
+  // Following the link leads back up the tree; the cycle is skipped instead of walked forever.
+  options = WalkOptions();
+  options.followSymlinks = true;
+  auto seen = walkAll(dir / "tree", options);
+  CHECK(seen.count("a/b/loop") == 1);
+  CHECK(seen.count("a/b/c/deep.txt") == 1);
+}
+
+TEST(followsSiblingSymlinksLikeFindL) {
+  TempDir dir;
+  for (int i = 0; i < 20; i++) {
+    std::string name = "dir" + std::to_string(i);
+    for (int j = 0; j < 5; j++) {
+      writeFile(dir / ("tree/" + name + "/file" + std::to_string(j)), "x");
+    }
+    CHECK(::symlink(name.c_str(), (dir / ("tree/link" + std::to_string(i))).c_str()) == 0);
+  }
+  // A link to a directory that was already seen elsewhere is not a cycle: both copies are walked.
+  WalkOptions options;
+  options.followSymlinks = true;
+  options.maxThreads = 4;
+  auto seen = walkAll(dir / "tree", options);
+  CHECK_EQ(seen.size(), size_t(240));
+  CHECK(seen.count("link7/file4") == 1);
+  CHECK(seen.count("dir7/file4") == 1);
+
+  // One level down, a link to the root or a parent is still a cycle.
+  CHECK(::symlink("..", (dir / "tree/dir0/up").c_str()) == 0);
+  seen = walkAll(dir / "tree", options);
+  // dir0/up, and link0/up (dir0 again, whose parent is the root).
+  CHECK_EQ(seen.size(), size_t(242));
+}
+
+TEST(missingRootThrows) {
+  TempDir dir;
+  CHECK_ERRNO(walk(dir / "missing", WalkOptions(), [](std::vector<DirEntry>&&) {}), ENOENT);
+}
+
+TEST(diskUsageTotalsAndLargest) {
+  TempDir dir;
+  makeTree(dir);
+  writeFile(dir / "tree/skip/big.bin", std::string(100'000, 'b'));
+  CHECK(::symlink("skip/big.bin", (dir / "tree/link").c_str()) == 0);
+
+  DiskUsage usage = diskUsage(dir / "tree", 4, 2);
+  // 0 + 1 + ... + 19 bytes in a, plus deep.txt, hidden.txt, top.txt and big.bin. The symlink is not followed.
+  uint64_t linkSize = static_cast<uint64_t>(std::string("skip/big.bin").size());
+  CHECK_EQ(usage.size, uint64_t(190 + 4 + 6 + 3 + 100'000) + linkSize);
+  CHECK_EQ(usage.fileCount, uint64_t(25));
+  CHECK_EQ(usage.directoryCount, uint64_t(4));
+  CHECK(usage.allocatedSize >= 100'000);
+
+  CHECK_EQ(usage.largestFiles.size(), size_t(2));
+  CHECK_EQ(usage.largestFiles[0].path, dir / "tree/skip/big.bin");
+  CHECK_EQ(usage.largestFiles[0].size, uint64_t(100'000));
+  CHECK_EQ(usage.largestFiles[1].path, dir / "tree/a/file19");
+  CHECK_EQ(usage.largestDirectories.size(), size_t(2));
+  CHECK_EQ(usage.largestDirectories[0].path, dir / "tree/skip");
+  CHECK_EQ(usage.largestDirectories[0].size, uint64_t(100'006));
+  CHECK_EQ(usage.largestDirectories[1].path, dir / "tree/a");
+  CHECK_EQ(usage.largestDirectories[1].size, uint64_t(194));
+}
+
+TEST(diskUsageCountsHardLinksOnce) {
+  TempDir dir;
+  writeFile(dir / "tree/a/big.bin", std::string(50'000, 'b'));
+  writeFile(dir / "tree/small.txt", "small");
+  mkdirs(dir / "tree/b");
+  CHECK(::link((dir / "tree/a/big.bin").c_str(), (dir / "tree/b/same.bin").c_str()) == 0);
+  CHECK(::link((dir / "tree/a/big.bin").c_str(), (dir / "tree/a/again.bin").c_str()) == 0);
+
+  DiskUsage usage = diskUsage(dir / "tree", 4, 10);
+  CHECK_EQ(usage.size, uint64_t(50'005));
+  CHECK_EQ(usage.fileCount, uint64_t(2));
+  CHECK(usage.allocatedSize < 100'000);
+  CHECK_EQ(usage.largestFiles.size(), size_t(2));
+}
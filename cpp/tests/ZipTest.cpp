@@ -0,0 +1,223 @@
+//
+//  ZipTest.cpp
+//  NitroFS
+//
+
+#include "Test.hpp"
+
+#include "core/FileSystem.hpp"
+#include "core/Zip.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <random>
+
+using namespace margelo::nitro::nitrofs::core;
+using margelo::nitro::nitrofs::test::TempDir;
+
+namespace {
+  std::string randomBytes(size_t size, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::string bytes(size, '\0');
+    for (char& c : bytes) {
+      c = static_cast<char>(random());
+    }
+    return bytes;
+  }
+
+  std::string text(size_t size) {
+    std::string result;
+    while (result.size() < size) {
+      result += "line " + std::to_string(result.size()) + " of some fairly repetitive text\n";
+    }
+    result.resize(size);
+    return result;
+  }
+
+  void put16(std::string& out, uint32_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>((value >> 8) & 0xFF));
+  }
+
+  void put32(std::string& out, uint32_t value) {
+    put16(out, value & 0xFFFF);
+    put16(out, value >> 16);
+  }
+
+  /**
+   * A one-entry archive with a stored entry named `name`, as a malicious archiver might write it.
+   */
+  std::string storedArchive(const std::string& name, const std::string& contents, uint32_t crc) {
+    std::string archive;
+    put32(archive, 0x04034b50);
+    put16(archive, 20);
+    put16(archive, 0);
+    put16(archive, 0);
+    put32(archive, 0);
+    put32(archive, crc);
+    put32(archive, static_cast<uint32_t>(contents.size()));
+    put32(archive, static_cast<uint32_t>(contents.size()));
+    put16(archive, static_cast<uint32_t>(name.size()));
+    put16(archive, 0);
+    archive += name + contents;
+    size_t directoryOffset = archive.size();
+    put32(archive, 0x02014b50);
+    put16(archive, 20);
+    put16(archive, 20);
+    put16(archive, 0);
+    put16(archive, 0);
+    put32(archive, 0);
+    put32(archive, crc);
+    put32(archive, static_cast<uint32_t>(contents.size()));
+    put32(archive, static_cast<uint32_t>(contents.size()));
+    put16(archive, static_cast<uint32_t>(name.size()));
+    put32(archive, 0);
+    put32(archive, 0);
+    put32(archive, 0);
+    put32(archive, 0);
+    archive += name;
+    size_t directorySize = archive.size() - directoryOffset;
+    put32(archive, 0x06054b50);
+    put32(archive, 0);
+    put16(archive, 1);
+    put16(archive, 1);
+    put32(archive, static_cast<uint32_t>(directorySize));
+    put32(archive, static_cast<uint32_t>(directoryOffset));
+    put16(archive, 0);
+    return archive;
+  }
+} // namespace
+
+TEST(roundTripsATree) {
+  TempDir dir;
+  writeFile(dir / "src/empty.txt", "");
+  writeFile(dir / "src/small.txt", "hello");
+  writeFile(dir / "src/nested/deeper/large.txt", text(3 * 1024 * 1024 + 123));
+  writeFile(dir / "src/nested/random.bin", randomBytes(200'000, 1));
+  mkdirs(dir / "src/emptyDir");
+  CHECK(::symlink("small.txt", (dir / "src/link").c_str()) == 0);
+
+  ZipProgress last;
+  ZipOptions zipOptions;
+  zipOptions.maxThreads = 4;
+  zipOptions.onProgress = [&](const ZipProgress& progress) { last = progress; };
+  uint64_t archiveSize = zip(dir / "src", dir / "out.zip", zipOptions);
+  CHECK_EQ(archiveSize, stat(dir / "out.zip").size);
+  CHECK_EQ(last.processedEntries, last.totalEntries);
+  CHECK_EQ(last.processedBytes, last.totalBytes);
+  // The text deflates well, even split into chunks.
+  CHECK(archiveSize < 1024 * 1024);
+
+  CHECK_EQ(unzip(dir / "out.zip", dir / "dest"), uint64_t(5));
+  CHECK_EQ(readFile(dir / "dest/empty.txt"), std::string(""));
+  CHECK_EQ(readFile(dir / "dest/small.txt"), std::string("hello"));
+  CHECK(readFile(dir / "dest/nested/deeper/large.txt") == text(3 * 1024 * 1024 + 123));
+  CHECK(readFile(dir / "dest/nested/random.bin") == randomBytes(200'000, 1));
+  CHECK(stat(dir / "dest/emptyDir").isDirectory);
+  char target[32] = {};
+  CHECK_EQ(::readlink((dir / "dest/link").c_str(), target, sizeof(target)), ssize_t(9));
+  CHECK_EQ(std::string(target), std::string("small.txt"));
+}
+
+TEST(incompressibleEntriesAreStored) {
+  TempDir dir;
+  // Larger than one chunk, so the whole entry has to fall back, not just a single chunk.
+  std::string random = randomBytes(3 * 1024 * 1024, 2);
+  writeFile(dir / "src/random.bin", random);
+  uint64_t archiveSize = zip(dir / "src/random.bin", dir / "random.zip");
+  // Stored: the data plus headers, never the data plus deflate's framing.
+  CHECK(archiveSize <= random.size() + 200);
+  CHECK_EQ(unzip(dir / "random.zip", dir / "dest"), uint64_t(1));
+  CHECK(readFile(dir / "dest/random.bin") == random);
+
+  // A first chunk that shrinks a little, followed by chunks that don't: only the total shows the entry grew.
+  std::string mixed = std::string(600, '\0') + randomBytes(3 * 1024 * 1024, 3);
+  writeFile(dir / "src/mixed.bin", mixed);
+  archiveSize = zip(dir / "src/mixed.bin", dir / "mixed.zip");
+  CHECK(archiveSize <= mixed.size() + 200);
+  CHECK_EQ(unzip(dir / "mixed.zip", dir / "dest"), uint64_t(1));
+  CHECK(readFile(dir / "dest/mixed.bin") == mixed);
+}
+
+TEST(storeOnlyLevel) {
+  TempDir dir;
+  writeFile(dir / "src/a.txt", text(2 * 1024 * 1024));
+  ZipOptions options;
+  options.level = 0;
+  CHECK(zip(dir / "src", dir / "out.zip", options) >= 2 * 1024 * 1024);
+  unzip(dir / "out.zip", dir / "dest");
+  CHECK(readFile(dir / "dest/a.txt") == text(2 * 1024 * 1024));
+  options.level = 10;
+  CHECK_THROWS(zip(dir / "src", dir / "bad.zip", options), std::invalid_argument);
+}
+
+TEST(rejectsZipSlip) {
+  TempDir dir;
+  // crc32("pwned")
+  const uint32_t crc = 0xd904537e;
+  for (const char* name : {"../evil.txt", "a/../../evil.txt", "/tmp/evil.txt"}) {
+    writeFile(dir / "evil.zip", storedArchive(name, "pwned", crc));
+    CHECK_THROWS(unzip(dir / "evil.zip", dir / "dest"), std::invalid_argument);
+    CHECK(!exists(dir / "evil.txt"));
+    // Nothing is written before every entry is checked.
+    CHECK(!exists(dir / "dest"));
+  }
+}
+
+TEST(rejectsCorruptArchives) {
+  TempDir dir;
+  writeFile(dir / "not.zip", "definitely not a zip archive");
+  CHECK_THROWS(unzip(dir / "not.zip", dir / "dest"), std::invalid_argument);
+  writeFile(dir / "crc.zip", storedArchive("file.txt", "pwned", 0x12345678));
+  CHECK_THROWS(unzip(dir / "crc.zip", dir / "dest"), std::invalid_argument);
+}
+
+TEST(roundTripsModesAndTimes) {
+  TempDir dir;
+  writeFile(dir / "src/bin/run.sh", "#!/bin/sh\n");
+  writeFile(dir / "src/private/notes.txt", "secret");
+  CHECK(::chmod((dir / "src/bin/run.sh").c_str(), 04755) == 0);
+  CHECK(::chmod((dir / "src/private/notes.txt").c_str(), 0600) == 0);
+  const timespec fileTimes[2] = {{0, UTIME_OMIT}, {1'588'748'889, 0}};
+  CHECK(::utimensat(AT_FDCWD, (dir / "src/bin/run.sh").c_str(), fileTimes, 0) == 0);
+  const timespec directoryTimes[2] = {{0, UTIME_OMIT}, {1'500'000'000, 0}};
+  CHECK(::utimensat(AT_FDCWD, (dir / "src/private").c_str(), directoryTimes, 0) == 0);
+  CHECK(::chmod((dir / "src/private").c_str(), 0700) == 0);
+
+  zip(dir / "src", dir / "out.zip");
+  unzip(dir / "out.zip", dir / "dest");
+
+  struct stat st {};
+  CHECK(::stat((dir / "dest/bin/run.sh").c_str(), &st) == 0);
+  // The exec bits survive; setuid doesn't.
+  CHECK_EQ(st.st_mode & 07777, mode_t(0755));
+  CHECK_EQ(st.st_mtime, time_t(1'588'748'889));
+  CHECK(::stat((dir / "dest/private/notes.txt").c_str(), &st) == 0);
+  CHECK_EQ(st.st_mode & 07777, mode_t(0600));
+  // Set after its contents were extracted.
+  CHECK(::stat((dir / "dest/private").c_str(), &st) == 0);
+  CHECK_EQ(st.st_mode & 07777, mode_t(0700));
+  CHECK_EQ(st.st_mtime, time_t(1'500'000'000));
+}
+
+TEST(rejectsEntriesThroughExistingSymlinks) {
+  TempDir dir;
+  mkdirs(dir / "outside");
+  mkdirs(dir / "first");
+  CHECK(::symlink((dir / "outside").c_str(), (dir / "first/a").c_str()) == 0);
+  zip(dir / "first", dir / "first.zip");
+  writeFile(dir / "second/a/evil.txt", "pwned");
+  zip(dir / "second", dir / "second.zip");
+
+  unzip(dir / "first.zip", dir / "dest");
+  CHECK_THROWS(unzip(dir / "second.zip", dir / "dest"), std::invalid_argument);
+  CHECK(!exists(dir / "outside/evil.txt"));
+
+  // destDir itself may be a symlink.
+  CHECK(::symlink((dir / "real").c_str(), (dir / "linked").c_str()) == 0);
+  mkdirs(dir / "real");
+  unzip(dir / "second.zip", dir / "linked");
+  CHECK_EQ(readFile(dir / "real/a/evil.txt"), std::string("pwned"));
+}
@@ -30,22 +30,13 @@ export const useFileSystem = () => {
   const listFiles = async (path: string) => {
     try {
       setLoading(true);
-      const fileList = await NitroFS.readdir(path);
-      const fileItems: FileItem[] = [];
-
-      for (const file of fileList) {
-        try {
-          const stat = await NitroFS.stat(file.path);
-          fileItems.push({
-            name: file.name,
-            path: file.path,
-            isDirectory: stat.isDirectory,
-            size: stat.size,
-          });
-        } catch (error) {
-          console.error(`Error getting stat for ${file.path}:`, error);
-        }
-      }
+      const entries = await NitroFS.readdir(path, { stats: true, mimeTypes: false });
+      const fileItems: FileItem[] = entries.map((entry) => ({
+        name: entry.name,
+        path: entry.path,
+        isDirectory: entry.type === 'directory',
+        size: entry.size ?? 0,
+      }));
 
       setFiles(fileItems);
       setCurrentPath(path);
@@ -450,7 +441,7 @@ export const useFileSystem = () => {
 
       const imageFiles = files.filter(file => {
         // Check mimeType first
-        if (imageMimeTypes.includes(file.mimeType.toLowerCase())) {
+        if (file.mimeType && imageMimeTypes.includes(file.mimeType.toLowerCase())) {
           return true;
         }
         // Fallback to extension check
@@ -1,5 +1,5 @@
 //
-//  HybridNitroFS.swift
+//  HybridNitroFSPlatform.swift
 //  NitroFS
 //
 //  Created by Patrick Kabwe on 26/04/2025.
@@ -9,7 +9,7 @@ import os
 import Foundation
 import NitroModules
 
-class HybridNitroFS: HybridNitroFSSpec {
+class HybridNitroFSPlatform: HybridNitroFSPlatformSpec {
     static private(set) var fileManager: FileManager = FileManager.default
     private(set) var nitroFSImpl: NitroFSImpl = NitroFSImpl(fileManager: fileManager)
     
@@ -22,6 +22,10 @@ class HybridNitroFS: HybridNitroFSSpec {
     var MOVIES_DIR: String = ""
     var MUSIC_DIR: String = ""
 
+    /// Running transfer attempts by the id the C++ queue gave them, so `cancelTransfer` can stop them.
+    private let transfersLock = NSLock()
+    private var transfers: [Double: Task<Void, Never>] = [:]
+
     func exists(path: String) throws -> Promise<Bool> {
         return .async { [unowned nitroFSImpl] in
             nitroFSImpl.exists(path: path)
@@ -157,10 +161,11 @@ class HybridNitroFS: HybridNitroFSSpec {
     }
 
     func uploadFile(
+        transferId: Double,
         uploadOptions: NitroUploadOptions,
         onProgress: ((_ uploadedBytes: Double, _ totalBytes: Double) -> Void)?
     ) throws -> Promise<Void>{
-        return .async { [unowned self] in
+        return transfer(transferId) { [unowned self] in
             do {
                 try await self.nitroFSImpl.uploadFile(
                     uploadOptions: uploadOptions,
@@ -173,8 +178,8 @@ class HybridNitroFS: HybridNitroFSSpec {
         }
     }
     
-    func downloadFile(downloadOptions: NitroDownloadOptions, onProgress: ((Double, Double) -> Void)?) throws -> NitroModules.Promise<NitroFile> {
-        return .async { [unowned self] in
+    func downloadFile(transferId: Double, downloadOptions: NitroDownloadOptions, onProgress: ((Double, Double) -> Void)?) throws -> NitroModules.Promise<NitroFile> {
+        return transfer(transferId) { [unowned self] in
             do {
                 return try await self.nitroFSImpl.downloadFile(
                     downloadOptions: downloadOptions,
@@ -186,4 +191,40 @@ class HybridNitroFS: HybridNitroFSSpec {
             }
         }
     }
+
+    func setMaxConnectionsPerHost(maxConnections: Double) throws {
+        NitroFSTransferSession.shared.setMaxConnectionsPerHost(Int(maxConnections))
+    }
+
+    func cancelTransfer(transferId: Double) throws {
+        transfersLock.lock()
+        let task = transfers[transferId]
+        transfersLock.unlock()
+        task?.cancel()
+    }
+
+    /// Like `Promise.async`, but keeps the task under `transferId` until it ends. It is dropped before the
+    /// promise settles, as the queue may start the next attempt under the same id from there.
+    private func transfer<T>(_ transferId: Double, _ run: @escaping () async throws -> T) -> Promise<T> {
+        let promise = Promise<T>()
+        transfersLock.lock()
+        defer { transfersLock.unlock() }
+        // Registered before the task can finish and remove itself, as it waits for the lock.
+        transfers[transferId] = Task { [unowned self] in
+            let result: Result<T, Error>
+            do {
+                result = .success(try await run())
+            } catch {
+                result = .failure(error)
+            }
+            self.transfersLock.lock()
+            self.transfers[transferId] = nil
+            self.transfersLock.unlock()
+            switch result {
+            case .success(let value): promise.resolve(withResult: value)
+            case .failure(let error): promise.reject(withError: error)
+            }
+        }
+        return promise
+    }
 }
@@ -7,54 +7,148 @@
 
 import Foundation
 
+/// What the partial download in `<destinationPath>.part` was fetched from, saved next to it as
+/// `<destinationPath>.part.json`. A later download of the same URL resumes from `bytes` with
+/// `Range`/`If-Range`, so the server only sends the rest if the file hasn't changed in between.
+/// Segmented downloads also record how far each of their `segments` got.
+struct DownloadCheckpoint: Codable {
+    static let partSuffix = ".part"
+    static let checkpointSuffix = ".json"
+
+    let url: String
+    let etag: String?
+    let lastModified: String?
+    var bytes: Int64
+    let totalBytes: Int64?
+    /// `[start, end, received]` for each range of a segmented download.
+    var segments: [[Int64]]? = nil
+
+    /// The `If-Range` value: the ETag if it is a strong one (weak ETags aren't allowed there), else Last-Modified.
+    var validator: String? {
+        if let etag, !etag.hasPrefix("W/") {
+            return etag
+        }
+        return lastModified
+    }
+
+    static func read(from url: URL) -> DownloadCheckpoint? {
+        guard let data = try? Data(contentsOf: url) else { return nil }
+        return try? JSONDecoder().decode(DownloadCheckpoint.self, from: data)
+    }
+
+    func write(to url: URL) {
+        guard let data = try? JSONEncoder().encode(self) else { return }
+        try? data.write(to: url, options: .atomic)
+    }
+}
+
+/// Downloads into `<destinationPath>.part` and moves it into place once complete. The progress is
+/// checkpointed, so a failed or cancelled download of the same URL picks up where it left off
+/// instead of starting from byte zero.
 final class NitroFSFileDownloader: NSObject {
+    private static let checkpointInterval: Int64 = 4 * 1024 * 1024
+    private static let progressInterval: TimeInterval = 0.1
+    private static let defaultMinSegmentSize: Double = 4 * 1024 * 1024
+
     private weak var fileManager: FileManager?
-    private var downloadTask: URLSessionDownloadTask?
+    private var dataTask: URLSessionDataTask?
     private var onProgress: ((Double, Double) -> Void)?
     private var continuation: CheckedContinuation<NitroFile, Error>?
-    private var destinationPath: String?
-    
+    private var request: URLRequest?
+    private var sourceURL = ""
+    private var resumable = true
+    private var destinationURL: URL?
+    private var partURL: URL?
+    private var checkpointURL: URL?
+
+    // Per-attempt state, only touched on the transfer queue.
+    private var checkpoint: DownloadCheckpoint?
+    private var fileHandle: FileHandle?
+    private var savedBytes: Int64 = 0
+    private var lastProgress = Date.distantPast
+    private var mimeType = "application/octet-stream"
+    private var partIsComplete = false
+    private var shouldRestart = false
+    private var failure: Error?
+    private var cancelled = false
+
     init(fileManager: FileManager) {
         self.fileManager = fileManager
         super.init()
     }
-        
+
+    /// Cancelling the calling task stops the download, keeping the part file and checkpoint to resume from.
     func downloadFile(
         _ downloadOptions: NitroDownloadOptions,
         onProgress: ((Double, Double) -> Void)?
     ) async throws -> NitroFile {
-        guard fileManager != nil else {
+        return try await withTaskCancellationHandler {
+            try await download(downloadOptions, onProgress: onProgress)
+        } onCancel: {
+            cancelDownload()
+        }
+    }
+
+    func cancelDownload() {
+        NitroFSTransferSession.shared.queue.addOperation {
+            self.cancelled = true
+            self.dataTask?.cancel()
+        }
+    }
+
+    private func download(
+        _ downloadOptions: NitroDownloadOptions,
+        onProgress: ((Double, Double) -> Void)?
+    ) async throws -> NitroFile {
+        guard let fileManager else {
             throw NitroFSError.unavailable(message: "FileManager is not available")
         }
-        
+
         self.onProgress = onProgress
-        self.destinationPath = downloadOptions.destinationPath
-        
+        let destinationURL = URL(fileURLWithPath: downloadOptions.destinationPath)
+        let partURL = URL(fileURLWithPath: downloadOptions.destinationPath + DownloadCheckpoint.partSuffix)
+        let checkpointURL = URL(fileURLWithPath: partURL.path + DownloadCheckpoint.checkpointSuffix)
+        self.destinationURL = destinationURL
+        self.partURL = partURL
+        self.checkpointURL = checkpointURL
+        try fileManager.createDirectory(at: destinationURL.deletingLastPathComponent(), withIntermediateDirectories: true)
+
         let request = try makeRequest(
             url: downloadOptions.url,
             headers: downloadOptions.headers
         )
-        
-        let session: URLSession = {
-            let config = URLSessionConfiguration.default
-            config.requestCachePolicy = .reloadIgnoringLocalCacheData
-            return URLSession(configuration: config, delegate: self, delegateQueue: .main)
-        }()
-            
-        
+        self.request = request
+        sourceURL = downloadOptions.url
+        // A caller asking for a range of their own gets exactly that, without resuming.
+        resumable = request.value(forHTTPHeaderField: "Range") == nil
+
+        if let segments = downloadOptions.segments, segments > 1, resumable {
+            let segmentedDownloader = NitroFSSegmentedDownloader(
+                request: request,
+                sourceURL: downloadOptions.url,
+                partURL: partURL,
+                checkpointURL: checkpointURL
+            )
+            if let mimeType = try await segmentedDownloader.download(
+                segments: Int(segments),
+                minSegmentSize: Int64(downloadOptions.minSegmentSize ?? Self.defaultMinSegmentSize),
+                onProgress: onProgress
+            ) {
+                self.mimeType = mimeType
+                return try moveIntoPlace()
+            }
+        }
+        // Also where segmented downloads end up if the server can't serve ranges or the file is too small to split.
+        let resumeFrom = resumable ? loadCheckpoint(url: downloadOptions.url) : nil
+
         return try await withCheckedThrowingContinuation { continuation in
-            self.continuation = continuation
-            downloadTask = session.downloadTask(with: request)
-            downloadTask?.resume()
+            NitroFSTransferSession.shared.queue.addOperation {
+                self.continuation = continuation
+                self.start(resumingFrom: resumeFrom)
+            }
         }
     }
-    
-    func cancelDownload() {
-        downloadTask?.cancel()
-    }
-    
-    // MARK: - Private Methods
-    
+
     private func makeRequest(
         url: String,
         headers: [String: String]?
@@ -63,101 +157,243 @@ final class NitroFSFileDownloader: NSObject {
               let url = URL(string: encoded) else {
             throw URLError(.badURL)
         }
-        
+
         var request = URLRequest(url: url)
         request.httpMethod = "GET"
         request.cachePolicy = .reloadIgnoringLocalCacheData
         headers?.forEach { field, value in
             request.setValue(value, forHTTPHeaderField: field)
         }
+        // Range offsets count bytes of the encoded body, so they only line up with the part file
+        // if nothing is transparently decompressed in between.
+        if request.value(forHTTPHeaderField: "Accept-Encoding") == nil {
+            request.setValue("identity", forHTTPHeaderField: "Accept-Encoding")
+        }
         return request
     }
-    
-    private func handleDownloadCompletion(
-        location: URL,
-        response: URLResponse,
-        downloadTask: URLSessionDownloadTask
-    ) throws -> NitroFile {
-        guard let fileManager else {
+
+    /// The checkpoint to resume from, with the part file trimmed to the bytes it vouches for.
+    /// Anything that can't be resumed safely is deleted, so the download starts over.
+    private func loadCheckpoint(url: String) -> DownloadCheckpoint? {
+        guard let partURL, let checkpointURL else { return nil }
+        let partSize = (try? fileManager?.attributesOfItem(atPath: partURL.path)[.size] as? NSNumber)?.int64Value ?? 0
+        guard var checkpoint = DownloadCheckpoint.read(from: checkpointURL),
+              checkpoint.url == url,
+              checkpoint.validator != nil,
+              min(checkpoint.bytes, partSize) > 0,
+              let handle = try? FileHandle(forWritingTo: partURL) else {
+            try? fileManager?.removeItem(at: partURL)
+            try? fileManager?.removeItem(at: checkpointURL)
+            return nil
+        }
+        checkpoint.bytes = min(checkpoint.bytes, partSize)
+        try? handle.truncate(atOffset: UInt64(checkpoint.bytes))
+        try? handle.close()
+        return checkpoint
+    }
+
+    private func start(resumingFrom resumeFrom: DownloadCheckpoint?) {
+        guard var request else { return }
+        // Cancelled before this attempt got going, or while the 416 was handled.
+        guard !cancelled else {
+            finish(.failure(CancellationError()))
+            return
+        }
+        if let resumeFrom, let validator = resumeFrom.validator {
+            request.setValue("bytes=\(resumeFrom.bytes)-", forHTTPHeaderField: "Range")
+            request.setValue(validator, forHTTPHeaderField: "If-Range")
+        }
+        checkpoint = resumeFrom
+        fileHandle = nil
+        partIsComplete = false
+        shouldRestart = false
+        failure = nil
+        let dataTask = NitroFSTransferSession.shared.session.dataTask(with: request)
+        dataTask.delegate = self
+        self.dataTask = dataTask
+        dataTask.resume()
+    }
+
+    /// Decides what to do with the part file: 206 continues it, 200 means the server ignored the
+    /// range or the file changed, and 416 means there is nothing left to fetch.
+    private func handleResponse(_ response: URLResponse) throws -> URLSession.ResponseDisposition {
+        guard let fileManager, let partURL else {
             throw NitroFSError.unavailable(message: "FileManager is not available")
         }
-        
         guard let response = response as? HTTPURLResponse else {
             throw NitroFSError.networkError(message: "Invalid response type")
         }
-        
+        let resumeFrom = checkpoint?.bytes ?? 0
+        let contentRange = Self.parseContentRange(response.value(forHTTPHeaderField: "Content-Range"))
+
+        if response.statusCode == 416 && resumeFrom > 0 {
+            // The part file is complete, unless the file changed size.
+            if contentRange?.total == resumeFrom {
+                partIsComplete = true
+            } else {
+                shouldRestart = true
+            }
+            return .cancel
+        }
         guard (200...299).contains(response.statusCode) else {
             throw NitroFSError.networkError(message: "HTTP Error: \(response.statusCode)")
         }
-        
-        guard let destinationPath = self.destinationPath else {
+        mimeType = response.value(forHTTPHeaderField: "Content-Type") ?? "application/octet-stream"
+
+        let append = resumeFrom > 0 && response.statusCode == 206
+        if append && contentRange?.start != resumeFrom {
+            throw NitroFSError.networkError(message: "HTTP Error: unexpected Content-Range \(response.value(forHTTPHeaderField: "Content-Range") ?? "")")
+        }
+        let offset = append ? resumeFrom : 0
+        let expected = response.expectedContentLength
+        checkpoint = DownloadCheckpoint(
+            url: sourceURL,
+            etag: response.value(forHTTPHeaderField: "ETag"),
+            lastModified: response.value(forHTTPHeaderField: "Last-Modified"),
+            bytes: offset,
+            totalBytes: contentRange?.total ?? (expected >= 0 ? expected + offset : nil)
+        )
+
+        if !append {
+            fileManager.createFile(atPath: partURL.path, contents: nil)
+        }
+        let handle = try FileHandle(forWritingTo: partURL)
+        if append {
+            try handle.seekToEnd()
+        } else {
+            try handle.truncate(atOffset: 0)
+        }
+        fileHandle = handle
+        savedBytes = offset
+        saveCheckpoint()
+        return .allow
+    }
+
+    private func handleData(_ data: Data) throws {
+        guard let fileHandle, var checkpoint else { return }
+        try fileHandle.write(contentsOf: data)
+        checkpoint.bytes += Int64(data.count)
+        self.checkpoint = checkpoint
+        if checkpoint.bytes - savedBytes >= Self.checkpointInterval {
+            saveCheckpoint()
+        }
+        let now = Date()
+        if let totalBytes = checkpoint.totalBytes, now.timeIntervalSince(lastProgress) >= Self.progressInterval {
+            lastProgress = now
+            reportProgress(checkpoint.bytes, totalBytes)
+        }
+    }
+
+    private func handleCompletion(_ error: Error?) throws -> NitroFile {
+        try? fileHandle?.close()
+        fileHandle = nil
+        saveCheckpoint()
+        if let error = failure ?? (partIsComplete ? nil : error) {
+            throw error
+        }
+        guard let checkpoint else {
             throw NitroFSError.networkError(message: "Destination path not set")
         }
-        
-        let destinationURL = URL(fileURLWithPath: destinationPath)
-        
-        try fileManager.createDirectory(at: destinationURL.deletingLastPathComponent(), withIntermediateDirectories: true)
-        
-        if fileManager.fileExists(atPath: destinationPath) {
+        if let totalBytes = checkpoint.totalBytes, checkpoint.bytes != totalBytes {
+            throw NitroFSError.networkError(message: "Download ended after \(checkpoint.bytes) of \(totalBytes) bytes")
+        }
+        reportProgress(checkpoint.bytes, checkpoint.totalBytes ?? checkpoint.bytes)
+        return try moveIntoPlace()
+    }
+
+    private func moveIntoPlace() throws -> NitroFile {
+        guard let fileManager, let destinationURL, let partURL, let checkpointURL else {
+            throw NitroFSError.networkError(message: "Destination path not set")
+        }
+        if fileManager.fileExists(atPath: destinationURL.path) {
             try fileManager.removeItem(at: destinationURL)
         }
-        
-        try fileManager.moveItem(at: location, to: destinationURL)
-        
+        try fileManager.moveItem(at: partURL, to: destinationURL)
+        try? fileManager.removeItem(at: checkpointURL)
+
         return NitroFile(
             name: destinationURL.lastPathComponent,
-            mimeType: response.allHeaderFields["Content-Type"] as? String ?? "application/octet-stream",
-            path: destinationPath
+            mimeType: mimeType,
+            path: destinationURL.path
         )
     }
+
+    private func saveCheckpoint() {
+        guard resumable, let checkpoint, let checkpointURL else { return }
+        checkpoint.write(to: checkpointURL)
+        savedBytes = checkpoint.bytes
+    }
+
+    private func reportProgress(_ bytes: Int64, _ totalBytes: Int64) {
+        guard let onProgress else { return }
+        DispatchQueue.main.async {
+            onProgress(Double(bytes), Double(totalBytes))
+        }
+    }
+
+    private func finish(_ result: Result<NitroFile, Error>) {
+        continuation?.resume(with: result)
+        continuation = nil
+        dataTask = nil
+    }
+
+    /// A parsed `Content-Range: bytes <start>-<end>/<total>`. A 416 carries only the total.
+    static func parseContentRange(_ value: String?) -> (start: Int64?, total: Int64?)? {
+        guard let value, value.hasPrefix("bytes ") else { return nil }
+        let parts = value.dropFirst("bytes ".count).split(separator: "/", maxSplits: 1)
+        guard parts.count == 2 else { return nil }
+        let start = parts[0].split(separator: "-").first.flatMap { Int64($0) }
+        return (start, Int64(parts[1]))
+    }
 }
 
-// MARK: - URLSessionDownloadDelegate
+// MARK: - URLSessionDataDelegate
 
-extension NitroFSFileDownloader: URLSessionDownloadDelegate {
+extension NitroFSFileDownloader: URLSessionDataDelegate {
     func urlSession(
         _ session: URLSession,
-        downloadTask: URLSessionDownloadTask,
-        didFinishDownloadingTo location: URL
+        dataTask: URLSessionDataTask,
+        didReceive response: URLResponse,
+        completionHandler: @escaping (URLSession.ResponseDisposition) -> Void
     ) {
-        guard let continuation = self.continuation else { return }
-        
         do {
-            let file = try handleDownloadCompletion(
-                location: location,
-                response: downloadTask.response ?? URLResponse(),
-                downloadTask: downloadTask
-            )
-            continuation.resume(returning: file)
+            completionHandler(try handleResponse(response))
         } catch {
-            continuation.resume(throwing: error)
+            failure = error
+            completionHandler(.cancel)
         }
-        self.continuation = nil
-        session.finishTasksAndInvalidate()
     }
-    
+
     func urlSession(
         _ session: URLSession,
-        downloadTask: URLSessionDownloadTask,
-        didWriteData bytesWritten: Int64,
-        totalBytesWritten: Int64,
-        totalBytesExpectedToWrite: Int64
+        dataTask: URLSessionDataTask,
+        didReceive data: Data
     ) {
-        guard totalBytesExpectedToWrite > 0 else { return }
-        DispatchQueue.main.async { [weak self] in
-            self?.onProgress?(Double(totalBytesWritten), Double(totalBytesExpectedToWrite))
+        do {
+            try handleData(data)
+        } catch {
+            failure = error
+            dataTask.cancel()
         }
     }
-    
+
     func urlSession(
         _ session: URLSession,
         task: URLSessionTask,
         didCompleteWithError error: Error?
     ) {
-        if let error {
-            continuation?.resume(throwing: error)
-            continuation = nil
-            session.finishTasksAndInvalidate()
+        if shouldRestart && failure == nil {
+            if let partURL, let checkpointURL {
+                try? fileManager?.removeItem(at: partURL)
+                try? fileManager?.removeItem(at: checkpointURL)
+            }
+            start(resumingFrom: nil)
+            return
+        }
+        do {
+            finish(.success(try handleCompletion(error)))
+        } catch {
+            finish(.failure(error))
         }
     }
 }
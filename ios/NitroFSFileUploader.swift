@@ -7,9 +7,16 @@
 
 import Foundation
 
+/// Sends the file straight from disk: as the whole body for `raw` uploads, and in between a generated
+/// preamble and trailer for `multipart` ones. Nothing is copied to a temporary file first.
 final class NitroFSFileUploader: NSObject, URLSessionDataDelegate {
     weak var fileManager: FileManager?
     private var onProgress: ((Double, Double) -> Void)?
+    private var body: MultipartBody?
+    private let lock = NSLock()
+    private var task: URLSessionTask?
+    private var continuation: CheckedContinuation<Void, Error>?
+    private var cancelled = false
 
     init(fileManager: FileManager) {
         super.init()
@@ -21,53 +28,69 @@ final class NitroFSFileUploader: NSObject, URLSessionDataDelegate {
         onProgress: ((Double, Double) -> Void)?
     ) async throws {
         self.onProgress = onProgress
-        
+
         guard let uploadURL = URL(string: uploadOptions.url) else {
             throw NitroFSError.networkError(message: "Invalid URL")
         }
 
-        let fieldName = uploadOptions.field ?? "file"
-        let boundary = UUID().uuidString
         let fileURL = URL(fileURLWithPath: uploadOptions.filePath)
-
-        // Create multipart file body on disk
-        let multipartFile = try createMultipartBodyFile(
-            fileURL: fileURL,
-            fieldName: fieldName,
-            boundary: boundary
-        )
-
         var request = URLRequest(url: uploadURL)
-        request.httpMethod = "POST"
+        request.httpMethod = uploadOptions.method?.stringValue ?? "POST"
         uploadOptions.headers?.forEach { field, value in
             request.setValue(value, forHTTPHeaderField: field)
         }
-        request.setValue("multipart/form-data; boundary=\(boundary)", forHTTPHeaderField: "Content-Type")
-
-        return try await withCheckedThrowingContinuation { [weak self] continuation in
-            let session = URLSession(configuration: .default, delegate: self, delegateQueue: nil)
 
-            let task = session.uploadTask(with: request, fromFile: multipartFile) { _, response, error in
-                defer {
-                    try? FileManager.default.removeItem(at: multipartFile)
-                    session.finishTasksAndInvalidate()
-                }
-
-                if let error = error {
-                    continuation.resume(throwing: error)
-                    return
-                }
+        let makeTask: (URLSession) -> URLSessionUploadTask
+        switch uploadOptions.bodyType ?? .multipart {
+        case .raw:
+            if request.value(forHTTPHeaderField: "Content-Type") == nil {
+                request.setValue("application/octet-stream", forHTTPHeaderField: "Content-Type")
+            }
+            makeTask = { $0.uploadTask(with: request, fromFile: fileURL) }
+        case .multipart:
+            let body = try MultipartBody(
+                fileURL: fileURL,
+                fieldName: uploadOptions.field ?? "file",
+                boundary: UUID().uuidString
+            )
+            self.body = body
+            request.setValue("multipart/form-data; boundary=\(body.boundary)", forHTTPHeaderField: "Content-Type")
+            // Sent as is rather than chunked, which not every server accepts.
+            request.setValue(String(body.contentLength), forHTTPHeaderField: "Content-Length")
+            // The body comes from `urlSession(_:task:needNewBodyStream:)`.
+            makeTask = { $0.uploadTask(withStreamedRequest: request) }
+        }
 
-                guard let httpResponse = response as? HTTPURLResponse,
-                      (200...299).contains(httpResponse.statusCode) else {
-                    continuation.resume(throwing: NitroFSError.networkError(message: "Invalid server response"))
-                    return
-                }
+        // Cancelling the calling task cancels the upload.
+        return try await withTaskCancellationHandler {
+            try await upload(makeTask)
+        } onCancel: {
+            cancelUpload()
+        }
+    }
 
-                continuation.resume()
-            }
+    func cancelUpload() {
+        lock.lock()
+        cancelled = true
+        let task = self.task
+        lock.unlock()
+        task?.cancel()
+    }
 
+    private func upload(_ makeTask: @escaping (URLSession) -> URLSessionUploadTask) async throws {
+        return try await withCheckedThrowingContinuation { continuation in
+            let task = makeTask(NitroFSTransferSession.shared.session)
+            // Progress and the outcome come through the task's own delegate, as the shared session has none.
+            task.delegate = self
+            lock.lock()
+            self.continuation = continuation
+            self.task = task
+            let cancelled = self.cancelled
+            lock.unlock()
             task.resume()
+            if cancelled {
+                task.cancel()
+            }
         }
     }
 }
@@ -75,61 +98,74 @@ final class NitroFSFileUploader: NSObject, URLSessionDataDelegate {
 // MARK: - Helpers
 
 extension NitroFSFileUploader {
-    private func createMultipartBodyFile(
-        fileURL: URL,
-        fieldName: String,
-        boundary: String
-    ) throws -> URL {
-        let tempURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
-
-        guard let output = OutputStream(url: tempURL, append: false) else {
-            throw NitroFSError.encodingError(message: "Failed to create output stream")
+    /// A `multipart/form-data` body with the file as its one part, generated while it is sent.
+    struct MultipartBody {
+        private static let chunkSize = 64 * 1024
+
+        let boundary: String
+        let fileURL: URL
+        private let preamble: Data
+        private let trailer: Data
+        private let fileSize: Int64
+
+        init(fileURL: URL, fieldName: String, boundary: String) throws {
+            let attributes = try FileManager.default.attributesOfItem(atPath: fileURL.path)
+            guard let fileSize = (attributes[.size] as? NSNumber)?.int64Value else {
+                throw NitroFSError.fileError(message: "Could not read the size of \(fileURL.path)")
+            }
+            self.boundary = boundary
+            self.fileURL = fileURL
+            self.fileSize = fileSize
+            preamble = Data("""
+            --\(boundary)\r\n\
+            Content-Disposition: form-data; name="\(Self.quoted(fieldName))"; filename="\(Self.quoted(fileURL.lastPathComponent))"\r\n\
+            Content-Type: application/octet-stream\r\n\
+            \r\n
+            """.utf8)
+            trailer = Data("\r\n--\(boundary)--\r\n".utf8)
         }
 
-        output.open()
-        defer { output.close() }
-
-        // Write multipart headers with proper CRLF line endings
-        let header = """
-        --\(boundary)\r\n\
-        Content-Disposition: form-data; name="\(fieldName)"; filename="\(fileURL.lastPathComponent)"\r\n\
-        Content-Type: application/octet-stream\r\n\
-        \r\n
-        """
-        try output.write(header)
-
-        // Stream file content efficiently
-        try streamFileContent(from: fileURL, to: output)
-
-        // Write multipart footer
-        let footer = "\r\n--\(boundary)--\r\n"
-        try output.write(footer)
+        var contentLength: Int64 {
+            Int64(preamble.count) + fileSize + Int64(trailer.count)
+        }
 
-        return tempURL
-    }
-    
-    private func streamFileContent(from fileURL: URL, to output: OutputStream) throws {
-        guard let input = InputStream(url: fileURL) else {
-            throw NitroFSError.fileError(message: "Could not read file from disk")
+        /// A new stream over the whole body, fed by a thread of its own. The session asks for another one
+        /// if it has to send the body again, say after an authentication challenge.
+        func makeStream() -> InputStream? {
+            var input: InputStream?
+            var output: OutputStream?
+            Stream.getBoundStreams(withBufferSize: Self.chunkSize, inputStream: &input, outputStream: &output)
+            guard let input, let output else { return nil }
+            let thread = Thread { self.write(to: output) }
+            thread.name = "com.nitrofs.upload-body"
+            thread.start()
+            return input
         }
 
-        input.open()
-        defer { input.close() }
-        
-        let bufferSize = 64 * 1024
-        var buffer = [UInt8](repeating: 0, count: bufferSize)
-
-        while input.hasBytesAvailable {
-            let bytesRead = input.read(&buffer, maxLength: bufferSize)
-            
-            if bytesRead > 0 {
-                let bytesWritten = output.write(buffer, maxLength: bytesRead)
-                if bytesWritten != bytesRead {
-                    throw NitroFSError.encodingError(message: "Failed to write file data to output stream")
-                }
-            } else if bytesRead < 0 {
-                throw NitroFSError.fileError(message: "Error reading file data")
+        /// Each write blocks until the session has read enough to make room. Stops early once the session
+        /// closes its end; a file that shrank meanwhile leaves the body short, which fails the upload.
+        private func write(to output: OutputStream) {
+            output.open()
+            defer { output.close() }
+            guard output.write(all: preamble),
+                  let handle = try? FileHandle(forReadingFrom: fileURL) else { return }
+            defer { try? handle.close() }
+            var remaining = fileSize
+            while remaining > 0 {
+                guard let chunk = try? handle.read(upToCount: Int(min(Int64(Self.chunkSize), remaining))),
+                      !chunk.isEmpty,
+                      output.write(all: chunk) else { return }
+                remaining -= Int64(chunk.count)
             }
+            _ = output.write(all: trailer)
+        }
+
+        /// Escapes a header parameter the way browsers do for form data.
+        private static func quoted(_ value: String) -> String {
+            value
+                .replacingOccurrences(of: "\"", with: "%22")
+                .replacingOccurrences(of: "\r", with: "%0D")
+                .replacingOccurrences(of: "\n", with: "%0A")
         }
     }
 }
@@ -143,32 +179,50 @@ extension NitroFSFileUploader: URLSessionTaskDelegate {
             self.onProgress?(Double(totalBytesSent), Double(totalBytesExpectedToSend))
         }
     }
+
+    func urlSession(_ _: URLSession, task: URLSessionTask,
+                    needNewBodyStream completionHandler: @escaping (InputStream?) -> Void) {
+        completionHandler(body?.makeStream())
+    }
+
+    func urlSession(_ _: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+        lock.lock()
+        let continuation = self.continuation
+        self.continuation = nil
+        self.task = nil
+        lock.unlock()
+
+        if let error {
+            continuation?.resume(throwing: error)
+            return
+        }
+        guard let httpResponse = task.response as? HTTPURLResponse,
+              (200...299).contains(httpResponse.statusCode) else {
+            continuation?.resume(throwing: NitroFSError.networkError(message: "Invalid server response"))
+            return
+        }
+        continuation?.resume()
+    }
 }
 
 // MARK: - OutputStream Extension
 
 private extension OutputStream {
-    func write(_ string: String) throws {
-        guard let data = string.data(using: .utf8) else {
-            throw NitroFSError.encodingError(message: "Failed to encode string to UTF-8.")
-        }
-        
-        try data.withUnsafeBytes { buffer in
+    /// Returns `false` if the stream was closed or failed before all of `data` was written.
+    func write(all data: Data) -> Bool {
+        return data.withUnsafeBytes { buffer in
             guard let baseAddress = buffer.baseAddress?.assumingMemoryBound(to: UInt8.self) else {
-                throw NitroFSError.fileError(message: "Could not get pointer to buffer.")
+                return true
             }
-            
-            var bytesRemaining = data.count
             var totalBytesWritten = 0
-            
-            while bytesRemaining > 0 {
-                let written = self.write(baseAddress.advanced(by: totalBytesWritten), maxLength: bytesRemaining)
-                if written < 0 {
-                    throw NitroFSError.fileError(message: "Failed to write to OutputStream.")
+            while totalBytesWritten < data.count {
+                let written = self.write(baseAddress.advanced(by: totalBytesWritten), maxLength: data.count - totalBytesWritten)
+                if written <= 0 {
+                    return false
                 }
-                bytesRemaining -= written
                 totalBytesWritten += written
             }
+            return true
         }
     }
 }
@@ -0,0 +1,399 @@
+//
+//  NitroFSSegmentedDownloader.swift
+//  NitroFS
+//
+
+import Foundation
+
+/// Fetches one file as several byte ranges at once, each over its own connection, and `pwrite`s every range
+/// straight to its offset in a preallocated part file. A segment that fails is retried on its own, from where
+/// it stopped.
+///
+/// The per-segment progress is checkpointed like a single-stream download, so an interrupted segmented download
+/// resumes too, and either kind can pick up what the other left behind.
+final class NitroFSSegmentedDownloader: NSObject {
+    private static let checkpointInterval: Int64 = 4 * 1024 * 1024
+    private static let progressInterval: TimeInterval = 0.1
+    private static let maxSegmentRetries = 3
+    private static let retryDelay: TimeInterval = 0.5
+
+    /// What the probe learned about the file, as an empty checkpoint.
+    private struct Probe {
+        let totalBytes: Int64
+        let checkpoint: DownloadCheckpoint
+        let mimeType: String
+    }
+
+    private final class Segment {
+        let start: Int64
+        let end: Int64
+        var received: Int64
+        var failures = 0
+
+        init(start: Int64, end: Int64, received: Int64) {
+            self.start = start
+            self.end = end
+            self.received = received
+        }
+
+        var position: Int64 { start + received }
+        var isDone: Bool { position >= end }
+    }
+
+    /// Thrown when the server answers a segment with another version of the file than the probe saw.
+    private struct FileChangedError: Error {}
+
+    private let request: URLRequest
+    private let sourceURL: String
+    private let partURL: URL
+    private let checkpointURL: URL
+
+    // Only touched on the transfer queue once the segments are running.
+    private var probe: Probe?
+    private var segments: [Segment] = []
+    private var tasks: [URLSessionTask: Segment] = [:]
+    private var startPositions: [URLSessionTask: Int64] = [:]
+    private var pendingErrors: [URLSessionTask: Error] = [:]
+    private var fd: Int32 = -1
+    private var continuation: CheckedContinuation<Void, Error>?
+    private var onProgress: ((Double, Double) -> Void)?
+    private var savedBytes: Int64 = 0
+    private var lastProgress = Date.distantPast
+    private var cancelled = false
+
+    init(request: URLRequest, sourceURL: String, partURL: URL, checkpointURL: URL) {
+        self.request = request
+        self.sourceURL = sourceURL
+        self.partURL = partURL
+        self.checkpointURL = checkpointURL
+        super.init()
+    }
+
+    /// Downloads the file into the part file and returns its MIME type, or nil without touching anything if
+    /// the server doesn't serve ranges or the file is smaller than two `minSegmentSize`s.
+    func download(
+        segments segmentCount: Int,
+        minSegmentSize: Int64,
+        onProgress: ((Double, Double) -> Void)?
+    ) async throws -> String? {
+        self.onProgress = onProgress
+        return try await withTaskCancellationHandler {
+            try await download(segments: segmentCount, minSegmentSize: minSegmentSize)
+        } onCancel: {
+            cancel()
+        }
+    }
+
+    /// Stops every segment, keeping the part file and checkpoint to resume from.
+    func cancel() {
+        NitroFSTransferSession.shared.queue.addOperation {
+            self.cancelled = true
+            self.finish(CancellationError())
+        }
+    }
+
+    private func download(segments segmentCount: Int, minSegmentSize: Int64) async throws -> String? {
+        // One more try if the file changes on the server mid-download; the second one starts from scratch.
+        for _ in 0..<2 {
+            try Task.checkCancellation()
+            guard let probe = try await probe(), probe.totalBytes >= 2 * minSegmentSize else {
+                return nil
+            }
+            do {
+                try await fetch(probe, segments: plan(probe, segmentCount: segmentCount, minSegmentSize: minSegmentSize))
+                return probe.mimeType
+            } catch is FileChangedError {
+                try? FileManager.default.removeItem(at: partURL)
+                try? FileManager.default.removeItem(at: checkpointURL)
+            }
+        }
+        throw NitroFSError.networkError(message: "Failed to download file: \(sourceURL) keeps changing on the server")
+    }
+
+    /// A one-byte range request: it tells the size, the validators and whether ranges are supported at all.
+    private func probe() async throws -> Probe? {
+        var probeRequest = request
+        probeRequest.setValue("bytes=0-0", forHTTPHeaderField: "Range")
+        let (_, response) = try await NitroFSTransferSession.shared.session.data(for: probeRequest)
+        guard let response = response as? HTTPURLResponse,
+              response.statusCode == 206,
+              let totalBytes = NitroFSFileDownloader.parseContentRange(response.value(forHTTPHeaderField: "Content-Range"))?.total else {
+            return nil
+        }
+        let checkpoint = DownloadCheckpoint(
+            url: sourceURL,
+            etag: response.value(forHTTPHeaderField: "ETag"),
+            lastModified: response.value(forHTTPHeaderField: "Last-Modified"),
+            bytes: 0,
+            totalBytes: totalBytes
+        )
+        return Probe(
+            totalBytes: totalBytes,
+            checkpoint: checkpoint,
+            mimeType: response.value(forHTTPHeaderField: "Content-Type") ?? "application/octet-stream"
+        )
+    }
+
+    /// The segments still to fetch: those of the checkpoint if it belongs to the same version of the file,
+    /// otherwise a fresh split of the whole file (or of what a single-stream download didn't get to).
+    private func plan(_ probe: Probe, segmentCount: Int, minSegmentSize: Int64) -> [Segment] {
+        let partSize = (try? FileManager.default.attributesOfItem(atPath: partURL.path)[.size] as? NSNumber)?.int64Value
+        if let checkpoint = DownloadCheckpoint.read(from: checkpointURL),
+           let partSize,
+           checkpoint.url == sourceURL,
+           let validator = probe.checkpoint.validator,
+           checkpoint.validator == validator,
+           checkpoint.totalBytes == probe.totalBytes {
+            if let saved = checkpoint.segments {
+                return saved.filter { $0.count == 3 }.map { Segment(start: $0[0], end: $0[1], received: $0[2]) }
+            }
+            let done = min(checkpoint.bytes, partSize)
+            return [Segment(start: 0, end: done, received: done)]
+                + split(from: done, to: probe.totalBytes, segmentCount: segmentCount, minSegmentSize: minSegmentSize)
+        }
+        try? FileManager.default.removeItem(at: partURL)
+        try? FileManager.default.removeItem(at: checkpointURL)
+        return split(from: 0, to: probe.totalBytes, segmentCount: segmentCount, minSegmentSize: minSegmentSize)
+    }
+
+    private func split(from start: Int64, to end: Int64, segmentCount: Int, minSegmentSize: Int64) -> [Segment] {
+        let length = end - start
+        guard length > 0 else { return [] }
+        let count = min(max(length / minSegmentSize, 1), Int64(segmentCount))
+        let size = (length + count - 1) / count
+        return (0..<count).map { i in
+            Segment(start: start + i * size, end: min(start + (i + 1) * size, end), received: 0)
+        }
+    }
+
+    private func fetch(_ probe: Probe, segments: [Segment]) async throws {
+        fd = open(partURL.path, O_RDWR | O_CREAT | O_CLOEXEC, 0o644)
+        guard fd >= 0 else {
+            throw NitroFSError.fileError(message: "Failed to open \(partURL.path): \(String(cString: strerror(errno)))")
+        }
+        defer {
+            close(fd)
+            fd = -1
+        }
+        try preallocate(probe.totalBytes)
+
+        self.probe = probe
+        self.segments = segments
+        savedBytes = receivedBytes
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+            NitroFSTransferSession.shared.queue.addOperation {
+                self.continuation = continuation
+                guard !self.cancelled else {
+                    self.finish(CancellationError())
+                    return
+                }
+                for segment in segments where !segment.isDone {
+                    self.start(segment)
+                }
+                self.finishIfDone()
+            }
+        }
+        if let onProgress {
+            let totalBytes = Double(probe.totalBytes)
+            DispatchQueue.main.async {
+                onProgress(totalBytes, totalBytes)
+            }
+        }
+    }
+
+    /// Reserves the whole file up front, so the segments don't fragment it and a full disk fails before the
+    /// download rather than in the middle of it.
+    private func preallocate(_ size: Int64) throws {
+        var info = stat()
+        guard fstat(fd, &info) == 0 else {
+            throw NitroFSError.fileError(message: "Failed to stat \(partURL.path): \(String(cString: strerror(errno)))")
+        }
+        guard info.st_size < size else { return }
+        var store = fstore_t(fst_flags: UInt32(F_ALLOCATEALL), fst_posmode: F_PEOFPOSMODE, fst_offset: 0, fst_length: size - info.st_size, fst_bytesalloc: 0)
+        _ = fcntl(fd, F_PREALLOCATE, &store)
+        guard ftruncate(fd, size) == 0 else {
+            throw NitroFSError.fileError(message: "Failed to allocate \(partURL.path): \(String(cString: strerror(errno)))")
+        }
+    }
+
+    private var receivedBytes: Int64 {
+        segments.reduce(0) { $0 + $1.received }
+    }
+
+    private func start(_ segment: Segment) {
+        guard let probe else { return }
+        var rangeRequest = request
+        rangeRequest.setValue("bytes=\(segment.position)-\(segment.end - 1)", forHTTPHeaderField: "Range")
+        if let validator = probe.checkpoint.validator {
+            rangeRequest.setValue(validator, forHTTPHeaderField: "If-Range")
+        }
+        let task = NitroFSTransferSession.shared.session.dataTask(with: rangeRequest)
+        task.delegate = self
+        tasks[task] = segment
+        startPositions[task] = segment.position
+        task.resume()
+    }
+
+    private func handleResponse(_ response: URLResponse, segment: Segment) throws {
+        guard let response = response as? HTTPURLResponse else {
+            throw NitroFSError.networkError(message: "Invalid response type")
+        }
+        if response.statusCode >= 500 {
+            throw URLError(.badServerResponse)
+        }
+        if response.statusCode == 200 {
+            // If-Range didn't match, so the server sent the new version of the whole file.
+            throw FileChangedError()
+        }
+        guard response.statusCode == 206 else {
+            throw NitroFSError.networkError(message: "HTTP Error: \(response.statusCode)")
+        }
+        let contentRange = NitroFSFileDownloader.parseContentRange(response.value(forHTTPHeaderField: "Content-Range"))
+        guard contentRange?.start == segment.position, contentRange?.total == probe?.totalBytes else {
+            throw FileChangedError()
+        }
+    }
+
+    private func handleData(_ data: Data, segment: Segment) throws {
+        let count = Int(min(Int64(data.count), segment.end - segment.position))
+        try data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) in
+            var written = 0
+            while written < count {
+                let result = pwrite(fd, buffer.baseAddress! + written, count - written, off_t(segment.position))
+                if result < 0 {
+                    if errno == EINTR { continue }
+                    throw NitroFSError.fileError(message: "Failed to write \(partURL.path): \(String(cString: strerror(errno)))")
+                }
+                written += result
+                segment.received += Int64(result)
+            }
+        }
+        if receivedBytes - savedBytes >= Self.checkpointInterval {
+            saveCheckpoint()
+        }
+        let now = Date()
+        if let onProgress, let probe, now.timeIntervalSince(lastProgress) >= Self.progressInterval {
+            lastProgress = now
+            let received = Double(receivedBytes)
+            let totalBytes = Double(probe.totalBytes)
+            DispatchQueue.main.async {
+                onProgress(received, totalBytes)
+            }
+        }
+    }
+
+    /// Retries dropped connections and server errors from where they stopped. Only consecutive failures that make
+    /// no progress count towards `maxSegmentRetries`.
+    private func handleCompletion(_ error: Error?, segment: Segment, startedAt position: Int64) {
+        guard continuation != nil else { return }
+        if segment.isDone {
+            finishIfDone()
+            return
+        }
+        let error = error ?? URLError(.networkConnectionLost)
+        guard error is URLError else {
+            finish(error)
+            return
+        }
+        segment.failures = segment.position > position ? 1 : segment.failures + 1
+        guard segment.failures <= Self.maxSegmentRetries else {
+            finish(error)
+            return
+        }
+        let delay = Self.retryDelay * Double(segment.failures)
+        DispatchQueue.global().asyncAfter(deadline: .now() + delay) { [weak self] in
+            NitroFSTransferSession.shared.queue.addOperation {
+                guard let self, self.continuation != nil else { return }
+                self.start(segment)
+            }
+        }
+    }
+
+    private func finishIfDone() {
+        guard tasks.isEmpty, segments.allSatisfy({ $0.isDone }) else { return }
+        finish(nil)
+    }
+
+    private func finish(_ error: Error?) {
+        guard let continuation else { return }
+        self.continuation = nil
+        saveCheckpoint()
+        // Late callbacks of the cancelled tasks find nothing to write to.
+        let running = tasks.keys
+        tasks.removeAll()
+        running.forEach { $0.cancel() }
+        if let error {
+            continuation.resume(throwing: error)
+        } else {
+            continuation.resume()
+        }
+    }
+
+    private func saveCheckpoint() {
+        guard let probe else { return }
+        // `bytes` is the contiguous prefix, which is what a single-stream download can resume from.
+        var prefix: Int64 = 0
+        for segment in segments.sorted(by: { $0.start < $1.start }) {
+            guard segment.start == prefix else { break }
+            prefix = segment.position
+            guard segment.isDone else { break }
+        }
+        var checkpoint = probe.checkpoint
+        checkpoint.bytes = prefix
+        checkpoint.segments = segments.map { [$0.start, $0.end, $0.received] }
+        checkpoint.write(to: checkpointURL)
+        savedBytes = receivedBytes
+    }
+}
+
+// MARK: - URLSessionDataDelegate
+
+extension NitroFSSegmentedDownloader: URLSessionDataDelegate {
+    func urlSession(
+        _ session: URLSession,
+        dataTask: URLSessionDataTask,
+        didReceive response: URLResponse,
+        completionHandler: @escaping (URLSession.ResponseDisposition) -> Void
+    ) {
+        guard let segment = tasks[dataTask] else {
+            completionHandler(.cancel)
+            return
+        }
+        do {
+            try handleResponse(response, segment: segment)
+            completionHandler(.allow)
+        } catch let error as URLError {
+            // Retried like a dropped connection once the task completes.
+            pendingErrors[dataTask] = error
+            completionHandler(.cancel)
+        } catch {
+            completionHandler(.cancel)
+            finish(error)
+        }
+    }
+
+    func urlSession(
+        _ session: URLSession,
+        dataTask: URLSessionDataTask,
+        didReceive data: Data
+    ) {
+        guard let segment = tasks[dataTask] else { return }
+        do {
+            try handleData(data, segment: segment)
+        } catch {
+            dataTask.cancel()
+            finish(error)
+        }
+    }
+
+    func urlSession(
+        _ session: URLSession,
+        task: URLSessionTask,
+        didCompleteWithError error: Error?
+    ) {
+        guard let segment = tasks.removeValue(forKey: task) else { return }
+        let startedAt = startPositions.removeValue(forKey: task) ?? segment.position
+        let error = pendingErrors.removeValue(forKey: task) ?? error
+        handleCompletion(error, segment: segment, startedAt: startedAt)
+    }
+}
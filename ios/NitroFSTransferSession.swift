@@ -0,0 +1,55 @@
+//
+//  NitroFSTransferSession.swift
+//  NitroFS
+//
+
+import Foundation
+
+/// The URLSession every upload and download runs on, so keep-alive connections, TLS sessions and HTTP/2
+/// streams are reused from one transfer to the next instead of being set up again for each. Transfers get
+/// their callbacks through per-task delegates, on one serial queue they can keep their state on without locking.
+final class NitroFSTransferSession {
+    static let shared = NitroFSTransferSession()
+    static let defaultMaxConnectionsPerHost = 6
+
+    /// The delegate queue of the session, and of any session that replaces it.
+    let queue: OperationQueue = {
+        let queue = OperationQueue()
+        queue.name = "com.nitrofs.transfers"
+        queue.maxConcurrentOperationCount = 1
+        return queue
+    }()
+
+    private let lock = NSLock()
+    private var current: URLSession?
+
+    /// The session to create new tasks on. Ask again for every task: it is replaced when the limits change.
+    var session: URLSession {
+        lock.lock()
+        defer { lock.unlock() }
+        if let current {
+            return current
+        }
+        let session = makeSession(maxConnectionsPerHost: Self.defaultMaxConnectionsPerHost)
+        current = session
+        return session
+    }
+
+    /// The most connections open at once to one host, across all transfers. Further requests wait their turn.
+    /// A session's configuration is fixed, so this moves new tasks onto a new session and lets the running ones
+    /// finish on the old one.
+    func setMaxConnectionsPerHost(_ maxConnectionsPerHost: Int) {
+        lock.lock()
+        let previous = current
+        current = makeSession(maxConnectionsPerHost: maxConnectionsPerHost)
+        lock.unlock()
+        previous?.finishTasksAndInvalidate()
+    }
+
+    private func makeSession(maxConnectionsPerHost: Int) -> URLSession {
+        let config = URLSessionConfiguration.default
+        config.requestCachePolicy = .reloadIgnoringLocalCacheData
+        config.httpMaximumConnectionsPerHost = maxConnectionsPerHost
+        return URLSession(configuration: config, delegate: nil, delegateQueue: queue)
+    }
+}
@@ -34,8 +34,14 @@ target_sources(
   ../nitrogen/generated/android/NitroFSOnLoad.cpp
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridNitroFSSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroFSPlatformSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroMappedFileSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroFileHandleSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroFileWriterSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroReadStreamSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroTransferSpec.cpp
   # Android-specific Nitrogen C++ sources
-  ../nitrogen/generated/android/c++/JHybridNitroFSSpec.cpp
+  ../nitrogen/generated/android/c++/JHybridNitroFSPlatformSpec.cpp
 )
 
 # From node_modules/react-native/ReactAndroid/cmake-utils/folly-flags.cmake
@@ -15,8 +15,9 @@
 #include <fbjni/fbjni.h>
 #include <NitroModules/HybridObjectRegistry.hpp>
 
-#include "JHybridNitroFSSpec.hpp"
+#include "JHybridNitroFSPlatformSpec.hpp"
 #include "JFunc_void_double_double.hpp"
+#include "HybridNitroFS.hpp"
 #include <NitroModules/DefaultConstructableObject.hpp>
 
 namespace margelo::nitro::nitrofs {
@@ -27,12 +28,12 @@ int initialize(JavaVM* vm) {
   });
 }
 
-struct JHybridNitroFSSpecImpl: public jni::JavaClass<JHybridNitroFSSpecImpl, JHybridNitroFSSpec::JavaPart> {
-  static constexpr auto kJavaDescriptor = "Lcom/nitrofs/HybridNitroFS;";
-  static std::shared_ptr<JHybridNitroFSSpec> create() {
-    static const auto constructorFn = javaClassStatic()->getConstructor<JHybridNitroFSSpecImpl::javaobject()>();
-    jni::local_ref<JHybridNitroFSSpec::JavaPart> javaPart = javaClassStatic()->newObject(constructorFn);
-    return javaPart->getJHybridNitroFSSpec();
+struct JHybridNitroFSPlatformSpecImpl: public jni::JavaClass<JHybridNitroFSPlatformSpecImpl, JHybridNitroFSPlatformSpec::JavaPart> {
+  static constexpr auto kJavaDescriptor = "Lcom/nitrofs/HybridNitroFSPlatform;";
+  static std::shared_ptr<JHybridNitroFSPlatformSpec> create() {
+    static const auto constructorFn = javaClassStatic()->getConstructor<JHybridNitroFSPlatformSpecImpl::javaobject()>();
+    jni::local_ref<JHybridNitroFSPlatformSpec::JavaPart> javaPart = javaClassStatic()->newObject(constructorFn);
+    return javaPart->getJHybridNitroFSPlatformSpec();
   }
 };
 
@@ -41,14 +42,23 @@ void registerAllNatives() {
   using namespace margelo::nitro::nitrofs;
 
   // Register native JNI methods
-  margelo::nitro::nitrofs::JHybridNitroFSSpec::CxxPart::registerNatives();
+  margelo::nitro::nitrofs::JHybridNitroFSPlatformSpec::CxxPart::registerNatives();
   margelo::nitro::nitrofs::JFunc_void_double_double_cxx::registerNatives();
 
   // Register Nitro Hybrid Objects
   HybridObjectRegistry::registerHybridObjectConstructor(
     "NitroFS",
     []() -> std::shared_ptr<HybridObject> {
-      return JHybridNitroFSSpecImpl::create();
+      static_assert(std::is_default_constructible_v<HybridNitroFS>,
+                    "The HybridObject \"HybridNitroFS\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridNitroFS>();
+    }
+  );
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "NitroFSPlatform",
+    []() -> std::shared_ptr<HybridObject> {
+      return JHybridNitroFSPlatformSpecImpl::create();
     }
   );
 }
@@ -1,11 +1,11 @@
 ///
-/// JHybridNitroFSSpec.cpp
+/// JHybridNitroFSPlatformSpec.cpp
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
 ///
 
-#include "JHybridNitroFSSpec.hpp"
+#include "JHybridNitroFSPlatformSpec.hpp"
 
 // Forward declaration of `NitroFileStat` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroFileStat; }
@@ -17,6 +17,8 @@ namespace margelo::nitro::nitrofs { enum class NitroFileEncoding; }
 namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
 // Forward declaration of `NitroUploadMethod` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroUploadMethod; }
+// Forward declaration of `NitroUploadBodyType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroUploadBodyType; }
 // Forward declaration of `NitroDownloadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 
@@ -34,8 +36,10 @@ namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 #include "NitroUploadOptions.hpp"
 #include "JNitroUploadOptions.hpp"
 #include "NitroUploadMethod.hpp"
+#include "NitroUploadBodyType.hpp"
 #include <optional>
 #include "JNitroUploadMethod.hpp"
+#include "JNitroUploadBodyType.hpp"
 #include <unordered_map>
 #include <functional>
 #include "JFunc_void_double_double.hpp"
@@ -45,77 +49,77 @@ namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 
 namespace margelo::nitro::nitrofs {
 
-  std::shared_ptr<JHybridNitroFSSpec> JHybridNitroFSSpec::JavaPart::getJHybridNitroFSSpec() {
+  std::shared_ptr<JHybridNitroFSPlatformSpec> JHybridNitroFSPlatformSpec::JavaPart::getJHybridNitroFSPlatformSpec() {
     auto hybridObject = JHybridObject::JavaPart::getJHybridObject();
-    auto castHybridObject = std::dynamic_pointer_cast<JHybridNitroFSSpec>(hybridObject);
+    auto castHybridObject = std::dynamic_pointer_cast<JHybridNitroFSPlatformSpec>(hybridObject);
     if (castHybridObject == nullptr) [[unlikely]] {
-      throw std::runtime_error("Failed to downcast JHybridObject to JHybridNitroFSSpec!");
+      throw std::runtime_error("Failed to downcast JHybridObject to JHybridNitroFSPlatformSpec!");
     }
     return castHybridObject;
   }
 
-  jni::local_ref<JHybridNitroFSSpec::CxxPart::jhybriddata> JHybridNitroFSSpec::CxxPart::initHybrid(jni::alias_ref<jhybridobject> jThis) {
+  jni::local_ref<JHybridNitroFSPlatformSpec::CxxPart::jhybriddata> JHybridNitroFSPlatformSpec::CxxPart::initHybrid(jni::alias_ref<jhybridobject> jThis) {
     return makeCxxInstance(jThis);
   }
 
-  std::shared_ptr<JHybridObject> JHybridNitroFSSpec::CxxPart::createHybridObject(const jni::local_ref<JHybridObject::JavaPart>& javaPart) {
-    auto castJavaPart = jni::dynamic_ref_cast<JHybridNitroFSSpec::JavaPart>(javaPart);
+  std::shared_ptr<JHybridObject> JHybridNitroFSPlatformSpec::CxxPart::createHybridObject(const jni::local_ref<JHybridObject::JavaPart>& javaPart) {
+    auto castJavaPart = jni::dynamic_ref_cast<JHybridNitroFSPlatformSpec::JavaPart>(javaPart);
     if (castJavaPart == nullptr) [[unlikely]] {
-      throw std::runtime_error("Failed to cast JHybridObject::JavaPart to JHybridNitroFSSpec::JavaPart!");
+      throw std::runtime_error("Failed to cast JHybridObject::JavaPart to JHybridNitroFSPlatformSpec::JavaPart!");
     }
-    return std::make_shared<JHybridNitroFSSpec>(castJavaPart);
+    return std::make_shared<JHybridNitroFSPlatformSpec>(castJavaPart);
   }
 
-  void JHybridNitroFSSpec::CxxPart::registerNatives() {
+  void JHybridNitroFSPlatformSpec::CxxPart::registerNatives() {
     registerHybrid({
-      makeNativeMethod("initHybrid", JHybridNitroFSSpec::CxxPart::initHybrid),
+      makeNativeMethod("initHybrid", JHybridNitroFSPlatformSpec::CxxPart::initHybrid),
     });
   }
 
   // Properties
-  std::string JHybridNitroFSSpec::getBUNDLE_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getBUNDLE_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getBUNDLE_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getDOCUMENT_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getDOCUMENT_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getDOCUMENT_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getCACHE_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getCACHE_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getCACHE_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getDOWNLOAD_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getDOWNLOAD_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getDOWNLOAD_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getDCIM_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getDCIM_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getDCIM_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getPICTURES_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getPICTURES_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getPICTURES_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getMOVIES_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getMOVIES_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getMOVIES_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::getMUSIC_DIR() {
+  std::string JHybridNitroFSPlatformSpec::getMUSIC_DIR() {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>()>("getMUSIC_DIR");
     auto __result = method(_javaPart);
     return __result->toStdString();
   }
 
   // Methods
-  std::shared_ptr<Promise<bool>> JHybridNitroFSSpec::exists(const std::string& path) {
+  std::shared_ptr<Promise<bool>> JHybridNitroFSPlatformSpec::exists(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */)>("exists");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return [&]() {
@@ -131,7 +135,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<void>> JHybridNitroFSSpec::writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) {
+  std::shared_ptr<Promise<void>> JHybridNitroFSPlatformSpec::writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */, jni::alias_ref<jni::JString> /* data */, jni::alias_ref<JNitroFileEncoding> /* encoding */)>("writeFile");
     auto __result = method(_javaPart, jni::make_jstring(path), jni::make_jstring(data), JNitroFileEncoding::fromCpp(encoding));
     return [&]() {
@@ -146,7 +150,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<std::string>> JHybridNitroFSSpec::readFile(const std::string& path, NitroFileEncoding encoding) {
+  std::shared_ptr<Promise<std::string>> JHybridNitroFSPlatformSpec::readFile(const std::string& path, NitroFileEncoding encoding) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */, jni::alias_ref<JNitroFileEncoding> /* encoding */)>("readFile");
     auto __result = method(_javaPart, jni::make_jstring(path), JNitroFileEncoding::fromCpp(encoding));
     return [&]() {
@@ -162,7 +166,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<void>> JHybridNitroFSSpec::copyFile(const std::string& srcPath, const std::string& destPath) {
+  std::shared_ptr<Promise<void>> JHybridNitroFSPlatformSpec::copyFile(const std::string& srcPath, const std::string& destPath) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* srcPath */, jni::alias_ref<jni::JString> /* destPath */)>("copyFile");
     auto __result = method(_javaPart, jni::make_jstring(srcPath), jni::make_jstring(destPath));
     return [&]() {
@@ -177,7 +181,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<void>> JHybridNitroFSSpec::copy(const std::string& srcPath, const std::string& destPath) {
+  std::shared_ptr<Promise<void>> JHybridNitroFSPlatformSpec::copy(const std::string& srcPath, const std::string& destPath) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* srcPath */, jni::alias_ref<jni::JString> /* destPath */)>("copy");
     auto __result = method(_javaPart, jni::make_jstring(srcPath), jni::make_jstring(destPath));
     return [&]() {
@@ -192,7 +196,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<bool>> JHybridNitroFSSpec::unlink(const std::string& path) {
+  std::shared_ptr<Promise<bool>> JHybridNitroFSPlatformSpec::unlink(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */)>("unlink");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return [&]() {
@@ -208,7 +212,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<bool>> JHybridNitroFSSpec::mkdir(const std::string& path) {
+  std::shared_ptr<Promise<bool>> JHybridNitroFSPlatformSpec::mkdir(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */)>("mkdir");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return [&]() {
@@ -224,7 +228,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<NitroFileStat>> JHybridNitroFSSpec::stat(const std::string& path) {
+  std::shared_ptr<Promise<NitroFileStat>> JHybridNitroFSPlatformSpec::stat(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */)>("stat");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return [&]() {
@@ -240,7 +244,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<std::vector<NitroFile>>> JHybridNitroFSSpec::readdir(const std::string& path) {
+  std::shared_ptr<Promise<std::vector<NitroFile>>> JHybridNitroFSPlatformSpec::readdir(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* path */)>("readdir");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return [&]() {
@@ -265,7 +269,7 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<void>> JHybridNitroFSSpec::rename(const std::string& oldPath, const std::string& newPath) {
+  std::shared_ptr<Promise<void>> JHybridNitroFSPlatformSpec::rename(const std::string& oldPath, const std::string& newPath) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<jni::JString> /* oldPath */, jni::alias_ref<jni::JString> /* newPath */)>("rename");
     auto __result = method(_javaPart, jni::make_jstring(oldPath), jni::make_jstring(newPath));
     return [&]() {
@@ -280,24 +284,24 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::string JHybridNitroFSSpec::dirname(const std::string& path) {
+  std::string JHybridNitroFSPlatformSpec::dirname(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>(jni::alias_ref<jni::JString> /* path */)>("dirname");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::basename(const std::string& path) {
+  std::string JHybridNitroFSPlatformSpec::basename(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>(jni::alias_ref<jni::JString> /* path */)>("basename");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return __result->toStdString();
   }
-  std::string JHybridNitroFSSpec::extname(const std::string& path) {
+  std::string JHybridNitroFSPlatformSpec::extname(const std::string& path) {
     static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<jni::JString>(jni::alias_ref<jni::JString> /* path */)>("extname");
     auto __result = method(_javaPart, jni::make_jstring(path));
     return __result->toStdString();
   }
-  std::shared_ptr<Promise<void>> JHybridNitroFSSpec::uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) {
-    static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<JNitroUploadOptions> /* uploadOptions */, jni::alias_ref<JFunc_void_double_double::javaobject> /* onProgress */)>("uploadFile_cxx");
-    auto __result = method(_javaPart, JNitroUploadOptions::fromCpp(uploadOptions), onProgress.has_value() ? JFunc_void_double_double_cxx::fromCpp(onProgress.value()) : nullptr);
+  std::shared_ptr<Promise<void>> JHybridNitroFSPlatformSpec::uploadFile(double transferId, const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) {
+    static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(double /* transferId */, jni::alias_ref<JNitroUploadOptions> /* uploadOptions */, jni::alias_ref<JFunc_void_double_double::javaobject> /* onProgress */)>("uploadFile_cxx");
+    auto __result = method(_javaPart, transferId, JNitroUploadOptions::fromCpp(uploadOptions), onProgress.has_value() ? JFunc_void_double_double_cxx::fromCpp(onProgress.value()) : nullptr);
     return [&]() {
       auto __promise = Promise<void>::create();
       __result->cthis()->addOnResolvedListener([=](const jni::alias_ref<jni::JObject>& /* unit */) {
@@ -310,9 +314,9 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
-  std::shared_ptr<Promise<NitroFile>> JHybridNitroFSSpec::downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) {
-    static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(jni::alias_ref<JNitroDownloadOptions> /* downloadOptions */, jni::alias_ref<JFunc_void_double_double::javaobject> /* onProgress */)>("downloadFile_cxx");
-    auto __result = method(_javaPart, JNitroDownloadOptions::fromCpp(downloadOptions), onProgress.has_value() ? JFunc_void_double_double_cxx::fromCpp(onProgress.value()) : nullptr);
+  std::shared_ptr<Promise<NitroFile>> JHybridNitroFSPlatformSpec::downloadFile(double transferId, const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) {
+    static const auto method = _javaPart->javaClassStatic()->getMethod<jni::local_ref<JPromise::javaobject>(double /* transferId */, jni::alias_ref<JNitroDownloadOptions> /* downloadOptions */, jni::alias_ref<JFunc_void_double_double::javaobject> /* onProgress */)>("downloadFile_cxx");
+    auto __result = method(_javaPart, transferId, JNitroDownloadOptions::fromCpp(downloadOptions), onProgress.has_value() ? JFunc_void_double_double_cxx::fromCpp(onProgress.value()) : nullptr);
     return [&]() {
       auto __promise = Promise<NitroFile>::create();
       __result->cthis()->addOnResolvedListener([=](const jni::alias_ref<jni::JObject>& __boxedResult) {
@@ -326,5 +330,13 @@ namespace margelo::nitro::nitrofs {
       return __promise;
     }();
   }
+  void JHybridNitroFSPlatformSpec::cancelTransfer(double transferId) {
+    static const auto method = _javaPart->javaClassStatic()->getMethod<void(double /* transferId */)>("cancelTransfer");
+    method(_javaPart, transferId);
+  }
+  void JHybridNitroFSPlatformSpec::setMaxConnectionsPerHost(double maxConnections) {
+    static const auto method = _javaPart->javaClassStatic()->getMethod<void(double /* maxConnections */)>("setMaxConnectionsPerHost");
+    method(_javaPart, maxConnections);
+  }
 
 } // namespace margelo::nitro::nitrofs
@@ -1,5 +1,5 @@
 ///
-/// HybridNitroFSSpec.hpp
+/// HybridNitroFSPlatformSpec.hpp
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
@@ -9,7 +9,7 @@
 
 #include <NitroModules/JHybridObject.hpp>
 #include <fbjni/fbjni.h>
-#include "HybridNitroFSSpec.hpp"
+#include "HybridNitroFSPlatformSpec.hpp"
 
 
 
@@ -18,14 +18,14 @@ namespace margelo::nitro::nitrofs {
 
   using namespace facebook;
 
-  class JHybridNitroFSSpec: public virtual HybridNitroFSSpec, public virtual JHybridObject {
+  class JHybridNitroFSPlatformSpec: public virtual HybridNitroFSPlatformSpec, public virtual JHybridObject {
   public:
     struct JavaPart: public jni::JavaClass<JavaPart, JHybridObject::JavaPart> {
-      static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/nitrofs/HybridNitroFSSpec;";
-      std::shared_ptr<JHybridNitroFSSpec> getJHybridNitroFSSpec();
+      static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/nitrofs/HybridNitroFSPlatformSpec;";
+      std::shared_ptr<JHybridNitroFSPlatformSpec> getJHybridNitroFSPlatformSpec();
     };
     struct CxxPart: public jni::HybridClass<CxxPart, JHybridObject::CxxPart> {
-      static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/nitrofs/HybridNitroFSSpec$CxxPart;";
+      static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/nitrofs/HybridNitroFSPlatformSpec$CxxPart;";
       static jni::local_ref<jhybriddata> initHybrid(jni::alias_ref<jhybridobject> jThis);
       static void registerNatives();
       using HybridBase::HybridBase;
@@ -34,17 +34,17 @@ namespace margelo::nitro::nitrofs {
     };
 
   public:
-    explicit JHybridNitroFSSpec(const jni::local_ref<JHybridNitroFSSpec::JavaPart>& javaPart):
-      HybridObject(HybridNitroFSSpec::TAG),
+    explicit JHybridNitroFSPlatformSpec(const jni::local_ref<JHybridNitroFSPlatformSpec::JavaPart>& javaPart):
+      HybridObject(HybridNitroFSPlatformSpec::TAG),
       JHybridObject(javaPart),
       _javaPart(jni::make_global(javaPart)) {}
-    ~JHybridNitroFSSpec() override {
+    ~JHybridNitroFSPlatformSpec() override {
       // Hermes GC can destroy JS objects on a non-JNI Thread.
       jni::ThreadScope::WithClassLoader([&] { _javaPart.reset(); });
     }
 
   public:
-    inline const jni::global_ref<JHybridNitroFSSpec::JavaPart>& getJavaPart() const noexcept {
+    inline const jni::global_ref<JHybridNitroFSPlatformSpec::JavaPart>& getJavaPart() const noexcept {
       return _javaPart;
     }
 
@@ -74,11 +74,13 @@ namespace margelo::nitro::nitrofs {
     std::string dirname(const std::string& path) override;
     std::string basename(const std::string& path) override;
     std::string extname(const std::string& path) override;
-    std::shared_ptr<Promise<void>> uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override;
-    std::shared_ptr<Promise<NitroFile>> downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    std::shared_ptr<Promise<void>> uploadFile(double transferId, const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    std::shared_ptr<Promise<NitroFile>> downloadFile(double transferId, const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override;
+    void cancelTransfer(double transferId) override;
+    void setMaxConnectionsPerHost(double maxConnections) override;
 
   private:
-    jni::global_ref<JHybridNitroFSSpec::JavaPart> _javaPart;
+    jni::global_ref<JHybridNitroFSPlatformSpec::JavaPart> _javaPart;
   };
 
 } // namespace margelo::nitro::nitrofs
@@ -39,6 +39,10 @@ namespace margelo::nitro::nitrofs {
       jni::local_ref<jni::JString> destinationPath = this->getFieldValue(fieldDestinationPath);
       static const auto fieldHeaders = clazz->getField<jni::JMap<jni::JString, jni::JString>>("headers");
       jni::local_ref<jni::JMap<jni::JString, jni::JString>> headers = this->getFieldValue(fieldHeaders);
+      static const auto fieldSegments = clazz->getField<jni::JDouble>("segments");
+      jni::local_ref<jni::JDouble> segments = this->getFieldValue(fieldSegments);
+      static const auto fieldMinSegmentSize = clazz->getField<jni::JDouble>("minSegmentSize");
+      jni::local_ref<jni::JDouble> minSegmentSize = this->getFieldValue(fieldMinSegmentSize);
       return NitroDownloadOptions(
         url->toStdString(),
         destinationPath->toStdString(),
@@ -49,7 +53,9 @@ namespace margelo::nitro::nitrofs {
             __map.emplace(__entry.first->toStdString(), __entry.second->toStdString());
           }
           return __map;
-        }()) : std::nullopt
+        }()) : std::nullopt,
+        segments != nullptr ? std::make_optional(segments->value()) : std::nullopt,
+        minSegmentSize != nullptr ? std::make_optional(minSegmentSize->value()) : std::nullopt
       );
     }
 
@@ -59,7 +65,7 @@ namespace margelo::nitro::nitrofs {
      */
     [[maybe_unused]]
     static jni::local_ref<JNitroDownloadOptions::javaobject> fromCpp(const NitroDownloadOptions& value) {
-      using JSignature = JNitroDownloadOptions(jni::alias_ref<jni::JString>, jni::alias_ref<jni::JString>, jni::alias_ref<jni::JMap<jni::JString, jni::JString>>);
+      using JSignature = JNitroDownloadOptions(jni::alias_ref<jni::JString>, jni::alias_ref<jni::JString>, jni::alias_ref<jni::JMap<jni::JString, jni::JString>>, jni::alias_ref<jni::JDouble>, jni::alias_ref<jni::JDouble>);
       static const auto clazz = javaClassStatic();
       static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
       return create(
@@ -72,7 +78,9 @@ namespace margelo::nitro::nitrofs {
             __map->put(jni::make_jstring(__entry.first), jni::make_jstring(__entry.second));
           }
           return __map;
-        }() : nullptr
+        }() : nullptr,
+        value.segments.has_value() ? jni::JDouble::valueOf(value.segments.value()) : nullptr,
+        value.minSegmentSize.has_value() ? jni::JDouble::valueOf(value.minSegmentSize.value()) : nullptr
       );
     }
   };
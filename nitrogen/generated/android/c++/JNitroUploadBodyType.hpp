@@ -0,0 +1,58 @@
+///
+/// JNitroUploadBodyType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "NitroUploadBodyType.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace facebook;
+
+  /**
+   * The C++ JNI bridge between the C++ enum "NitroUploadBodyType" and the the Kotlin enum "NitroUploadBodyType".
+   */
+  struct JNitroUploadBodyType final: public jni::JavaClass<JNitroUploadBodyType> {
+  public:
+    static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/nitrofs/NitroUploadBodyType;";
+
+  public:
+    /**
+     * Convert this Java/Kotlin-based enum to the C++ enum NitroUploadBodyType.
+     */
+    [[maybe_unused]]
+    [[nodiscard]]
+    NitroUploadBodyType toCpp() const {
+      static const auto clazz = javaClassStatic();
+      static const auto fieldOrdinal = clazz->getField<int>("value");
+      int ordinal = this->getFieldValue(fieldOrdinal);
+      return static_cast<NitroUploadBodyType>(ordinal);
+    }
+
+  public:
+    /**
+     * Create a Java/Kotlin-based enum with the given C++ enum's value.
+     */
+    [[maybe_unused]]
+    static jni::alias_ref<JNitroUploadBodyType> fromCpp(NitroUploadBodyType value) {
+      static const auto clazz = javaClassStatic();
+      switch (value) {
+        case NitroUploadBodyType::MULTIPART:
+          static const auto fieldMULTIPART = clazz->getStaticField<JNitroUploadBodyType>("MULTIPART");
+          return clazz->getStaticFieldValue(fieldMULTIPART);
+        case NitroUploadBodyType::RAW:
+          static const auto fieldRAW = clazz->getStaticField<JNitroUploadBodyType>("RAW");
+          return clazz->getStaticFieldValue(fieldRAW);
+        default:
+          std::string stringValue = std::to_string(static_cast<int>(value));
+          throw std::invalid_argument("Invalid enum value (" + stringValue + "!");
+      }
+    }
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -10,7 +10,9 @@
 #include <fbjni/fbjni.h>
 #include "NitroUploadOptions.hpp"
 
+#include "JNitroUploadBodyType.hpp"
 #include "JNitroUploadMethod.hpp"
+#include "NitroUploadBodyType.hpp"
 #include "NitroUploadMethod.hpp"
 #include <optional>
 #include <string>
@@ -41,6 +43,8 @@ namespace margelo::nitro::nitrofs {
       jni::local_ref<jni::JString> url = this->getFieldValue(fieldUrl);
       static const auto fieldMethod = clazz->getField<JNitroUploadMethod>("method");
       jni::local_ref<JNitroUploadMethod> method = this->getFieldValue(fieldMethod);
+      static const auto fieldBodyType = clazz->getField<JNitroUploadBodyType>("bodyType");
+      jni::local_ref<JNitroUploadBodyType> bodyType = this->getFieldValue(fieldBodyType);
       static const auto fieldField = clazz->getField<jni::JString>("field");
       jni::local_ref<jni::JString> field = this->getFieldValue(fieldField);
       static const auto fieldHeaders = clazz->getField<jni::JMap<jni::JString, jni::JString>>("headers");
@@ -49,6 +53,7 @@ namespace margelo::nitro::nitrofs {
         filePath->toStdString(),
         url->toStdString(),
         method != nullptr ? std::make_optional(method->toCpp()) : std::nullopt,
+        bodyType != nullptr ? std::make_optional(bodyType->toCpp()) : std::nullopt,
         field != nullptr ? std::make_optional(field->toStdString()) : std::nullopt,
         headers != nullptr ? std::make_optional([&]() {
           std::unordered_map<std::string, std::string> __map;
@@ -67,7 +72,7 @@ namespace margelo::nitro::nitrofs {
      */
     [[maybe_unused]]
     static jni::local_ref<JNitroUploadOptions::javaobject> fromCpp(const NitroUploadOptions& value) {
-      using JSignature = JNitroUploadOptions(jni::alias_ref<jni::JString>, jni::alias_ref<jni::JString>, jni::alias_ref<JNitroUploadMethod>, jni::alias_ref<jni::JString>, jni::alias_ref<jni::JMap<jni::JString, jni::JString>>);
+      using JSignature = JNitroUploadOptions(jni::alias_ref<jni::JString>, jni::alias_ref<jni::JString>, jni::alias_ref<JNitroUploadMethod>, jni::alias_ref<JNitroUploadBodyType>, jni::alias_ref<jni::JString>, jni::alias_ref<jni::JMap<jni::JString, jni::JString>>);
       static const auto clazz = javaClassStatic();
       static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
       return create(
@@ -75,6 +80,7 @@ namespace margelo::nitro::nitrofs {
         jni::make_jstring(value.filePath),
         jni::make_jstring(value.url),
         value.method.has_value() ? JNitroUploadMethod::fromCpp(value.method.value()) : nullptr,
+        value.bodyType.has_value() ? JNitroUploadBodyType::fromCpp(value.bodyType.value()) : nullptr,
         value.field.has_value() ? jni::make_jstring(value.field.value()) : nullptr,
         value.headers.has_value() ? [&]() -> jni::local_ref<jni::JMap<jni::JString, jni::JString>> {
           auto __map = jni::JHashMap<jni::JString, jni::JString>::create(value.headers.value().size());
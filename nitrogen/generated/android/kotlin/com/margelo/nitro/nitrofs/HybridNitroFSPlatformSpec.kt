@@ -1,5 +1,5 @@
 ///
-/// HybridNitroFSSpec.kt
+/// HybridNitroFSPlatformSpec.kt
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
@@ -14,8 +14,8 @@ import com.margelo.nitro.core.Promise
 import com.margelo.nitro.core.HybridObject
 
 /**
- * A Kotlin class representing the NitroFS HybridObject.
- * Implement this abstract class to create Kotlin-based instances of NitroFS.
+ * A Kotlin class representing the NitroFSPlatform HybridObject.
+ * Implement this abstract class to create Kotlin-based instances of NitroFSPlatform.
  */
 @DoNotStrip
 @Keep
@@ -24,7 +24,7 @@ import com.margelo.nitro.core.HybridObject
   "RedundantSuppression", "RedundantUnitReturnType", "SimpleRedundantLet",
   "LocalVariableName", "PropertyName", "PrivatePropertyName", "FunctionName"
 )
-abstract class HybridNitroFSSpec: HybridObject() {
+abstract class HybridNitroFSPlatformSpec: HybridObject() {
   // Properties
   @get:DoNotStrip
   @get:Keep
@@ -111,34 +111,42 @@ abstract class HybridNitroFSSpec: HybridObject() {
   @Keep
   abstract fun extname(path: String): String
   
-  abstract fun uploadFile(uploadOptions: NitroUploadOptions, onProgress: ((uploadedBytes: Double, totalBytes: Double) -> Unit)?): Promise<Unit>
+  abstract fun uploadFile(transferId: Double, uploadOptions: NitroUploadOptions, onProgress: ((uploadedBytes: Double, totalBytes: Double) -> Unit)?): Promise<Unit>
   
   @DoNotStrip
   @Keep
-  private fun uploadFile_cxx(uploadOptions: NitroUploadOptions, onProgress: Func_void_double_double?): Promise<Unit> {
-    val __result = uploadFile(uploadOptions, onProgress?.let { it })
+  private fun uploadFile_cxx(transferId: Double, uploadOptions: NitroUploadOptions, onProgress: Func_void_double_double?): Promise<Unit> {
+    val __result = uploadFile(transferId, uploadOptions, onProgress?.let { it })
     return __result
   }
   
-  abstract fun downloadFile(downloadOptions: NitroDownloadOptions, onProgress: ((downloadedBytes: Double, totalBytes: Double) -> Unit)?): Promise<NitroFile>
+  abstract fun downloadFile(transferId: Double, downloadOptions: NitroDownloadOptions, onProgress: ((downloadedBytes: Double, totalBytes: Double) -> Unit)?): Promise<NitroFile>
   
   @DoNotStrip
   @Keep
-  private fun downloadFile_cxx(downloadOptions: NitroDownloadOptions, onProgress: Func_void_double_double?): Promise<NitroFile> {
-    val __result = downloadFile(downloadOptions, onProgress?.let { it })
+  private fun downloadFile_cxx(transferId: Double, downloadOptions: NitroDownloadOptions, onProgress: Func_void_double_double?): Promise<NitroFile> {
+    val __result = downloadFile(transferId, downloadOptions, onProgress?.let { it })
     return __result
   }
+  
+  @DoNotStrip
+  @Keep
+  abstract fun cancelTransfer(transferId: Double): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun setMaxConnectionsPerHost(maxConnections: Double): Unit
 
   // Default implementation of `HybridObject.toString()`
   override fun toString(): String {
-    return "[HybridObject NitroFS]"
+    return "[HybridObject NitroFSPlatform]"
   }
 
   // C++ backing class
   @DoNotStrip
   @Keep
-  protected open class CxxPart(javaPart: HybridNitroFSSpec): HybridObject.CxxPart(javaPart) {
-    // C++ JHybridNitroFSSpec::CxxPart::initHybrid(...)
+  protected open class CxxPart(javaPart: HybridNitroFSPlatformSpec): HybridObject.CxxPart(javaPart) {
+    // C++ JHybridNitroFSPlatformSpec::CxxPart::initHybrid(...)
     external override fun initHybrid(): HybridData
   }
   override fun createCxxPart(): CxxPart {
@@ -146,6 +154,6 @@ abstract class HybridNitroFSSpec: HybridObject() {
   }
 
   companion object {
-    protected const val TAG = "HybridNitroFSSpec"
+    protected const val TAG = "HybridNitroFSPlatformSpec"
   }
 }
@@ -26,7 +26,13 @@ data class NitroDownloadOptions(
   val destinationPath: String,
   @DoNotStrip
   @Keep
-  val headers: Map<String, String>?
+  val headers: Map<String, String>?,
+  @DoNotStrip
+  @Keep
+  val segments: Double?,
+  @DoNotStrip
+  @Keep
+  val minSegmentSize: Double?
 ) {
   /* primary constructor */
 
@@ -36,13 +42,17 @@ data class NitroDownloadOptions(
     return Objects.deepEquals(this.url, other.url)
       && Objects.deepEquals(this.destinationPath, other.destinationPath)
       && Objects.deepEquals(this.headers, other.headers)
+      && Objects.deepEquals(this.segments, other.segments)
+      && Objects.deepEquals(this.minSegmentSize, other.minSegmentSize)
   }
 
   override fun hashCode(): Int {
     return arrayOf(
       url,
       destinationPath,
-      headers
+      headers,
+      segments,
+      minSegmentSize
     ).contentDeepHashCode()
   }
 
@@ -54,8 +64,8 @@ data class NitroDownloadOptions(
     @Keep
     @Suppress("unused")
     @JvmStatic
-    private fun fromCpp(url: String, destinationPath: String, headers: Map<String, String>?): NitroDownloadOptions {
-      return NitroDownloadOptions(url, destinationPath, headers)
+    private fun fromCpp(url: String, destinationPath: String, headers: Map<String, String>?, segments: Double?, minSegmentSize: Double?): NitroDownloadOptions {
+      return NitroDownloadOptions(url, destinationPath, headers, segments, minSegmentSize)
     }
   }
 }
@@ -0,0 +1,23 @@
+///
+/// NitroUploadBodyType.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrofs
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+
+/**
+ * Represents the JavaScript enum/union "NitroUploadBodyType".
+ */
+@DoNotStrip
+@Keep
+enum class NitroUploadBodyType(@DoNotStrip @Keep val value: Int) {
+  MULTIPART(0),
+  RAW(1);
+
+  companion object
+}
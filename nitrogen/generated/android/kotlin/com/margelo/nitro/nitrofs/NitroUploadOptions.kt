@@ -29,6 +29,9 @@ data class NitroUploadOptions(
   val method: NitroUploadMethod?,
   @DoNotStrip
   @Keep
+  val bodyType: NitroUploadBodyType?,
+  @DoNotStrip
+  @Keep
   val field: String?,
   @DoNotStrip
   @Keep
@@ -42,6 +45,7 @@ data class NitroUploadOptions(
     return Objects.deepEquals(this.filePath, other.filePath)
       && Objects.deepEquals(this.url, other.url)
       && Objects.deepEquals(this.method, other.method)
+      && Objects.deepEquals(this.bodyType, other.bodyType)
       && Objects.deepEquals(this.field, other.field)
       && Objects.deepEquals(this.headers, other.headers)
   }
@@ -51,6 +55,7 @@ data class NitroUploadOptions(
       filePath,
       url,
       method,
+      bodyType,
       field,
       headers
     ).contentDeepHashCode()
@@ -64,8 +69,8 @@ data class NitroUploadOptions(
     @Keep
     @Suppress("unused")
     @JvmStatic
-    private fun fromCpp(filePath: String, url: String, method: NitroUploadMethod?, field: String?, headers: Map<String, String>?): NitroUploadOptions {
-      return NitroUploadOptions(filePath, url, method, field, headers)
+    private fun fromCpp(filePath: String, url: String, method: NitroUploadMethod?, bodyType: NitroUploadBodyType?, field: String?, headers: Map<String, String>?): NitroUploadOptions {
+      return NitroUploadOptions(filePath, url, method, bodyType, field, headers)
     }
   }
 }
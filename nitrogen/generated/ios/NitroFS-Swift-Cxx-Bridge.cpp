@@ -8,7 +8,7 @@
 #include "NitroFS-Swift-Cxx-Bridge.hpp"
 
 // Include C++ implementation defined types
-#include "HybridNitroFSSpecSwift.hpp"
+#include "HybridNitroFSPlatformSpecSwift.hpp"
 #include "NitroFS-Swift-Cxx-Umbrella.hpp"
 #include <NitroModules/NitroDefines.hpp>
 
@@ -78,19 +78,19 @@ namespace margelo::nitro::nitrofs::bridge::swift {
     };
   }
   
-  // pragma MARK: std::shared_ptr<HybridNitroFSSpec>
-  std::shared_ptr<HybridNitroFSSpec> create_std__shared_ptr_HybridNitroFSSpec_(void* NON_NULL swiftUnsafePointer) noexcept {
-    NitroFS::HybridNitroFSSpec_cxx swiftPart = NitroFS::HybridNitroFSSpec_cxx::fromUnsafe(swiftUnsafePointer);
-    return std::make_shared<margelo::nitro::nitrofs::HybridNitroFSSpecSwift>(swiftPart);
+  // pragma MARK: std::shared_ptr<HybridNitroFSPlatformSpec>
+  std::shared_ptr<HybridNitroFSPlatformSpec> create_std__shared_ptr_HybridNitroFSPlatformSpec_(void* NON_NULL swiftUnsafePointer) noexcept {
+    NitroFS::HybridNitroFSPlatformSpec_cxx swiftPart = NitroFS::HybridNitroFSPlatformSpec_cxx::fromUnsafe(swiftUnsafePointer);
+    return std::make_shared<margelo::nitro::nitrofs::HybridNitroFSPlatformSpecSwift>(swiftPart);
   }
-  void* NON_NULL get_std__shared_ptr_HybridNitroFSSpec_(std__shared_ptr_HybridNitroFSSpec_ cppType) {
-    std::shared_ptr<margelo::nitro::nitrofs::HybridNitroFSSpecSwift> swiftWrapper = std::dynamic_pointer_cast<margelo::nitro::nitrofs::HybridNitroFSSpecSwift>(cppType);
+  void* NON_NULL get_std__shared_ptr_HybridNitroFSPlatformSpec_(std__shared_ptr_HybridNitroFSPlatformSpec_ cppType) {
+    std::shared_ptr<margelo::nitro::nitrofs::HybridNitroFSPlatformSpecSwift> swiftWrapper = std::dynamic_pointer_cast<margelo::nitro::nitrofs::HybridNitroFSPlatformSpecSwift>(cppType);
     #ifdef NITRO_DEBUG
     if (swiftWrapper == nullptr) [[unlikely]] {
-      throw std::runtime_error("Class \"HybridNitroFSSpec\" is not implemented in Swift!");
+      throw std::runtime_error("Class \"HybridNitroFSPlatformSpec\" is not implemented in Swift!");
     }
     #endif
-    NitroFS::HybridNitroFSSpec_cxx& swiftPart = swiftWrapper->getSwiftPart();
+    NitroFS::HybridNitroFSPlatformSpec_cxx& swiftPart = swiftWrapper->getSwiftPart();
     return swiftPart.toUnsafe();
   }
 
@@ -8,24 +8,27 @@
 #pragma once
 
 // Forward declarations of C++ defined types
-// Forward declaration of `HybridNitroFSSpec` to properly resolve imports.
-namespace margelo::nitro::nitrofs { class HybridNitroFSSpec; }
+// Forward declaration of `HybridNitroFSPlatformSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroFSPlatformSpec; }
 // Forward declaration of `NitroFileStat` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroFileStat; }
 // Forward declaration of `NitroFile` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroFile; }
 // Forward declaration of `NitroUploadMethod` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroUploadMethod; }
+// Forward declaration of `NitroUploadBodyType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroUploadBodyType; }
 
 // Forward declarations of Swift defined types
-// Forward declaration of `HybridNitroFSSpec_cxx` to properly resolve imports.
-namespace NitroFS { class HybridNitroFSSpec_cxx; }
+// Forward declaration of `HybridNitroFSPlatformSpec_cxx` to properly resolve imports.
+namespace NitroFS { class HybridNitroFSPlatformSpec_cxx; }
 
 // Include C++ defined types
-#include "HybridNitroFSSpec.hpp"
+#include "HybridNitroFSPlatformSpec.hpp"
 #include "NitroFile.hpp"
 #include "NitroFileStat.hpp"
 #include "NitroUploadMethod.hpp"
+#include "NitroUploadBodyType.hpp"
 #include <NitroModules/Promise.hpp>
 #include <NitroModules/PromiseHolder.hpp>
 #include <NitroModules/Result.hpp>
@@ -261,6 +264,21 @@ namespace margelo::nitro::nitrofs::bridge::swift {
     return optional.value();
   }
   
+  // pragma MARK: std::optional<NitroUploadBodyType>
+  /**
+   * Specialized version of `std::optional<NitroUploadBodyType>`.
+   */
+  using std__optional_NitroUploadBodyType_ = std::optional<NitroUploadBodyType>;
+  inline std::optional<NitroUploadBodyType> create_std__optional_NitroUploadBodyType_(const NitroUploadBodyType& value) noexcept {
+    return std::optional<NitroUploadBodyType>(value);
+  }
+  inline bool has_value_std__optional_NitroUploadBodyType_(const std::optional<NitroUploadBodyType>& optional) noexcept {
+    return optional.has_value();
+  }
+  inline NitroUploadBodyType get_std__optional_NitroUploadBodyType_(const std::optional<NitroUploadBodyType>& optional) noexcept {
+    return optional.value();
+  }
+  
   // pragma MARK: std::optional<std::string>
   /**
    * Specialized version of `std::optional<std::string>`.
@@ -316,6 +334,21 @@ namespace margelo::nitro::nitrofs::bridge::swift {
     return optional.value();
   }
   
+  // pragma MARK: std::optional<double>
+  /**
+   * Specialized version of `std::optional<double>`.
+   */
+  using std__optional_double_ = std::optional<double>;
+  inline std::optional<double> create_std__optional_double_(const double& value) noexcept {
+    return std::optional<double>(value);
+  }
+  inline bool has_value_std__optional_double_(const std::optional<double>& optional) noexcept {
+    return optional.has_value();
+  }
+  inline double get_std__optional_double_(const std::optional<double>& optional) noexcept {
+    return optional.value();
+  }
+  
   // pragma MARK: std::function<void(double /* uploadedBytes */, double /* totalBytes */)>
   /**
    * Specialized version of `std::function<void(double, double)>`.
@@ -402,17 +435,17 @@ namespace margelo::nitro::nitrofs::bridge::swift {
     return optional.value();
   }
   
-  // pragma MARK: std::shared_ptr<HybridNitroFSSpec>
+  // pragma MARK: std::shared_ptr<HybridNitroFSPlatformSpec>
   /**
-   * Specialized version of `std::shared_ptr<HybridNitroFSSpec>`.
+   * Specialized version of `std::shared_ptr<HybridNitroFSPlatformSpec>`.
    */
-  using std__shared_ptr_HybridNitroFSSpec_ = std::shared_ptr<HybridNitroFSSpec>;
-  std::shared_ptr<HybridNitroFSSpec> create_std__shared_ptr_HybridNitroFSSpec_(void* NON_NULL swiftUnsafePointer) noexcept;
-  void* NON_NULL get_std__shared_ptr_HybridNitroFSSpec_(std__shared_ptr_HybridNitroFSSpec_ cppType);
+  using std__shared_ptr_HybridNitroFSPlatformSpec_ = std::shared_ptr<HybridNitroFSPlatformSpec>;
+  std::shared_ptr<HybridNitroFSPlatformSpec> create_std__shared_ptr_HybridNitroFSPlatformSpec_(void* NON_NULL swiftUnsafePointer) noexcept;
+  void* NON_NULL get_std__shared_ptr_HybridNitroFSPlatformSpec_(std__shared_ptr_HybridNitroFSPlatformSpec_ cppType);
   
-  // pragma MARK: std::weak_ptr<HybridNitroFSSpec>
-  using std__weak_ptr_HybridNitroFSSpec_ = std::weak_ptr<HybridNitroFSSpec>;
-  inline std__weak_ptr_HybridNitroFSSpec_ weakify_std__shared_ptr_HybridNitroFSSpec_(const std::shared_ptr<HybridNitroFSSpec>& strong) noexcept { return strong; }
+  // pragma MARK: std::weak_ptr<HybridNitroFSPlatformSpec>
+  using std__weak_ptr_HybridNitroFSPlatformSpec_ = std::weak_ptr<HybridNitroFSPlatformSpec>;
+  inline std__weak_ptr_HybridNitroFSPlatformSpec_ weakify_std__shared_ptr_HybridNitroFSPlatformSpec_(const std::shared_ptr<HybridNitroFSPlatformSpec>& strong) noexcept { return strong; }
   
   // pragma MARK: Result<std::shared_ptr<Promise<bool>>>
   using Result_std__shared_ptr_Promise_bool___ = Result<std::shared_ptr<Promise<bool>>>;
@@ -476,5 +509,14 @@ namespace margelo::nitro::nitrofs::bridge::swift {
   inline Result_std__shared_ptr_Promise_NitroFile___ create_Result_std__shared_ptr_Promise_NitroFile___(const std::exception_ptr& error) noexcept {
     return Result<std::shared_ptr<Promise<NitroFile>>>::withError(error);
   }
+  
+  // pragma MARK: Result<void>
+  using Result_void_ = Result<void>;
+  inline Result_void_ create_Result_void_() noexcept {
+    return Result<void>::withValue();
+  }
+  inline Result_void_ create_Result_void_(const std::exception_ptr& error) noexcept {
+    return Result<void>::withError(error);
+  }
 
 } // namespace margelo::nitro::nitrofs::bridge::swift
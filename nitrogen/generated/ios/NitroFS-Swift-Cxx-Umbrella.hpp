@@ -8,8 +8,8 @@
 #pragma once
 
 // Forward declarations of C++ defined types
-// Forward declaration of `HybridNitroFSSpec` to properly resolve imports.
-namespace margelo::nitro::nitrofs { class HybridNitroFSSpec; }
+// Forward declaration of `HybridNitroFSPlatformSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroFSPlatformSpec; }
 // Forward declaration of `NitroDownloadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 // Forward declaration of `NitroFileEncoding` to properly resolve imports.
@@ -20,16 +20,19 @@ namespace margelo::nitro::nitrofs { struct NitroFileStat; }
 namespace margelo::nitro::nitrofs { struct NitroFile; }
 // Forward declaration of `NitroUploadMethod` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroUploadMethod; }
+// Forward declaration of `NitroUploadBodyType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroUploadBodyType; }
 // Forward declaration of `NitroUploadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
 
 // Include C++ defined types
-#include "HybridNitroFSSpec.hpp"
+#include "HybridNitroFSPlatformSpec.hpp"
 #include "NitroDownloadOptions.hpp"
 #include "NitroFile.hpp"
 #include "NitroFileEncoding.hpp"
 #include "NitroFileStat.hpp"
 #include "NitroUploadMethod.hpp"
+#include "NitroUploadBodyType.hpp"
 #include "NitroUploadOptions.hpp"
 #include <NitroModules/Promise.hpp>
 #include <NitroModules/Result.hpp>
@@ -51,8 +54,8 @@ namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
 #include <NitroModules/DateToChronoDate.hpp>
 
 // Forward declarations of Swift defined types
-// Forward declaration of `HybridNitroFSSpec_cxx` to properly resolve imports.
-namespace NitroFS { class HybridNitroFSSpec_cxx; }
+// Forward declaration of `HybridNitroFSPlatformSpec_cxx` to properly resolve imports.
+namespace NitroFS { class HybridNitroFSPlatformSpec_cxx; }
 
 // Include Swift defined types
 #if __has_include("NitroFS-Swift.h")
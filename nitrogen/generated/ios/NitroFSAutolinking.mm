@@ -10,7 +10,8 @@
 #import "NitroFS-Swift-Cxx-Umbrella.hpp"
 #import <type_traits>
 
-#include "HybridNitroFSSpecSwift.hpp"
+#include "HybridNitroFS.hpp"
+#include "HybridNitroFSPlatformSpecSwift.hpp"
 
 @interface NitroFSAutolinking : NSObject
 @end
@@ -24,7 +25,16 @@
   HybridObjectRegistry::registerHybridObjectConstructor(
     "NitroFS",
     []() -> std::shared_ptr<HybridObject> {
-      std::shared_ptr<HybridNitroFSSpec> hybridObject = NitroFS::NitroFSAutolinking::createNitroFS();
+      static_assert(std::is_default_constructible_v<HybridNitroFS>,
+                    "The HybridObject \"HybridNitroFS\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridNitroFS>();
+    }
+  );
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "NitroFSPlatform",
+    []() -> std::shared_ptr<HybridObject> {
+      std::shared_ptr<HybridNitroFSPlatformSpec> hybridObject = NitroFS::NitroFSAutolinking::createNitroFSPlatform();
       return hybridObject;
     }
   );
@@ -12,15 +12,15 @@ import NitroModules
 public final class NitroFSAutolinking {
   public typealias bridge = margelo.nitro.nitrofs.bridge.swift
 
-  public static func createNitroFS() -> bridge.std__shared_ptr_HybridNitroFSSpec_ {
-    let hybridObject = HybridNitroFS()
-    return { () -> bridge.std__shared_ptr_HybridNitroFSSpec_ in
+  public static func createNitroFSPlatform() -> bridge.std__shared_ptr_HybridNitroFSPlatformSpec_ {
+    let hybridObject = HybridNitroFSPlatform()
+    return { () -> bridge.std__shared_ptr_HybridNitroFSPlatformSpec_ in
       let __cxxWrapped = hybridObject.getCxxWrapper()
       return __cxxWrapped.getCxxPart()
     }()
   }
   
-  public static func isNitroFSRecyclable() -> Bool {
-    return HybridNitroFS.self is any RecyclableView.Type
+  public static func isNitroFSPlatformRecyclable() -> Bool {
+    return HybridNitroFSPlatform.self is any RecyclableView.Type
   }
 }
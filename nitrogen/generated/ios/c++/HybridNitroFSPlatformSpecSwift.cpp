@@ -1,11 +1,11 @@
 ///
-/// HybridNitroFSSpecSwift.cpp
+/// HybridNitroFSPlatformSpecSwift.cpp
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
 ///
 
-#include "HybridNitroFSSpecSwift.hpp"
+#include "HybridNitroFSPlatformSpecSwift.hpp"
 
 namespace margelo::nitro::nitrofs {
 } // namespace margelo::nitro::nitrofs
@@ -1,5 +1,5 @@
 ///
-/// HybridNitroFSSpecSwift.hpp
+/// HybridNitroFSPlatformSpecSwift.hpp
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
@@ -7,10 +7,10 @@
 
 #pragma once
 
-#include "HybridNitroFSSpec.hpp"
+#include "HybridNitroFSPlatformSpec.hpp"
 
-// Forward declaration of `HybridNitroFSSpec_cxx` to properly resolve imports.
-namespace NitroFS { class HybridNitroFSSpec_cxx; }
+// Forward declaration of `HybridNitroFSPlatformSpec_cxx` to properly resolve imports.
+namespace NitroFS { class HybridNitroFSPlatformSpec_cxx; }
 
 // Forward declaration of `NitroFileEncoding` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroFileEncoding; }
@@ -22,6 +22,8 @@ namespace margelo::nitro::nitrofs { struct NitroFile; }
 namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
 // Forward declaration of `NitroUploadMethod` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroUploadMethod; }
+// Forward declaration of `NitroUploadBodyType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroUploadBodyType; }
 // Forward declaration of `NitroDownloadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 
@@ -33,6 +35,7 @@ namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 #include <vector>
 #include "NitroUploadOptions.hpp"
 #include "NitroUploadMethod.hpp"
+#include "NitroUploadBodyType.hpp"
 #include <optional>
 #include <unordered_map>
 #include <functional>
@@ -43,25 +46,25 @@ namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
 namespace margelo::nitro::nitrofs {
 
   /**
-   * The C++ part of HybridNitroFSSpec_cxx.swift.
+   * The C++ part of HybridNitroFSPlatformSpec_cxx.swift.
    *
-   * HybridNitroFSSpecSwift (C++) accesses HybridNitroFSSpec_cxx (Swift), and might
+   * HybridNitroFSPlatformSpecSwift (C++) accesses HybridNitroFSPlatformSpec_cxx (Swift), and might
    * contain some additional bridging code for C++ <> Swift interop.
    *
    * Since this obviously introduces an overhead, I hope at some point in
-   * the future, HybridNitroFSSpec_cxx can directly inherit from the C++ class HybridNitroFSSpec
+   * the future, HybridNitroFSPlatformSpec_cxx can directly inherit from the C++ class HybridNitroFSPlatformSpec
    * to simplify the whole structure and memory management.
    */
-  class HybridNitroFSSpecSwift: public virtual HybridNitroFSSpec {
+  class HybridNitroFSPlatformSpecSwift: public virtual HybridNitroFSPlatformSpec {
   public:
     // Constructor from a Swift instance
-    explicit HybridNitroFSSpecSwift(const NitroFS::HybridNitroFSSpec_cxx& swiftPart):
-      HybridObject(HybridNitroFSSpec::TAG),
+    explicit HybridNitroFSPlatformSpecSwift(const NitroFS::HybridNitroFSPlatformSpec_cxx& swiftPart):
+      HybridObject(HybridNitroFSPlatformSpec::TAG),
       _swiftPart(swiftPart) { }
 
   public:
     // Get the Swift part
-    inline NitroFS::HybridNitroFSSpec_cxx& getSwiftPart() noexcept {
+    inline NitroFS::HybridNitroFSPlatformSpec_cxx& getSwiftPart() noexcept {
       return _swiftPart;
     }
 
@@ -70,7 +73,7 @@ namespace margelo::nitro::nitrofs {
       return _swiftPart.getMemorySize();
     }
     bool equals(const std::shared_ptr<HybridObject>& other) override {
-      if (auto otherCast = std::dynamic_pointer_cast<HybridNitroFSSpecSwift>(other)) {
+      if (auto otherCast = std::dynamic_pointer_cast<HybridNitroFSPlatformSpecSwift>(other)) {
         return _swiftPart.equals(otherCast->_swiftPart);
       }
       return false;
@@ -223,25 +226,37 @@ namespace margelo::nitro::nitrofs {
       auto __value = std::move(__result.value());
       return __value;
     }
-    inline std::shared_ptr<Promise<void>> uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override {
-      auto __result = _swiftPart.uploadFile(std::forward<decltype(uploadOptions)>(uploadOptions), onProgress);
+    inline std::shared_ptr<Promise<void>> uploadFile(double transferId, const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) override {
+      auto __result = _swiftPart.uploadFile(std::forward<decltype(transferId)>(transferId), std::forward<decltype(uploadOptions)>(uploadOptions), onProgress);
       if (__result.hasError()) [[unlikely]] {
         std::rethrow_exception(__result.error());
       }
       auto __value = std::move(__result.value());
       return __value;
     }
-    inline std::shared_ptr<Promise<NitroFile>> downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override {
-      auto __result = _swiftPart.downloadFile(std::forward<decltype(downloadOptions)>(downloadOptions), onProgress);
+    inline std::shared_ptr<Promise<NitroFile>> downloadFile(double transferId, const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) override {
+      auto __result = _swiftPart.downloadFile(std::forward<decltype(transferId)>(transferId), std::forward<decltype(downloadOptions)>(downloadOptions), onProgress);
       if (__result.hasError()) [[unlikely]] {
         std::rethrow_exception(__result.error());
       }
       auto __value = std::move(__result.value());
       return __value;
     }
+    inline void cancelTransfer(double transferId) override {
+      auto __result = _swiftPart.cancelTransfer(std::forward<decltype(transferId)>(transferId));
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void setMaxConnectionsPerHost(double maxConnections) override {
+      auto __result = _swiftPart.setMaxConnectionsPerHost(std::forward<decltype(maxConnections)>(maxConnections));
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
 
   private:
-    NitroFS::HybridNitroFSSpec_cxx _swiftPart;
+    NitroFS::HybridNitroFSPlatformSpec_cxx _swiftPart;
   };
 
 } // namespace margelo::nitro::nitrofs
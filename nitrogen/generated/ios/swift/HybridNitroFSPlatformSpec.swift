@@ -1,5 +1,5 @@
 ///
-/// HybridNitroFSSpec.swift
+/// HybridNitroFSPlatformSpec.swift
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
@@ -7,8 +7,8 @@
 
 import NitroModules
 
-/// See ``HybridNitroFSSpec``
-public protocol HybridNitroFSSpec_protocol: HybridObject {
+/// See ``HybridNitroFSPlatformSpec``
+public protocol HybridNitroFSPlatformSpec_protocol: HybridObject {
   // Properties
   var BUNDLE_DIR: String { get }
   var DOCUMENT_DIR: String { get }
@@ -33,31 +33,33 @@ public protocol HybridNitroFSSpec_protocol: HybridObject {
   func dirname(path: String) throws -> String
   func basename(path: String) throws -> String
   func extname(path: String) throws -> String
-  func uploadFile(uploadOptions: NitroUploadOptions, onProgress: ((_ uploadedBytes: Double, _ totalBytes: Double) -> Void)?) throws -> Promise<Void>
-  func downloadFile(downloadOptions: NitroDownloadOptions, onProgress: ((_ downloadedBytes: Double, _ totalBytes: Double) -> Void)?) throws -> Promise<NitroFile>
+  func uploadFile(transferId: Double, uploadOptions: NitroUploadOptions, onProgress: ((_ uploadedBytes: Double, _ totalBytes: Double) -> Void)?) throws -> Promise<Void>
+  func downloadFile(transferId: Double, downloadOptions: NitroDownloadOptions, onProgress: ((_ downloadedBytes: Double, _ totalBytes: Double) -> Void)?) throws -> Promise<NitroFile>
+  func cancelTransfer(transferId: Double) throws -> Void
+  func setMaxConnectionsPerHost(maxConnections: Double) throws -> Void
 }
 
-public extension HybridNitroFSSpec_protocol {
+public extension HybridNitroFSPlatformSpec_protocol {
   /// Default implementation of ``HybridObject.toString``
   func toString() -> String {
-    return "[HybridObject NitroFS]"
+    return "[HybridObject NitroFSPlatform]"
   }
 }
 
-/// See ``HybridNitroFSSpec``
-open class HybridNitroFSSpec_base {
-  private weak var cxxWrapper: HybridNitroFSSpec_cxx? = nil
+/// See ``HybridNitroFSPlatformSpec``
+open class HybridNitroFSPlatformSpec_base {
+  private weak var cxxWrapper: HybridNitroFSPlatformSpec_cxx? = nil
   public init() { }
-  public func getCxxWrapper() -> HybridNitroFSSpec_cxx {
+  public func getCxxWrapper() -> HybridNitroFSPlatformSpec_cxx {
   #if DEBUG
-    guard self is any HybridNitroFSSpec else {
-      fatalError("`self` is not a `HybridNitroFSSpec`! Did you accidentally inherit from `HybridNitroFSSpec_base` instead of `HybridNitroFSSpec`?")
+    guard self is any HybridNitroFSPlatformSpec else {
+      fatalError("`self` is not a `HybridNitroFSPlatformSpec`! Did you accidentally inherit from `HybridNitroFSPlatformSpec_base` instead of `HybridNitroFSPlatformSpec`?")
     }
   #endif
     if let cxxWrapper = self.cxxWrapper {
       return cxxWrapper
     } else {
-      let cxxWrapper = HybridNitroFSSpec_cxx(self as! any HybridNitroFSSpec)
+      let cxxWrapper = HybridNitroFSPlatformSpec_cxx(self as! any HybridNitroFSPlatformSpec)
       self.cxxWrapper = cxxWrapper
       return cxxWrapper
     }
@@ -65,12 +67,12 @@ open class HybridNitroFSSpec_base {
 }
 
 /**
- * A Swift base-protocol representing the NitroFS HybridObject.
- * Implement this protocol to create Swift-based instances of NitroFS.
+ * A Swift base-protocol representing the NitroFSPlatform HybridObject.
+ * Implement this protocol to create Swift-based instances of NitroFSPlatform.
  * ```swift
- * class HybridNitroFS : HybridNitroFSSpec {
+ * class HybridNitroFSPlatform : HybridNitroFSPlatformSpec {
  *   // ...
  * }
  * ```
  */
-public typealias HybridNitroFSSpec = HybridNitroFSSpec_protocol & HybridNitroFSSpec_base
+public typealias HybridNitroFSPlatformSpec = HybridNitroFSPlatformSpec_protocol & HybridNitroFSPlatformSpec_base
@@ -1,5 +1,5 @@
 ///
-/// HybridNitroFSSpec_cxx.swift
+/// HybridNitroFSPlatformSpec_cxx.swift
 /// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
 /// https://github.com/mrousavy/nitro
 /// Copyright © Marc Rousavy @ Margelo
@@ -8,7 +8,7 @@
 import NitroModules
 
 /**
- * A class implementation that bridges HybridNitroFSSpec over to C++.
+ * A class implementation that bridges HybridNitroFSPlatformSpec over to C++.
  * In C++, we cannot use Swift protocols - so we need to wrap it in a class to make it strongly defined.
  *
  * Also, some Swift types need to be bridged with special handling:
@@ -16,7 +16,7 @@ import NitroModules
  * - Other HybridObjects need to be wrapped/unwrapped from the Swift TCxx wrapper
  * - Throwing methods need to be wrapped with a Result<T, Error> type, as exceptions cannot be propagated to C++
  */
-open class HybridNitroFSSpec_cxx {
+open class HybridNitroFSPlatformSpec_cxx {
   /**
    * The Swift <> C++ bridge's namespace (`margelo::nitro::nitrofs::bridge::swift`)
    * from `NitroFS-Swift-Cxx-Bridge.hpp`.
@@ -25,30 +25,30 @@ open class HybridNitroFSSpec_cxx {
   public typealias bridge = margelo.nitro.nitrofs.bridge.swift
 
   /**
-   * Holds an instance of the `HybridNitroFSSpec` Swift protocol.
+   * Holds an instance of the `HybridNitroFSPlatformSpec` Swift protocol.
    */
-  private var __implementation: any HybridNitroFSSpec
+  private var __implementation: any HybridNitroFSPlatformSpec
 
   /**
    * Holds a weak pointer to the C++ class that wraps the Swift class.
    */
-  private var __cxxPart: bridge.std__weak_ptr_HybridNitroFSSpec_
+  private var __cxxPart: bridge.std__weak_ptr_HybridNitroFSPlatformSpec_
 
   /**
-   * Create a new `HybridNitroFSSpec_cxx` that wraps the given `HybridNitroFSSpec`.
+   * Create a new `HybridNitroFSPlatformSpec_cxx` that wraps the given `HybridNitroFSPlatformSpec`.
    * All properties and methods bridge to C++ types.
    */
-  public init(_ implementation: any HybridNitroFSSpec) {
+  public init(_ implementation: any HybridNitroFSPlatformSpec) {
     self.__implementation = implementation
     self.__cxxPart = .init()
     /* no base class */
   }
 
   /**
-   * Get the actual `HybridNitroFSSpec` instance this class wraps.
+   * Get the actual `HybridNitroFSPlatformSpec` instance this class wraps.
    */
   @inline(__always)
-  public func getHybridNitroFSSpec() -> any HybridNitroFSSpec {
+  public func getHybridNitroFSPlatformSpec() -> any HybridNitroFSPlatformSpec {
     return __implementation
   }
 
@@ -61,25 +61,25 @@ open class HybridNitroFSSpec_cxx {
   }
 
   /**
-   * Casts an unsafe pointer to a `HybridNitroFSSpec_cxx`.
-   * The pointer has to be a retained opaque `Unmanaged<HybridNitroFSSpec_cxx>`.
+   * Casts an unsafe pointer to a `HybridNitroFSPlatformSpec_cxx`.
+   * The pointer has to be a retained opaque `Unmanaged<HybridNitroFSPlatformSpec_cxx>`.
    * This removes one strong reference from the object!
    */
-  public class func fromUnsafe(_ pointer: UnsafeMutableRawPointer) -> HybridNitroFSSpec_cxx {
-    return Unmanaged<HybridNitroFSSpec_cxx>.fromOpaque(pointer).takeRetainedValue()
+  public class func fromUnsafe(_ pointer: UnsafeMutableRawPointer) -> HybridNitroFSPlatformSpec_cxx {
+    return Unmanaged<HybridNitroFSPlatformSpec_cxx>.fromOpaque(pointer).takeRetainedValue()
   }
 
   /**
    * Gets (or creates) the C++ part of this Hybrid Object.
-   * The C++ part is a `std::shared_ptr<HybridNitroFSSpec>`.
+   * The C++ part is a `std::shared_ptr<HybridNitroFSPlatformSpec>`.
    */
-  public func getCxxPart() -> bridge.std__shared_ptr_HybridNitroFSSpec_ {
+  public func getCxxPart() -> bridge.std__shared_ptr_HybridNitroFSPlatformSpec_ {
     let cachedCxxPart = self.__cxxPart.lock()
     if Bool(fromCxx: cachedCxxPart) {
       return cachedCxxPart
     } else {
-      let newCxxPart = bridge.create_std__shared_ptr_HybridNitroFSSpec_(self.toUnsafe())
-      __cxxPart = bridge.weakify_std__shared_ptr_HybridNitroFSSpec_(newCxxPart)
+      let newCxxPart = bridge.create_std__shared_ptr_HybridNitroFSPlatformSpec_(self.toUnsafe())
+      __cxxPart = bridge.weakify_std__shared_ptr_HybridNitroFSPlatformSpec_(newCxxPart)
       return newCxxPart
     }
   }
@@ -99,7 +99,7 @@ open class HybridNitroFSSpec_cxx {
    * Compares this object with the given [other] object for reference equality.
    */
   @inline(__always)
-  public func equals(other: HybridNitroFSSpec_cxx) -> Bool {
+  public func equals(other: HybridNitroFSPlatformSpec_cxx) -> Bool {
     return self.__implementation === other.__implementation
   }
 
@@ -411,9 +411,9 @@ open class HybridNitroFSSpec_cxx {
   }
   
   @inline(__always)
-  public final func uploadFile(uploadOptions: NitroUploadOptions, onProgress: bridge.std__optional_std__function_void_double____uploadedBytes_____double____totalBytes______) -> bridge.Result_std__shared_ptr_Promise_void___ {
+  public final func uploadFile(transferId: Double, uploadOptions: NitroUploadOptions, onProgress: bridge.std__optional_std__function_void_double____uploadedBytes_____double____totalBytes______) -> bridge.Result_std__shared_ptr_Promise_void___ {
     do {
-      let __result = try self.__implementation.uploadFile(uploadOptions: uploadOptions, onProgress: { () -> ((_ uploadedBytes: Double, _ totalBytes: Double) -> Void)? in
+      let __result = try self.__implementation.uploadFile(transferId: transferId, uploadOptions: uploadOptions, onProgress: { () -> ((_ uploadedBytes: Double, _ totalBytes: Double) -> Void)? in
         if bridge.has_value_std__optional_std__function_void_double____uploadedBytes_____double____totalBytes______(onProgress) {
           let __unwrapped = bridge.get_std__optional_std__function_void_double____uploadedBytes_____double____totalBytes______(onProgress)
           return { () -> (Double, Double) -> Void in
@@ -442,9 +442,9 @@ open class HybridNitroFSSpec_cxx {
   }
   
   @inline(__always)
-  public final func downloadFile(downloadOptions: NitroDownloadOptions, onProgress: bridge.std__optional_std__function_void_double____downloadedBytes_____double____totalBytes______) -> bridge.Result_std__shared_ptr_Promise_NitroFile___ {
+  public final func downloadFile(transferId: Double, downloadOptions: NitroDownloadOptions, onProgress: bridge.std__optional_std__function_void_double____downloadedBytes_____double____totalBytes______) -> bridge.Result_std__shared_ptr_Promise_NitroFile___ {
     do {
-      let __result = try self.__implementation.downloadFile(downloadOptions: downloadOptions, onProgress: { () -> ((_ downloadedBytes: Double, _ totalBytes: Double) -> Void)? in
+      let __result = try self.__implementation.downloadFile(transferId: transferId, downloadOptions: downloadOptions, onProgress: { () -> ((_ downloadedBytes: Double, _ totalBytes: Double) -> Void)? in
         if bridge.has_value_std__optional_std__function_void_double____downloadedBytes_____double____totalBytes______(onProgress) {
           let __unwrapped = bridge.get_std__optional_std__function_void_double____downloadedBytes_____double____totalBytes______(onProgress)
           return { () -> (Double, Double) -> Void in
@@ -471,4 +471,26 @@ open class HybridNitroFSSpec_cxx {
       return bridge.create_Result_std__shared_ptr_Promise_NitroFile___(__exceptionPtr)
     }
   }
+  
+  @inline(__always)
+  public final func cancelTransfer(transferId: Double) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.cancelTransfer(transferId: transferId)
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func setMaxConnectionsPerHost(maxConnections: Double) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.setMaxConnectionsPerHost(maxConnections: maxConnections)
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
 }
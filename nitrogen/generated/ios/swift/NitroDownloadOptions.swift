@@ -18,7 +18,7 @@ public extension NitroDownloadOptions {
   /**
    * Create a new instance of `NitroDownloadOptions`.
    */
-  init(url: String, destinationPath: String, headers: Dictionary<String, String>?) {
+  init(url: String, destinationPath: String, headers: Dictionary<String, String>?, segments: Double?, minSegmentSize: Double?) {
     self.init(std.string(url), std.string(destinationPath), { () -> bridge.std__optional_std__unordered_map_std__string__std__string__ in
       if let __unwrappedValue = headers {
         return bridge.create_std__optional_std__unordered_map_std__string__std__string__({ () -> bridge.std__unordered_map_std__string__std__string_ in
@@ -31,6 +31,18 @@ public extension NitroDownloadOptions {
       } else {
         return .init()
       }
+    }(), { () -> bridge.std__optional_double_ in
+      if let __unwrappedValue = segments {
+        return bridge.create_std__optional_double_(__unwrappedValue)
+      } else {
+        return .init()
+      }
+    }(), { () -> bridge.std__optional_double_ in
+      if let __unwrappedValue = minSegmentSize {
+        return bridge.create_std__optional_double_(__unwrappedValue)
+      } else {
+        return .init()
+      }
     }())
   }
 
@@ -63,4 +75,14 @@ public extension NitroDownloadOptions {
       }
     }()
   }
+  
+  @inline(__always)
+  var segments: Double? {
+    return self.__segments.value
+  }
+  
+  @inline(__always)
+  var minSegmentSize: Double? {
+    return self.__minSegmentSize.value
+  }
 }
@@ -0,0 +1,40 @@
+///
+/// NitroUploadBodyType.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+/**
+ * Represents the JS union `NitroUploadBodyType`, backed by a C++ enum.
+ */
+public typealias NitroUploadBodyType = margelo.nitro.nitrofs.NitroUploadBodyType
+
+public extension NitroUploadBodyType {
+  /**
+   * Get a NitroUploadBodyType for the given String value, or
+   * return `nil` if the given value was invalid/unknown.
+   */
+  init?(fromString string: String) {
+    switch string {
+      case "multipart":
+        self = .multipart
+      case "raw":
+        self = .raw
+      default:
+        return nil
+    }
+  }
+
+  /**
+   * Get the String value this NitroUploadBodyType represents.
+   */
+  var stringValue: String {
+    switch self {
+      case .multipart:
+        return "multipart"
+      case .raw:
+        return "raw"
+    }
+  }
+}
@@ -18,13 +18,19 @@ public extension NitroUploadOptions {
   /**
    * Create a new instance of `NitroUploadOptions`.
    */
-  init(filePath: String, url: String, method: NitroUploadMethod?, field: String?, headers: Dictionary<String, String>?) {
+  init(filePath: String, url: String, method: NitroUploadMethod?, bodyType: NitroUploadBodyType?, field: String?, headers: Dictionary<String, String>?) {
     self.init(std.string(filePath), std.string(url), { () -> bridge.std__optional_NitroUploadMethod_ in
       if let __unwrappedValue = method {
         return bridge.create_std__optional_NitroUploadMethod_(__unwrappedValue)
       } else {
         return .init()
       }
+    }(), { () -> bridge.std__optional_NitroUploadBodyType_ in
+      if let __unwrappedValue = bodyType {
+        return bridge.create_std__optional_NitroUploadBodyType_(__unwrappedValue)
+      } else {
+        return .init()
+      }
     }(), { () -> bridge.std__optional_std__string_ in
       if let __unwrappedValue = field {
         return bridge.create_std__optional_std__string_(std.string(__unwrappedValue))
@@ -61,6 +67,11 @@ public extension NitroUploadOptions {
     return self.__method.value
   }
   
+  @inline(__always)
+  var bodyType: NitroUploadBodyType? {
+    return self.__bodyType.value
+  }
+  
   @inline(__always)
   var field: String? {
     return { () -> String? in
@@ -0,0 +1,45 @@
+///
+/// HybridNitroFSPlatformSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroFSPlatformSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroFSPlatformSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("BUNDLE_DIR", &HybridNitroFSPlatformSpec::getBUNDLE_DIR);
+      prototype.registerHybridGetter("DOCUMENT_DIR", &HybridNitroFSPlatformSpec::getDOCUMENT_DIR);
+      prototype.registerHybridGetter("CACHE_DIR", &HybridNitroFSPlatformSpec::getCACHE_DIR);
+      prototype.registerHybridGetter("DOWNLOAD_DIR", &HybridNitroFSPlatformSpec::getDOWNLOAD_DIR);
+      prototype.registerHybridGetter("DCIM_DIR", &HybridNitroFSPlatformSpec::getDCIM_DIR);
+      prototype.registerHybridGetter("PICTURES_DIR", &HybridNitroFSPlatformSpec::getPICTURES_DIR);
+      prototype.registerHybridGetter("MOVIES_DIR", &HybridNitroFSPlatformSpec::getMOVIES_DIR);
+      prototype.registerHybridGetter("MUSIC_DIR", &HybridNitroFSPlatformSpec::getMUSIC_DIR);
+      prototype.registerHybridMethod("exists", &HybridNitroFSPlatformSpec::exists);
+      prototype.registerHybridMethod("writeFile", &HybridNitroFSPlatformSpec::writeFile);
+      prototype.registerHybridMethod("readFile", &HybridNitroFSPlatformSpec::readFile);
+      prototype.registerHybridMethod("copyFile", &HybridNitroFSPlatformSpec::copyFile);
+      prototype.registerHybridMethod("copy", &HybridNitroFSPlatformSpec::copy);
+      prototype.registerHybridMethod("unlink", &HybridNitroFSPlatformSpec::unlink);
+      prototype.registerHybridMethod("mkdir", &HybridNitroFSPlatformSpec::mkdir);
+      prototype.registerHybridMethod("stat", &HybridNitroFSPlatformSpec::stat);
+      prototype.registerHybridMethod("readdir", &HybridNitroFSPlatformSpec::readdir);
+      prototype.registerHybridMethod("rename", &HybridNitroFSPlatformSpec::rename);
+      prototype.registerHybridMethod("dirname", &HybridNitroFSPlatformSpec::dirname);
+      prototype.registerHybridMethod("basename", &HybridNitroFSPlatformSpec::basename);
+      prototype.registerHybridMethod("extname", &HybridNitroFSPlatformSpec::extname);
+      prototype.registerHybridMethod("uploadFile", &HybridNitroFSPlatformSpec::uploadFile);
+      prototype.registerHybridMethod("downloadFile", &HybridNitroFSPlatformSpec::downloadFile);
+      prototype.registerHybridMethod("cancelTransfer", &HybridNitroFSPlatformSpec::cancelTransfer);
+      prototype.registerHybridMethod("setMaxConnectionsPerHost", &HybridNitroFSPlatformSpec::setMaxConnectionsPerHost);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,103 @@
+///
+/// HybridNitroFSPlatformSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFileEncoding` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFileEncoding; }
+// Forward declaration of `NitroFileStat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroFileStat; }
+// Forward declaration of `NitroFile` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroFile; }
+// Forward declaration of `NitroUploadOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
+// Forward declaration of `NitroDownloadOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
+
+#include <string>
+#include <NitroModules/Promise.hpp>
+#include "NitroFileEncoding.hpp"
+#include "NitroFileStat.hpp"
+#include "NitroFile.hpp"
+#include <vector>
+#include "NitroUploadOptions.hpp"
+#include <functional>
+#include <optional>
+#include "NitroDownloadOptions.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroFSPlatform`
+   * Inherit this class to create instances of `HybridNitroFSPlatformSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroFS: public HybridNitroFSPlatformSpec {
+   * public:
+   *   HybridNitroFSPlatform(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroFSPlatformSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroFSPlatformSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroFSPlatformSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getBUNDLE_DIR() = 0;
+      virtual std::string getDOCUMENT_DIR() = 0;
+      virtual std::string getCACHE_DIR() = 0;
+      virtual std::string getDOWNLOAD_DIR() = 0;
+      virtual std::string getDCIM_DIR() = 0;
+      virtual std::string getPICTURES_DIR() = 0;
+      virtual std::string getMOVIES_DIR() = 0;
+      virtual std::string getMUSIC_DIR() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<Promise<bool>> exists(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<void>> writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) = 0;
+      virtual std::shared_ptr<Promise<std::string>> readFile(const std::string& path, NitroFileEncoding encoding) = 0;
+      virtual std::shared_ptr<Promise<void>> copyFile(const std::string& srcPath, const std::string& destPath) = 0;
+      virtual std::shared_ptr<Promise<void>> copy(const std::string& srcPath, const std::string& destPath) = 0;
+      virtual std::shared_ptr<Promise<bool>> unlink(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<bool>> mkdir(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<NitroFileStat>> stat(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<std::vector<NitroFile>>> readdir(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<void>> rename(const std::string& oldPath, const std::string& newPath) = 0;
+      virtual std::string dirname(const std::string& path) = 0;
+      virtual std::string basename(const std::string& path) = 0;
+      virtual std::string extname(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<void>> uploadFile(double transferId, const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
+      virtual std::shared_ptr<Promise<NitroFile>> downloadFile(double transferId, const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
+      virtual void cancelTransfer(double transferId) = 0;
+      virtual void setMaxConnectionsPerHost(double maxConnections) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroFSPlatform";
+  };
+
+} // namespace margelo::nitro::nitrofs
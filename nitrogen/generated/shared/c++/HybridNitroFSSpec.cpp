@@ -23,20 +23,43 @@ namespace margelo::nitro::nitrofs {
       prototype.registerHybridGetter("MOVIES_DIR", &HybridNitroFSSpec::getMOVIES_DIR);
       prototype.registerHybridGetter("MUSIC_DIR", &HybridNitroFSSpec::getMUSIC_DIR);
       prototype.registerHybridMethod("exists", &HybridNitroFSSpec::exists);
+      prototype.registerHybridMethod("existsMany", &HybridNitroFSSpec::existsMany);
       prototype.registerHybridMethod("writeFile", &HybridNitroFSSpec::writeFile);
       prototype.registerHybridMethod("readFile", &HybridNitroFSSpec::readFile);
+      prototype.registerHybridMethod("readFileBuffer", &HybridNitroFSSpec::readFileBuffer);
+      prototype.registerHybridMethod("writeFileBuffer", &HybridNitroFSSpec::writeFileBuffer);
+      prototype.registerHybridMethod("appendFile", &HybridNitroFSSpec::appendFile);
+      prototype.registerHybridMethod("mapFile", &HybridNitroFSSpec::mapFile);
+      prototype.registerHybridMethod("open", &HybridNitroFSSpec::open);
+      prototype.registerHybridMethod("createFileWriter", &HybridNitroFSSpec::createFileWriter);
+      prototype.registerHybridMethod("createReadStream", &HybridNitroFSSpec::createReadStream);
+      prototype.registerHybridMethod("readLines", &HybridNitroFSSpec::readLines);
+      prototype.registerHybridMethod("indexLines", &HybridNitroFSSpec::indexLines);
+      prototype.registerHybridMethod("hashFile", &HybridNitroFSSpec::hashFile);
+      prototype.registerHybridMethod("compressFile", &HybridNitroFSSpec::compressFile);
+      prototype.registerHybridMethod("decompressFile", &HybridNitroFSSpec::decompressFile);
+      prototype.registerHybridMethod("isCompressionAvailable", &HybridNitroFSSpec::isCompressionAvailable);
       prototype.registerHybridMethod("copyFile", &HybridNitroFSSpec::copyFile);
       prototype.registerHybridMethod("copy", &HybridNitroFSSpec::copy);
+      prototype.registerHybridMethod("unzip", &HybridNitroFSSpec::unzip);
+      prototype.registerHybridMethod("zip", &HybridNitroFSSpec::zip);
       prototype.registerHybridMethod("unlink", &HybridNitroFSSpec::unlink);
+      prototype.registerHybridMethod("rm", &HybridNitroFSSpec::rm);
       prototype.registerHybridMethod("mkdir", &HybridNitroFSSpec::mkdir);
       prototype.registerHybridMethod("stat", &HybridNitroFSSpec::stat);
+      prototype.registerHybridMethod("statMany", &HybridNitroFSSpec::statMany);
       prototype.registerHybridMethod("readdir", &HybridNitroFSSpec::readdir);
+      prototype.registerHybridMethod("walk", &HybridNitroFSSpec::walk);
+      prototype.registerHybridMethod("du", &HybridNitroFSSpec::du);
       prototype.registerHybridMethod("rename", &HybridNitroFSSpec::rename);
       prototype.registerHybridMethod("dirname", &HybridNitroFSSpec::dirname);
       prototype.registerHybridMethod("basename", &HybridNitroFSSpec::basename);
       prototype.registerHybridMethod("extname", &HybridNitroFSSpec::extname);
       prototype.registerHybridMethod("uploadFile", &HybridNitroFSSpec::uploadFile);
       prototype.registerHybridMethod("downloadFile", &HybridNitroFSSpec::downloadFile);
+      prototype.registerHybridMethod("enqueueDownload", &HybridNitroFSSpec::enqueueDownload);
+      prototype.registerHybridMethod("enqueueUpload", &HybridNitroFSSpec::enqueueUpload);
+      prototype.registerHybridMethod("configureTransfers", &HybridNitroFSSpec::configureTransfers);
     });
   }
 
@@ -15,25 +15,117 @@
 
 // Forward declaration of `NitroFileEncoding` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroFileEncoding; }
+// Forward declaration of `NitroWriteOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroWriteOptions; }
+// Forward declaration of `NitroReadOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroReadOptions; }
+// Forward declaration of `HybridNitroMappedFileSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroMappedFileSpec; }
+// Forward declaration of `NitroMapOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroMapOptions; }
+// Forward declaration of `HybridNitroFileHandleSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroFileHandleSpec; }
+// Forward declaration of `NitroOpenMode` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroOpenMode; }
+// Forward declaration of `HybridNitroFileWriterSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroFileWriterSpec; }
+// Forward declaration of `NitroFileWriterOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroFileWriterOptions; }
+// Forward declaration of `HybridNitroReadStreamSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroReadStreamSpec; }
+// Forward declaration of `NitroReadStreamOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroReadStreamOptions; }
+// Forward declaration of `NitroLineBatch` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroLineBatch; }
+// Forward declaration of `NitroReadLinesOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroReadLinesOptions; }
+// Forward declaration of `NitroHashAlgorithm` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroHashAlgorithm; }
+// Forward declaration of `NitroHashOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroHashOptions; }
+// Forward declaration of `NitroCompressionFormat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroCompressionFormat; }
+// Forward declaration of `NitroCompressOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroCompressOptions; }
+// Forward declaration of `NitroCopyOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroCopyOptions; }
+// Forward declaration of `NitroUnzipOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroUnzipOptions; }
+// Forward declaration of `NitroZipOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroZipOptions; }
+// Forward declaration of `NitroRemoveOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroRemoveOptions; }
 // Forward declaration of `NitroFileStat` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroFileStat; }
+// Forward declaration of `NitroStatResult` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroStatResult; }
+// Forward declaration of `NitroDirEntry` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroDirEntry; }
+// Forward declaration of `NitroFileType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFileType; }
+// Forward declaration of `NitroReaddirOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroReaddirOptions; }
+// Forward declaration of `NitroWalkOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroWalkOptions; }
+// Forward declaration of `NitroDiskUsage` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroDiskUsage; }
+// Forward declaration of `NitroDiskUsageOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroDiskUsageOptions; }
 // Forward declaration of `NitroFile` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroFile; }
 // Forward declaration of `NitroUploadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroUploadOptions; }
 // Forward declaration of `NitroDownloadOptions` to properly resolve imports.
 namespace margelo::nitro::nitrofs { struct NitroDownloadOptions; }
+// Forward declaration of `HybridNitroTransferSpec` to properly resolve imports.
+namespace margelo::nitro::nitrofs { class HybridNitroTransferSpec; }
+// Forward declaration of `NitroTransferPriority` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroTransferPriority; }
+// Forward declaration of `NitroTransferOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroTransferOptions; }
 
 #include <string>
 #include <NitroModules/Promise.hpp>
+#include <vector>
 #include "NitroFileEncoding.hpp"
+#include "NitroWriteOptions.hpp"
+#include <optional>
+#include "NitroReadOptions.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <memory>
+#include "HybridNitroMappedFileSpec.hpp"
+#include "NitroMapOptions.hpp"
+#include "HybridNitroFileHandleSpec.hpp"
+#include "NitroOpenMode.hpp"
+#include "HybridNitroFileWriterSpec.hpp"
+#include "NitroFileWriterOptions.hpp"
+#include "HybridNitroReadStreamSpec.hpp"
+#include "NitroReadStreamOptions.hpp"
+#include "NitroLineBatch.hpp"
+#include <functional>
+#include "NitroReadLinesOptions.hpp"
+#include "NitroHashAlgorithm.hpp"
+#include "NitroHashOptions.hpp"
+#include "NitroCompressionFormat.hpp"
+#include "NitroCompressOptions.hpp"
+#include "NitroCopyOptions.hpp"
+#include "NitroUnzipOptions.hpp"
+#include "NitroZipOptions.hpp"
+#include "NitroRemoveOptions.hpp"
 #include "NitroFileStat.hpp"
+#include "NitroStatResult.hpp"
+#include "NitroDirEntry.hpp"
+#include "NitroFileType.hpp"
+#include "NitroReaddirOptions.hpp"
+#include "NitroWalkOptions.hpp"
+#include "NitroDiskUsage.hpp"
+#include "NitroDiskUsageOptions.hpp"
 #include "NitroFile.hpp"
-#include <vector>
 #include "NitroUploadOptions.hpp"
-#include <functional>
-#include <optional>
 #include "NitroDownloadOptions.hpp"
+#include "HybridNitroTransferSpec.hpp"
+#include "NitroTransferPriority.hpp"
+#include "NitroTransferOptions.hpp"
 
 namespace margelo::nitro::nitrofs {
 
@@ -74,20 +166,43 @@ namespace margelo::nitro::nitrofs {
     public:
       // Methods
       virtual std::shared_ptr<Promise<bool>> exists(const std::string& path) = 0;
-      virtual std::shared_ptr<Promise<void>> writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) = 0;
-      virtual std::shared_ptr<Promise<std::string>> readFile(const std::string& path, NitroFileEncoding encoding) = 0;
+      virtual std::shared_ptr<Promise<std::vector<bool>>> existsMany(const std::vector<std::string>& paths) = 0;
+      virtual std::shared_ptr<Promise<void>> writeFile(const std::string& path, const std::string& data, NitroFileEncoding encoding, const std::optional<NitroWriteOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<std::string>> readFile(const std::string& path, NitroFileEncoding encoding, const std::optional<NitroReadOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> readFileBuffer(const std::string& path, const std::optional<NitroReadOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<void>> writeFileBuffer(const std::string& path, const std::shared_ptr<ArrayBuffer>& data, const std::optional<NitroWriteOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<void>> appendFile(const std::string& path, const std::string& data, NitroFileEncoding encoding) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<HybridNitroMappedFileSpec>>> mapFile(const std::string& path, const std::optional<NitroMapOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileHandleSpec>>> open(const std::string& path, NitroOpenMode mode) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<HybridNitroFileWriterSpec>>> createFileWriter(const std::string& path, const std::optional<NitroFileWriterOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<HybridNitroReadStreamSpec>>> createReadStream(const std::string& path, const std::optional<NitroReadStreamOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<double>> readLines(const std::string& path, const std::function<void(const NitroLineBatch& /* batch */)>& onLines, const std::optional<NitroReadLinesOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<double>> indexLines(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<std::string>> hashFile(const std::string& path, NitroHashAlgorithm algorithm, const std::optional<NitroHashOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<double>> compressFile(const std::string& srcPath, const std::string& destPath, NitroCompressionFormat format, const std::optional<NitroCompressOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<double>> decompressFile(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCompressionFormat>& format) = 0;
+      virtual bool isCompressionAvailable(NitroCompressionFormat format) = 0;
       virtual std::shared_ptr<Promise<void>> copyFile(const std::string& srcPath, const std::string& destPath) = 0;
-      virtual std::shared_ptr<Promise<void>> copy(const std::string& srcPath, const std::string& destPath) = 0;
+      virtual std::shared_ptr<Promise<void>> copy(const std::string& srcPath, const std::string& destPath, const std::optional<NitroCopyOptions>& options, const std::optional<std::function<void(double /* copiedBytes */, double /* totalBytes */, double /* copiedFiles */, double /* totalFiles */)>>& onProgress) = 0;
+      virtual std::shared_ptr<Promise<double>> unzip(const std::string& archivePath, const std::string& destDir, const std::optional<NitroUnzipOptions>& options, const std::optional<std::function<void(double /* extractedBytes */, double /* totalBytes */, double /* extractedEntries */, double /* totalEntries */)>>& onProgress) = 0;
+      virtual std::shared_ptr<Promise<double>> zip(const std::string& srcPath, const std::string& archivePath, const std::optional<NitroZipOptions>& options, const std::optional<std::function<void(double /* zippedBytes */, double /* totalBytes */, double /* zippedEntries */, double /* totalEntries */)>>& onProgress) = 0;
       virtual std::shared_ptr<Promise<bool>> unlink(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<double>> rm(const std::string& path, const std::optional<NitroRemoveOptions>& options, const std::optional<std::function<void(double /* removedEntries */)>>& onProgress) = 0;
       virtual std::shared_ptr<Promise<bool>> mkdir(const std::string& path) = 0;
       virtual std::shared_ptr<Promise<NitroFileStat>> stat(const std::string& path) = 0;
-      virtual std::shared_ptr<Promise<std::vector<NitroFile>>> readdir(const std::string& path) = 0;
+      virtual std::shared_ptr<Promise<std::vector<NitroStatResult>>> statMany(const std::vector<std::string>& paths) = 0;
+      virtual std::shared_ptr<Promise<std::vector<NitroDirEntry>>> readdir(const std::string& path, const std::optional<NitroReaddirOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<double>> walk(const std::string& root, const std::function<void(const std::vector<NitroDirEntry>& /* entries */)>& onEntries, const std::optional<NitroWalkOptions>& options) = 0;
+      virtual std::shared_ptr<Promise<NitroDiskUsage>> du(const std::string& path, const std::optional<NitroDiskUsageOptions>& options) = 0;
       virtual std::shared_ptr<Promise<void>> rename(const std::string& oldPath, const std::string& newPath) = 0;
       virtual std::string dirname(const std::string& path) = 0;
       virtual std::string basename(const std::string& path) = 0;
       virtual std::string extname(const std::string& path) = 0;
       virtual std::shared_ptr<Promise<void>> uploadFile(const NitroUploadOptions& uploadOptions, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
       virtual std::shared_ptr<Promise<NitroFile>> downloadFile(const NitroDownloadOptions& downloadOptions, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
+      virtual std::shared_ptr<HybridNitroTransferSpec> enqueueDownload(const NitroDownloadOptions& downloadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* downloadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
+      virtual std::shared_ptr<HybridNitroTransferSpec> enqueueUpload(const NitroUploadOptions& uploadOptions, const std::optional<NitroTransferPriority>& priority, const std::optional<std::function<void(double /* uploadedBytes */, double /* totalBytes */)>>& onProgress) = 0;
+      virtual void configureTransfers(const NitroTransferOptions& options) = 0;
 
     protected:
       // Hybrid Setup
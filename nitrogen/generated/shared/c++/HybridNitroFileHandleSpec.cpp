@@ -0,0 +1,27 @@
+///
+/// HybridNitroFileHandleSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroFileHandleSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroFileHandleSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("path", &HybridNitroFileHandleSpec::getPath);
+      prototype.registerHybridMethod("read", &HybridNitroFileHandleSpec::read);
+      prototype.registerHybridMethod("write", &HybridNitroFileHandleSpec::write);
+      prototype.registerHybridMethod("size", &HybridNitroFileHandleSpec::size);
+      prototype.registerHybridMethod("truncate", &HybridNitroFileHandleSpec::truncate);
+      prototype.registerHybridMethod("sync", &HybridNitroFileHandleSpec::sync);
+      prototype.registerHybridMethod("close", &HybridNitroFileHandleSpec::close);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,69 @@
+///
+/// HybridNitroFileHandleSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroFileHandle`
+   * Inherit this class to create instances of `HybridNitroFileHandleSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroFileHandle: public HybridNitroFileHandleSpec {
+   * public:
+   *   HybridNitroFileHandle(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroFileHandleSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroFileHandleSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroFileHandleSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getPath() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> read(double offset, double length) = 0;
+      virtual std::shared_ptr<Promise<void>> write(double offset, const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<Promise<double>> size() = 0;
+      virtual std::shared_ptr<Promise<void>> truncate(double length) = 0;
+      virtual std::shared_ptr<Promise<void>> sync() = 0;
+      virtual std::shared_ptr<Promise<void>> close() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroFileHandle";
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,25 @@
+///
+/// HybridNitroFileWriterSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroFileWriterSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroFileWriterSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("path", &HybridNitroFileWriterSpec::getPath);
+      prototype.registerHybridMethod("write", &HybridNitroFileWriterSpec::write);
+      prototype.registerHybridMethod("writeBuffer", &HybridNitroFileWriterSpec::writeBuffer);
+      prototype.registerHybridMethod("flush", &HybridNitroFileWriterSpec::flush);
+      prototype.registerHybridMethod("close", &HybridNitroFileWriterSpec::close);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
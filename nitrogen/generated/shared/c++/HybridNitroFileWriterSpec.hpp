@@ -0,0 +1,67 @@
+///
+/// HybridNitroFileWriterSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroFileWriter`
+   * Inherit this class to create instances of `HybridNitroFileWriterSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroFileWriter: public HybridNitroFileWriterSpec {
+   * public:
+   *   HybridNitroFileWriter(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroFileWriterSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroFileWriterSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroFileWriterSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getPath() = 0;
+
+    public:
+      // Methods
+      virtual void write(const std::string& data) = 0;
+      virtual void writeBuffer(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::shared_ptr<Promise<void>> flush() = 0;
+      virtual std::shared_ptr<Promise<void>> close() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroFileWriter";
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,24 @@
+///
+/// HybridNitroMappedFileSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroMappedFileSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroMappedFileSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("buffer", &HybridNitroMappedFileSpec::getBuffer);
+      prototype.registerHybridGetter("offset", &HybridNitroMappedFileSpec::getOffset);
+      prototype.registerHybridGetter("readOnly", &HybridNitroMappedFileSpec::getReadOnly);
+      prototype.registerHybridMethod("sync", &HybridNitroMappedFileSpec::sync);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
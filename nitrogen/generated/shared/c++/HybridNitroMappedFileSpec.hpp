@@ -0,0 +1,65 @@
+///
+/// HybridNitroMappedFileSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroMappedFile`
+   * Inherit this class to create instances of `HybridNitroMappedFileSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroMappedFile: public HybridNitroMappedFileSpec {
+   * public:
+   *   HybridNitroMappedFile(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroMappedFileSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroMappedFileSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroMappedFileSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::shared_ptr<ArrayBuffer> getBuffer() = 0;
+      virtual double getOffset() = 0;
+      virtual bool getReadOnly() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<Promise<void>> sync() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroMappedFile";
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,24 @@
+///
+/// HybridNitroReadStreamSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroReadStreamSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroReadStreamSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("path", &HybridNitroReadStreamSpec::getPath);
+      prototype.registerHybridMethod("read", &HybridNitroReadStreamSpec::read);
+      prototype.registerHybridMethod("readString", &HybridNitroReadStreamSpec::readString);
+      prototype.registerHybridMethod("close", &HybridNitroReadStreamSpec::close);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
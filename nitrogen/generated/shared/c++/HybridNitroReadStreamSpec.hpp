@@ -0,0 +1,67 @@
+///
+/// HybridNitroReadStreamSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroReadStream`
+   * Inherit this class to create instances of `HybridNitroReadStreamSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroReadStream: public HybridNitroReadStreamSpec {
+   * public:
+   *   HybridNitroReadStream(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroReadStreamSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroReadStreamSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroReadStreamSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getPath() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> read() = 0;
+      virtual std::shared_ptr<Promise<std::optional<std::string>>> readString() = 0;
+      virtual void close() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroReadStream";
+  };
+
+} // namespace margelo::nitro::nitrofs
@@ -0,0 +1,28 @@
+///
+/// HybridNitroTransferSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroTransferSpec.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  void HybridNitroTransferSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("id", &HybridNitroTransferSpec::getId);
+      prototype.registerHybridGetter("state", &HybridNitroTransferSpec::getState);
+      prototype.registerHybridGetter("priority", &HybridNitroTransferSpec::getPriority);
+      prototype.registerHybridMethod("result", &HybridNitroTransferSpec::result);
+      prototype.registerHybridMethod("pause", &HybridNitroTransferSpec::pause);
+      prototype.registerHybridMethod("resume", &HybridNitroTransferSpec::resume);
+      prototype.registerHybridMethod("cancel", &HybridNitroTransferSpec::cancel);
+      prototype.registerHybridMethod("setPriority", &HybridNitroTransferSpec::setPriority);
+    });
+  }
+
+} // namespace margelo::nitro::nitrofs
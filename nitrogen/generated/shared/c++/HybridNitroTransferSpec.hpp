@@ -0,0 +1,76 @@
+///
+/// HybridNitroTransferSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroTransferState` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroTransferState; }
+// Forward declaration of `NitroTransferPriority` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroTransferPriority; }
+// Forward declaration of `NitroFile` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroFile; }
+
+#include "NitroTransferState.hpp"
+#include "NitroTransferPriority.hpp"
+#include "NitroFile.hpp"
+#include <NitroModules/Promise.hpp>
+
+namespace margelo::nitro::nitrofs {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroTransfer`
+   * Inherit this class to create instances of `HybridNitroTransferSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroTransfer: public HybridNitroTransferSpec {
+   * public:
+   *   HybridNitroTransfer(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroTransferSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroTransferSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroTransferSpec() override = default;
+
+    public:
+      // Properties
+      virtual double getId() = 0;
+      virtual NitroTransferState getState() = 0;
+      virtual NitroTransferPriority getPriority() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<Promise<NitroFile>> result() = 0;
+      virtual void pause() = 0;
+      virtual void resume() = 0;
+      virtual void cancel() = 0;
+      virtual void setPriority(NitroTransferPriority priority) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroTransfer";
+  };
+
+} // namespace margelo::nitro::nitrofs
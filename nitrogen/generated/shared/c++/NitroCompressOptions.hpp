@@ -0,0 +1,87 @@
+///
+/// NitroCompressOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroCompressOptions).
+   */
+  struct NitroCompressOptions final {
+  public:
+    std::optional<double> level     SWIFT_PRIVATE;
+    std::optional<double> threads     SWIFT_PRIVATE;
+
+  public:
+    NitroCompressOptions() = default;
+    explicit NitroCompressOptions(std::optional<double> level, std::optional<double> threads): level(level), threads(threads) {}
+
+  public:
+    friend bool operator==(const NitroCompressOptions& lhs, const NitroCompressOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroCompressOptions <> JS NitroCompressOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroCompressOptions> final {
+    static inline margelo::nitro::nitrofs::NitroCompressOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroCompressOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "level"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "threads")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroCompressOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "level"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.level));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "threads"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.threads));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "level")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "threads")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
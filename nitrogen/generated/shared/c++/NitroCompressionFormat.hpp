@@ -0,0 +1,80 @@
+///
+/// NitroCompressionFormat.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroCompressionFormat).
+   */
+  enum class NitroCompressionFormat {
+    GZIP      SWIFT_NAME(gzip) = 0,
+    DEFLATE      SWIFT_NAME(deflate) = 1,
+    ZSTD      SWIFT_NAME(zstd) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroCompressionFormat <> JS NitroCompressionFormat (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroCompressionFormat> final {
+    static inline margelo::nitro::nitrofs::NitroCompressionFormat fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("gzip"): return margelo::nitro::nitrofs::NitroCompressionFormat::GZIP;
+        case hashString("deflate"): return margelo::nitro::nitrofs::NitroCompressionFormat::DEFLATE;
+        case hashString("zstd"): return margelo::nitro::nitrofs::NitroCompressionFormat::ZSTD;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroCompressionFormat - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroCompressionFormat arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroCompressionFormat::GZIP: return JSIConverter<std::string>::toJSI(runtime, "gzip");
+        case margelo::nitro::nitrofs::NitroCompressionFormat::DEFLATE: return JSIConverter<std::string>::toJSI(runtime, "deflate");
+        case margelo::nitro::nitrofs::NitroCompressionFormat::ZSTD: return JSIConverter<std::string>::toJSI(runtime, "zstd");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroCompressionFormat to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("gzip"):
+        case hashString("deflate"):
+        case hashString("zstd"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
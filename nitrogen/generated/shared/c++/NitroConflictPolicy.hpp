@@ -0,0 +1,80 @@
+///
+/// NitroConflictPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroConflictPolicy).
+   */
+  enum class NitroConflictPolicy {
+    OVERWRITE      SWIFT_NAME(overwrite) = 0,
+    SKIP      SWIFT_NAME(skip) = 1,
+    FAIL      SWIFT_NAME(fail) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroConflictPolicy <> JS NitroConflictPolicy (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroConflictPolicy> final {
+    static inline margelo::nitro::nitrofs::NitroConflictPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("overwrite"): return margelo::nitro::nitrofs::NitroConflictPolicy::OVERWRITE;
+        case hashString("skip"): return margelo::nitro::nitrofs::NitroConflictPolicy::SKIP;
+        case hashString("fail"): return margelo::nitro::nitrofs::NitroConflictPolicy::FAIL;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroConflictPolicy - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroConflictPolicy arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroConflictPolicy::OVERWRITE: return JSIConverter<std::string>::toJSI(runtime, "overwrite");
+        case margelo::nitro::nitrofs::NitroConflictPolicy::SKIP: return JSIConverter<std::string>::toJSI(runtime, "skip");
+        case margelo::nitro::nitrofs::NitroConflictPolicy::FAIL: return JSIConverter<std::string>::toJSI(runtime, "fail");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroConflictPolicy to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("overwrite"):
+        case hashString("skip"):
+        case hashString("fail"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
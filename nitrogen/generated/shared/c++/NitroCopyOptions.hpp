@@ -0,0 +1,89 @@
+///
+/// NitroCopyOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroConflictPolicy` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroConflictPolicy; }
+
+#include "NitroConflictPolicy.hpp"
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroCopyOptions).
+   */
+  struct NitroCopyOptions final {
+  public:
+    std::optional<NitroConflictPolicy> conflict     SWIFT_PRIVATE;
+    std::optional<double> parallelism     SWIFT_PRIVATE;
+
+  public:
+    NitroCopyOptions() = default;
+    explicit NitroCopyOptions(std::optional<NitroConflictPolicy> conflict, std::optional<double> parallelism): conflict(conflict), parallelism(parallelism) {}
+
+  public:
+    friend bool operator==(const NitroCopyOptions& lhs, const NitroCopyOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroCopyOptions <> JS NitroCopyOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroCopyOptions> final {
+    static inline margelo::nitro::nitrofs::NitroCopyOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroCopyOptions(
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroConflictPolicy>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "conflict"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "parallelism")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroCopyOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "conflict"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroConflictPolicy>>::toJSI(runtime, arg.conflict));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "parallelism"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.parallelism));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroConflictPolicy>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "conflict")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "parallelism")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
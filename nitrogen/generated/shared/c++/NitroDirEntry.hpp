@@ -0,0 +1,106 @@
+///
+/// NitroDirEntry.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFileType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFileType; }
+
+#include <string>
+#include <optional>
+#include "NitroFileType.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroDirEntry).
+   */
+  struct NitroDirEntry final {
+  public:
+    std::string name     SWIFT_PRIVATE;
+    std::optional<std::string> mimeType     SWIFT_PRIVATE;
+    std::string path     SWIFT_PRIVATE;
+    std::optional<NitroFileType> type     SWIFT_PRIVATE;
+    std::optional<double> size     SWIFT_PRIVATE;
+    std::optional<double> mtime     SWIFT_PRIVATE;
+
+  public:
+    NitroDirEntry() = default;
+    explicit NitroDirEntry(std::string name, std::optional<std::string> mimeType, std::string path, std::optional<NitroFileType> type, std::optional<double> size, std::optional<double> mtime): name(name), mimeType(mimeType), path(path), type(type), size(size), mtime(mtime) {}
+
+  public:
+    friend bool operator==(const NitroDirEntry& lhs, const NitroDirEntry& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroDirEntry <> JS NitroDirEntry (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroDirEntry> final {
+    static inline margelo::nitro::nitrofs::NitroDirEntry fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroDirEntry(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "name"))),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeType"))),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "path"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileType>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "type"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mtime")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroDirEntry& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "name"), JSIConverter<std::string>::toJSI(runtime, arg.name));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "mimeType"), JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.mimeType));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "path"), JSIConverter<std::string>::toJSI(runtime, arg.path));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "type"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileType>>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "size"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.size));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "mtime"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.mtime));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "name")))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeType")))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "path")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileType>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "type")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mtime")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
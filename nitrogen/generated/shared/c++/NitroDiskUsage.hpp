@@ -0,0 +1,105 @@
+///
+/// NitroDiskUsage.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroDiskUsageEntry` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroDiskUsageEntry; }
+
+#include "NitroDiskUsageEntry.hpp"
+#include <vector>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroDiskUsage).
+   */
+  struct NitroDiskUsage final {
+  public:
+    double size     SWIFT_PRIVATE;
+    double allocatedSize     SWIFT_PRIVATE;
+    double fileCount     SWIFT_PRIVATE;
+    double directoryCount     SWIFT_PRIVATE;
+    std::vector<NitroDiskUsageEntry> largestFiles     SWIFT_PRIVATE;
+    std::vector<NitroDiskUsageEntry> largestDirectories     SWIFT_PRIVATE;
+
+  public:
+    NitroDiskUsage() = default;
+    explicit NitroDiskUsage(double size, double allocatedSize, double fileCount, double directoryCount, std::vector<NitroDiskUsageEntry> largestFiles, std::vector<NitroDiskUsageEntry> largestDirectories): size(size), allocatedSize(allocatedSize), fileCount(fileCount), directoryCount(directoryCount), largestFiles(largestFiles), largestDirectories(largestDirectories) {}
+
+  public:
+    friend bool operator==(const NitroDiskUsage& lhs, const NitroDiskUsage& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroDiskUsage <> JS NitroDiskUsage (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroDiskUsage> final {
+    static inline margelo::nitro::nitrofs::NitroDiskUsage fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroDiskUsage(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "allocatedSize"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileCount"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "directoryCount"))),
+        JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "largestFiles"))),
+        JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "largestDirectories")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroDiskUsage& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "size"), JSIConverter<double>::toJSI(runtime, arg.size));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "allocatedSize"), JSIConverter<double>::toJSI(runtime, arg.allocatedSize));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fileCount"), JSIConverter<double>::toJSI(runtime, arg.fileCount));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "directoryCount"), JSIConverter<double>::toJSI(runtime, arg.directoryCount));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "largestFiles"), JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::toJSI(runtime, arg.largestFiles));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "largestDirectories"), JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::toJSI(runtime, arg.largestDirectories));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "allocatedSize")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileCount")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "directoryCount")))) return false;
+      if (!JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "largestFiles")))) return false;
+      if (!JSIConverter<std::vector<margelo::nitro::nitrofs::NitroDiskUsageEntry>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "largestDirectories")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
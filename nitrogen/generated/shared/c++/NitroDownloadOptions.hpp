@@ -44,10 +44,12 @@ namespace margelo::nitro::nitrofs {
     std::string url     SWIFT_PRIVATE;
     std::string destinationPath     SWIFT_PRIVATE;
     std::optional<std::unordered_map<std::string, std::string>> headers     SWIFT_PRIVATE;
+    std::optional<double> segments     SWIFT_PRIVATE;
+    std::optional<double> minSegmentSize     SWIFT_PRIVATE;
 
   public:
     NitroDownloadOptions() = default;
-    explicit NitroDownloadOptions(std::string url, std::string destinationPath, std::optional<std::unordered_map<std::string, std::string>> headers): url(url), destinationPath(destinationPath), headers(headers) {}
+    explicit NitroDownloadOptions(std::string url, std::string destinationPath, std::optional<std::unordered_map<std::string, std::string>> headers, std::optional<double> segments, std::optional<double> minSegmentSize): url(url), destinationPath(destinationPath), headers(headers), segments(segments), minSegmentSize(minSegmentSize) {}
 
   public:
     friend bool operator==(const NitroDownloadOptions& lhs, const NitroDownloadOptions& rhs) = default;
@@ -65,7 +67,9 @@ namespace margelo::nitro {
       return margelo::nitro::nitrofs::NitroDownloadOptions(
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "url"))),
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "destinationPath"))),
-        JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "headers")))
+        JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "headers"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "segments"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "minSegmentSize")))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroDownloadOptions& arg) {
@@ -73,6 +77,8 @@ namespace margelo::nitro {
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "url"), JSIConverter<std::string>::toJSI(runtime, arg.url));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "destinationPath"), JSIConverter<std::string>::toJSI(runtime, arg.destinationPath));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "headers"), JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::toJSI(runtime, arg.headers));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "segments"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.segments));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "minSegmentSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.minSegmentSize));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -86,6 +92,8 @@ namespace margelo::nitro {
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "url")))) return false;
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "destinationPath")))) return false;
       if (!JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "headers")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "segments")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "minSegmentSize")))) return false;
       return true;
     }
   };
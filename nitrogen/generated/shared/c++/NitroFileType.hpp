@@ -0,0 +1,84 @@
+///
+/// NitroFileType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroFileType).
+   */
+  enum class NitroFileType {
+    FILE      SWIFT_NAME(file) = 0,
+    DIRECTORY      SWIFT_NAME(directory) = 1,
+    SYMLINK      SWIFT_NAME(symlink) = 2,
+    OTHER      SWIFT_NAME(other) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroFileType <> JS NitroFileType (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroFileType> final {
+    static inline margelo::nitro::nitrofs::NitroFileType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("file"): return margelo::nitro::nitrofs::NitroFileType::FILE;
+        case hashString("directory"): return margelo::nitro::nitrofs::NitroFileType::DIRECTORY;
+        case hashString("symlink"): return margelo::nitro::nitrofs::NitroFileType::SYMLINK;
+        case hashString("other"): return margelo::nitro::nitrofs::NitroFileType::OTHER;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroFileType - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroFileType arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroFileType::FILE: return JSIConverter<std::string>::toJSI(runtime, "file");
+        case margelo::nitro::nitrofs::NitroFileType::DIRECTORY: return JSIConverter<std::string>::toJSI(runtime, "directory");
+        case margelo::nitro::nitrofs::NitroFileType::SYMLINK: return JSIConverter<std::string>::toJSI(runtime, "symlink");
+        case margelo::nitro::nitrofs::NitroFileType::OTHER: return JSIConverter<std::string>::toJSI(runtime, "other");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroFileType to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("file"):
+        case hashString("directory"):
+        case hashString("symlink"):
+        case hashString("other"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,108 @@
+///
+/// NitroFileWriterOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFsyncMode` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFsyncMode; }
+// Forward declaration of `NitroCompressionFormat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroCompressionFormat; }
+
+#include <optional>
+#include "NitroFsyncMode.hpp"
+#include "NitroCompressionFormat.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroFileWriterOptions).
+   */
+  struct NitroFileWriterOptions final {
+  public:
+    std::optional<double> bufferSize     SWIFT_PRIVATE;
+    std::optional<double> flushInterval     SWIFT_PRIVATE;
+    std::optional<NitroFsyncMode> fsync     SWIFT_PRIVATE;
+    std::optional<NitroCompressionFormat> compress     SWIFT_PRIVATE;
+    std::optional<double> compressionLevel     SWIFT_PRIVATE;
+    std::optional<double> highWaterMark     SWIFT_PRIVATE;
+
+  public:
+    NitroFileWriterOptions() = default;
+    explicit NitroFileWriterOptions(std::optional<double> bufferSize, std::optional<double> flushInterval, std::optional<NitroFsyncMode> fsync, std::optional<NitroCompressionFormat> compress, std::optional<double> compressionLevel, std::optional<double> highWaterMark): bufferSize(bufferSize), flushInterval(flushInterval), fsync(fsync), compress(compress), compressionLevel(compressionLevel), highWaterMark(highWaterMark) {}
+
+  public:
+    friend bool operator==(const NitroFileWriterOptions& lhs, const NitroFileWriterOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroFileWriterOptions <> JS NitroFileWriterOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroFileWriterOptions> final {
+    static inline margelo::nitro::nitrofs::NitroFileWriterOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroFileWriterOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bufferSize"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "flushInterval"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fsync"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compress"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroFileWriterOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bufferSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.bufferSize));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "flushInterval"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.flushInterval));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fsync"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::toJSI(runtime, arg.fsync));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compress"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::toJSI(runtime, arg.compress));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.compressionLevel));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.highWaterMark));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bufferSize")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "flushInterval")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fsync")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compress")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
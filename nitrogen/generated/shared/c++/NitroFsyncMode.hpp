@@ -0,0 +1,80 @@
+///
+/// NitroFsyncMode.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroFsyncMode).
+   */
+  enum class NitroFsyncMode {
+    NONE      SWIFT_NAME(none) = 0,
+    DATA      SWIFT_NAME(data) = 1,
+    FULL      SWIFT_NAME(full) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroFsyncMode <> JS NitroFsyncMode (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroFsyncMode> final {
+    static inline margelo::nitro::nitrofs::NitroFsyncMode fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("none"): return margelo::nitro::nitrofs::NitroFsyncMode::NONE;
+        case hashString("data"): return margelo::nitro::nitrofs::NitroFsyncMode::DATA;
+        case hashString("full"): return margelo::nitro::nitrofs::NitroFsyncMode::FULL;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroFsyncMode - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroFsyncMode arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroFsyncMode::NONE: return JSIConverter<std::string>::toJSI(runtime, "none");
+        case margelo::nitro::nitrofs::NitroFsyncMode::DATA: return JSIConverter<std::string>::toJSI(runtime, "data");
+        case margelo::nitro::nitrofs::NitroFsyncMode::FULL: return JSIConverter<std::string>::toJSI(runtime, "full");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroFsyncMode to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("none"):
+        case hashString("data"):
+        case hashString("full"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
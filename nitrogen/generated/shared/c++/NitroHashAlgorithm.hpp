@@ -0,0 +1,84 @@
+///
+/// NitroHashAlgorithm.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroHashAlgorithm).
+   */
+  enum class NitroHashAlgorithm {
+    SHA256      SWIFT_NAME(sha256) = 0,
+    CRC32C      SWIFT_NAME(crc32c) = 1,
+    XXH3      SWIFT_NAME(xxh3) = 2,
+    BLAKE3      SWIFT_NAME(blake3) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroHashAlgorithm <> JS NitroHashAlgorithm (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroHashAlgorithm> final {
+    static inline margelo::nitro::nitrofs::NitroHashAlgorithm fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("sha256"): return margelo::nitro::nitrofs::NitroHashAlgorithm::SHA256;
+        case hashString("crc32c"): return margelo::nitro::nitrofs::NitroHashAlgorithm::CRC32C;
+        case hashString("xxh3"): return margelo::nitro::nitrofs::NitroHashAlgorithm::XXH3;
+        case hashString("blake3"): return margelo::nitro::nitrofs::NitroHashAlgorithm::BLAKE3;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroHashAlgorithm - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroHashAlgorithm arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroHashAlgorithm::SHA256: return JSIConverter<std::string>::toJSI(runtime, "sha256");
+        case margelo::nitro::nitrofs::NitroHashAlgorithm::CRC32C: return JSIConverter<std::string>::toJSI(runtime, "crc32c");
+        case margelo::nitro::nitrofs::NitroHashAlgorithm::XXH3: return JSIConverter<std::string>::toJSI(runtime, "xxh3");
+        case margelo::nitro::nitrofs::NitroHashAlgorithm::BLAKE3: return JSIConverter<std::string>::toJSI(runtime, "blake3");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroHashAlgorithm to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("sha256"):
+        case hashString("crc32c"):
+        case hashString("xxh3"):
+        case hashString("blake3"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,84 @@
+///
+/// NitroOpenMode.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroOpenMode).
+   */
+  enum class NitroOpenMode {
+    READ      SWIFT_NAME(read) = 0,
+    WRITE      SWIFT_NAME(write) = 1,
+    CREATE      SWIFT_NAME(create) = 2,
+    OVERWRITE      SWIFT_NAME(overwrite) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroOpenMode <> JS NitroOpenMode (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroOpenMode> final {
+    static inline margelo::nitro::nitrofs::NitroOpenMode fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("read"): return margelo::nitro::nitrofs::NitroOpenMode::READ;
+        case hashString("write"): return margelo::nitro::nitrofs::NitroOpenMode::WRITE;
+        case hashString("create"): return margelo::nitro::nitrofs::NitroOpenMode::CREATE;
+        case hashString("overwrite"): return margelo::nitro::nitrofs::NitroOpenMode::OVERWRITE;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroOpenMode - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroOpenMode arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroOpenMode::READ: return JSIConverter<std::string>::toJSI(runtime, "read");
+        case margelo::nitro::nitrofs::NitroOpenMode::WRITE: return JSIConverter<std::string>::toJSI(runtime, "write");
+        case margelo::nitro::nitrofs::NitroOpenMode::CREATE: return JSIConverter<std::string>::toJSI(runtime, "create");
+        case margelo::nitro::nitrofs::NitroOpenMode::OVERWRITE: return JSIConverter<std::string>::toJSI(runtime, "overwrite");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroOpenMode to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("read"):
+        case hashString("write"):
+        case hashString("create"):
+        case hashString("overwrite"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
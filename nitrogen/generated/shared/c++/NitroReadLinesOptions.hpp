@@ -0,0 +1,95 @@
+///
+/// NitroReadLinesOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroReadLinesOptions).
+   */
+  struct NitroReadLinesOptions final {
+  public:
+    std::optional<double> startLine     SWIFT_PRIVATE;
+    std::optional<double> maxLines     SWIFT_PRIVATE;
+    std::optional<double> batchSize     SWIFT_PRIVATE;
+    std::optional<bool> offsetsOnly     SWIFT_PRIVATE;
+
+  public:
+    NitroReadLinesOptions() = default;
+    explicit NitroReadLinesOptions(std::optional<double> startLine, std::optional<double> maxLines, std::optional<double> batchSize, std::optional<bool> offsetsOnly): startLine(startLine), maxLines(maxLines), batchSize(batchSize), offsetsOnly(offsetsOnly) {}
+
+  public:
+    friend bool operator==(const NitroReadLinesOptions& lhs, const NitroReadLinesOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroReadLinesOptions <> JS NitroReadLinesOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroReadLinesOptions> final {
+    static inline margelo::nitro::nitrofs::NitroReadLinesOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroReadLinesOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "startLine"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLines"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "batchSize"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "offsetsOnly")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroReadLinesOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "startLine"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.startLine));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxLines"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxLines));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "batchSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.batchSize));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "offsetsOnly"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.offsetsOnly));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "startLine")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLines")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "batchSize")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "offsetsOnly")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
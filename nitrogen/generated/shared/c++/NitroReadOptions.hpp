@@ -0,0 +1,85 @@
+///
+/// NitroReadOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroCompressionFormat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroCompressionFormat; }
+
+#include <optional>
+#include "NitroCompressionFormat.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroReadOptions).
+   */
+  struct NitroReadOptions final {
+  public:
+    std::optional<NitroCompressionFormat> decompress     SWIFT_PRIVATE;
+
+  public:
+    NitroReadOptions() = default;
+    explicit NitroReadOptions(std::optional<NitroCompressionFormat> decompress): decompress(decompress) {}
+
+  public:
+    friend bool operator==(const NitroReadOptions& lhs, const NitroReadOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroReadOptions <> JS NitroReadOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroReadOptions> final {
+    static inline margelo::nitro::nitrofs::NitroReadOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroReadOptions(
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "decompress")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroReadOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "decompress"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::toJSI(runtime, arg.decompress));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "decompress")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
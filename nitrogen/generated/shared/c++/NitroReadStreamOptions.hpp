@@ -0,0 +1,101 @@
+///
+/// NitroReadStreamOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFileEncoding` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFileEncoding; }
+
+#include <optional>
+#include "NitroFileEncoding.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroReadStreamOptions).
+   */
+  struct NitroReadStreamOptions final {
+  public:
+    std::optional<double> chunkSize     SWIFT_PRIVATE;
+    std::optional<double> start     SWIFT_PRIVATE;
+    std::optional<double> end     SWIFT_PRIVATE;
+    std::optional<NitroFileEncoding> encoding     SWIFT_PRIVATE;
+    std::optional<double> highWaterMark     SWIFT_PRIVATE;
+
+  public:
+    NitroReadStreamOptions() = default;
+    explicit NitroReadStreamOptions(std::optional<double> chunkSize, std::optional<double> start, std::optional<double> end, std::optional<NitroFileEncoding> encoding, std::optional<double> highWaterMark): chunkSize(chunkSize), start(start), end(end), encoding(encoding), highWaterMark(highWaterMark) {}
+
+  public:
+    friend bool operator==(const NitroReadStreamOptions& lhs, const NitroReadStreamOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroReadStreamOptions <> JS NitroReadStreamOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroReadStreamOptions> final {
+    static inline margelo::nitro::nitrofs::NitroReadStreamOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroReadStreamOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "chunkSize"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "start"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "end"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileEncoding>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "encoding"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroReadStreamOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "chunkSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.chunkSize));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "start"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.start));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "end"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.end));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "encoding"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileEncoding>>::toJSI(runtime, arg.encoding));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.highWaterMark));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "chunkSize")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "start")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "end")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileEncoding>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "encoding")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "highWaterMark")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,87 @@
+///
+/// NitroReaddirOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroReaddirOptions).
+   */
+  struct NitroReaddirOptions final {
+  public:
+    std::optional<bool> stats     SWIFT_PRIVATE;
+    std::optional<bool> mimeTypes     SWIFT_PRIVATE;
+
+  public:
+    NitroReaddirOptions() = default;
+    explicit NitroReaddirOptions(std::optional<bool> stats, std::optional<bool> mimeTypes): stats(stats), mimeTypes(mimeTypes) {}
+
+  public:
+    friend bool operator==(const NitroReaddirOptions& lhs, const NitroReaddirOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroReaddirOptions <> JS NitroReaddirOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroReaddirOptions> final {
+    static inline margelo::nitro::nitrofs::NitroReaddirOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroReaddirOptions(
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stats"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroReaddirOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "stats"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.stats));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.mimeTypes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stats")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
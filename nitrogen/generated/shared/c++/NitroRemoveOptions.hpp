@@ -0,0 +1,91 @@
+///
+/// NitroRemoveOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroRemoveOptions).
+   */
+  struct NitroRemoveOptions final {
+  public:
+    std::optional<bool> recursive     SWIFT_PRIVATE;
+    std::optional<double> parallelism     SWIFT_PRIVATE;
+    std::optional<bool> background     SWIFT_PRIVATE;
+
+  public:
+    NitroRemoveOptions() = default;
+    explicit NitroRemoveOptions(std::optional<bool> recursive, std::optional<double> parallelism, std::optional<bool> background): recursive(recursive), parallelism(parallelism), background(background) {}
+
+  public:
+    friend bool operator==(const NitroRemoveOptions& lhs, const NitroRemoveOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroRemoveOptions <> JS NitroRemoveOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroRemoveOptions> final {
+    static inline margelo::nitro::nitrofs::NitroRemoveOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroRemoveOptions(
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "recursive"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "parallelism"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "background")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroRemoveOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "recursive"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.recursive));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "parallelism"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.parallelism));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "background"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.background));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "recursive")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "parallelism")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "background")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,90 @@
+///
+/// NitroStatResult.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFileStat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroFileStat; }
+
+#include "NitroFileStat.hpp"
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroStatResult).
+   */
+  struct NitroStatResult final {
+  public:
+    std::optional<NitroFileStat> stat     SWIFT_PRIVATE;
+    std::optional<std::string> error     SWIFT_PRIVATE;
+
+  public:
+    NitroStatResult() = default;
+    explicit NitroStatResult(std::optional<NitroFileStat> stat, std::optional<std::string> error): stat(stat), error(error) {}
+
+  public:
+    friend bool operator==(const NitroStatResult& lhs, const NitroStatResult& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroStatResult <> JS NitroStatResult (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroStatResult> final {
+    static inline margelo::nitro::nitrofs::NitroStatResult fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroStatResult(
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileStat>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stat"))),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "error")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroStatResult& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "stat"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileStat>>::toJSI(runtime, arg.stat));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "error"), JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.error));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFileStat>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stat")))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "error")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,87 @@
+///
+/// NitroTransferOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroTransferOptions).
+   */
+  struct NitroTransferOptions final {
+  public:
+    std::optional<double> maxConnectionsPerHost     SWIFT_PRIVATE;
+    std::optional<double> maxConcurrentTransfers     SWIFT_PRIVATE;
+
+  public:
+    NitroTransferOptions() = default;
+    explicit NitroTransferOptions(std::optional<double> maxConnectionsPerHost, std::optional<double> maxConcurrentTransfers): maxConnectionsPerHost(maxConnectionsPerHost), maxConcurrentTransfers(maxConcurrentTransfers) {}
+
+  public:
+    friend bool operator==(const NitroTransferOptions& lhs, const NitroTransferOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroTransferOptions <> JS NitroTransferOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroTransferOptions> final {
+    static inline margelo::nitro::nitrofs::NitroTransferOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroTransferOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxConnectionsPerHost"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxConcurrentTransfers")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroTransferOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxConnectionsPerHost"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxConnectionsPerHost));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxConcurrentTransfers"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxConcurrentTransfers));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxConnectionsPerHost")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxConcurrentTransfers")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
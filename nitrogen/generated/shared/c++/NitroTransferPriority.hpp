@@ -0,0 +1,76 @@
+///
+/// NitroTransferPriority.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroTransferPriority).
+   */
+  enum class NitroTransferPriority {
+    USERVISIBLE      SWIFT_NAME(userVisible) = 0,
+    PREFETCH      SWIFT_NAME(prefetch) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroTransferPriority <> JS NitroTransferPriority (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroTransferPriority> final {
+    static inline margelo::nitro::nitrofs::NitroTransferPriority fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("userVisible"): return margelo::nitro::nitrofs::NitroTransferPriority::USERVISIBLE;
+        case hashString("prefetch"): return margelo::nitro::nitrofs::NitroTransferPriority::PREFETCH;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroTransferPriority - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroTransferPriority arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroTransferPriority::USERVISIBLE: return JSIConverter<std::string>::toJSI(runtime, "userVisible");
+        case margelo::nitro::nitrofs::NitroTransferPriority::PREFETCH: return JSIConverter<std::string>::toJSI(runtime, "prefetch");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroTransferPriority to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("userVisible"):
+        case hashString("prefetch"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
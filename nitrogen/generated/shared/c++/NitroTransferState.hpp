@@ -0,0 +1,92 @@
+///
+/// NitroTransferState.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroTransferState).
+   */
+  enum class NitroTransferState {
+    QUEUED      SWIFT_NAME(queued) = 0,
+    RUNNING      SWIFT_NAME(running) = 1,
+    PAUSED      SWIFT_NAME(paused) = 2,
+    COMPLETED      SWIFT_NAME(completed) = 3,
+    FAILED      SWIFT_NAME(failed) = 4,
+    CANCELLED      SWIFT_NAME(cancelled) = 5,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroTransferState <> JS NitroTransferState (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroTransferState> final {
+    static inline margelo::nitro::nitrofs::NitroTransferState fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("queued"): return margelo::nitro::nitrofs::NitroTransferState::QUEUED;
+        case hashString("running"): return margelo::nitro::nitrofs::NitroTransferState::RUNNING;
+        case hashString("paused"): return margelo::nitro::nitrofs::NitroTransferState::PAUSED;
+        case hashString("completed"): return margelo::nitro::nitrofs::NitroTransferState::COMPLETED;
+        case hashString("failed"): return margelo::nitro::nitrofs::NitroTransferState::FAILED;
+        case hashString("cancelled"): return margelo::nitro::nitrofs::NitroTransferState::CANCELLED;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroTransferState - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroTransferState arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroTransferState::QUEUED: return JSIConverter<std::string>::toJSI(runtime, "queued");
+        case margelo::nitro::nitrofs::NitroTransferState::RUNNING: return JSIConverter<std::string>::toJSI(runtime, "running");
+        case margelo::nitro::nitrofs::NitroTransferState::PAUSED: return JSIConverter<std::string>::toJSI(runtime, "paused");
+        case margelo::nitro::nitrofs::NitroTransferState::COMPLETED: return JSIConverter<std::string>::toJSI(runtime, "completed");
+        case margelo::nitro::nitrofs::NitroTransferState::FAILED: return JSIConverter<std::string>::toJSI(runtime, "failed");
+        case margelo::nitro::nitrofs::NitroTransferState::CANCELLED: return JSIConverter<std::string>::toJSI(runtime, "cancelled");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroTransferState to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("queued"):
+        case hashString("running"):
+        case hashString("paused"):
+        case hashString("completed"):
+        case hashString("failed"):
+        case hashString("cancelled"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
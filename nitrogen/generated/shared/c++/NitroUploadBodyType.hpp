@@ -0,0 +1,76 @@
+///
+/// NitroUploadBodyType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * An enum which can be represented as a JavaScript union (NitroUploadBodyType).
+   */
+  enum class NitroUploadBodyType {
+    MULTIPART      SWIFT_NAME(multipart) = 0,
+    RAW      SWIFT_NAME(raw) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroUploadBodyType <> JS NitroUploadBodyType (union)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroUploadBodyType> final {
+    static inline margelo::nitro::nitrofs::NitroUploadBodyType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("multipart"): return margelo::nitro::nitrofs::NitroUploadBodyType::MULTIPART;
+        case hashString("raw"): return margelo::nitro::nitrofs::NitroUploadBodyType::RAW;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum NitroUploadBodyType - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::nitrofs::NitroUploadBodyType arg) {
+      switch (arg) {
+        case margelo::nitro::nitrofs::NitroUploadBodyType::MULTIPART: return JSIConverter<std::string>::toJSI(runtime, "multipart");
+        case margelo::nitro::nitrofs::NitroUploadBodyType::RAW: return JSIConverter<std::string>::toJSI(runtime, "raw");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert NitroUploadBodyType to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("multipart"):
+        case hashString("raw"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
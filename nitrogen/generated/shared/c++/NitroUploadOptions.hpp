@@ -30,10 +30,13 @@
 
 // Forward declaration of `NitroUploadMethod` to properly resolve imports.
 namespace margelo::nitro::nitrofs { enum class NitroUploadMethod; }
+// Forward declaration of `NitroUploadBodyType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroUploadBodyType; }
 
 #include <string>
 #include "NitroUploadMethod.hpp"
 #include <optional>
+#include "NitroUploadBodyType.hpp"
 #include <unordered_map>
 
 namespace margelo::nitro::nitrofs {
@@ -46,12 +49,13 @@ namespace margelo::nitro::nitrofs {
     std::string filePath     SWIFT_PRIVATE;
     std::string url     SWIFT_PRIVATE;
     std::optional<NitroUploadMethod> method     SWIFT_PRIVATE;
+    std::optional<NitroUploadBodyType> bodyType     SWIFT_PRIVATE;
     std::optional<std::string> field     SWIFT_PRIVATE;
     std::optional<std::unordered_map<std::string, std::string>> headers     SWIFT_PRIVATE;
 
   public:
     NitroUploadOptions() = default;
-    explicit NitroUploadOptions(std::string filePath, std::string url, std::optional<NitroUploadMethod> method, std::optional<std::string> field, std::optional<std::unordered_map<std::string, std::string>> headers): filePath(filePath), url(url), method(method), field(field), headers(headers) {}
+    explicit NitroUploadOptions(std::string filePath, std::string url, std::optional<NitroUploadMethod> method, std::optional<NitroUploadBodyType> bodyType, std::optional<std::string> field, std::optional<std::unordered_map<std::string, std::string>> headers): filePath(filePath), url(url), method(method), bodyType(bodyType), field(field), headers(headers) {}
 
   public:
     friend bool operator==(const NitroUploadOptions& lhs, const NitroUploadOptions& rhs) = default;
@@ -70,6 +74,7 @@ namespace margelo::nitro {
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "filePath"))),
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "url"))),
         JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadMethod>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "method"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadBodyType>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bodyType"))),
         JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "field"))),
         JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "headers")))
       );
@@ -79,6 +84,7 @@ namespace margelo::nitro {
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "filePath"), JSIConverter<std::string>::toJSI(runtime, arg.filePath));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "url"), JSIConverter<std::string>::toJSI(runtime, arg.url));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "method"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadMethod>>::toJSI(runtime, arg.method));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bodyType"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadBodyType>>::toJSI(runtime, arg.bodyType));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "field"), JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.field));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "headers"), JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::toJSI(runtime, arg.headers));
       return obj;
@@ -94,6 +100,7 @@ namespace margelo::nitro {
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "filePath")))) return false;
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "url")))) return false;
       if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadMethod>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "method")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroUploadBodyType>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bodyType")))) return false;
       if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "field")))) return false;
       if (!JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "headers")))) return false;
       return true;
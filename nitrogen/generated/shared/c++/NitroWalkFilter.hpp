@@ -0,0 +1,95 @@
+///
+/// NitroWalkFilter.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFileType` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFileType; }
+
+#include "NitroFileType.hpp"
+#include <vector>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroWalkFilter).
+   */
+  struct NitroWalkFilter final {
+  public:
+    std::optional<std::vector<NitroFileType>> types     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> extensions     SWIFT_PRIVATE;
+    std::optional<bool> includeHidden     SWIFT_PRIVATE;
+
+  public:
+    NitroWalkFilter() = default;
+    explicit NitroWalkFilter(std::optional<std::vector<NitroFileType>> types, std::optional<std::vector<std::string>> extensions, std::optional<bool> includeHidden): types(types), extensions(extensions), includeHidden(includeHidden) {}
+
+  public:
+    friend bool operator==(const NitroWalkFilter& lhs, const NitroWalkFilter& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroWalkFilter <> JS NitroWalkFilter (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroWalkFilter> final {
+    static inline margelo::nitro::nitrofs::NitroWalkFilter fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroWalkFilter(
+        JSIConverter<std::optional<std::vector<margelo::nitro::nitrofs::NitroFileType>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "types"))),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "extensions"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "includeHidden")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroWalkFilter& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "types"), JSIConverter<std::optional<std::vector<margelo::nitro::nitrofs::NitroFileType>>>::toJSI(runtime, arg.types));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "extensions"), JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.extensions));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "includeHidden"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.includeHidden));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<std::vector<margelo::nitro::nitrofs::NitroFileType>>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "types")))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "extensions")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "includeHidden")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
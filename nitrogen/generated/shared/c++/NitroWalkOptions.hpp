@@ -0,0 +1,105 @@
+///
+/// NitroWalkOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroWalkFilter` to properly resolve imports.
+namespace margelo::nitro::nitrofs { struct NitroWalkFilter; }
+
+#include <optional>
+#include "NitroWalkFilter.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroWalkOptions).
+   */
+  struct NitroWalkOptions final {
+  public:
+    std::optional<double> maxDepth     SWIFT_PRIVATE;
+    std::optional<bool> followSymlinks     SWIFT_PRIVATE;
+    std::optional<NitroWalkFilter> filter     SWIFT_PRIVATE;
+    std::optional<bool> stats     SWIFT_PRIVATE;
+    std::optional<bool> mimeTypes     SWIFT_PRIVATE;
+    std::optional<double> batchSize     SWIFT_PRIVATE;
+
+  public:
+    NitroWalkOptions() = default;
+    explicit NitroWalkOptions(std::optional<double> maxDepth, std::optional<bool> followSymlinks, std::optional<NitroWalkFilter> filter, std::optional<bool> stats, std::optional<bool> mimeTypes, std::optional<double> batchSize): maxDepth(maxDepth), followSymlinks(followSymlinks), filter(filter), stats(stats), mimeTypes(mimeTypes), batchSize(batchSize) {}
+
+  public:
+    friend bool operator==(const NitroWalkOptions& lhs, const NitroWalkOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroWalkOptions <> JS NitroWalkOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroWalkOptions> final {
+    static inline margelo::nitro::nitrofs::NitroWalkOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroWalkOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDepth"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "followSymlinks"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroWalkFilter>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "filter"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stats"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "batchSize")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroWalkOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxDepth"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxDepth));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "followSymlinks"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.followSymlinks));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "filter"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroWalkFilter>>::toJSI(runtime, arg.filter));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "stats"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.stats));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.mimeTypes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "batchSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.batchSize));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDepth")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "followSymlinks")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroWalkFilter>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "filter")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "stats")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mimeTypes")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "batchSize")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,104 @@
+///
+/// NitroWriteOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroFsyncMode` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroFsyncMode; }
+// Forward declaration of `NitroCompressionFormat` to properly resolve imports.
+namespace margelo::nitro::nitrofs { enum class NitroCompressionFormat; }
+
+#include <optional>
+#include "NitroFsyncMode.hpp"
+#include "NitroCompressionFormat.hpp"
+
+namespace margelo::nitro::nitrofs {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroWriteOptions).
+   */
+  struct NitroWriteOptions final {
+  public:
+    std::optional<bool> atomic     SWIFT_PRIVATE;
+    std::optional<NitroFsyncMode> fsync     SWIFT_PRIVATE;
+    std::optional<bool> preallocate     SWIFT_PRIVATE;
+    std::optional<NitroCompressionFormat> compress     SWIFT_PRIVATE;
+    std::optional<double> compressionLevel     SWIFT_PRIVATE;
+
+  public:
+    NitroWriteOptions() = default;
+    explicit NitroWriteOptions(std::optional<bool> atomic, std::optional<NitroFsyncMode> fsync, std::optional<bool> preallocate, std::optional<NitroCompressionFormat> compress, std::optional<double> compressionLevel): atomic(atomic), fsync(fsync), preallocate(preallocate), compress(compress), compressionLevel(compressionLevel) {}
+
+  public:
+    friend bool operator==(const NitroWriteOptions& lhs, const NitroWriteOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofs
+
+namespace margelo::nitro {
+
+  // C++ NitroWriteOptions <> JS NitroWriteOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofs::NitroWriteOptions> final {
+    static inline margelo::nitro::nitrofs::NitroWriteOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofs::NitroWriteOptions(
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "atomic"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fsync"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "preallocate"))),
+        JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compress"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofs::NitroWriteOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "atomic"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.atomic));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fsync"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::toJSI(runtime, arg.fsync));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "preallocate"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.preallocate));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compress"), JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::toJSI(runtime, arg.compress));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.compressionLevel));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "atomic")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroFsyncMode>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fsync")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "preallocate")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::nitrofs::NitroCompressionFormat>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compress")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionLevel")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
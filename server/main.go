@@ -1,17 +1,27 @@
 package main
 
 import (
+	"flag"
 	"fmt"
 	"io"
 	"mime"
 	"net/http"
 	"os"
 	"path/filepath"
+	"strconv"
 	"strings"
 	"time"
 )
 
+// Network conditions for download benchmarks, overridable per request with ?latency= and ?rate=
+var (
+	defaultLatency = flag.Duration("latency", 0, "delay before answering each download request, e.g. 150ms")
+	defaultRate    = flag.Int64("rate", 0, "bytes per second each download connection is capped at, 0 for unlimited")
+)
+
 func main() {
+	flag.Parse()
+
 	// Create uploads directory if it doesn't exist
 	os.MkdirAll("./uploads", os.ModePerm)
 
@@ -29,7 +39,7 @@ func main() {
 }
 
 func downloadHandler(w http.ResponseWriter, r *http.Request) {
-	if r.Method != http.MethodGet {
+	if r.Method != http.MethodGet && r.Method != http.MethodHead {
 		http.Error(w, "Method not allowed", http.StatusMethodNotAllowed)
 		return
 	}
@@ -45,24 +55,24 @@ func downloadHandler(w http.ResponseWriter, r *http.Request) {
 	filename = filepath.Base(filename)
 	filePath := filepath.Join("./uploads", filename)
 
-	// Check if file exists
-	_, err := os.Stat(filePath)
+	// Open the file
+	file, err := os.Open(filePath)
 	if err != nil {
 		if os.IsNotExist(err) {
 			http.Error(w, "File not found", http.StatusNotFound)
 		} else {
-			http.Error(w, "Failed to access file", http.StatusInternalServerError)
+			http.Error(w, "Failed to open file", http.StatusInternalServerError)
 		}
 		return
 	}
+	defer file.Close()
 
-	// Open the file
-	file, err := os.Open(filePath)
+	// Get file info
+	fileInfo, err := file.Stat()
 	if err != nil {
-		http.Error(w, "Failed to open file", http.StatusInternalServerError)
+		http.Error(w, "Failed to get file info", http.StatusInternalServerError)
 		return
 	}
-	defer file.Close()
 
 	// Set content type
 	contentType := mime.TypeByExtension(filepath.Ext(filename))
@@ -70,23 +80,68 @@ func downloadHandler(w http.ResponseWriter, r *http.Request) {
 		contentType = "application/octet-stream"
 	}
 
-	// Get file info
-	fileInfo, err := file.Stat()
-	if err != nil {
-		http.Error(w, "Failed to get file info", http.StatusInternalServerError)
-		return
-	}
-
-	// Set headers
+	// Set headers. The strong ETag lets clients resume with If-Range; it changes whenever the file does.
 	w.Header().Set("Content-Type", contentType)
-	w.Header().Set("Content-Length", fmt.Sprintf("%d", fileInfo.Size()))
 	w.Header().Set("Content-Disposition", fmt.Sprintf(`attachment; filename="%s"`, filename))
+	w.Header().Set("ETag", fmt.Sprintf(`"%x-%x"`, fileInfo.ModTime().UnixNano(), fileInfo.Size()))
+
+	// Simulated network conditions:
+	//   ?failAfter=N drops the connection after N body bytes, to exercise resumable downloads
+	//   ?latency=D waits D (e.g. 150ms) before answering, like a distant server
+	//   ?rate=N caps this connection at N bytes per second, like a long fat pipe that one TCP stream can't fill
+	query := r.URL.Query()
+	content := &shapedReader{file: file, failAfter: -1, rate: *defaultRate}
+	if failAfter, err := strconv.ParseInt(query.Get("failAfter"), 10, 64); err == nil && failAfter >= 0 {
+		content.failAfter = failAfter
+	}
+	if rate, err := strconv.ParseInt(query.Get("rate"), 10, 64); err == nil && rate >= 0 {
+		content.rate = rate
+	}
+	latency := *defaultLatency
+	if d, err := time.ParseDuration(query.Get("latency")); err == nil {
+		latency = d
+	}
+	time.Sleep(latency)
 
-	// Send the file
-	_, err = io.Copy(w, file)
-	if err != nil {
-		fmt.Printf("Error sending file: %v\n", err)
+	// Send the file. ServeContent handles Range, If-Range, If-None-Match and Last-Modified.
+	http.ServeContent(w, r, filename, fileInfo.ModTime(), content)
+}
+
+// shapedReader paces the body at `rate` bytes per second and aborts the response after `failAfter` bytes.
+type shapedReader struct {
+	file      *os.File
+	failAfter int64 // -1 for never
+	rate      int64 // 0 for unlimited
+	sent      int64
+	start     time.Time
+}
+
+func (s *shapedReader) Read(p []byte) (int, error) {
+	if s.failAfter >= 0 {
+		if s.sent >= s.failAfter {
+			panic(http.ErrAbortHandler)
+		}
+		if int64(len(p)) > s.failAfter-s.sent {
+			p = p[:s.failAfter-s.sent]
+		}
+	}
+	if s.rate > 0 {
+		if s.start.IsZero() {
+			s.start = time.Now()
+		}
+		// Reads of at most 50ms worth of data keep the pace even
+		if limit := s.rate/20 + 1; int64(len(p)) > limit {
+			p = p[:limit]
+		}
+		time.Sleep(time.Until(s.start.Add(time.Duration(float64(s.sent) / float64(s.rate) * float64(time.Second)))))
 	}
+	n, err := s.file.Read(p)
+	s.sent += int64(n)
+	return n, err
+}
+
+func (s *shapedReader) Seek(offset int64, whence int) (int64, error) {
+	return s.file.Seek(offset, whence)
 }
 
 func uploadHandler(w http.ResponseWriter, r *http.Request) {
@@ -1,8 +1,24 @@
 import { NitroModules } from 'react-native-nitro-modules'
 import type { NitroFS as NitroFSSpec } from './specs/nitro-fs.nitro'
+import type { NitroDirEntry, NitroFile, NitroReaddirOptions } from './type'
 export * from './type'
+export * from './stream'
+export type { NitroFileHandle } from './specs/nitro-file-handle.nitro'
+export type { NitroFileWriter } from './specs/nitro-file-writer.nitro'
+export type { NitroMappedFile } from './specs/nitro-mapped-file.nitro'
+export type { NitroReadStream } from './specs/nitro-read-stream.nitro'
+export type { NitroTransfer } from './specs/nitro-transfer.nitro'
+
+/**
+ * The `NitroFS` spec, with `readdir` typed per call: unless `mimeTypes` is turned off, every entry has a
+ * `mimeType`, so those calls still return `NitroFile`s as they did before `NitroDirEntry`
+ */
+export interface NitroFSModule extends Omit<NitroFSSpec, 'readdir'> {
+    readdir(path: string, options?: NitroReaddirOptions & { mimeTypes?: true }): Promise<(NitroDirEntry & NitroFile)[]>
+    readdir(path: string, options: NitroReaddirOptions): Promise<NitroDirEntry[]>
+}
 
 const NitroFS =
-    NitroModules.createHybridObject<NitroFSSpec>('NitroFS')
+    NitroModules.createHybridObject<NitroFSSpec>('NitroFS') as NitroFSModule
 
 export default NitroFS
\ No newline at end of file
@@ -0,0 +1,37 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+
+/**
+ * An open file, returned by `NitroFS.open(...)`.
+ * Reads and writes take an explicit offset, so they can run concurrently.
+ */
+export interface NitroFileHandle extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    /**
+     * The path the file was opened with
+     */
+    readonly path: string
+
+    /**
+     * Read up to `length` bytes at `offset`. Fewer bytes are returned only at the end of the file
+     */
+    read(offset: number, length: number): Promise<ArrayBuffer>
+    /**
+     * Write all of `data` at `offset`, growing the file if needed
+     */
+    write(offset: number, data: ArrayBuffer): Promise<void>
+    /**
+     * Get the current size of the file in bytes
+     */
+    size(): Promise<number>
+    /**
+     * Shrink or extend the file to `length` bytes
+     */
+    truncate(length: number): Promise<void>
+    /**
+     * Flush written data to storage
+     */
+    sync(): Promise<void>
+    /**
+     * Close the file. Waits for pending reads and writes; later calls fail
+     */
+    close(): Promise<void>
+}
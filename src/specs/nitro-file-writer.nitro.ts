@@ -0,0 +1,31 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+
+/**
+ * A buffered, append-only writer, returned by `NitroFS.createFileWriter(...)`.
+ * Writes are collected in native memory and written out by a background thread.
+ */
+export interface NitroFileWriter extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    /**
+     * The path the writer appends to
+     */
+    readonly path: string
+
+    /**
+     * Append UTF-8 text. Only copies into the buffer, so it returns right away, unless `highWaterMark`
+     * bytes are still waiting to be written; then it blocks until the disk catches up.
+     * Throws if the writer was closed, or if an earlier background write failed
+     */
+    write(data: string): void
+    /**
+     * Append the raw bytes of an ArrayBuffer. The bytes are copied, so the buffer can be reused right away
+     */
+    writeBuffer(data: ArrayBuffer): void
+    /**
+     * Resolve once everything written so far is on disk and synced. Concurrent flushes share one sync
+     */
+    flush(): Promise<void>
+    /**
+     * Flush and close the file. Later writes throw
+     */
+    close(): Promise<void>
+}
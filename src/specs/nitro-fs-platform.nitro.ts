@@ -0,0 +1,46 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+import type {
+    NitroDownloadOptions,
+    NitroFile,
+    NitroFileEncoding,
+    NitroFileStat,
+    NitroUploadOptions,
+} from '../type'
+
+/**
+ * The Swift/Kotlin layer behind `NitroFS`.
+ *
+ * `NitroFS` is implemented in C++ and handles local paths itself.
+ * It only calls into this object for the well-known directories,
+ * for paths it cannot open with POSIX (e.g. Android `content://` URIs)
+ * and for networking.
+ */
+export interface NitroFSPlatform extends HybridObject<{ ios: 'swift', android: 'kotlin' }> {
+    readonly BUNDLE_DIR: string
+    readonly DOCUMENT_DIR: string
+    readonly CACHE_DIR: string
+    readonly DOWNLOAD_DIR: string
+    readonly DCIM_DIR: string
+    readonly PICTURES_DIR: string
+    readonly MOVIES_DIR: string
+    readonly MUSIC_DIR: string
+
+    exists(path: string): Promise<boolean>
+    writeFile(path: string, data: string, encoding: NitroFileEncoding): Promise<void>
+    readFile(path: string, encoding: NitroFileEncoding): Promise<string>
+    copyFile(srcPath: string, destPath: string): Promise<void>
+    copy(srcPath: string, destPath: string): Promise<void>
+    unlink(path: string): Promise<boolean>
+    mkdir(path: string): Promise<boolean>
+    stat(path: string): Promise<NitroFileStat>
+    readdir(path: string): Promise<NitroFile[]>
+    rename(oldPath: string, newPath: string): Promise<void>
+    dirname(path: string): string
+    basename(path: string): string
+    extname(path: string): string
+
+    uploadFile(transferId: number, uploadOptions: NitroUploadOptions, onProgress?: (uploadedBytes: number, totalBytes: number) => void): Promise<void>
+    downloadFile(transferId: number, downloadOptions: NitroDownloadOptions, onProgress?: (downloadedBytes: number, totalBytes: number) => void): Promise<NitroFile>
+    cancelTransfer(transferId: number): void
+    setMaxConnectionsPerHost(maxConnections: number): void
+}
@@ -1,14 +1,43 @@
 
 import type { HybridObject } from 'react-native-nitro-modules'
 import type {
+    NitroCompressOptions,
+    NitroCompressionFormat,
+    NitroCopyOptions,
+    NitroDirEntry,
+    NitroDiskUsage,
+    NitroDiskUsageOptions,
     NitroDownloadOptions,
     NitroFile,
     NitroFileEncoding,
     NitroFileStat,
+    NitroFileWriterOptions,
+    NitroHashAlgorithm,
+    NitroHashOptions,
+    NitroLineBatch,
+    NitroMapOptions,
+    NitroOpenMode,
+    NitroReadLinesOptions,
+    NitroReadOptions,
+    NitroReadStreamOptions,
+    NitroReaddirOptions,
+    NitroRemoveOptions,
+    NitroStatResult,
+    NitroTransferOptions,
+    NitroTransferPriority,
+    NitroUnzipOptions,
     NitroUploadOptions,
+    NitroWalkOptions,
+    NitroWriteOptions,
+    NitroZipOptions,
 } from '../type'
+import type { NitroFileHandle } from './nitro-file-handle.nitro'
+import type { NitroFileWriter } from './nitro-file-writer.nitro'
+import type { NitroMappedFile } from './nitro-mapped-file.nitro'
+import type { NitroReadStream } from './nitro-read-stream.nitro'
+import type { NitroTransfer } from './nitro-transfer.nitro'
 
-export interface NitroFS extends HybridObject<{ ios: 'swift', android: 'kotlin' }> {
+export interface NitroFS extends HybridObject<{ ios: 'c++', android: 'c++' }> {
     /**
      * The directory for storing bundle files
      * @platform ios
@@ -62,25 +91,119 @@ export interface NitroFS extends HybridObject<{ ios: 'swift', android: 'kotlin'
      */
     exists(path: string): Promise<boolean>
     /**
-     * Write a file to the file system
+     * Check which of many paths exist, in a single native call. The result has one entry per path, in order
      */
-    writeFile(path: string, data: string, encoding: NitroFileEncoding): Promise<void>
+    existsMany(paths: string[]): Promise<boolean[]>
+    /**
+     * Write a file to the file system. See `NitroWriteOptions` for atomic and durable writes
+     */
+    writeFile(path: string, data: string, encoding: NitroFileEncoding, options?: NitroWriteOptions): Promise<void>
     /**
      * Read a file from the file system
      */
-    readFile(path: string, encoding: NitroFileEncoding): Promise<string>
+    readFile(path: string, encoding: NitroFileEncoding, options?: NitroReadOptions): Promise<string>
+    /**
+     * Read a file into an ArrayBuffer, as raw bytes without any text or base64 decoding
+     */
+    readFileBuffer(path: string, options?: NitroReadOptions): Promise<ArrayBuffer>
+    /**
+     * Write the raw bytes of an ArrayBuffer to a file, replacing its contents
+     */
+    writeFileBuffer(path: string, data: ArrayBuffer, options?: NitroWriteOptions): Promise<void>
+    /**
+     * Append data to a file, creating it if needed. For many small appends, use `createFileWriter`
+     */
+    appendFile(path: string, data: string, encoding: NitroFileEncoding): Promise<void>
+    /**
+     * Memory-map a file, or a range of it. Pages are loaded on demand when the buffer is accessed
+     */
+    mapFile(path: string, options?: NitroMapOptions): Promise<NitroMappedFile>
+    /**
+     * Open a file for reading and writing at arbitrary offsets, without loading or rewriting the whole file
+     */
+    open(path: string, mode: NitroOpenMode): Promise<NitroFileHandle>
+    /**
+     * Open a buffered writer that appends to `path`, creating it if needed
+     */
+    createFileWriter(path: string, options?: NitroFileWriterOptions): Promise<NitroFileWriter>
+    /**
+     * Read a file, or a range of it, chunk by chunk with constant memory
+     */
+    createReadStream(path: string, options?: NitroReadStreamOptions): Promise<NitroReadStream>
+    /**
+     * Read the lines of a text file in batches, starting at any line. Resolves with the number of lines read
+     */
+    readLines(path: string, onLines: (batch: NitroLineBatch) => void, options?: NitroReadLinesOptions): Promise<number>
+    /**
+     * Index the lines of a text file, so `readLines` can jump to any line. Resolves with the number of lines
+     */
+    indexLines(path: string): Promise<number>
+    /**
+     * Hash a file, or a range of it, natively with constant memory. Resolves with the digest as lowercase hex;
+     * integer checksums are big-endian
+     */
+    hashFile(path: string, algorithm: NitroHashAlgorithm, options?: NitroHashOptions): Promise<string>
+    /**
+     * Compress a file natively in fixed-size chunks, with constant memory. Resolves with the compressed size
+     */
+    compressFile(srcPath: string, destPath: string, format: NitroCompressionFormat, options?: NitroCompressOptions): Promise<number>
+    /**
+     * Decompress a file natively in fixed-size chunks. The format is detected from the file if not given.
+     * Resolves with the decompressed size
+     */
+    decompressFile(srcPath: string, destPath: string, format?: NitroCompressionFormat): Promise<number>
+    /**
+     * Whether this build supports a compression format. gzip and deflate always are; zstd needs libzstd
+     */
+    isCompressionAvailable(format: NitroCompressionFormat): boolean
     /**
      * Copy a file to the file system
      */
     copyFile(srcPath: string, destPath: string): Promise<void>
     /**
-     * Copy a file or directory to the file system
+     * Copy a file or directory to the file system. Directories are copied with several threads;
+     * `onProgress` is called at most every 100ms, and once when done
+     */
+    copy(
+        srcPath: string,
+        destPath: string,
+        options?: NitroCopyOptions,
+        onProgress?: (copiedBytes: number, totalBytes: number, copiedFiles: number, totalFiles: number) => void
+    ): Promise<void>
+    /**
+     * Extract a zip archive into a directory, overwriting existing files. The central directory is read once,
+     * then the entries are inflated on several threads straight into their files. Entries that would end up outside
+     * `destDir`, encrypted entries and compression methods other than stored and deflate are rejected before anything
+     * is written. Resolves with the number of files and symlinks extracted.
+     * `onProgress` is called at most every 100ms, and once when done
      */
-    copy(srcPath: string, destPath: string): Promise<void>
+    unzip(
+        archivePath: string,
+        destDir: string,
+        options?: NitroUnzipOptions,
+        onProgress?: (extractedBytes: number, totalBytes: number, extractedEntries: number, totalEntries: number) => void
+    ): Promise<number>
+    /**
+     * Create a zip archive from a file or directory. Files are deflated in 1MB chunks on several threads and written
+     * out in order. Resolves with the size of the archive.
+     * `onProgress` is called at most every 100ms, and once when done
+     */
+    zip(
+        srcPath: string,
+        archivePath: string,
+        options?: NitroZipOptions,
+        onProgress?: (zippedBytes: number, totalBytes: number, zippedEntries: number, totalEntries: number) => void
+    ): Promise<number>
     /**
      * Delete a file or directory from the file system
      */
     unlink(path: string): Promise<boolean>
+    /**
+     * Delete a file or directory. With `recursive`, directory trees are removed by several threads.
+     * Resolves with the number of entries removed, or 0 if nothing existed at `path`.
+     * `onProgress` is called at most every 100ms, and once when done
+     */
+    rm(path: string, options?: NitroRemoveOptions, onProgress?: (removedEntries: number) => void): Promise<number>
     /**
      * Create a directory in the file system
      */
@@ -90,9 +213,26 @@ export interface NitroFS extends HybridObject<{ ios: 'swift', android: 'kotlin'
      */
     stat(path: string): Promise<NitroFileStat>
     /**
-     * List contents of a directory
+     * Get the stat of many files or directories in a single native call. The result has one entry per path, in order,
+     * and a path that fails only sets `error` on its own entry instead of rejecting the whole batch
+     */
+    statMany(paths: string[]): Promise<NitroStatResult[]>
+    /**
+     * List contents of a directory. Every entry's type comes from the same native pass,
+     * and `options.stats` adds size and mtime without a separate `stat` per entry
+     */
+    readdir(path: string, options?: NitroReaddirOptions): Promise<NitroDirEntry[]>
+    /**
+     * Recursively list a directory tree on several threads, one directory at a time per thread.
+     * Entries are passed to `onEntries` in batches while the walk goes on, in no particular order.
+     * Resolves with the number of entries reported, after the last batch
+     */
+    walk(root: string, onEntries: (entries: NitroDirEntry[]) => void, options?: NitroWalkOptions): Promise<number>
+    /**
+     * Compute the total size and file count of a directory tree natively, on several threads.
+     * Symlinks are not followed
      */
-    readdir(path: string): Promise<NitroFile[]>
+    du(path: string, options?: NitroDiskUsageOptions): Promise<NitroDiskUsage>
     /**
      * Rename or move a file or directory
      */
@@ -155,4 +295,31 @@ export interface NitroFS extends HybridObject<{ ios: 'swift', android: 'kotlin'
      * ```
      */
     downloadFile(downloadOptions: NitroDownloadOptions, onProgress?: (downloadedBytes: number, totalBytes: number) => void): Promise<NitroFile>
+    /**
+     * Queue a download and return a handle to pause, resume, cancel or reprioritize it. `downloadFile` goes
+     * through the same queue, as a `userVisible` transfer
+     * ```typescript
+     * const transfer = NitroFS.enqueueDownload(options, 'prefetch')
+     * transfer.setPriority('userVisible') // the user opened it
+     * const file = await transfer.result()
+     * ```
+     */
+    enqueueDownload(downloadOptions: NitroDownloadOptions, priority?: NitroTransferPriority, onProgress?: (downloadedBytes: number, totalBytes: number) => void): NitroTransfer
+    /**
+     * Queue an upload and return a handle to pause, resume, cancel or reprioritize it. `uploadFile` goes
+     * through the same queue, as a `userVisible` transfer
+     * ```typescript
+     * const transfer = NitroFS.enqueueUpload(options)
+     * transfer.cancel()
+     * ```
+     */
+    enqueueUpload(uploadOptions: NitroUploadOptions, priority?: NitroTransferPriority, onProgress?: (uploadedBytes: number, totalBytes: number) => void): NitroTransfer
+    /**
+     * Configure the HTTP client shared by every upload and download. It keeps connections alive and reuses
+     * them (over HTTP/2 where the server supports it); transfers already running keep their connections
+     * ```typescript
+     * NitroFS.configureTransfers({ maxConnectionsPerHost: 8, maxConcurrentTransfers: 4 })
+     * ```
+     */
+    configureTransfers(options: NitroTransferOptions): void
 }
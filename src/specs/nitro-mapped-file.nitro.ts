@@ -0,0 +1,25 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+
+/**
+ * A memory-mapped file, returned by `NitroFS.mapFile(...)`.
+ * The mapping is released once both this object and `buffer` are garbage collected.
+ */
+export interface NitroMappedFile extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    /**
+     * The mapped bytes
+     */
+    readonly buffer: ArrayBuffer
+    /**
+     * The offset in the file of the first byte of `buffer`
+     */
+    readonly offset: number
+    /**
+     * Whether writes to `buffer` stay in memory instead of reaching the file
+     */
+    readonly readOnly: boolean
+
+    /**
+     * Flush changes made through `buffer` to the file. Does nothing for read-only mappings
+     */
+    sync(): Promise<void>
+}
@@ -0,0 +1,26 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+
+/**
+ * A file being read chunk by chunk, returned by `NitroFS.createReadStream(...)`.
+ * A native thread reads a few chunks ahead and pauses until they are consumed.
+ */
+export interface NitroReadStream extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    /**
+     * The path the stream reads from
+     */
+    readonly path: string
+
+    /**
+     * Get the next chunk as raw bytes, or `undefined` at the end of the stream
+     */
+    read(): Promise<ArrayBuffer | undefined>
+    /**
+     * Get the next chunk decoded with the stream's `encoding`, or `undefined` at the end of the stream.
+     * Chunks never split a UTF-8 character, and base64 chunks can be decoded on their own
+     */
+    readString(): Promise<string | undefined>
+    /**
+     * Stop reading. Read-ahead chunks are dropped and later reads fail
+     */
+    close(): void
+}
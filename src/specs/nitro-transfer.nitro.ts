@@ -0,0 +1,34 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+import type { NitroFile, NitroTransferPriority, NitroTransferState } from '../type'
+
+/**
+ * An upload or download in the transfer queue, returned by `NitroFS.enqueueDownload(...)` and
+ * `NitroFS.enqueueUpload(...)`. The transfer keeps going if the handle is dropped, unless it is paused.
+ */
+export interface NitroTransfer extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    readonly id: number
+    readonly state: NitroTransferState
+    readonly priority: NitroTransferPriority
+
+    /**
+     * Resolve once the transfer completes. Rejects if it fails or is cancelled
+     */
+    result(): Promise<NitroFile>
+    /**
+     * Stop the transfer and free its slot. A download keeps what it has and picks up from there once resumed;
+     * an upload starts over
+     */
+    pause(): void
+    /**
+     * Put a paused transfer back in the queue, in its old place
+     */
+    resume(): void
+    /**
+     * Stop the transfer for good and reject its result. A cancelled download deletes its partial file
+     */
+    cancel(): void
+    /**
+     * Move the transfer to another priority. A running transfer keeps running
+     */
+    setPriority(priority: NitroTransferPriority): void
+}
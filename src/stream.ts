@@ -0,0 +1,29 @@
+import type { NitroReadStream } from './specs/nitro-read-stream.nitro'
+
+/**
+ * Iterate over the chunks of a read stream with `for await`.
+ * The next chunk is only requested once the loop body is done with the current one,
+ * and the stream is closed when the loop ends, also on `break` or an error
+ */
+export async function* readStreamChunks(stream: NitroReadStream): AsyncGenerator<ArrayBuffer> {
+    try {
+        for (let chunk = await stream.read(); chunk !== undefined; chunk = await stream.read()) {
+            yield chunk
+        }
+    } finally {
+        stream.close()
+    }
+}
+
+/**
+ * Like `readStreamChunks`, but yields chunks decoded with the stream's `encoding`
+ */
+export async function* readStreamStrings(stream: NitroReadStream): AsyncGenerator<string> {
+    try {
+        for (let chunk = await stream.readString(); chunk !== undefined; chunk = await stream.readString()) {
+            yield chunk
+        }
+    } finally {
+        stream.close()
+    }
+}
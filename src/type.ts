@@ -1,7 +1,271 @@
 export type NitroFileEncoding = 'utf8' | 'ascii' | 'base64'
 
+/**
+ * How `NitroFS.open` opens a file:
+ * - `read`: read only, the file must exist
+ * - `write`: read and write, the file must exist
+ * - `create`: read and write, the file is created if missing and its contents are kept
+ * - `overwrite`: read and write, the file is created if missing and truncated to 0 bytes
+ */
+export type NitroOpenMode = 'read' | 'write' | 'create' | 'overwrite'
+
+/**
+ * What `NitroFS.copy` does with a file that already exists at its destination:
+ * - `overwrite`: replace it
+ * - `skip`: keep it
+ * - `fail`: reject before anything is copied
+ */
+export type NitroConflictPolicy = 'overwrite' | 'skip' | 'fail'
+
+export interface NitroCopyOptions {
+    /**
+     * What to do with files that already exist at the destination. Directories are always merged
+     * @default 'overwrite'
+     */
+    conflict?: NitroConflictPolicy
+    /**
+     * The maximum number of threads copying at once
+     * @default the number of CPU cores
+     */
+    parallelism?: number
+}
+
+export interface NitroUnzipOptions {
+    /**
+     * The maximum number of threads extracting at once
+     * @default the number of CPU cores
+     */
+    parallelism?: number
+}
+
+export interface NitroZipOptions {
+    /**
+     * The deflate level, from 0 (store only) to 9 (smallest). Entries that don't shrink are always stored
+     * @default 6
+     */
+    level?: number
+    /**
+     * The maximum number of threads compressing at once
+     * @default the number of CPU cores
+     */
+    parallelism?: number
+}
+
+/**
+ * How far a write is flushed to storage before it resolves
+ * - `none`: nothing, the OS writes the data back later
+ * - `data`: the file contents (`fdatasync`)
+ * - `full`: contents and metadata (`fsync`, or `F_FULLFSYNC` on iOS)
+ */
+export type NitroFsyncMode = 'none' | 'data' | 'full'
+
+/**
+ * Compressed file formats:
+ * - `gzip`: what `gzip` writes, and HTTP's `Content-Encoding: gzip`
+ * - `deflate`: zlib-wrapped deflate, like HTTP's `Content-Encoding: deflate` and Node's `zlib.deflate`
+ * - `zstd`: Zstandard, faster and smaller; only available if the app links libzstd (see `isCompressionAvailable`)
+ */
+export type NitroCompressionFormat = 'gzip' | 'deflate' | 'zstd'
+
+export interface NitroWriteOptions {
+    /**
+     * Write to a temporary file in the same directory and rename it over the destination,
+     * so a crash leaves either the old or the new contents
+     * @default false
+     */
+    atomic?: boolean
+    /**
+     * How the file (and for atomic writes, its directory) is synced before the write resolves
+     * @default 'data' for atomic writes, 'none' otherwise
+     */
+    fsync?: NitroFsyncMode
+    /**
+     * Reserve the final size before writing. Ignored when compressing
+     * @default false
+     */
+    preallocate?: boolean
+    /**
+     * Compress the data natively on its way to disk
+     */
+    compress?: NitroCompressionFormat
+    /**
+     * Compression level: 0-9 for gzip and deflate, 1-22 for zstd (negative levels trade ratio for speed)
+     * @default 6 for gzip and deflate, 3 for zstd
+     */
+    compressionLevel?: number
+}
+
+export interface NitroReadOptions {
+    /**
+     * Decompress the file natively while reading it; only the decompressed data is returned
+     */
+    decompress?: NitroCompressionFormat
+}
+
+export interface NitroCompressOptions {
+    /**
+     * Compression level: 0-9 for gzip and deflate, 1-22 for zstd (negative levels trade ratio for speed)
+     * @default 6 for gzip and deflate, 3 for zstd
+     */
+    level?: number
+    /**
+     * Threads compressing a zstd file. gzip and deflate always use one thread
+     * @default the number of CPU cores for files of 4MB or more, 1 otherwise
+     */
+    threads?: number
+}
+
+export interface NitroFileWriterOptions {
+    /**
+     * Buffered bytes that trigger a write
+     * @default 65536
+     */
+    bufferSize?: number
+    /**
+     * The longest, in milliseconds, that written data waits in the buffer
+     * @default 1000
+     */
+    flushInterval?: number
+    /**
+     * How `flush()` and `close()` sync the file. Writes triggered by `bufferSize` or `flushInterval` are never synced
+     * @default 'data'
+     */
+    fsync?: NitroFsyncMode
+    /**
+     * Compress everything written. Every buffer written out is flushed through the compressor, so the file can always
+     * be decompressed up to the last write. Reopening a gzip or zstd file appends a new member or frame;
+     * a non-empty file can't be continued with `deflate`
+     */
+    compress?: NitroCompressionFormat
+    /**
+     * Compression level: 0-9 for gzip and deflate, 1-22 for zstd (negative levels trade ratio for speed)
+     * @default 6 for gzip and deflate, 3 for zstd
+     */
+    compressionLevel?: number
+    /**
+     * Unwritten bytes at which `write` and `writeBuffer` block until the disk catches up. Raised to `bufferSize` if lower
+     * @default 8388608
+     */
+    highWaterMark?: number
+}
+
+export interface NitroReadStreamOptions {
+    /**
+     * Size of each chunk in bytes. The last chunk may be shorter
+     * @default 65536
+     */
+    chunkSize?: number
+    /**
+     * Offset of the first byte to read
+     * @default 0
+     */
+    start?: number
+    /**
+     * Offset of the last byte to read (inclusive, like Node's `fs.createReadStream`)
+     * @default the end of the file
+     */
+    end?: number
+    /**
+     * The encoding used by `readString()`
+     * @default 'utf8'
+     */
+    encoding?: NitroFileEncoding
+    /**
+     * How many chunks are read ahead before reading pauses
+     * @default 4
+     */
+    highWaterMark?: number
+}
+
+export interface NitroReadLinesOptions {
+    /**
+     * The first line to read (0-based). Negative values count from the end: `-100` reads the last 100 lines
+     * @default 0
+     */
+    startLine?: number
+    /**
+     * The most lines to read
+     * @default Infinity
+     */
+    maxLines?: number
+    /**
+     * Lines per `onLines` call
+     * @default 1000
+     */
+    batchSize?: number
+    /**
+     * Only report the byte offset of each line, without its text
+     * @default false
+     */
+    offsetsOnly?: boolean
+}
+
+export type NitroLineBatch = {
+    /**
+     * The number of the first line in this batch (0-based)
+     */
+    firstLine: number
+    /**
+     * The lines, without their line breaks. Empty if `offsetsOnly` is set
+     */
+    lines: string[]
+    /**
+     * The byte offset of each line in the file
+     */
+    offsets: number[]
+}
+
+/**
+ * Checksum or digest for `NitroFS.hashFile`:
+ * - `sha256`: SHA-256, for verifying downloads against a published digest
+ * - `crc32c`: CRC-32C (Castagnoli), as used by Google Cloud Storage and iSCSI
+ * - `xxh3`: XXH3 64-bit, a fast non-cryptographic hash for cache keys and change detection
+ * - `blake3`: BLAKE3 256-bit, cryptographic and hashed on several threads for large files
+ */
+export type NitroHashAlgorithm = 'sha256' | 'crc32c' | 'xxh3' | 'blake3'
+
+export interface NitroHashOptions {
+    /**
+     * The byte offset to start hashing at
+     * @default 0
+     */
+    offset?: number
+    /**
+     * The number of bytes to hash. Hashing stops at the end of the file if it comes first
+     * @default the rest of the file
+     */
+    length?: number
+}
+
+export interface NitroRemoveOptions {
+    /**
+     * Remove directories together with everything in them
+     * @default false
+     */
+    recursive?: boolean
+    /**
+     * The maximum number of threads removing at once
+     * @default the number of CPU cores
+     */
+    parallelism?: number
+    /**
+     * Only move the tree out of the way, and remove it on a background thread. The promise resolves
+     * with 0 as soon as the path is gone. Requires `recursive`
+     * @default false
+     */
+    background?: boolean
+}
+
 export type NitroUploadMethod = 'POST' | 'PUT' | 'PATCH'
 
+/**
+ * How `NitroFS.uploadFile` sends the file:
+ * - `multipart`: as the one part of a `multipart/form-data` body, under `field`
+ * - `raw`: as the whole request body, as object stores expect for a `PUT`. The `Content-Type` header
+ *   defaults to `application/octet-stream`
+ */
+export type NitroUploadBodyType = 'multipart' | 'raw'
+
 export interface NitroUploadOptions {
     /**
      * The path to the file to upload
@@ -16,7 +280,12 @@ export interface NitroUploadOptions {
      */
     method?: NitroUploadMethod
     /**
-     * The field name to use for the file upload
+     * How the file is sent
+     * @default 'multipart'
+     */
+    bodyType?: NitroUploadBodyType
+    /**
+     * The field name to use for the file upload. Only used by `multipart` uploads
      * @default 'file'
      */
     field?: string
@@ -39,14 +308,184 @@ export interface NitroDownloadOptions {
      * The headers to send with the download request
      */
     headers?: Record<string, string>
+    /**
+     * The number of byte ranges fetched at once, each over its own connection. Only used when the server
+     * supports ranges and the file is at least two `minSegmentSize`s; otherwise the file is fetched in one piece
+     * @default 1
+     */
+    segments?: number
+    /**
+     * The smallest range one segment is given, in bytes
+     * @default 4194304 (4MB)
+     */
+    minSegmentSize?: number
 }
 
+export interface NitroTransferOptions {
+    /**
+     * The most connections open at once to one host, across all uploads and downloads. Further requests wait
+     * for a free one. Segmented downloads are capped by it too, clamped to 1-64
+     * @default 6
+     */
+    maxConnectionsPerHost?: number
+    /**
+     * The most uploads and downloads running at once, across all hosts. Further ones wait in the queue,
+     * clamped to 1-64
+     * @default 8
+     */
+    maxConcurrentTransfers?: number
+}
+
+/**
+ * How the transfer queue orders a transfer:
+ * - `userVisible`: something the user is waiting on. Always starts before any prefetch
+ * - `prefetch`: speculative work. Only starts while no user-visible transfer is waiting, and never takes
+ *   more than half of `maxConcurrentTransfers`
+ */
+export type NitroTransferPriority = 'userVisible' | 'prefetch'
+
+/**
+ * Where a queued transfer is. `completed`, `failed` and `cancelled` are final
+ */
+export type NitroTransferState = 'queued' | 'running' | 'paused' | 'completed' | 'failed' | 'cancelled'
+
 export type NitroFile = {
     name: string
     mimeType: string
     path: string
 }
 
+export type NitroFileType = 'file' | 'directory' | 'symlink' | 'other'
+
+export interface NitroReaddirOptions {
+    /**
+     * Also return `size` and `mtime` of every entry, read in the same native pass as the listing
+     * @default false
+     */
+    stats?: boolean
+    /**
+     * Guess `mimeType` from every entry's file extension
+     * @default true
+     */
+    mimeTypes?: boolean
+}
+
+export type NitroDirEntry = {
+    name: string
+    /**
+     * Only set if `mimeTypes` is enabled
+     */
+    mimeType?: string
+    path: string
+    /**
+     * The type of the entry itself; symlinks are not followed. Not set for `content://` directories
+     */
+    type?: NitroFileType
+    /**
+     * Only set if `stats` is enabled
+     */
+    size?: number
+    /**
+     * Only set if `stats` is enabled
+     */
+    mtime?: number
+}
+
+export interface NitroWalkFilter {
+    /**
+     * Only report entries of these types. Directories are still walked either way
+     * @default all types
+     */
+    types?: NitroFileType[]
+    /**
+     * Only report entries with one of these file extensions, compared case-insensitively, e.g. `['jpg', 'png']`
+     * @default all extensions
+     */
+    extensions?: string[]
+    /**
+     * Report and walk entries whose name starts with a dot
+     * @default true
+     */
+    includeHidden?: boolean
+}
+
+export interface NitroWalkOptions {
+    /**
+     * How many levels below the root to list; `1` lists only the root's own entries
+     * @default Infinity
+     */
+    maxDepth?: number
+    /**
+     * Walk into symlinked directories, and report symlinks as what they point to. A link to a directory it is inside of is reported but not walked again; other links to the same directory are walked, like `find -L`
+     * @default false
+     */
+    followSymlinks?: boolean
+    /**
+     * Which entries to report
+     */
+    filter?: NitroWalkFilter
+    /**
+     * Also return `size` and `mtime` of every entry
+     * @default false
+     */
+    stats?: boolean
+    /**
+     * Guess `mimeType` from every entry's file extension
+     * @default true
+     */
+    mimeTypes?: boolean
+    /**
+     * The maximum number of entries passed to `onEntries` at once
+     * @default 1000
+     */
+    batchSize?: number
+}
+
+export interface NitroDiskUsageOptions {
+    /**
+     * The maximum number of threads counting at once
+     * @default the number of CPU cores
+     */
+    parallelism?: number
+    /**
+     * How many of the largest files and directories to return
+     * @default 0
+     */
+    topK?: number
+}
+
+export type NitroDiskUsageEntry = {
+    path: string
+    size: number
+}
+
+export type NitroDiskUsage = {
+    /**
+     * The sum of all file sizes, in bytes
+     */
+    size: number
+    /**
+     * The space actually allocated on disk for files and directories, in bytes
+     */
+    allocatedSize: number
+    /**
+     * Everything that is not a directory, symlinks included
+     */
+    fileCount: number
+    /**
+     * The number of directories below the root
+     */
+    directoryCount: number
+    /**
+     * The `topK` largest files, largest first
+     */
+    largestFiles: NitroDiskUsageEntry[]
+    /**
+     * The `topK` largest directories below the root by total size, largest first
+     */
+    largestDirectories: NitroDiskUsageEntry[]
+}
+
 export type NitroFileStat = {
     size: number
     ctime: number
@@ -54,3 +493,32 @@ export type NitroFileStat = {
     isFile: boolean
     isDirectory: boolean
 }
+
+/**
+ * The result of `NitroFS.statMany` for one path: either `stat` or `error` is set
+ */
+export type NitroStatResult = {
+    stat?: NitroFileStat
+    /**
+     * Why the path could not be stat'ed, e.g. `stat(/a/b): No such file or directory`
+     */
+    error?: string
+}
+
+export interface NitroMapOptions {
+    /**
+     * The first byte of the file to map
+     * @default 0
+     */
+    offset?: number
+    /**
+     * The number of bytes to map
+     * @default the rest of the file
+     */
+    length?: number
+    /**
+     * Map the file privately; writes to the buffer are never written back to the file
+     * @default true
+     */
+    readOnly?: boolean
+}